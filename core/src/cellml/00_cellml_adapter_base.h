@@ -57,6 +57,12 @@ public:
   //! get the prefactor value, i.e. the factor with which the solution will be scaled before the transfer in an operator splitting scheme
   double prefactor();
 
+  //! get the parameter values of all instances, in struct-of-array order
+  std::vector<double> &parameters();
+
+  //! get the intermediate values of all instances, in struct-of-array order
+  std::vector<double> &intermediates();
+
 protected:
 
   //! scan the given cellml source file for initial values that are given by dummy assignments (OpenCMISS) or directly (OpenCOR). This also sets nParameters_, nConstants_ and nIntermediates_
@@ -192,3 +192,17 @@ prefactor()
 {
   return prefactor_;
 }
+
+template<int nStates, typename FunctionSpaceType>
+std::vector<double> &CellmlAdapterBase<nStates,FunctionSpaceType>::
+parameters()
+{
+  return parameters_;
+}
+
+template<int nStates, typename FunctionSpaceType>
+std::vector<double> &CellmlAdapterBase<nStates,FunctionSpaceType>::
+intermediates()
+{
+  return intermediates_;
+}
@@ -27,16 +27,70 @@ class RhsRoutineHandler:
 {
 public:
 
+  typedef void (*RhsRoutine)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);   ///< signature of the rhs routine for multiple instances
+  typedef void (*BatchedRhsRoutine)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters,
+                                    int instanceBegin, int instanceEnd);   ///< signature of the batched rhs routine that computes the instances instanceBegin <= i < instanceEnd
+  typedef void (*BatchedRhsRoutineSinglePrecision)(void *context, double t, float *states, float *rates, float *algebraics, float *parameters,
+                                                   int instanceBegin, int instanceEnd);   ///< signature of the batched rhs routine with values in single precision
+  typedef void (*GatingCoefficientsRoutine)(void *context, double t, double *states, double *coefficients, double *algebraics, double *parameters);   ///< signature of the routine that computes the coefficients b of the rates a - b*y of the gating variables
+
   //! constructor
   using CellmlAdapterBase<nStates,FunctionSpaceType>::CellmlAdapterBase;
 
+  //! Create, compile and load the simd rhs routine for the given number of instances, this is used to evaluate the instances of several CellmlAdapter objects in one call.
+  //! This is collective on MPI_COMM_WORLD like compileLibraryCollectively, ranks without a batch have to call compileLibraryCollectively with an empty filename instead.
+  //! @return the rhs routine or nullptr if this is not possible, e.g. for a given library or gpu code
+  //! The routine only computes the given range of instances, such that instances that do not need to be computed can be skipped.
+  //! If gatingCoefficientsRoutine is given, it is set to the routine of the same library that computes the coefficients of the gating variables of all instances, or nullptr if there is none.
+  BatchedRhsRoutine createBatchedRhsRoutine(int nInstancesBatch, GatingCoefficientsRoutine *gatingCoefficientsRoutine = nullptr);
+
+  //! Create, compile and load the simd rhs routine for the given number of instances where states, rates, algebraics and parameters are stored in single precision, like createBatchedRhsRoutine
+  BatchedRhsRoutineSinglePrecision createBatchedRhsRoutineSinglePrecision(int nInstancesBatch);
+
+  //! if the option "useSinglePrecision" is set, i.e. the states should be integrated in single precision where this is possible (several instances integrated together by BatchedAdvance)
+  bool useSinglePrecision() const;
+
+  //! the states that are accumulated in double precision when the other states are integrated in single precision, option "doublePrecisionStateNos"
+  const std::vector<int> &doublePrecisionStateNos() const;
+
+  //! the states that are gating variables, i.e. their rate has the form a - b*y with a and b independent of the state y, this is detected when the simd source file is created
+  const std::vector<int> &gatingStateNos() const;
+
+  //! Compile the library with the given compile command, collective on MPI_COMM_WORLD. Every library filename is compiled only once, by the lowest rank that needs it,
+  //! the other ranks wait until it has been compiled. Ranks that do not need a library take part with an empty libraryFilename. @return if the library exists
+  static bool compileLibraryCollectively(std::string libraryFilename, std::string compileCommand);
+
 protected:
-  //! given a normal cellml source file for rhs routine create a second file for multiple instances. @return: if successful
-  bool createSimdSourceFile(std::string &simdSourceFilename);
+  //! given a normal cellml source file for rhs routine create a second file for nInstances instances. @return: if successful
+  //! If useLookupTables_ is set, algebraics that only depend on the membrane potential and contain function calls are interpolated in lookup tables.
+  //! If singlePrecision is set, the rhs routine is called computeCellMLRightHandSideSinglePrecision and has float arrays.
+  //! If instanceRange is set, the rhs routine has the additional arguments instanceBegin and instanceEnd and only computes these instances, see BatchedRhsRoutine.
+  bool createSimdSourceFile(std::string &simdSourceFilename, int nInstances, bool singlePrecision = false, bool instanceRange = false);
+
+  //! create the simd source file for the given number of instances, compile and load it, this is collective on MPI_COMM_WORLD. @return the handle of the library or nullptr
+  void *loadBatchedRhsLibrary(int nInstancesBatch, bool singlePrecision);
+
+  //! get the compiler command and flags for the simd source file
+  std::string simdCompileCommandOptions();
 
   //! given a normal cellml source file for rhs routine create a third file for gpu acceloration. @return: if successful
   bool createGPUSourceFile(std::string &gpuSourceFilename);
 
+  //! parse the options for the lookup tables of the simd source file
+  void parseLookupTableOptions();
+
+  //! parse the options for the integration in single precision
+  void parseSinglePrecisionOptions();
+
+  //! create the code of the lookup tables for the given algebraics, to be placed in front of the simd rhs routine, the statements compute the tabulated algebraics from the membrane potential
+  std::string createLookupTableSource(const std::vector<int> &lookupTableAlgebraics, const std::string &lookupTableStatements);
+
+  //! call the routine initializeLookupTables of the loaded library that computes the values of the lookup tables, if the library has lookup tables
+  void initializeLookupTables(void *handle);
+
+  //! get a short hash of the generated source code that is used in the library filenames, such that libraries of different code have different names
+  static std::string computeSourceHash(const std::string &source);
+
   //! initialize the rhs routine, either directly from a library or compile it
   void initializeRhsRoutine();
 
@@ -49,12 +103,22 @@ protected:
   bool useGivenLibrary_;   ///< if the given library at libraryFileName_ should be loaded instead of compiling on our own
 
   std::vector<std::string> constantAssignments_;   ///< source code lines where constant variables are assigned
+  std::vector<int> gatingStateNos_;                ///< the states that are gating variables, detected in createSimdSourceFile
+  std::string generatedSourceHash_;                ///< hash of the last source file that was created by createSimdSourceFile or createGPUSourceFile, part of the library filenames
+
+  bool useLookupTables_;                           ///< if algebraics that only depend on the membrane potential are interpolated in lookup tables instead of evaluating their expressions
+  int lookupTableStateNo_;                         ///< the state that is the membrane potential, the variable of the lookup tables
+  std::array<double,2> lookupTableRange_;          ///< the range of the membrane potential that is covered by the lookup tables, values outside are clamped
+  double lookupTableResolution_;                   ///< the distance between the sampling points of the lookup tables
+  bool useSinglePrecision_;                        ///< if the states should be stored and integrated in single precision by batched time stepping schemes
+  std::vector<int> doublePrecisionStateNos_;       ///< the states that are accumulated in double precision if useSinglePrecision_ is set, e.g. the membrane potential
 
   void (*rhsRoutine_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);  ///< function pointer to the rhs routine that can compute several instances of the problem in parallel. Data is assumed to contain values for a state contiguously, e.g. (state[1], state[1], state[1], state[2], state[2], state[2], ...). The first parameter is a this pointer.
 
   //! helper rhs routines
   void (*rhsRoutineOpenCMISS_)(double VOI, double* OC_STATE, double* OC_RATE, double* OC_WANTED, double* OC_KNOWN);   ///< function pointer to a rhs function that is passed as dynamic library, computes rates and intermediate values from states. The parameters are: VOI, STATES, RATES, WANTED, KNOWN, (VOI: current simulation time, not used)
   void (*rhsRoutineGPU_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);   ///< function pointer to a gpu processed rhs function that is passed as dynamic library. Data is assumed to contain values for a state contiguously, e.g. (state[1], state[1], state[1], state[2], state[2], state[2], ...).
+  GatingCoefficientsRoutine gatingCoefficientsRoutine_ = nullptr;   ///< function pointer to the routine that computes the coefficients b of the rates a - b*y of the gating variables, nullptr if the library does not contain it
   void (*initConstsOpenCOR_)(double* CONSTANTS, double* RATES, double *STATES); ///< function pointer to a function that initializes everything, generated by OpenCOR
   void (*computeRatesOpenCOR_)(double VOI, double* CONSTANTS, double* RATES, double* STATES, double* ALGEBRAIC); ///< function pointer to a function that computes the rates from the current states, generated by OpenCOR
   void (*computeVariablesOpenCOR_)(double VOI, double* CONSTANTS, double* RATES, double* STATES, double* ALGEBRAIC); ///< function pointer to a function that computes the algebraic variables from the current states, generated by OpenCOR
@@ -2,13 +2,21 @@
 
 #include <Python.h>  // has to be the first included header
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
 #include <list>
+#include <map>
+#include <set>
 #include <sstream>
 
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
 #include "utility/string_utility.h"
 #include "mesh/mesh_manager.h"
+#include "cellml/expression_analysis.h"
 
 #include <unistd.h>  //dlopen
 #include <dlfcn.h>
@@ -31,6 +39,8 @@ initializeRhsRoutine()
    */
   std::string libraryFilename;
   useGivenLibrary_ = this->specificSettings_.getOptionBool("useGivenLibrary", false);
+  parseLookupTableOptions();
+  parseSinglePrecisionOptions();
 
   // output warning if the old option forceRecompileRhs is still used
   if (this->specificSettings_.hasKey("forceRecompileRhs"))
@@ -89,31 +99,18 @@ initializeRhsRoutine()
       //
 
       // file does not exist yet or is not a matching one. create one.
-      if (!createSimdSourceFile(simdSourceFilename))
+      if (!createSimdSourceFile(simdSourceFilename, this->nInstances_))
       {
          LOG(ERROR) << "Could not create a simd version for CellML RHS.";
       }
       sourceFilenameToUse = simdSourceFilename;
 
-      // load compiler flags     
-      std::string compilerFlags = this->specificSettings_.getOptionString("compilerFlags", "-fPIC -finstrument-functions -ftree-vectorize -fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
-
-#ifdef NDEBUG
-      // other possible options
-      // -fopt-info-vec-missed=vectorizer_missed.log
-      // -fopt-info-vec-all=vectorizer_all.log
-      std::stringstream s;
-      s << C_COMPILER_COMMAND << " -O3 " << compilerFlags << " ";
-      compileCommandOptions = s.str();
-#else
-      std::stringstream s;
-      s << C_COMPILER_COMMAND << " -O0 -ggdb " << compilerFlags << " ";
-      compileCommandOptions = s.str();
-#endif
+      compileCommandOptions = simdCompileCommandOptions();
     }
     // compile source file to a library
     std::stringstream s;
-    s << "lib/"+StringUtility::extractBasename(this->sourceFilename_) << "_" << this->nInstances_ << ".so";
+    // the hash of the generated source is part of the name, such that libraries of different options, e.g. for the lookup tables, are not mixed up
+    s << "lib/"+StringUtility::extractBasename(this->sourceFilename_) << "_" << this->nInstances_ << "_" << generatedSourceHash_ << ".so";
     libraryFilename = s.str();
 
     if (this->specificSettings_.hasKey("libraryFilename"))
@@ -210,6 +207,272 @@ initializeRhsRoutine()
   loadRhsLibrary(libraryFilename);
 }
 
+template<int nStates, typename FunctionSpaceType>
+void RhsRoutineHandler<nStates,FunctionSpaceType>::
+parseLookupTableOptions()
+{
+  useLookupTables_ = this->specificSettings_.getOptionBool("useLookupTables", false);
+  lookupTableStateNo_ = this->specificSettings_.getOptionInt("lookupTableStateNo", 0, PythonUtility::NonNegative);
+  lookupTableRange_ = this->specificSettings_.template getOptionArray<double,2>("lookupTableRange", std::array<double,2>({-100.0, 100.0}));
+  lookupTableResolution_ = this->specificSettings_.getOptionDouble("lookupTableResolution", 0.05, PythonUtility::Positive);
+
+  if (!useLookupTables_)
+    return;
+
+  if (lookupTableStateNo_ >= nStates)
+  {
+    LOG(ERROR) << this->specificSettings_ << "[\"lookupTableStateNo\"] = " << lookupTableStateNo_ << " is invalid, there are only " << nStates << " states. "
+      << "No lookup tables are used.";
+    useLookupTables_ = false;
+  }
+  if (lookupTableRange_[1] <= lookupTableRange_[0])
+  {
+    LOG(ERROR) << this->specificSettings_ << "[\"lookupTableRange\"] = " << lookupTableRange_ << " is invalid, the upper bound has to be greater than the lower bound. "
+      << "No lookup tables are used.";
+    useLookupTables_ = false;
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void RhsRoutineHandler<nStates,FunctionSpaceType>::
+parseSinglePrecisionOptions()
+{
+  useSinglePrecision_ = this->specificSettings_.getOptionBool("useSinglePrecision", false);
+
+  // by default the membrane potential (state 0) is accumulated in double precision, because its increments are small compared to its value
+  // getOptionVector appends to the given vector, the default has to be removed first, an empty list means that no state is accumulated in double precision
+  doublePrecisionStateNos_ = std::vector<int>({0});
+  if (this->specificSettings_.hasKey("doublePrecisionStateNos"))
+  {
+    doublePrecisionStateNos_.clear();
+    this->specificSettings_.getOptionVector("doublePrecisionStateNos", doublePrecisionStateNos_);
+  }
+
+  for (std::vector<int>::iterator iter = doublePrecisionStateNos_.begin(); iter != doublePrecisionStateNos_.end();)
+  {
+    if (*iter < 0 || *iter >= nStates)
+    {
+      LOG(ERROR) << this->specificSettings_ << "[\"doublePrecisionStateNos\"] contains the invalid state " << *iter << ", there are only " << nStates << " states.";
+      iter = doublePrecisionStateNos_.erase(iter);
+    }
+    else
+    {
+      iter++;
+    }
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+std::string RhsRoutineHandler<nStates,FunctionSpaceType>::
+simdCompileCommandOptions()
+{
+  // load compiler flags
+  std::string compilerFlags = this->specificSettings_.getOptionString("compilerFlags", "-fPIC -finstrument-functions -ftree-vectorize -fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
+
+#ifdef NDEBUG
+  // other possible options
+  // -fopt-info-vec-missed=vectorizer_missed.log
+  // -fopt-info-vec-all=vectorizer_all.log
+  std::stringstream s;
+  s << C_COMPILER_COMMAND << " -O3 " << compilerFlags << " ";
+#else
+  std::stringstream s;
+  s << C_COMPILER_COMMAND << " -O0 -ggdb " << compilerFlags << " ";
+#endif
+  return s.str();
+}
+
+template<int nStates, typename FunctionSpaceType>
+typename RhsRoutineHandler<nStates,FunctionSpaceType>::BatchedRhsRoutine RhsRoutineHandler<nStates,FunctionSpaceType>::
+createBatchedRhsRoutine(int nInstancesBatch, GatingCoefficientsRoutine *gatingCoefficientsRoutine)
+{
+  if (gatingCoefficientsRoutine)
+    *gatingCoefficientsRoutine = nullptr;
+
+  void *handle = loadBatchedRhsLibrary(nInstancesBatch, false);
+  if (!handle)
+    return nullptr;
+
+  // the library only contains the routine for the gating variables if the model has gating variables
+  if (gatingCoefficientsRoutine)
+    *gatingCoefficientsRoutine = (GatingCoefficientsRoutine) dlsym(handle, "computeCellMLGatingCoefficients");
+
+  return (BatchedRhsRoutine) dlsym(handle, "computeCellMLRightHandSide");
+}
+
+template<int nStates, typename FunctionSpaceType>
+typename RhsRoutineHandler<nStates,FunctionSpaceType>::BatchedRhsRoutineSinglePrecision RhsRoutineHandler<nStates,FunctionSpaceType>::
+createBatchedRhsRoutineSinglePrecision(int nInstancesBatch)
+{
+  void *handle = loadBatchedRhsLibrary(nInstancesBatch, true);
+  if (!handle)
+    return nullptr;
+
+  return (BatchedRhsRoutineSinglePrecision) dlsym(handle, "computeCellMLRightHandSideSinglePrecision");
+}
+
+template<int nStates, typename FunctionSpaceType>
+bool RhsRoutineHandler<nStates,FunctionSpaceType>::
+useSinglePrecision() const
+{
+  return useSinglePrecision_;
+}
+
+template<int nStates, typename FunctionSpaceType>
+const std::vector<int> &RhsRoutineHandler<nStates,FunctionSpaceType>::
+doublePrecisionStateNos() const
+{
+  return doublePrecisionStateNos_;
+}
+
+template<int nStates, typename FunctionSpaceType>
+void *RhsRoutineHandler<nStates,FunctionSpaceType>::
+loadBatchedRhsLibrary(int nInstancesBatch, bool singlePrecision)
+{
+  // only the simd code generated by opendihu can be created for a different number of instances
+  if (useGivenLibrary_ || this->specificSettings_.hasKey("gpuSourceFilename"))
+  {
+    LOG(DEBUG) << "createBatchedRhsRoutine: rhs routine is given by a library or gpu code, it cannot be batched";
+    compileLibraryCollectively("", "");
+    return nullptr;
+  }
+
+  std::string simdSourceFilename;
+  if (!createSimdSourceFile(simdSourceFilename, nInstancesBatch, singlePrecision, true))
+  {
+    LOG(ERROR) << "Could not create a simd version for CellML RHS with " << nInstancesBatch << " instances.";
+    compileLibraryCollectively("", "");
+    return nullptr;
+  }
+
+  // libraries with different code need different names, because dlopen returns the already loaded library for the same filename,
+  // therefore the name contains the hash of the generated source, which changes e.g. with the precision or the lookup table options
+  std::stringstream s;
+  s << "lib/" << StringUtility::extractBasename(this->sourceFilename_) << "_batch_" << (singlePrecision? "single_" : "") << nInstancesBatch
+    << "_" << generatedSourceHash_ << ".so";
+  std::string libraryFilename = s.str();
+
+  std::stringstream compileCommand;
+  compileCommand << simdCompileCommandOptions() << " " << simdSourceFilename;
+
+  if (!compileLibraryCollectively(libraryFilename, compileCommand.str()))
+    return nullptr;
+
+  std::string currentWorkingDirectory = getcwd(NULL,0);
+  if (currentWorkingDirectory[currentWorkingDirectory.length()-1] != '/')
+    currentWorkingDirectory += "/";
+
+  void* handle = dlopen((currentWorkingDirectory+libraryFilename).c_str(), RTLD_LOCAL | RTLD_LAZY);
+  if (!handle)
+  {
+    LOG(ERROR) << "Could not load dynamic library \"" << libraryFilename << "\". Reason: " << dlerror();
+    return nullptr;
+  }
+
+  initializeLookupTables(handle);
+  return handle;
+}
+
+template<int nStates, typename FunctionSpaceType>
+void RhsRoutineHandler<nStates,FunctionSpaceType>::
+initializeLookupTables(void *handle)
+{
+  // the routine only exists if the generated source contains lookup tables
+  void (*initializeLookupTablesRoutine)() = (void (*)()) dlsym(handle, "initializeLookupTables");
+  if (initializeLookupTablesRoutine)
+  {
+    LOG(DEBUG) << "initialize lookup tables";
+    initializeLookupTablesRoutine();
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+std::string RhsRoutineHandler<nStates,FunctionSpaceType>::
+computeSourceHash(const std::string &source)
+{
+  std::stringstream s;
+  s << std::hex << std::hash<std::string>()(source);
+  return s.str();
+}
+
+template<int nStates, typename FunctionSpaceType>
+bool RhsRoutineHandler<nStates,FunctionSpaceType>::
+compileLibraryCollectively(std::string libraryFilename, std::string compileCommand)
+{
+  int nRanks = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_size(MPI_COMM_WORLD, &nRanks), "MPI_Comm_size");
+  int rankNoWorldCommunicator = DihuContext::ownRankNo();
+
+  // gather which library all ranks need, identified by the hash of the filename, 0 means that the rank needs no library
+  unsigned long long libraryHash = 0;
+  if (!libraryFilename.empty())
+    libraryHash = std::max((unsigned long long)std::hash<std::string>()(libraryFilename), 1ULL);
+
+  std::vector<unsigned long long> libraryHashRanks(nRanks);
+  libraryHashRanks[rankNoWorldCommunicator] = libraryHash;
+
+  MPIUtility::handleReturnValue(MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, libraryHashRanks.data(),
+                                              1, MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD), "MPI_Allgather");
+
+  // determine if this rank should do compilation, such that each library is compiled only once, by the rank with lowest number
+  int rankWhichCompilesLibrary = std::find(libraryHashRanks.begin(), libraryHashRanks.end(), libraryHash) - libraryHashRanks.begin();
+
+  bool compilationSucceeded = true;
+  if (libraryHash != 0 && rankWhichCompilesLibrary == rankNoWorldCommunicator)
+  {
+    LOG(DEBUG) << "compile batched library \"" << libraryFilename << "\" on this rank";
+
+    std::string path = libraryFilename.substr(0, libraryFilename.rfind("/"));
+    int ret = system((std::string("mkdir -p ")+path).c_str());
+    if (ret != 0)
+    {
+      LOG(ERROR) << "Could not create path \"" << path << "\".";
+    }
+
+    // compile library to filename with "*.rankNoWorldCommunicator", then rename file to without "*.rankNoWorldCommunicator"
+    std::stringstream command;
+    command << compileCommand
+      << " -o " << libraryFilename << "." << rankNoWorldCommunicator
+      << " && mv " << libraryFilename << "." << rankNoWorldCommunicator << " " << libraryFilename;
+
+    ret = system(command.str().c_str());
+    if (ret != 0)
+    {
+      LOG(ERROR) << "Compilation failed. Command: \"" << command.str() << "\".";
+      compilationSucceeded = false;
+    }
+    else
+    {
+      LOG(DEBUG) << "Compilation successful. Command: \"" << command.str() << "\".";
+    }
+  }
+
+  // barrier to wait until the ranks that compile the libraries have finished
+  MPIUtility::handleReturnValue(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+
+  if (libraryHash == 0)
+    return false;
+
+  // the ranks that did not compile the library check if it exists
+  if (rankWhichCompilesLibrary != rankNoWorldCommunicator)
+  {
+    std::ifstream file(libraryFilename);
+    if (!file.is_open())
+    {
+      LOG(ERROR) << "Library \"" << libraryFilename << "\" was not compiled by rank " << rankWhichCompilesLibrary << ".";
+      compilationSucceeded = false;
+    }
+  }
+  return compilationSucceeded;
+}
+
+template<int nStates, typename FunctionSpaceType>
+const std::vector<int> &RhsRoutineHandler<nStates,FunctionSpaceType>::
+gatingStateNos() const
+{
+  return gatingStateNos_;
+}
+
 template<int nStates, typename FunctionSpaceType>
 bool RhsRoutineHandler<nStates,FunctionSpaceType>::
 loadRhsLibrary(std::string libraryFilename)
@@ -231,12 +494,16 @@ loadRhsLibrary(std::string libraryFilename)
 
   if (handle)
   {
+    // compute the lookup tables of a generated library once, before the rhs routine is called
+    initializeLookupTables(handle);
+
     // load rhs method
 
     // try to load several routine names
     rhsRoutine_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeCellMLRightHandSide");
     rhsRoutineOpenCMISS_ = (void (*)(double,double*,double*,double*,double*)) dlsym(handle, "OC_CellML_RHS_routine");
     rhsRoutineGPU_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeGPUCellMLRightHandSide");
+    gatingCoefficientsRoutine_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeCellMLGatingCoefficients");
     initConstsOpenCOR_ = (void(*)(double*, double*, double*)) dlsym(handle, "initConsts");
     computeRatesOpenCOR_ = (void(*)(double, double*, double*, double*, double*)) dlsym(handle, "computeRates");
     computeVariablesOpenCOR_  = (void(*)(double, double*, double*, double*, double*)) dlsym(handle, "computeVariables");
@@ -330,9 +597,11 @@ loadRhsLibrary(std::string libraryFilename)
 
 template<int nStates, typename FunctionSpaceType>
 bool RhsRoutineHandler<nStates,FunctionSpaceType>::
-createSimdSourceFile(std::string &simdSourceFilename)
+createSimdSourceFile(std::string &simdSourceFilename, int nInstances, bool singlePrecision, bool instanceRange)
 {
   // This method can handle two different types of input c files: from OpenCMISS and from OpenCOR
+  // It can be called multiple times for different nInstances, the constant assignments are collected again in every call
+  constantAssignments_.clear();
 
   // input source filename is this->sourceFilename_
   bool inputFileTypeOpenCMISS = true;   //< if the input file that is being parsed is from OpenCMISS and not from OpenCOR
@@ -354,7 +623,22 @@ createSimdSourceFile(std::string &simdSourceFilename)
     bool discardOpenBrace = false;   // if the next line consisting of only "{" should be discarded
     std::stringstream simdSource;
 
-    simdSource << "#include <math.h>" << std::endl;
+    // for the detection of gating variables, i.e. states with a rate that is linear in the state itself
+    const std::string gatingStatePlaceholder = "GATING_STATE";
+    std::map<int,std::set<int>> algebraicStateDependencies;    // for every algebraic the states on which it depends
+    std::map<int,std::string> gatingRateExpressions;           // for every gating state the expression of its rate, with gatingStatePlaceholder for the state
+
+    // in single precision, the states, rates, algebraics and parameters are float arrays, constants and lookup tables stay double
+    const std::string realType = (singlePrecision? "float" : "double");
+
+    // the loops over the instances either compute all instances or only the range that is given by the arguments instanceBegin and instanceEnd
+    const std::string loopBegin = (instanceRange? "instanceBegin" : "0");
+    const std::string loopEnd = (instanceRange? "instanceEnd" : std::to_string(nInstances));
+
+    // for the lookup tables, i.e. algebraics that can be computed from the membrane potential and constants only
+    std::set<int> membranePotentialAlgebraics;     // all algebraics that only depend on the membrane potential
+    std::vector<int> lookupTableAlgebraics;        // the algebraics that are interpolated in the lookup tables
+    std::stringstream lookupTableStatements;       // the statements that compute membranePotentialAlgebraics from the membrane potential
 
     // step through lines and create simd source file
     while(!source.eof())
@@ -383,7 +667,7 @@ createSimdSourceFile(std::string &simdSourceFilename)
         size_t posEnd = line.find("]", posStart);
         int algebraicSize = atoi(line.substr(posStart).c_str());
 
-        simdSource << line.substr(0, posStart) << algebraicSize * this->nInstances_ << line.substr(posEnd) << std::endl;
+        simdSource << line.substr(0, posStart) << algebraicSize * nInstances << line.substr(posEnd) << std::endl;
       }
       else if (line.find("initConsts") != std::string::npos)
       {
@@ -428,9 +712,13 @@ createSimdSourceFile(std::string &simdSourceFilename)
         auto t = std::time(nullptr);
         auto tm = *std::localtime(&t);
         simdSource << std::endl << "/* This function was created by opendihu at " << std::put_time(&tm, "%d/%m/%Y %H:%M:%S")
-          << ".\n * It is designed for " << this->nInstances_ << " instances of the CellML problem. */" << std::endl
-          << "void computeCellMLRightHandSide("
-          << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters)" << std::endl << "{" << std::endl;
+          << ".\n * It is designed for " << nInstances << " instances of the CellML problem"
+          << (singlePrecision? ", the values are stored in single precision" : "") << "."
+          << (instanceRange? "\n * Only the instances instanceBegin <= i < instanceEnd are computed." : "") << " */" << std::endl
+          << "void computeCellMLRightHandSide" << (singlePrecision? "SinglePrecision" : "") << "("
+          << "void *context, double t, " << realType << " *states, " << realType << " *rates, "
+          << realType << " *algebraics, " << realType << " *parameters"
+          << (instanceRange? ", int instanceBegin, int instanceEnd" : "") << ")" << std::endl << "{" << std::endl;
         discardOpenBrace = true;
 
         simdSource << "  double VOI = t;   /* current simulation time */" << std::endl;
@@ -443,8 +731,8 @@ createSimdSourceFile(std::string &simdSourceFilename)
             simdSource << "  " << constantAssignmentsLine << std::endl;
           }
           simdSource << std::endl
-            << "  double ALGEBRAIC[" << this->nIntermediates_*this->nInstances_ << "];  "
-            << "  /* " << this->nIntermediates_ << " per instance * " << this->nInstances_ << " instances */ " << std::endl;
+            << "  double ALGEBRAIC[" << this->nIntermediates_*nInstances << "];  "
+            << "  /* " << this->nIntermediates_ << " per instance * " << nInstances << " instances */ " << std::endl;
         }
       }
       // line contains OpenCMISS assignment
@@ -593,13 +881,20 @@ createSimdSourceFile(std::string &simdSourceFilename)
         }
         else
         {
-          // add pragma omp here
-          simdSource << std::endl << "  for (int i = 0; i < " << this->nInstances_ << "; i++)" << std::endl
-            << "  {" << std::endl << "    ";
-
           VLOG(2) << "parsed " << entries.size() << " entries";
 
-          // write out parsed code with adjusted indices
+          // the assigned variable, e.g. "rates" for OC_RATE[1], and the states and algebraics on which the assigned value depends
+          const entry_t &assignedEntry = entries.front();
+          std::set<int> stateDependencies;
+          std::set<int> algebraicDependencies;
+
+          // write out parsed code with adjusted indices, for a rate also with a placeholder for its own state
+          // and for an algebraic also with the membrane potential as variable for the lookup tables
+          std::stringstream statement;
+          std::stringstream statementWithPlaceholder;
+          std::stringstream statementLookupTable;
+          bool dependsOnlyOnMembranePotential = (assignedEntry.code == "algebraics");
+          bool isFirstEntry = true;
           for (auto entry : entries)
           {
             VLOG(2) << " entry type=" << entry.type << ", code: \"" << entry.code << "\", index: " << entry.arrayIndex;
@@ -609,20 +904,140 @@ createSimdSourceFile(std::string &simdSourceFilename)
                 if (entry.code == "CONSTANTS")
                 {
                   // constants only exist once for all instances
-                  simdSource << entry.code << "[" << entry.arrayIndex<< "]";
+                  statement << entry.code << "[" << entry.arrayIndex<< "]";
+                  statementWithPlaceholder << entry.code << "[" << entry.arrayIndex<< "]";
+                  statementLookupTable << entry.code << "[" << entry.arrayIndex<< "]";
                 }
                 else
                 {
                   // all other variables (states, rates, intermediates, parameters) exist for every instance
-                  simdSource << entry.code << "[" << entry.arrayIndex * this->nInstances_ << "+i]";
+                  statement << entry.code << "[" << entry.arrayIndex * nInstances << "+i]";
+
+                  // parameters can be different for every instance, they cannot be part of a lookup table
+                  if (entry.code == "states" && entry.arrayIndex == lookupTableStateNo_)
+                    statementLookupTable << "membranePotential";
+                  else if (entry.code == "algebraics" && (isFirstEntry || membranePotentialAlgebraics.find(entry.arrayIndex) != membranePotentialAlgebraics.end()))
+                    statementLookupTable << "ALGEBRAIC[" << entry.arrayIndex << "]";
+                  else
+                    dependsOnlyOnMembranePotential = false;
+
+                  if (!isFirstEntry && entry.code == "states" && assignedEntry.code == "rates" && entry.arrayIndex == assignedEntry.arrayIndex)
+                    statementWithPlaceholder << gatingStatePlaceholder;
+                  else
+                    statementWithPlaceholder << entry.code << "[" << entry.arrayIndex * nInstances << "+i]";
+
+                  if (!isFirstEntry && entry.code == "states")
+                    stateDependencies.insert(entry.arrayIndex);
+                  else if (!isFirstEntry && entry.code == "algebraics")
+                    algebraicDependencies.insert(entry.arrayIndex);
                 }
                 break;
               case entry_t::other:
-                simdSource << entry.code;
+                statement << entry.code;
+                statementWithPlaceholder << entry.code;
+                statementLookupTable << entry.code;
                 break;
             }
+            isFirstEntry = false;
+          }
+
+          // check if the algebraic only depends on the membrane potential, then it can be interpolated in a lookup table,
+          // this is only worth it if the expression contains function calls like exp or pow
+          bool isInterpolated = false;
+          if (useLookupTables_ && dependsOnlyOnMembranePotential)
+          {
+            std::string statementLookupTableString = statementLookupTable.str();
+            size_t posAssignment = statementLookupTableString.find("=");
+            size_t posEnd = statementLookupTableString.rfind(";");
+
+            if (posAssignment != std::string::npos && posEnd != std::string::npos && posEnd > posAssignment)
+            {
+              // the expression must not use the simulation time or local variables of the rhs routine
+              std::string expression = statementLookupTableString.substr(posAssignment+1, posEnd-posAssignment-1);
+              std::set<std::string> variableNames;
+              bool usesOnlyKnownVariables = CellmlExpressionAnalysis::getVariableNames(expression, variableNames);
+              for (const std::string &variableName : variableNames)
+              {
+                if (variableName != "membranePotential" && variableName != "ALGEBRAIC" && variableName != "CONSTANTS")
+                  usesOnlyKnownVariables = false;
+              }
+
+              if (usesOnlyKnownVariables)
+              {
+                membranePotentialAlgebraics.insert(assignedEntry.arrayIndex);
+                lookupTableStatements << "  " << statementLookupTableString << std::endl;
+
+                if (CellmlExpressionAnalysis::containsFunctionCall(expression))
+                {
+                  isInterpolated = true;
+                }
+              }
+            }
+          }
+
+          // add pragma omp here
+          simdSource << std::endl << "  for (int i = " << loopBegin << "; i < " << loopEnd << "; i++)" << std::endl
+            << "  {" << std::endl << "    ";
+
+          if (isInterpolated)
+          {
+            simdSource << "algebraics[" << assignedEntry.arrayIndex * nInstances << "+i] = interpolateLookupTable(lookupTables["
+              << lookupTableAlgebraics.size() << "], states[" << lookupTableStateNo_ * nInstances << "+i]);"
+              << std::endl << "    /* lookup table for " << line << " */";
+            lookupTableAlgebraics.push_back(assignedEntry.arrayIndex);
+          }
+          else
+          {
+            simdSource << statement.str();
           }
           simdSource << std::endl << "  }" << std::endl;
+
+          // collect the states on which the values depend, also indirectly through other algebraics
+          for (int algebraicNo : algebraicDependencies)
+          {
+            const std::set<int> &dependencies = algebraicStateDependencies[algebraicNo];
+            stateDependencies.insert(dependencies.begin(), dependencies.end());
+          }
+
+          if (assignedEntry.code == "algebraics")
+          {
+            algebraicStateDependencies[assignedEntry.arrayIndex] = stateDependencies;
+          }
+          else if (assignedEntry.code == "rates")
+          {
+            // a rate of a gating variable has the form a - b*y, where a and b do not depend on the state y,
+            // i.e. the expression is linear in the state and the algebraics in the expression do not depend on the state
+            const int stateNo = assignedEntry.arrayIndex;
+            bool algebraicsDependOnState = false;
+            for (int algebraicNo : algebraicDependencies)
+            {
+              if (algebraicStateDependencies[algebraicNo].find(stateNo) != algebraicStateDependencies[algebraicNo].end())
+                algebraicsDependOnState = true;
+            }
+
+            std::string statement = statementWithPlaceholder.str();
+            size_t posAssignment = statement.find("=");
+            size_t posEnd = statement.rfind(";");
+            if (!algebraicsDependOnState && posAssignment != std::string::npos && posEnd != std::string::npos && posEnd > posAssignment)
+            {
+              std::string expression = statement.substr(posAssignment+1, posEnd-posAssignment-1);
+
+              // the expression must not use local variables of the rhs routine, because it is also evaluated in the gating coefficients routine
+              std::set<std::string> variableNames;
+              bool usesOnlyKnownVariables = CellmlExpressionAnalysis::getVariableNames(expression, variableNames);
+              for (const std::string &variableName : variableNames)
+              {
+                if (variableName != gatingStatePlaceholder && variableName != "states" && variableName != "algebraics"
+                  && variableName != "parameters" && variableName != "CONSTANTS" && variableName != "VOI")
+                  usesOnlyKnownVariables = false;
+              }
+
+              if (usesOnlyKnownVariables && CellmlExpressionAnalysis::polynomialDegree(expression, gatingStatePlaceholder) == 1)
+              {
+                gatingRateExpressions[stateNo] = expression;
+              }
+            }
+          }
         }
       }
       // every other line
@@ -632,6 +1047,49 @@ createSimdSourceFile(std::string &simdSourceFilename)
       }
     }
 
+    // add a function that computes the coefficients b of the rates a - b*y of the gating variables, for exponential integrators
+    // the algebraics have to be computed by computeCellMLRightHandSide for the same states before,
+    // the single precision rhs routine is only used for batched explicit schemes, which do not need it
+    if (!singlePrecision)
+      gatingStateNos_.clear();
+
+    if (!gatingRateExpressions.empty() && !singlePrecision)
+    {
+      simdSource << std::endl << "/* This function was created by opendihu for the " << gatingRateExpressions.size() << " gating variables of the CellML problem.\n"
+        << " * For every state with a rate of the form a - b*y, it computes the coefficient b as rate(y=0) - rate(y=1). */" << std::endl
+        << "void computeCellMLGatingCoefficients("
+        << "void *context, double t, double *states, double *coefficients, double *algebraics, double *parameters)" << std::endl << "{" << std::endl
+        << "  double VOI = t;   /* current simulation time */" << std::endl;
+
+      // the constants are local variables of the rhs routine in OpenCOR and OpenCMISS files
+      if (!constantAssignments_.empty())
+      {
+        simdSource << std::endl << "  /* define constants */" << std::endl
+          << "  double CONSTANTS[" << this->nConstants_ << "];" << std::endl;
+        for (std::string constantAssignmentsLine : constantAssignments_)
+        {
+          simdSource << "  " << constantAssignmentsLine << std::endl;
+        }
+      }
+
+      for (std::pair<const int,std::string> &gatingRateExpression : gatingRateExpressions)
+      {
+        const int stateNo = gatingRateExpression.first;
+        std::string rateAtZero = StringUtility::replaceAll(gatingRateExpression.second, gatingStatePlaceholder, "(0.0)");
+        std::string rateAtOne = StringUtility::replaceAll(gatingRateExpression.second, gatingStatePlaceholder, "(1.0)");
+
+        simdSource << std::endl << "  for (int i = 0; i < " << nInstances << "; i++)" << std::endl
+          << "  {" << std::endl
+          << "    coefficients[" << stateNo * nInstances << "+i] = (" << rateAtZero << ") - (" << rateAtOne << ");" << std::endl
+          << "  }" << std::endl;
+
+        gatingStateNos_.push_back(stateNo);
+      }
+      simdSource << "}" << std::endl;
+
+      LOG(DEBUG) << "CellML model has " << gatingStateNos_.size() << " gating variables: " << gatingStateNos_;
+    }
+
     // write out source file
     std::stringstream s;
     s << "src/" << StringUtility::extractBasename(this->sourceFilename_) << "_simd.c";  // standard file name for SIMD source is subfolder "src" and "_simd.c" suffix
@@ -655,8 +1113,17 @@ createSimdSourceFile(std::string &simdSourceFilename)
     }
     else
     {
-      std::string fileContents = simdSource.str();
-      simdSourceFile << fileContents;
+      // the lookup tables have to be defined before the rhs routine
+      std::stringstream fileContents;
+      fileContents << "#include <math.h>" << std::endl;
+      if (!lookupTableAlgebraics.empty())
+      {
+        fileContents << createLookupTableSource(lookupTableAlgebraics, lookupTableStatements.str());
+      }
+      fileContents << simdSource.str();
+
+      generatedSourceHash_ = computeSourceHash(fileContents.str());
+      simdSourceFile << fileContents.str();
       simdSourceFile.close();
     }
   }
@@ -664,6 +1131,88 @@ createSimdSourceFile(std::string &simdSourceFilename)
   return true;
 }
 
+template<int nStates, typename FunctionSpaceType>
+std::string RhsRoutineHandler<nStates,FunctionSpaceType>::
+createLookupTableSource(const std::vector<int> &lookupTableAlgebraics, const std::string &lookupTableStatements)
+{
+  const int nLookupTables = lookupTableAlgebraics.size();
+
+  // the number of sampling points is chosen such that the distance between them is at most lookupTableResolution_
+  const int nSamples = int(std::ceil((lookupTableRange_[1] - lookupTableRange_[0]) / lookupTableResolution_ - 1e-10)) + 1;
+  const double sampleDistance = (lookupTableRange_[1] - lookupTableRange_[0]) / (nSamples - 1);
+
+  LOG(DEBUG) << "CellML model has " << nLookupTables << " lookup tables for the algebraics " << lookupTableAlgebraics << " with "
+    << nSamples << " samples of state " << lookupTableStateNo_ << " in " << lookupTableRange_;
+
+  std::stringstream source;
+  source << std::setprecision(17);
+
+  source << std::endl << "/* Lookup tables created by opendihu for " << nLookupTables << " algebraics that only depend on the membrane potential (state "
+    << lookupTableStateNo_ << ").\n"
+    << " * The tables have " << nSamples << " samples in [" << lookupTableRange_[0] << "," << lookupTableRange_[1] << "], "
+    << "values of the membrane potential outside of this range are clamped. */" << std::endl
+    << "static double lookupTables[" << nLookupTables << "][" << nSamples+1 << "];" << std::endl;
+
+  // linear interpolation, the last sample is duplicated such that the upper bound of the range needs no special treatment
+  source << std::endl << "/* linear interpolation in a lookup table */" << std::endl
+    << "static inline double interpolateLookupTable(const double *table, double membranePotential)" << std::endl << "{" << std::endl
+    << "  double position = (membranePotential - (" << lookupTableRange_[0] << ")) * " << 1.0/sampleDistance << ";" << std::endl
+    << "  position = fmin(fmax(position, 0.0), " << nSamples-1 << ".0);" << std::endl
+    << "  int index = (int)position;" << std::endl
+    << "  double weight = position - index;" << std::endl
+    << "  return table[index] + weight*(table[index+1] - table[index]);" << std::endl
+    << "}" << std::endl;
+
+  // evaluation of the tabulated algebraics for a single value of the membrane potential
+  source << std::endl << "/* compute the tabulated algebraics for the given membrane potential */" << std::endl
+    << "static void computeLookupTableValues(double membranePotential, double *values)" << std::endl << "{" << std::endl;
+
+  if (!constantAssignments_.empty())
+  {
+    source << "  double CONSTANTS[" << this->nConstants_ << "];" << std::endl;
+    for (std::string constantAssignmentsLine : constantAssignments_)
+    {
+      source << "  " << constantAssignmentsLine << std::endl;
+    }
+  }
+  source << "  double ALGEBRAIC[" << this->nIntermediates_ << "];" << std::endl
+    << lookupTableStatements;
+
+  for (int lookupTableNo = 0; lookupTableNo < nLookupTables; lookupTableNo++)
+  {
+    source << "  values[" << lookupTableNo << "] = ALGEBRAIC[" << lookupTableAlgebraics[lookupTableNo] << "];" << std::endl;
+  }
+  source << "}" << std::endl;
+
+  // initialization of the tables, expressions like x/(exp(x)-1) that are not defined at single points are replaced by the mean of the values next to these points,
+  // this routine is exported and called once after the library has been loaded, see initializeLookupTables
+  source << std::endl << "/* compute the values of the lookup tables, called by opendihu after the library has been loaded */" << std::endl
+    << "void initializeLookupTables()" << std::endl << "{" << std::endl
+    << "  double values[" << nLookupTables << "], valuesLeft[" << nLookupTables << "], valuesRight[" << nLookupTables << "];" << std::endl
+    << "  for (int sampleNo = 0; sampleNo < " << nSamples << "; sampleNo++)" << std::endl
+    << "  {" << std::endl
+    << "    double membranePotential = " << lookupTableRange_[0] << " + sampleNo * " << sampleDistance << ";" << std::endl
+    << "    computeLookupTableValues(membranePotential, values);" << std::endl
+    << "    for (int lookupTableNo = 0; lookupTableNo < " << nLookupTables << "; lookupTableNo++)" << std::endl
+    << "    {" << std::endl
+    << "      if (!isfinite(values[lookupTableNo]))" << std::endl
+    << "      {" << std::endl
+    << "        computeLookupTableValues(membranePotential - " << 1e-6*sampleDistance << ", valuesLeft);" << std::endl
+    << "        computeLookupTableValues(membranePotential + " << 1e-6*sampleDistance << ", valuesRight);" << std::endl
+    << "        values[lookupTableNo] = 0.5*(valuesLeft[lookupTableNo] + valuesRight[lookupTableNo]);" << std::endl
+    << "      }" << std::endl
+    << "      lookupTables[lookupTableNo][sampleNo] = values[lookupTableNo];" << std::endl
+    << "    }" << std::endl
+    << "  }" << std::endl
+    << "  for (int lookupTableNo = 0; lookupTableNo < " << nLookupTables << "; lookupTableNo++)" << std::endl
+    << "  {" << std::endl
+    << "    lookupTables[lookupTableNo][" << nSamples << "] = lookupTables[lookupTableNo][" << nSamples-1 << "];" << std::endl
+    << "  }" << std::endl
+    << "}" << std::endl;
+
+  return source.str();
+}
+
 
 // given a normal cellml source file for rhs routine, create a third file for gpu acceleration. @return: if successful
 template<int nStates, typename FunctionSpaceType>
@@ -995,6 +1544,7 @@ createGPUSourceFile(std::string &gpuSourceFilename)
     else
     {
       std::string fileContents = gpuSource.str();
+      generatedSourceHash_ = computeSourceHash(fileContents);
       gpuSourceFile << fileContents;
       gpuSourceFile.close();
     }
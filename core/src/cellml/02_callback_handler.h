@@ -8,6 +8,7 @@
 #include "function_space/function_space.h"
 #include "basis_function/lagrange.h"
 #include "cellml/01_rhs_routine_handler.h"
+#include "cellml/stimulation_schedule.h"
 
 /** The is a class that contains cellml equations and can be used with a time stepping scheme.
  *  The nStates template parameter specifies the number of state variables that should be used with the integrator.
@@ -20,6 +21,11 @@
  *   Constant - these are constants that are only present in the source files
  *   State: state variable
  *   Rate: the time derivative of the state variable, i.e. the increment value in an explicit Euler stepping
+ *
+ *  Stimulation patterns and piecewise constant parameters can be given by the settings "stimulationSchedule" and "parameterTables" (see CellmlStimulationSchedule),
+ *  they are evaluated natively without calling Python. The Python callback functions are only needed for other cases.
+ *  With the option "pythonCallbackBuffers", the setParameters and handleResult callbacks get memoryviews of the data instead of lists, which avoids copying.
+ *  With the option "skipWhenQuiescent", the instances are not computed while they rest at a steady state and the schedule does not stimulate them (see CellmlAdapter::isQuiescent).
  */
 template <int nStates, typename FunctionSpaceType>
 class CallbackHandler :
@@ -86,6 +92,13 @@ protected:
   PyObject *pyHandleResultFunctionAdditionalParameter_;   ///< an additional python object that will be passed as last argument to the handleResult callback function
 
   PyObject *pyGlobalNaturalDofsList_;    ///< python list of global dof nos
+
+  CellmlStimulationSchedule stimulationSchedule_;   ///< the stimulation and parameter schedule that is given in the settings and evaluated without Python
+  bool pythonCallbackBuffers_;            ///< if the data is passed to the setParameters and handleResult callbacks as memoryview instead of list, option "pythonCallbackBuffers"
+
+  bool skipWhenQuiescent_;                ///< if the instances may be skipped while they are at a steady state and not stimulated, option "skipWhenQuiescent"
+  double quiescentRateTolerance_;         ///< the maximum absolute rate of all states below which the instances are at a steady state, option "quiescentRateTolerance"
+  bool atSteadyState_;                    ///< if all rates of the last evaluation were below quiescentRateTolerance_
 };
 
 #include "cellml/02_callback_handler.tpp"
@@ -17,7 +17,8 @@ CallbackHandler(DihuContext context) :
   DiscretizableInTime(),
   setParameters_(NULL), setSpecificParameters_(NULL), setSpecificStates_(NULL), handleResult_(NULL),
   pythonSetParametersFunction_(NULL), pythonSetSpecificParametersFunction_(NULL), pythonSetSpecificStatesFunction_(NULL), pythonHandleResultFunction_(NULL),
-  pySetFunctionAdditionalParameter_(NULL), pyHandleResultFunctionAdditionalParameter_(NULL), pyGlobalNaturalDofsList_(NULL)
+  pySetFunctionAdditionalParameter_(NULL), pyHandleResultFunctionAdditionalParameter_(NULL), pyGlobalNaturalDofsList_(NULL),
+  pythonCallbackBuffers_(false), skipWhenQuiescent_(false), quiescentRateTolerance_(0.0), atSteadyState_(false)
 {
 }
 
@@ -96,6 +97,27 @@ initializeCallbackFunctions()
   {
     LOG(ERROR) << "Settings key \"setParametersFunctionAdditionalParameter\" has recently been changed to \"additionalArgument\".";
   }
+
+  // the stimulation and parameter schedule that is evaluated without calling Python
+  if (this->specificSettings_.hasKey("stimulationSchedule") || this->specificSettings_.hasKey("parameterTables"))
+  {
+    std::vector<global_no_t> dofNosGlobalNatural;
+    this->functionSpace_->meshPartitionBase()->getDofNosGlobalNatural(dofNosGlobalNatural);
+    stimulationSchedule_.initialize(this->specificSettings_, dofNosGlobalNatural, nStates, this->nParameters_);
+  }
+
+  pythonCallbackBuffers_ = this->specificSettings_.getOptionBool("pythonCallbackBuffers", false);
+
+  // the detection of instances at rest that do not need to be computed
+  skipWhenQuiescent_ = this->specificSettings_.getOptionBool("skipWhenQuiescent", false);
+  quiescentRateTolerance_ = this->specificSettings_.getOptionDouble("quiescentRateTolerance", 1e-5, PythonUtility::Positive);
+  atSteadyState_ = false;
+
+  if (skipWhenQuiescent_ && (setParameters_ || setSpecificParameters_ || setSpecificStates_ || handleResult_))
+  {
+    LOG(WARNING) << this->specificSettings_ << "[\"skipWhenQuiescent\"] has no effect, because the Python callback functions could change the instances at any time. "
+      << "Use \"stimulationSchedule\" and \"parameterTables\" instead.";
+  }
 }
 
 template<int nStates, typename FunctionSpaceType>
@@ -105,6 +127,9 @@ callPythonSetParametersFunction(int nInstances, int timeStepNo, double currentTi
   if (pythonSetParametersFunction_ == NULL)
     return;
 
+  // the lock of the python interpreter may have been released by the caller, e.g. for the rhs routine
+  PyGILState_STATE gilState = PyGILState_Ensure();
+
   // create list of global dof nos if it does not already exist
   if (pyGlobalNaturalDofsList_ == nullptr)
   {
@@ -113,8 +138,13 @@ callPythonSetParametersFunction(int nInstances, int timeStepNo, double currentTi
     pyGlobalNaturalDofsList_ = PythonUtility::convertToPythonList(dofNosGlobalNatural);
   }
 
-  // compose callback function
-  PyObject *parametersList = PythonUtility::convertToPythonList(parameters);
+  // compose callback function, the parameters are either passed as memoryview that is directly changed by the callback or as list
+  PyObject *parametersList = NULL;
+  if (pythonCallbackBuffers_)
+    parametersList = PythonUtility::convertToPythonBuffer(parameters.size(), parameters.data());
+  else
+    parametersList = PythonUtility::convertToPythonList(parameters);
+
   PyObject *arglist = Py_BuildValue("(i,i,d,O,O,O)", this->functionSpace_->meshPartitionBase()->nDofsGlobal(),
                                     timeStepNo, currentTime, parametersList, pyGlobalNaturalDofsList_, pySetFunctionAdditionalParameter_);
   PyObject *returnValue = PyObject_CallObject(pythonSetParametersFunction_, arglist);
@@ -123,17 +153,26 @@ callPythonSetParametersFunction(int nInstances, int timeStepNo, double currentTi
   if (returnValue == NULL)
     PyErr_Print();
 
-  // copy new values in parametersList to parameters_ vector
-  for (unsigned int i=0; i<parameters.size(); i++)
+  // copy new values in parametersList to parameters_ vector, the memoryview is released, such that it cannot be used by python after the callback
+  if (pythonCallbackBuffers_)
   {
-    PyObject *item = PyList_GetItem(parametersList, (Py_ssize_t)i);
-    parameters[i] = PythonUtility::convertFromPython<double>::get(item);
+    PythonUtility::releasePythonBuffer(parametersList);
+  }
+  else
+  {
+    for (unsigned int i=0; i<parameters.size(); i++)
+    {
+      PyObject *item = PyList_GetItem(parametersList, (Py_ssize_t)i);
+      parameters[i] = PythonUtility::convertFromPython<double>::get(item);
+    }
   }
 
   // decrement reference counters for python objects
   Py_CLEAR(parametersList);
   Py_CLEAR(returnValue);
   Py_CLEAR(arglist);
+
+  PyGILState_Release(gilState);
 }
 
 
@@ -144,6 +183,8 @@ callPythonSetSpecificParametersFunction(int nInstances, int timeStepNo, double c
   if (pythonSetSpecificParametersFunction_ == NULL)
     return;
 
+  PyGILState_STATE gilState = PyGILState_Ensure();
+
   VLOG(1) << "callPythonSetSpecificParametersFunction timeStepNo=" << timeStepNo;
 
   // compose callback function
@@ -195,6 +236,8 @@ callPythonSetSpecificParametersFunction(int nInstances, int timeStepNo, double c
   Py_CLEAR(globalParametersDict);
   Py_CLEAR(returnValue);
   Py_CLEAR(arglist);
+
+  PyGILState_Release(gilState);
 }
 
 template<int nStates, typename FunctionSpaceType>
@@ -204,6 +247,8 @@ callPythonSetSpecificStatesFunction(int nInstances, int timeStepNo, double curre
   if (pythonSetSpecificStatesFunction_ == NULL)
     return;
 
+  PyGILState_STATE gilState = PyGILState_Ensure();
+
   VLOG(1) << "callPythonSetSpecificStatesFunction timeStepNo=" << timeStepNo;
 
   // compose callback function
@@ -254,6 +299,8 @@ callPythonSetSpecificStatesFunction(int nInstances, int timeStepNo, double curre
   Py_CLEAR(globalStatesDict);
   Py_CLEAR(returnValue);
   Py_CLEAR(arglist);
+
+  PyGILState_Release(gilState);
 }
 
 template<int nStates, typename FunctionSpaceType>
@@ -264,10 +311,22 @@ callPythonHandleResultFunction(int nInstances, int timeStepNo, double currentTim
   if (pythonHandleResultFunction_ == NULL)
     return;
 
+  PyGILState_STATE gilState = PyGILState_Ensure();
+
   // compose callback function
   LOG(DEBUG) << "callPythonHandleResultFunction: nInstances: " << this->nInstances_<< ", nStates: " << nStates << ", nIntermediates: " << this->nIntermediates_;
-  PyObject *statesList = PythonUtility::convertToPythonList(nStates*this->nInstances_, localStates);
-  PyObject *intermediatesList = PythonUtility::convertToPythonList(this->nIntermediates_*this->nInstances_, intermediates);
+  PyObject *statesList = NULL;
+  PyObject *intermediatesList = NULL;
+  if (pythonCallbackBuffers_)
+  {
+    statesList = PythonUtility::convertToPythonBuffer(nStates*this->nInstances_, localStates);
+    intermediatesList = PythonUtility::convertToPythonBuffer(this->nIntermediates_*this->nInstances_, intermediates);
+  }
+  else
+  {
+    statesList = PythonUtility::convertToPythonList(nStates*this->nInstances_, localStates);
+    intermediatesList = PythonUtility::convertToPythonList(this->nIntermediates_*this->nInstances_, intermediates);
+  }
   PyObject *arglist = Py_BuildValue("(i,i,d,O,O,O)", nInstances, timeStepNo, currentTime, statesList, intermediatesList, pyHandleResultFunctionAdditionalParameter_);
   PyObject *returnValue = PyObject_CallObject(pythonHandleResultFunction_, arglist);
 
@@ -275,9 +334,18 @@ callPythonHandleResultFunction(int nInstances, int timeStepNo, double currentTim
   if (returnValue == NULL)
     PyErr_Print();
 
+  // release the memoryviews, such that they cannot be used by python after the callback
+  if (pythonCallbackBuffers_)
+  {
+    PythonUtility::releasePythonBuffer(statesList);
+    PythonUtility::releasePythonBuffer(intermediatesList);
+  }
+
   // decrement reference counters for python objects
   Py_CLEAR(statesList);
   Py_CLEAR(intermediatesList);
   Py_CLEAR(returnValue);
   Py_CLEAR(arglist);
+
+  PyGILState_Release(gilState);
 }
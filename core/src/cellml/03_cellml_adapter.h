@@ -48,9 +48,50 @@ public:
 
   //! evaluate rhs
   void evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepNo, double currentTime);
+
+  //! evaluate rhs and the coefficients b of the rates a - b*y of the gating variables, which are needed by exponential integrators (Rush-Larsen scheme).
+  //! gatingCoefficients has the same layout as the rates, only the entries of the states in gatingStateNos() are set
+  void evaluateTimesteppingRightHandSideAndGatingCoefficients(Vec& input, Vec& output, double *gatingCoefficients, int timeStepNo, double currentTime);
+
+  //! if the coefficients of the gating variables can be computed, i.e. the model has gating variables and the rhs was compiled by opendihu
+  bool hasGatingCoefficients();
   
   //! evaluate rhs
   //void evaluateTimesteppingRightHandSideImplicit(Vec& input, Vec& output, int timeStepNo, double currentTime);
+
+  //! increment the counter of right hand side evaluations, this has to be done once before every evaluation, the call intervals of the callbacks refer to this counter
+  void incrementInternalTimeStepNo();
+
+  //! set the parameters of the parameter schedule and call the setParameters and setSpecificParameters callback functions if they are due in the current evaluation.
+  //! @return if the parameters may have changed
+  bool applySetParametersCallbacks(double currentTime);
+
+  //! if states are set in the current evaluation, by the stimulation schedule or by the setSpecificStates callback function
+  bool setSpecificStatesCallbackDue(double currentTime);
+
+  //! set the states of the stimulation schedule and call the setSpecificStates callback function if it is due, states are the states of all instances of this object (struct-of-array order)
+  void applySetSpecificStatesCallback(double *states, double currentTime);
+
+  //! if the handleResult callback function is due in the current evaluation
+  bool handleResultCallbackDue();
+
+  //! call the handleResult callback function if it is due, states are the states of all instances of this object (struct-of-array order)
+  void applyHandleResultCallback(double *states, double currentTime);
+
+  //! if the option "skipWhenQuiescent" is set, i.e. the instances may be skipped by BatchedAdvance while isQuiescent is true
+  bool skipWhenQuiescent() const;
+
+  //! if the instances do not need to be computed in the interval [startTime,endTime]: they were at a steady state in the last evaluation (all rates below "quiescentRateTolerance"),
+  //! the stimulation schedule does not set any state or parameter in the interval and there are no Python callback functions. This is always false without the option "skipWhenQuiescent".
+  bool isQuiescent(double startTime, double endTime);
+
+  //! determine if the instances are at a steady state from the rates of the last evaluation, this is only done with the option "skipWhenQuiescent".
+  //! The rate of state stateNo of instance i is rates[stateNo*nInstancesRates + instanceOffset + i], i.e. the rates can be part of a batch of several objects (CellmlAdapterBatch)
+  template<typename RealType>
+  void checkSteadyState(const RealType *rates, int nInstancesRates, int instanceOffset);
+
+  //! if the right hand side of the other object is computed by the same code, with the same numbers of parameters and intermediates, such that they can be evaluated together
+  bool hasSameRhsRoutine(CellmlAdapter<nStates_,FunctionSpaceType> &other);
   
   //! return false because the object is independent of mesh type
   bool knowsMeshType();
@@ -4,6 +4,7 @@
 
 #include <list>
 #include <sstream>
+#include <cmath>
 
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
@@ -71,7 +72,21 @@ template<int nStates_, typename FunctionSpaceType>
 void CellmlAdapter<nStates_,FunctionSpaceType>::
 evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepNo, double currentTime)
 {
-  this->internalTimeStepNo_++;
+  evaluateTimesteppingRightHandSideAndGatingCoefficients(input, output, nullptr, timeStepNo, currentTime);
+}
+
+template<int nStates_, typename FunctionSpaceType>
+bool CellmlAdapter<nStates_,FunctionSpaceType>::
+hasGatingCoefficients()
+{
+  return this->gatingCoefficientsRoutine_ && !this->gatingStateNos_.empty();
+}
+
+template<int nStates_, typename FunctionSpaceType>
+void CellmlAdapter<nStates_,FunctionSpaceType>::
+evaluateTimesteppingRightHandSideAndGatingCoefficients(Vec& input, Vec& output, double *gatingCoefficients, int timeStepNo, double currentTime)
+{
+  incrementInternalTimeStepNo();
 
   //PetscUtility::getVectorEntries(input, states_);
   double *states, *rates;
@@ -92,6 +107,54 @@ evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepN
 
   //LOG(DEBUG) << " evaluateTimesteppingRightHandSide: nInstances=" << this->nInstances_ << ", nStates_=" << nStates_;
   
+  // get new values for parameters and states, call callback functions of python config
+  applySetParametersCallbacks(currentTime);
+  applySetSpecificStatesCallback(states, currentTime);
+
+  //              this          STATES, RATES, WANTED,                KNOWN
+  if (this->rhsRoutine_)
+  {
+    VLOG(1) << "call rhsRoutine_ with " << this->intermediates_.size() << " intermediates, " << this->parameters_.size() << " parameters";
+    VLOG(2) << "intermediates: " << this->intermediates_ << ", parameters: " << this->parameters_;
+
+    // the rhs routine does not use the python interpreter, other threads can use it meanwhile
+    PythonUtility::GlobalInterpreterLockRelease globalInterpreterLockRelease;
+
+    // call actual rhs routine from cellml code
+    this->rhsRoutine_((void *)this, currentTime, states, rates, this->intermediates_.data(), this->parameters_.data());
+
+    // compute the coefficients of the gating variables, this uses the intermediates that were just computed by the rhs routine
+    if (gatingCoefficients && hasGatingCoefficients())
+    {
+      this->gatingCoefficientsRoutine_((void *)this, currentTime, states, gatingCoefficients, this->intermediates_.data(), this->parameters_.data());
+    }
+  }
+
+  // handle intermediates, call callback function of python config
+  applyHandleResultCallback(states, currentTime);
+
+  checkSteadyState(rates, this->nInstances_, 0);
+
+  //PetscUtility::setVector(rates_, output);
+  // give control of data back to Petsc
+  ierr = VecRestoreArray(input, &states); CHKERRV(ierr);
+  ierr = VecRestoreArray(output, &rates); CHKERRV(ierr);
+}
+
+template<int nStates_, typename FunctionSpaceType>
+void CellmlAdapter<nStates_,FunctionSpaceType>::
+incrementInternalTimeStepNo()
+{
+  this->internalTimeStepNo_++;
+}
+
+template<int nStates_, typename FunctionSpaceType>
+bool CellmlAdapter<nStates_,FunctionSpaceType>::
+applySetParametersCallbacks(double currentTime)
+{
+  // set the parameters of the stimulation and parameter schedule, this does not need the python interpreter
+  bool parametersChanged = this->stimulationSchedule_.setParameters(currentTime, this->parameters_);
+
   // get new values for parameters, call callback function of python config
   if (this->setParameters_ && this->internalTimeStepNo_ % this->setParametersCallInterval_ == 0)
   {
@@ -100,6 +163,7 @@ evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepN
     
     VLOG(1) << "call setParameters";
     this->setParameters_((void *)this, this->nInstances_, this->internalTimeStepNo_, currentTime, this->parameters_);
+    parametersChanged = true;
   }
 
   // get new values for parameters, call callback function of python config
@@ -110,9 +174,27 @@ evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepN
 
     VLOG(1) << "call setSpecificParameters";
     this->setSpecificParameters_((void *)this, this->nInstances_, this->internalTimeStepNo_, currentTime, this->parameters_);
+    parametersChanged = true;
   }
+  return parametersChanged;
+}
 
-  // get new values for parameters, call callback function of python config
+template<int nStates_, typename FunctionSpaceType>
+bool CellmlAdapter<nStates_,FunctionSpaceType>::
+setSpecificStatesCallbackDue(double currentTime)
+{
+  return (this->setSpecificStates_ && this->internalTimeStepNo_ % this->setSpecificStatesCallInterval_ == 0)
+    || this->stimulationSchedule_.statesStimulated(currentTime);
+}
+
+template<int nStates_, typename FunctionSpaceType>
+void CellmlAdapter<nStates_,FunctionSpaceType>::
+applySetSpecificStatesCallback(double *states, double currentTime)
+{
+  // set the stimulated states of the stimulation schedule
+  this->stimulationSchedule_.setStates(currentTime, states);
+
+  // get new values for states, call callback function of python config
   if (this->setSpecificStates_ && this->internalTimeStepNo_ % this->setSpecificStatesCallInterval_ == 0)
   {
     // start critical section for python API calls
@@ -121,34 +203,82 @@ evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepN
     VLOG(1) << "call setSpecificStates, this->internalTimeStepNo_ = " << this->internalTimeStepNo_ << ", this->setSpecificStatesCallInterval_: " << this->setSpecificStatesCallInterval_;
     this->setSpecificStates_((void *)this, this->nInstances_, this->internalTimeStepNo_, currentTime, states);
   }
+}
 
-  //              this          STATES, RATES, WANTED,                KNOWN
-  if (this->rhsRoutine_)
-  {
-    VLOG(1) << "call rhsRoutine_ with " << this->intermediates_.size() << " intermediates, " << this->parameters_.size() << " parameters";
-    VLOG(2) << "intermediates: " << this->intermediates_ << ", parameters: " << this->parameters_;
-
-    // call actual rhs routine from cellml code
-    this->rhsRoutine_((void *)this, currentTime, states, rates, this->intermediates_.data(), this->parameters_.data());
-  }
+template<int nStates_, typename FunctionSpaceType>
+bool CellmlAdapter<nStates_,FunctionSpaceType>::
+handleResultCallbackDue()
+{
+  return this->handleResult_ && this->internalTimeStepNo_ % this->handleResultCallInterval_ == 0;
+}
 
+template<int nStates_, typename FunctionSpaceType>
+void CellmlAdapter<nStates_,FunctionSpaceType>::
+applyHandleResultCallback(double *states, double currentTime)
+{
   // handle intermediates, call callback function of python config
-  if (this->handleResult_ && this->internalTimeStepNo_ % this->handleResultCallInterval_ == 0)
+  if (handleResultCallbackDue())
   {
-    int nStatesInput;
-    VecGetSize(input, &nStatesInput);
-
     // start critical section for python API calls
     // PythonUtility::GlobalInterpreterLock lock;
     
-    VLOG(1) << "call handleResult with in total " << nStatesInput << " states, " << this->intermediates_.size() << " intermediates";
+    VLOG(1) << "call handleResult with in total " << nStates_*this->nInstances_ << " states, " << this->intermediates_.size() << " intermediates";
     this->handleResult_((void *)this, this->nInstances_, this->internalTimeStepNo_, currentTime, states, this->intermediates_.data());
   }
+}
 
-  //PetscUtility::setVector(rates_, output);
-  // give control of data back to Petsc
-  ierr = VecRestoreArray(input, &states); CHKERRV(ierr);
-  ierr = VecRestoreArray(output, &rates); CHKERRV(ierr);
+template<int nStates_, typename FunctionSpaceType>
+bool CellmlAdapter<nStates_,FunctionSpaceType>::
+skipWhenQuiescent() const
+{
+  return this->skipWhenQuiescent_;
+}
+
+template<int nStates_, typename FunctionSpaceType>
+bool CellmlAdapter<nStates_,FunctionSpaceType>::
+isQuiescent(double startTime, double endTime)
+{
+  if (!this->skipWhenQuiescent_ || !this->atSteadyState_)
+    return false;
+
+  // the Python callbacks could change states or parameters at any time
+  if (this->setParameters_ || this->setSpecificParameters_ || this->setSpecificStates_ || this->handleResult_)
+    return false;
+
+  return !this->stimulationSchedule_.hasEventsInInterval(startTime, endTime);
+}
+
+template<int nStates_, typename FunctionSpaceType>
+template<typename RealType>
+void CellmlAdapter<nStates_,FunctionSpaceType>::
+checkSteadyState(const RealType *rates, int nInstancesRates, int instanceOffset)
+{
+  if (!this->skipWhenQuiescent_)
+    return;
+
+  // the instances are at a steady state if the rates of all states are below the tolerance, the comparison is false for rates that are not a number
+  bool atSteadyState = true;
+  for (int stateNo = 0; stateNo < nStates_ && atSteadyState; stateNo++)
+  {
+    const RealType *stateRates = rates + stateNo*nInstancesRates + instanceOffset;
+    for (int instanceNo = 0; instanceNo < this->nInstances_; instanceNo++)
+    {
+      if (!(std::fabs(stateRates[instanceNo]) <= this->quiescentRateTolerance_))
+        atSteadyState = false;
+    }
+  }
+  this->atSteadyState_ = atSteadyState;
+}
+
+template<int nStates_, typename FunctionSpaceType>
+bool CellmlAdapter<nStates_,FunctionSpaceType>::
+hasSameRhsRoutine(CellmlAdapter<nStates_,FunctionSpaceType> &other)
+{
+  return this->sourceFilename_ == other.sourceFilename_
+    && this->nIntermediates_ == other.nIntermediates_ && this->nParameters_ == other.nParameters_
+    && this->parametersUsedAsIntermediate_ == other.parametersUsedAsIntermediate_
+    && this->parametersUsedAsConstant_ == other.parametersUsedAsConstant_
+    && this->useGivenLibrary_ == other.useGivenLibrary_;
 }
 
 /*
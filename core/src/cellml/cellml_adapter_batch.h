@@ -0,0 +1,136 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <vector>
+#include <array>
+
+#include "cellml/03_cellml_adapter.h"
+
+/** Evaluation of the right hand sides of several CellmlAdapter objects on the own rank with a single call to the rhs routine,
+ *  e.g. for all fibers of a rank, where every fiber has its own CellmlAdapter.
+ *
+ *  The states of all instances of all adapters are stored in one contiguous array in struct-of-array order, i.e.
+ *  [state0 of all instances of adapter 0, state0 of all instances of adapter 1, ..., state1 of all instances of adapter 0, ...].
+ *  The entry of instance instanceNo of adapter adapterNo for state stateNo is at stateNo*nInstances() + instanceOffset(adapterNo) + instanceNo.
+ *  The same layout is used for rates, parameters and intermediates. The rhs routine is generated and compiled for the total number of instances.
+ *
+ *  The callback functions (setParameters, setSpecificParameters, setSpecificStates, handleResult) of the individual adapters are still called
+ *  with the data of their own instances, the data is copied from and to the batch only when a callback is due.
+ *
+ *  If the option "useSinglePrecision" is set for the adapters, the rhs routine is generated for float arrays and states, rates, parameters
+ *  and intermediates of the batch are stored in single precision. Then evaluateRightHandSide has to be called with float arrays.
+ *  The rounding errors of the states that are accumulated in double precision are given by setRoundingErrors, gatherStates and scatterStates include them.
+ *  Therefore the rounding errors are also reset for the states that are set by the callbacks or the stimulation schedule.
+ *
+ *  In double precision, evaluateRightHandSide can also compute the coefficients of the gating variables for exponential integrators (Rush-Larsen scheme),
+ *  with the routine computeCellMLGatingCoefficients of the batched library.
+ *
+ *  Adapters can be deactivated by setActiveAdapters, e.g. while they are quiescent. Then only the contiguous ranges of instances of the active adapters
+ *  are computed and the values of the other instances in the batch are not changed.
+ */
+template<int nStates, typename FunctionSpaceType>
+class CellmlAdapterBatch
+{
+public:
+
+  typedef CellmlAdapter<nStates,FunctionSpaceType> CellmlAdapterType;
+
+  //! constructor
+  CellmlAdapterBatch(const std::vector<CellmlAdapterType *> &cellmlAdapters);
+
+  //! compile the rhs routine for all instances and collect the parameters of all adapters. @return if the adapters can be evaluated together,
+  //! i.e. there are at least two adapters, they use the same CellML code and the code can be generated for the total number of instances.
+  //! This is collective on MPI_COMM_WORLD, such that every library is compiled only once, it has to be called on all ranks, also with less than two adapters.
+  bool initialize();
+
+  //! the total number of instances of all adapters
+  int nInstances();
+
+  //! the index of the first instance of the adapter in the batch
+  int instanceOffset(int adapterNo);
+
+  //! if the values of the batch are stored in single precision, then the float variant of evaluateRightHandSide has to be used
+  bool singlePrecision();
+
+  //! if the coefficients of the gating variables can be computed by evaluateRightHandSide, i.e. the model has gating variables and the values are in double precision
+  bool hasGatingCoefficients();
+
+  //! the states that are gating variables, see RhsRoutineHandler::gatingStateNos
+  const std::vector<int> &gatingStateNos();
+
+  //! set which adapters are computed by evaluateRightHandSide and scatterIntermediates, initially all adapters are active
+  void setActiveAdapters(const std::vector<bool> &adapterIsActive);
+
+  //! if the adapter is computed by evaluateRightHandSide
+  bool adapterIsActive(int adapterNo);
+
+  //! the ranges [begin,end) of the instances of the active adapters in the batch
+  const std::vector<std::array<int,2>> &activeInstanceRanges();
+
+  //! set the rounding errors of the states that are accumulated in double precision, if singlePrecision() is true. roundingErrorsOffset[stateNo] is the index
+  //! of the rounding error of the first instance of state stateNo in roundingErrors or -1 if the state is only stored in single precision
+  void setRoundingErrors(double *roundingErrors, const std::vector<int> &roundingErrorsOffset);
+
+  //! copy the values of an adapter from its own struct-of-array layout (nStates values per instance) to the batch layout,
+  //! this stores the rounding errors of the states that are accumulated in double precision
+  template<typename RealType>
+  void gatherStates(int adapterNo, const double *adapterStates, RealType *batchStates);
+
+  //! copy the values of an adapter from the batch layout to its own struct-of-array layout (nStates values per instance),
+  //! this adds the rounding errors of the states that are accumulated in double precision
+  template<typename RealType>
+  void scatterStates(int adapterNo, const RealType *batchStates, double *adapterStates);
+
+  //! evaluate the right hand side of all instances of all active adapters, this corresponds to CellmlAdapter::evaluateTimesteppingRightHandSideExplicit for every adapter,
+  //! RealType is float if singlePrecision() is true and double otherwise. If gatingCoefficients is given and hasGatingCoefficients() is true,
+  //! also the coefficients b of the rates a - b*y of the gating variables are computed, in the same layout as the rates
+  template<typename RealType>
+  void evaluateRightHandSide(RealType *states, RealType *rates, double currentTime, double *gatingCoefficients = nullptr);
+
+  //! copy the intermediate values of the last evaluation to the active adapters
+  void scatterIntermediates();
+
+protected:
+
+  //! copy values with nValuesPerInstance values per instance from the struct-of-array layout of an adapter to the batch layout
+  template<typename AdapterValueType, typename BatchValueType>
+  void copyToBatch(int adapterNo, int nValuesPerInstance, const AdapterValueType *adapterValues, BatchValueType *batchValues);
+
+  //! copy values with nValuesPerInstance values per instance from the batch layout to the struct-of-array layout of an adapter
+  template<typename BatchValueType, typename AdapterValueType>
+  void copyFromBatch(int adapterNo, int nValuesPerInstance, const BatchValueType *batchValues, AdapterValueType *adapterValues);
+
+  //! copy the parameters of an adapter to the parameters of the batch in the precision of the batch
+  void copyParametersToBatch(int adapterNo);
+
+  //! copy the intermediates of the batch to the intermediates of an adapter
+  void copyIntermediatesFromBatch(int adapterNo);
+
+  //! call the rhs routine in double precision, and the routine for the coefficients of the gating variables if gatingCoefficients is given
+  void callRhsRoutine(double *states, double *rates, double currentTime, double *gatingCoefficients);
+
+  //! call the rhs routine in single precision, there are no coefficients of the gating variables in single precision
+  void callRhsRoutine(float *states, float *rates, double currentTime, double *gatingCoefficients);
+
+  std::vector<CellmlAdapterType *> cellmlAdapters_;      ///< the adapters whose instances are evaluated together
+  std::vector<int> instanceOffsets_;                     ///< the index of the first instance of every adapter in the batch, the last entry is the total number of instances
+  int nIntermediates_;                                   ///< number of intermediates per instance, the same for all adapters
+  int nParameters_;                                      ///< number of parameters per instance, the same for all adapters
+
+  bool singlePrecision_;                                 ///< if the values of the batch are stored in single precision
+  typename CellmlAdapterType::BatchedRhsRoutine rhsRoutine_;    ///< the rhs routine that is compiled for the total number of instances
+  typename CellmlAdapterType::BatchedRhsRoutineSinglePrecision rhsRoutineSinglePrecision_;   ///< the rhs routine in single precision, if singlePrecision_ is set
+  typename CellmlAdapterType::GatingCoefficientsRoutine gatingCoefficientsRoutine_;   ///< the routine for the coefficients of the gating variables of all instances, nullptr if there is none
+  std::vector<double> parameters_;                       ///< parameters of all instances in batch layout
+  std::vector<double> intermediates_;                    ///< intermediates of all instances in batch layout
+  std::vector<float> parametersSinglePrecision_;         ///< parameters of all instances in batch layout, if singlePrecision_ is set
+  std::vector<float> intermediatesSinglePrecision_;      ///< intermediates of all instances in batch layout, if singlePrecision_ is set
+  std::vector<double> adapterStates_;                    ///< buffer for the states of one adapter, used for the callbacks
+  double *roundingErrors_;                               ///< the rounding errors of the states in single precision that are accumulated in double precision, set by setRoundingErrors
+  std::vector<int> roundingErrorsOffset_;                ///< for every state the index of the rounding error of the first instance in roundingErrors_, -1 if there is none
+  std::vector<bool> adapterIsActive_;                    ///< for every adapter if it is computed
+  std::vector<std::array<int,2>> activeInstanceRanges_;  ///< the ranges [begin,end) of the instances of the active adapters, adjacent adapters are merged
+};
+
+#include "cellml/cellml_adapter_batch.tpp"
@@ -0,0 +1,358 @@
+#include "cellml/cellml_adapter_batch.h"
+
+#include <algorithm>
+#include <cassert>
+
+template<int nStates, typename FunctionSpaceType>
+CellmlAdapterBatch<nStates,FunctionSpaceType>::
+CellmlAdapterBatch(const std::vector<CellmlAdapterType *> &cellmlAdapters) :
+  cellmlAdapters_(cellmlAdapters), nIntermediates_(0), nParameters_(0), singlePrecision_(false), rhsRoutine_(nullptr), rhsRoutineSinglePrecision_(nullptr),
+  gatingCoefficientsRoutine_(nullptr), roundingErrors_(nullptr)
+{
+}
+
+template<int nStates, typename FunctionSpaceType>
+bool CellmlAdapterBatch<nStates,FunctionSpaceType>::
+initialize()
+{
+  // the compilation of the rhs routine is collective for all ranks, ranks that have no batch take part without compiling a library
+  if (cellmlAdapters_.size() <= 1)
+  {
+    CellmlAdapterType::compileLibraryCollectively("", "");
+    return false;
+  }
+
+  // all adapters have to compute the same rhs
+  for (CellmlAdapterType *cellmlAdapter : cellmlAdapters_)
+  {
+    if (!cellmlAdapters_[0]->hasSameRhsRoutine(*cellmlAdapter))
+    {
+      LOG(DEBUG) << "CellmlAdapterBatch: the CellmlAdapter objects use different CellML code, they cannot be evaluated together.";
+      CellmlAdapterType::compileLibraryCollectively("", "");
+      return false;
+    }
+  }
+
+  // determine the position of the instances of every adapter in the batch
+  instanceOffsets_.resize(cellmlAdapters_.size()+1);
+  instanceOffsets_[0] = 0;
+  for (int adapterNo = 0; adapterNo < cellmlAdapters_.size(); adapterNo++)
+  {
+    int nInstancesAdapter;
+    cellmlAdapters_[adapterNo]->getNumbers(nInstancesAdapter, nIntermediates_, nParameters_);
+    instanceOffsets_[adapterNo+1] = instanceOffsets_[adapterNo] + nInstancesAdapter;
+  }
+
+  LOG(DEBUG) << "CellmlAdapterBatch: create rhs routine for " << cellmlAdapters_.size() << " CellmlAdapter objects with in total " << nInstances() << " instances";
+
+  singlePrecision_ = cellmlAdapters_[0]->useSinglePrecision();
+  if (singlePrecision_)
+    rhsRoutineSinglePrecision_ = cellmlAdapters_[0]->createBatchedRhsRoutineSinglePrecision(nInstances());
+  else
+    rhsRoutine_ = cellmlAdapters_[0]->createBatchedRhsRoutine(nInstances(), &gatingCoefficientsRoutine_);
+
+  if (!rhsRoutine_ && !rhsRoutineSinglePrecision_)
+  {
+    LOG(WARNING) << "Could not create a rhs routine for " << nInstances() << " CellML instances, the " << cellmlAdapters_.size()
+      << " CellmlAdapter objects are evaluated separately.";
+    return false;
+  }
+
+  // collect the parameters of all adapters
+  if (singlePrecision_)
+  {
+    parametersSinglePrecision_.resize(nParameters_*nInstances());
+    intermediatesSinglePrecision_.resize(nIntermediates_*nInstances());
+  }
+  else
+  {
+    parameters_.resize(nParameters_*nInstances());
+    intermediates_.resize(nIntermediates_*nInstances());
+  }
+
+  for (int adapterNo = 0; adapterNo < cellmlAdapters_.size(); adapterNo++)
+  {
+    copyParametersToBatch(adapterNo);
+  }
+
+  setActiveAdapters(std::vector<bool>(cellmlAdapters_.size(), true));
+  return true;
+}
+
+template<int nStates, typename FunctionSpaceType>
+int CellmlAdapterBatch<nStates,FunctionSpaceType>::
+nInstances()
+{
+  return instanceOffsets_.back();
+}
+
+template<int nStates, typename FunctionSpaceType>
+int CellmlAdapterBatch<nStates,FunctionSpaceType>::
+instanceOffset(int adapterNo)
+{
+  return instanceOffsets_[adapterNo];
+}
+
+template<int nStates, typename FunctionSpaceType>
+bool CellmlAdapterBatch<nStates,FunctionSpaceType>::
+singlePrecision()
+{
+  return singlePrecision_;
+}
+
+template<int nStates, typename FunctionSpaceType>
+bool CellmlAdapterBatch<nStates,FunctionSpaceType>::
+hasGatingCoefficients()
+{
+  return gatingCoefficientsRoutine_ && !cellmlAdapters_[0]->gatingStateNos().empty();
+}
+
+template<int nStates, typename FunctionSpaceType>
+const std::vector<int> &CellmlAdapterBatch<nStates,FunctionSpaceType>::
+gatingStateNos()
+{
+  return cellmlAdapters_[0]->gatingStateNos();
+}
+
+template<int nStates, typename FunctionSpaceType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+setActiveAdapters(const std::vector<bool> &adapterIsActive)
+{
+  assert(adapterIsActive.size() == cellmlAdapters_.size());
+  adapterIsActive_ = adapterIsActive;
+
+  // collect the instances of the active adapters in contiguous ranges, such that the rhs routine is called as few times as possible
+  activeInstanceRanges_.clear();
+  for (int adapterNo = 0; adapterNo < cellmlAdapters_.size(); adapterNo++)
+  {
+    if (!adapterIsActive_[adapterNo])
+      continue;
+
+    if (!activeInstanceRanges_.empty() && activeInstanceRanges_.back()[1] == instanceOffsets_[adapterNo])
+      activeInstanceRanges_.back()[1] = instanceOffsets_[adapterNo+1];
+    else
+      activeInstanceRanges_.push_back(std::array<int,2>({instanceOffsets_[adapterNo], instanceOffsets_[adapterNo+1]}));
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+bool CellmlAdapterBatch<nStates,FunctionSpaceType>::
+adapterIsActive(int adapterNo)
+{
+  return adapterIsActive_[adapterNo];
+}
+
+template<int nStates, typename FunctionSpaceType>
+const std::vector<std::array<int,2>> &CellmlAdapterBatch<nStates,FunctionSpaceType>::
+activeInstanceRanges()
+{
+  return activeInstanceRanges_;
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename AdapterValueType, typename BatchValueType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+copyToBatch(int adapterNo, int nValuesPerInstance, const AdapterValueType *adapterValues, BatchValueType *batchValues)
+{
+  const int nInstancesAdapter = instanceOffsets_[adapterNo+1] - instanceOffsets_[adapterNo];
+  for (int valueNo = 0; valueNo < nValuesPerInstance; valueNo++)
+  {
+    std::copy(adapterValues + valueNo*nInstancesAdapter, adapterValues + (valueNo+1)*nInstancesAdapter,
+              batchValues + valueNo*nInstances() + instanceOffsets_[adapterNo]);
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename BatchValueType, typename AdapterValueType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+copyFromBatch(int adapterNo, int nValuesPerInstance, const BatchValueType *batchValues, AdapterValueType *adapterValues)
+{
+  const int nInstancesAdapter = instanceOffsets_[adapterNo+1] - instanceOffsets_[adapterNo];
+  for (int valueNo = 0; valueNo < nValuesPerInstance; valueNo++)
+  {
+    const BatchValueType *batchValuesBegin = batchValues + valueNo*nInstances() + instanceOffsets_[adapterNo];
+    std::copy(batchValuesBegin, batchValuesBegin + nInstancesAdapter, adapterValues + valueNo*nInstancesAdapter);
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+copyParametersToBatch(int adapterNo)
+{
+  if (singlePrecision_)
+    copyToBatch(adapterNo, nParameters_, cellmlAdapters_[adapterNo]->parameters().data(), parametersSinglePrecision_.data());
+  else
+    copyToBatch(adapterNo, nParameters_, cellmlAdapters_[adapterNo]->parameters().data(), parameters_.data());
+}
+
+template<int nStates, typename FunctionSpaceType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+copyIntermediatesFromBatch(int adapterNo)
+{
+  if (singlePrecision_)
+    copyFromBatch(adapterNo, nIntermediates_, intermediatesSinglePrecision_.data(), cellmlAdapters_[adapterNo]->intermediates().data());
+  else
+    copyFromBatch(adapterNo, nIntermediates_, intermediates_.data(), cellmlAdapters_[adapterNo]->intermediates().data());
+}
+
+template<int nStates, typename FunctionSpaceType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+callRhsRoutine(double *states, double *rates, double currentTime, double *gatingCoefficients)
+{
+  assert(rhsRoutine_);
+
+  // the rhs routine does not use the python interpreter, other threads can use it meanwhile
+  PythonUtility::GlobalInterpreterLockRelease globalInterpreterLockRelease;
+  for (const std::array<int,2> &instanceRange : activeInstanceRanges_)
+  {
+    rhsRoutine_((void *)cellmlAdapters_[0], currentTime, states, rates, intermediates_.data(), parameters_.data(), instanceRange[0], instanceRange[1]);
+  }
+
+  // the coefficients are computed for all instances, they use the intermediates that were just computed by the rhs routine,
+  // the values of inactive instances are not used
+  if (gatingCoefficients && hasGatingCoefficients())
+  {
+    gatingCoefficientsRoutine_((void *)cellmlAdapters_[0], currentTime, states, gatingCoefficients, intermediates_.data(), parameters_.data());
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+callRhsRoutine(float *states, float *rates, double currentTime, double *gatingCoefficients)
+{
+  assert(rhsRoutineSinglePrecision_);
+  assert(gatingCoefficients == nullptr);
+
+  // the rhs routine does not use the python interpreter, other threads can use it meanwhile
+  PythonUtility::GlobalInterpreterLockRelease globalInterpreterLockRelease;
+  for (const std::array<int,2> &instanceRange : activeInstanceRanges_)
+  {
+    rhsRoutineSinglePrecision_((void *)cellmlAdapters_[0], currentTime, states, rates, intermediatesSinglePrecision_.data(), parametersSinglePrecision_.data(),
+                               instanceRange[0], instanceRange[1]);
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+setRoundingErrors(double *roundingErrors, const std::vector<int> &roundingErrorsOffset)
+{
+  assert(roundingErrorsOffset.size() == nStates);
+  roundingErrors_ = roundingErrors;
+  roundingErrorsOffset_ = roundingErrorsOffset;
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+gatherStates(int adapterNo, const double *adapterStates, RealType *batchStates)
+{
+  copyToBatch(adapterNo, nStates, adapterStates, batchStates);
+
+  if (!singlePrecision_ || !roundingErrors_)
+    return;
+
+  // store the part of the values that is lost by rounding to single precision, this replaces the rounding errors of the previous values
+  const int nInstancesAdapter = instanceOffsets_[adapterNo+1] - instanceOffsets_[adapterNo];
+  for (int stateNo = 0; stateNo < nStates; stateNo++)
+  {
+    if (roundingErrorsOffset_[stateNo] == -1)
+      continue;
+
+    double *roundingErrors = roundingErrors_ + roundingErrorsOffset_[stateNo] + instanceOffsets_[adapterNo];
+    const RealType *batchValues = batchStates + stateNo*nInstances() + instanceOffsets_[adapterNo];
+    for (int i = 0; i < nInstancesAdapter; i++)
+    {
+      roundingErrors[i] = adapterStates[stateNo*nInstancesAdapter + i] - double(batchValues[i]);
+    }
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+scatterStates(int adapterNo, const RealType *batchStates, double *adapterStates)
+{
+  copyFromBatch(adapterNo, nStates, batchStates, adapterStates);
+
+  if (!singlePrecision_ || !roundingErrors_)
+    return;
+
+  // add the rounding errors to get the values of the states that are accumulated in double precision
+  const int nInstancesAdapter = instanceOffsets_[adapterNo+1] - instanceOffsets_[adapterNo];
+  for (int stateNo = 0; stateNo < nStates; stateNo++)
+  {
+    if (roundingErrorsOffset_[stateNo] == -1)
+      continue;
+
+    const double *roundingErrors = roundingErrors_ + roundingErrorsOffset_[stateNo] + instanceOffsets_[adapterNo];
+    for (int i = 0; i < nInstancesAdapter; i++)
+    {
+      adapterStates[stateNo*nInstancesAdapter + i] += roundingErrors[i];
+    }
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+evaluateRightHandSide(RealType *states, RealType *rates, double currentTime, double *gatingCoefficients)
+{
+  // call the callback functions that set parameters and states of the individual adapters, if they are due
+  for (int adapterNo = 0; adapterNo < cellmlAdapters_.size(); adapterNo++)
+  {
+    if (!adapterIsActive_[adapterNo])
+      continue;
+
+    CellmlAdapterType &cellmlAdapter = *cellmlAdapters_[adapterNo];
+    cellmlAdapter.incrementInternalTimeStepNo();
+
+    if (cellmlAdapter.applySetParametersCallbacks(currentTime))
+    {
+      copyParametersToBatch(adapterNo);
+    }
+
+    // the states are copied back including their rounding errors, such that states that are set to new values do not keep the rounding errors of the old values
+    if (cellmlAdapter.setSpecificStatesCallbackDue(currentTime))
+    {
+      adapterStates_.resize(nStates*(instanceOffsets_[adapterNo+1] - instanceOffsets_[adapterNo]));
+      scatterStates(adapterNo, states, adapterStates_.data());
+      cellmlAdapter.applySetSpecificStatesCallback(adapterStates_.data(), currentTime);
+      gatherStates(adapterNo, adapterStates_.data(), states);
+    }
+  }
+
+  // compute the rates of all active instances with one call per contiguous range
+  VLOG(1) << "call batched rhsRoutine_ with " << nInstances() << " instances in " << activeInstanceRanges_.size() << " range(s)";
+  callRhsRoutine(states, rates, currentTime, gatingCoefficients);
+
+  // call the handleResult callback functions of the individual adapters, if they are due
+  for (int adapterNo = 0; adapterNo < cellmlAdapters_.size(); adapterNo++)
+  {
+    if (!adapterIsActive_[adapterNo])
+      continue;
+
+    CellmlAdapterType &cellmlAdapter = *cellmlAdapters_[adapterNo];
+    cellmlAdapter.checkSteadyState(rates, nInstances(), instanceOffsets_[adapterNo]);
+
+    if (cellmlAdapter.handleResultCallbackDue())
+    {
+      adapterStates_.resize(nStates*(instanceOffsets_[adapterNo+1] - instanceOffsets_[adapterNo]));
+      scatterStates(adapterNo, states, adapterStates_.data());
+      copyIntermediatesFromBatch(adapterNo);
+
+      cellmlAdapter.applyHandleResultCallback(adapterStates_.data(), currentTime);
+      gatherStates(adapterNo, adapterStates_.data(), states);
+    }
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void CellmlAdapterBatch<nStates,FunctionSpaceType>::
+scatterIntermediates()
+{
+  for (int adapterNo = 0; adapterNo < cellmlAdapters_.size(); adapterNo++)
+  {
+    if (adapterIsActive_[adapterNo])
+      copyIntermediatesFromBatch(adapterNo);
+  }
+}
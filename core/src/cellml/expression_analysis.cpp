@@ -0,0 +1,251 @@
+#include "cellml/expression_analysis.h"
+
+#include <cctype>
+#include <algorithm>
+
+namespace CellmlExpressionAnalysis
+{
+
+namespace
+{
+
+//! recursive descent parser for arithmetic C expressions that computes the polynomial degree in one variable, a degree of -1 means not polynomial
+class DegreeParser
+{
+public:
+  //! constructor
+  DegreeParser(const std::string &expression, const std::string &variableName) :
+    expression_(expression), variableName_(variableName), position_(0), valid_(true), containsFunctionCall_(false)
+  {
+  }
+
+  //! parse the whole expression
+  int parse()
+  {
+    int degree = parseSum();
+    skipWhitespace();
+
+    // the expression has to be consumed completely, otherwise it contains unsupported syntax
+    if (position_ != expression_.length())
+      valid_ = false;
+
+    if (!valid_)
+      return -1;
+    return degree;
+  }
+
+  //! if the expression could be parsed, after parse was called
+  bool valid() const
+  {
+    return valid_;
+  }
+
+  //! the names of the variables and arrays in the expression, after parse was called
+  const std::set<std::string> &variableNames() const
+  {
+    return variableNames_;
+  }
+
+  //! if the expression contains a function call, after parse was called
+  bool containsFunctionCall() const
+  {
+    return containsFunctionCall_;
+  }
+
+private:
+
+  //! sum := product (('+'|'-') product)*
+  int parseSum()
+  {
+    int degree = parseProduct();
+    while (valid_)
+    {
+      skipWhitespace();
+      if (!accept('+') && !accept('-'))
+        break;
+
+      int degree2 = parseProduct();
+      degree = (degree == -1 || degree2 == -1)? -1 : std::max(degree, degree2);
+    }
+    return degree;
+  }
+
+  //! product := unary (('*'|'/') unary)*
+  int parseProduct()
+  {
+    int degree = parseUnary();
+    while (valid_)
+    {
+      skipWhitespace();
+      if (accept('*'))
+      {
+        int degree2 = parseUnary();
+        degree = (degree == -1 || degree2 == -1)? -1 : degree + degree2;
+      }
+      else if (accept('/'))
+      {
+        // the variable must not occur in a denominator
+        int degree2 = parseUnary();
+        if (degree2 != 0)
+          degree = -1;
+      }
+      else break;
+    }
+    return degree;
+  }
+
+  //! unary := ('+'|'-') unary | primary
+  int parseUnary()
+  {
+    skipWhitespace();
+    if (accept('+') || accept('-'))
+      return parseUnary();
+    return parsePrimary();
+  }
+
+  //! primary := number | identifier | identifier '[' ... ']' | identifier '(' sum (',' sum)* ')' | '(' sum ')'
+  int parsePrimary()
+  {
+    skipWhitespace();
+    if (position_ >= expression_.length())
+    {
+      valid_ = false;
+      return -1;
+    }
+
+    char c = expression_[position_];
+
+    // parenthesis
+    if (accept('('))
+    {
+      int degree = parseSum();
+      skipWhitespace();
+      if (!accept(')'))
+        valid_ = false;
+      return degree;
+    }
+
+    // number literal, e.g. 1.00000, 1e-3
+    if (std::isdigit(c) || c == '.')
+    {
+      while (position_ < expression_.length())
+      {
+        char d = expression_[position_];
+        if (std::isdigit(d) || d == '.')
+          position_++;
+        else if ((d == 'e' || d == 'E') && position_+1 < expression_.length())
+        {
+          position_++;
+          if (expression_[position_] == '+' || expression_[position_] == '-')
+            position_++;
+        }
+        else break;
+      }
+      return 0;
+    }
+
+    // identifier, array entry or function call
+    if (std::isalpha(c) || c == '_')
+    {
+      size_t start = position_;
+      while (position_ < expression_.length() && (std::isalnum(expression_[position_]) || expression_[position_] == '_'))
+        position_++;
+      std::string identifier = expression_.substr(start, position_-start);
+      std::string name = identifier;
+
+      skipWhitespace();
+
+      // array entry, the index is not analyzed
+      if (accept('['))
+      {
+        size_t end = expression_.find(']', position_);
+        if (end == std::string::npos)
+        {
+          valid_ = false;
+          return -1;
+        }
+        identifier += expression_.substr(start + identifier.length(), end+1 - (start + identifier.length()));
+        identifier.erase(std::remove_if(identifier.begin(), identifier.end(), ::isspace), identifier.end());
+        position_ = end+1;
+      }
+      // function call, the variable must not occur in an argument
+      else if (accept('('))
+      {
+        containsFunctionCall_ = true;
+        int degree = 0;
+        skipWhitespace();
+        if (!accept(')'))
+        {
+          do
+          {
+            if (parseSum() != 0)
+              degree = -1;
+            skipWhitespace();
+          }
+          while (valid_ && accept(','));
+
+          if (!accept(')'))
+            valid_ = false;
+        }
+        return degree;
+      }
+
+      variableNames_.insert(name);
+      return (identifier == variableName_)? 1 : 0;
+    }
+
+    // any other character, e.g. of a conditional or comparison operator, is not supported
+    valid_ = false;
+    return -1;
+  }
+
+  //! advance the position over whitespace
+  void skipWhitespace()
+  {
+    while (position_ < expression_.length() && std::isspace(expression_[position_]))
+      position_++;
+  }
+
+  //! if the current character is c, advance the position, @return if the character was found
+  bool accept(char c)
+  {
+    if (position_ < expression_.length() && expression_[position_] == c)
+    {
+      position_++;
+      return true;
+    }
+    return false;
+  }
+
+  const std::string &expression_;    ///< the expression to parse
+  const std::string &variableName_;  ///< the name of the variable
+  size_t position_;                  ///< the current position in expression_
+  bool valid_;                       ///< if the expression could be parsed so far
+  std::set<std::string> variableNames_;   ///< the names of the variables and arrays that occur in the expression
+  bool containsFunctionCall_;        ///< if a function is called in the expression
+};
+
+}  // anonymous namespace
+
+int polynomialDegree(const std::string &expression, const std::string &variableName)
+{
+  DegreeParser parser(expression, variableName);
+  return parser.parse();
+}
+
+bool getVariableNames(const std::string &expression, std::set<std::string> &variableNames)
+{
+  DegreeParser parser(expression, "");
+  parser.parse();
+  variableNames = parser.variableNames();
+  return parser.valid();
+}
+
+bool containsFunctionCall(const std::string &expression)
+{
+  DegreeParser parser(expression, "");
+  parser.parse();
+  return parser.containsFunctionCall();
+}
+
+}  // namespace
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <string>
+#include <set>
+
+/** Analysis of the C expressions of the CellML source code, e.g. to find the gating variables of a model.
+ */
+namespace CellmlExpressionAnalysis
+{
+
+//! get the polynomial degree of the C expression in the variable with the given name,
+//! e.g. 1 for "a*(1.0 - y) - b*y" with variableName "y", where a and b can be any other variables, array entries or function calls.
+//! @return the degree or -1 if the expression is not a polynomial in the variable or cannot be parsed,
+//! e.g. if the variable occurs in an argument of a function, in a denominator or in a conditional expression
+int polynomialDegree(const std::string &expression, const std::string &variableName);
+
+//! get the names of all variables and arrays that are used in the C expression, without function names and array indices, e.g. "states" and "VOI" for "exp(states[3*10+i]*VOI)".
+//! @return if the expression could be parsed
+bool getVariableNames(const std::string &expression, std::set<std::string> &variableNames);
+
+//! check if a function like exp or pow is called in the C expression, if the expression cannot be parsed only the part before the unsupported syntax is considered
+bool containsFunctionCall(const std::string &expression);
+
+}  // namespace
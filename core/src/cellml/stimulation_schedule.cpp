@@ -0,0 +1,233 @@
+#include "cellml/stimulation_schedule.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "easylogging++.h"
+
+CellmlStimulationSchedule::CellmlStimulationSchedule() :
+  nInstances_(0)
+{
+}
+
+void CellmlStimulationSchedule::initialize(const PythonConfig &specificSettings, const std::vector<global_no_t> &dofNosGlobalNatural, int nStates, int nParameters)
+{
+  nInstances_ = dofNosGlobalNatural.size();
+  stimulations_.clear();
+  parameterTables_.clear();
+
+  // parse the stimulations
+  std::vector<PythonConfig> stimulationSettings;
+  specificSettings.getOptionVector("stimulationSchedule", stimulationSettings);
+
+  for (PythonConfig &settings : stimulationSettings)
+  {
+    Stimulation stimulation;
+    settings.getOptionVector("firingTimes", stimulation.firingTimes);
+    std::sort(stimulation.firingTimes.begin(), stimulation.firingTimes.end());
+    stimulation.duration = settings.getOptionDouble("stimulationDuration", 0.1, PythonUtility::Positive);
+
+    std::vector<int> dofNos;
+    if (settings.hasKey("dofNos"))
+      settings.getOptionVector("dofNos", dofNos);
+    getInstanceNos(dofNosGlobalNatural, dofNos, stimulation.instanceNos);
+
+    stimulation.isState = settings.hasKey("stateNo");
+    if (stimulation.isState)
+    {
+      stimulation.componentNo = settings.getOptionInt("stateNo", 0, PythonUtility::NonNegative);
+      if (stimulation.componentNo >= nStates)
+      {
+        LOG(ERROR) << settings << "[\"stateNo\"] = " << stimulation.componentNo << " is invalid, there are only " << nStates << " states.";
+        continue;
+      }
+    }
+    else
+    {
+      stimulation.componentNo = settings.getOptionInt("parameterNo", 0, PythonUtility::NonNegative);
+      if (stimulation.componentNo >= nParameters)
+      {
+        LOG(ERROR) << settings << "[\"parameterNo\"] = " << stimulation.componentNo << " is invalid, there are only " << nParameters << " parameters.";
+        continue;
+      }
+    }
+    stimulation.value = settings.getOptionDouble("value", 0.0);
+    stimulation.restValue = settings.getOptionDouble("restValue", 0.0);
+    stimulation.lastStatus = -1;
+
+    LOG(DEBUG) << "stimulation of " << (stimulation.isState? "state " : "parameter ") << stimulation.componentNo << " at "
+      << stimulation.instanceNos.size() << " local instances, " << stimulation.firingTimes.size() << " firing times";
+
+    stimulations_.push_back(stimulation);
+  }
+
+  // parse the parameter tables
+  std::vector<PythonConfig> parameterTableSettings;
+  specificSettings.getOptionVector("parameterTables", parameterTableSettings);
+
+  for (PythonConfig &settings : parameterTableSettings)
+  {
+    ParameterTable parameterTable;
+    parameterTable.parameterNo = settings.getOptionInt("parameterNo", 0, PythonUtility::NonNegative);
+    settings.getOptionVector("times", parameterTable.times);
+    settings.getOptionVector("values", parameterTable.values);
+
+    if (parameterTable.parameterNo >= nParameters)
+    {
+      LOG(ERROR) << settings << "[\"parameterNo\"] = " << parameterTable.parameterNo << " is invalid, there are only " << nParameters << " parameters.";
+      continue;
+    }
+    if (parameterTable.times.size() != parameterTable.values.size() || !std::is_sorted(parameterTable.times.begin(), parameterTable.times.end()))
+    {
+      LOG(ERROR) << settings << ": \"times\" and \"values\" have to have the same number of entries and \"times\" has to be sorted.";
+      continue;
+    }
+
+    std::vector<int> dofNos;
+    if (settings.hasKey("dofNos"))
+      settings.getOptionVector("dofNos", dofNos);
+    getInstanceNos(dofNosGlobalNatural, dofNos, parameterTable.instanceNos);
+    parameterTable.lastIntervalNo = -1;
+
+    parameterTables_.push_back(parameterTable);
+  }
+}
+
+void CellmlStimulationSchedule::getInstanceNos(const std::vector<global_no_t> &dofNosGlobalNatural, const std::vector<int> &dofNos, std::vector<int> &instanceNos) const
+{
+  instanceNos.clear();
+
+  // no dofs given means all dofs
+  if (dofNos.empty())
+  {
+    instanceNos.resize(nInstances_);
+    for (int instanceNo = 0; instanceNo < nInstances_; instanceNo++)
+      instanceNos[instanceNo] = instanceNo;
+    return;
+  }
+
+  std::unordered_map<global_no_t,int> instanceNoOfDofNo;
+  for (int instanceNo = 0; instanceNo < nInstances_; instanceNo++)
+  {
+    instanceNoOfDofNo[dofNosGlobalNatural[instanceNo]] = instanceNo;
+  }
+
+  // only keep the dofs that are on the own rank
+  for (int dofNo : dofNos)
+  {
+    if (instanceNoOfDofNo.find(dofNo) != instanceNoOfDofNo.end())
+      instanceNos.push_back(instanceNoOfDofNo[dofNo]);
+  }
+}
+
+bool CellmlStimulationSchedule::isActive() const
+{
+  return !stimulations_.empty() || !parameterTables_.empty();
+}
+
+bool CellmlStimulationSchedule::isStimulated(const Stimulation &stimulation, double currentTime)
+{
+  // find the last firing time that is not after currentTime
+  std::vector<double>::const_iterator iter = std::upper_bound(stimulation.firingTimes.begin(), stimulation.firingTimes.end(), currentTime);
+  if (iter == stimulation.firingTimes.begin())
+    return false;
+
+  return currentTime < *(iter-1) + stimulation.duration;
+}
+
+bool CellmlStimulationSchedule::setParameters(double currentTime, std::vector<double> &parameters)
+{
+  bool parametersChanged = false;
+
+  // the parameters are only written if their value changes
+  for (Stimulation &stimulation : stimulations_)
+  {
+    if (stimulation.isState || stimulation.instanceNos.empty())
+      continue;
+
+    int status = (isStimulated(stimulation, currentTime)? 1 : 0);
+    if (status == stimulation.lastStatus)
+      continue;
+
+    const double value = (status == 1? stimulation.value : stimulation.restValue);
+    for (int instanceNo : stimulation.instanceNos)
+    {
+      parameters[stimulation.componentNo*nInstances_ + instanceNo] = value;
+    }
+    stimulation.lastStatus = status;
+    parametersChanged = true;
+  }
+
+  for (ParameterTable &parameterTable : parameterTables_)
+  {
+    if (parameterTable.instanceNos.empty())
+      continue;
+
+    int intervalNo = std::upper_bound(parameterTable.times.begin(), parameterTable.times.end(), currentTime) - parameterTable.times.begin() - 1;
+    if (intervalNo < 0 || intervalNo == parameterTable.lastIntervalNo)
+      continue;
+
+    for (int instanceNo : parameterTable.instanceNos)
+    {
+      parameters[parameterTable.parameterNo*nInstances_ + instanceNo] = parameterTable.values[intervalNo];
+    }
+    parameterTable.lastIntervalNo = intervalNo;
+    parametersChanged = true;
+  }
+
+  return parametersChanged;
+}
+
+bool CellmlStimulationSchedule::statesStimulated(double currentTime) const
+{
+  for (const Stimulation &stimulation : stimulations_)
+  {
+    if (stimulation.isState && !stimulation.instanceNos.empty() && isStimulated(stimulation, currentTime))
+      return true;
+  }
+  return false;
+}
+
+void CellmlStimulationSchedule::setStates(double currentTime, double *states) const
+{
+  for (const Stimulation &stimulation : stimulations_)
+  {
+    if (!stimulation.isState || !isStimulated(stimulation, currentTime))
+      continue;
+
+    for (int instanceNo : stimulation.instanceNos)
+    {
+      states[stimulation.componentNo*nInstances_ + instanceNo] = stimulation.value;
+    }
+  }
+}
+
+bool CellmlStimulationSchedule::hasEventsInInterval(double startTime, double endTime) const
+{
+  for (const Stimulation &stimulation : stimulations_)
+  {
+    if (stimulation.instanceNos.empty())
+      continue;
+
+    // a parameter that has not been set yet or is still set to the stimulation value has to be updated
+    if (!stimulation.isState && stimulation.lastStatus != 0)
+      return true;
+
+    // find the first stimulation that ends after startTime, it is an event if it starts before endTime
+    std::vector<double>::const_iterator iter = std::upper_bound(stimulation.firingTimes.begin(), stimulation.firingTimes.end(), startTime - stimulation.duration);
+    if (iter != stimulation.firingTimes.end() && *iter <= endTime)
+      return true;
+  }
+
+  for (const ParameterTable &parameterTable : parameterTables_)
+  {
+    if (parameterTable.instanceNos.empty())
+      continue;
+
+    // the parameter changes if the interval at endTime has not been set yet
+    int intervalNo = std::upper_bound(parameterTable.times.begin(), parameterTable.times.end(), endTime) - parameterTable.times.begin() - 1;
+    if (intervalNo >= 0 && intervalNo != parameterTable.lastIntervalNo)
+      return true;
+  }
+  return false;
+}
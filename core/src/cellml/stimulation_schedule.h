@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <vector>
+
+#include "control/types.h"
+#include "control/python_config.h"
+
+/** A stimulation and parameter schedule of the CellML instances that is given declaratively in the settings and evaluated natively,
+ *  without calling the Python interpreter. This replaces the setSpecificStatesFunction, setSpecificParametersFunction and
+ *  setParametersFunction callbacks for the usual stimulation patterns. The Python callbacks can still be used in addition for other cases.
+ *
+ *  Settings in the CellML scope:
+ *    "stimulationSchedule": list of dicts, every dict describes the stimulation of a spatial region:
+ *      "firingTimes":         list of times at which the stimulation starts, e.g. the firing times of the motor unit of the fiber
+ *      "stimulationDuration": duration of every stimulation, default 0.1
+ *      "dofNos":              global natural dof nos of the stimulated region, default: all dofs
+ *      "stateNo" or "parameterNo": the state or parameter that is set
+ *      "value":               the value during stimulation
+ *      "restValue":           only for parameters, the value outside of the stimulation, default 0.0
+ *    "parameterTables": list of dicts, every dict describes a piecewise constant parameter:
+ *      "parameterNo":         the parameter that is set
+ *      "times", "values":     the parameter is set to values[i] in the interval [times[i], times[i+1]) and stays at the last value, before times[0] it is not changed
+ *      "dofNos":              global natural dof nos where the parameter is set, default: all dofs
+ *
+ *  The states and parameters are in struct-of-array order, the entry of instance instanceNo for state stateNo is states[stateNo*nInstances + instanceNo].
+ */
+class CellmlStimulationSchedule
+{
+public:
+
+  //! constructor
+  CellmlStimulationSchedule();
+
+  //! parse the settings, dofNosGlobalNatural contains the global natural dof no for every local instance
+  void initialize(const PythonConfig &specificSettings, const std::vector<global_no_t> &dofNosGlobalNatural, int nStates, int nParameters);
+
+  //! if any schedule was specified
+  bool isActive() const;
+
+  //! set the parameters that are prescribed at currentTime, @return if a parameter value was changed
+  bool setParameters(double currentTime, std::vector<double> &parameters);
+
+  //! if a stimulation of a state is active at currentTime
+  bool statesStimulated(double currentTime) const;
+
+  //! set the states that are stimulated at currentTime
+  void setStates(double currentTime, double *states) const;
+
+  //! if the schedule sets or changes any state or parameter in the interval [startTime,endTime], otherwise the instances are not influenced by the schedule in this interval
+  bool hasEventsInInterval(double startTime, double endTime) const;
+
+protected:
+
+  //! a stimulation of a region given by a list of firing times
+  struct Stimulation
+  {
+    std::vector<double> firingTimes;      ///< sorted times at which a stimulation starts
+    double duration;                      ///< duration of every stimulation
+    std::vector<int> instanceNos;         ///< the local instances of the stimulated region
+    bool isState;                         ///< if a state is set, otherwise a parameter
+    int componentNo;                      ///< the state or parameter no
+    double value;                         ///< value during stimulation
+    double restValue;                     ///< value of the parameter outside of the stimulation
+    int lastStatus;                       ///< -1 if the parameter has not been set yet, 0 if restValue and 1 if value is set
+  };
+
+  //! a piecewise constant parameter
+  struct ParameterTable
+  {
+    std::vector<double> times;            ///< the start times of the intervals
+    std::vector<double> values;           ///< the parameter value for every interval
+    std::vector<int> instanceNos;         ///< the local instances where the parameter is set
+    int parameterNo;                      ///< the parameter no
+    int lastIntervalNo;                   ///< the interval of the last set value, -1 if no value has been set yet
+  };
+
+  //! if the stimulation is active at currentTime
+  static bool isStimulated(const Stimulation &stimulation, double currentTime);
+
+  //! get the local instances of the given global natural dof nos, or all instances if the list is empty
+  void getInstanceNos(const std::vector<global_no_t> &dofNosGlobalNatural, const std::vector<int> &dofNos, std::vector<int> &instanceNos) const;
+
+  std::vector<Stimulation> stimulations_;         ///< the stimulations from the setting "stimulationSchedule"
+  std::vector<ParameterTable> parameterTables_;   ///< the parameter tables from the setting "parameterTables"
+  int nInstances_;                                ///< number of local instances
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+namespace Control
+{
+
+/** Advance multiple instances of a time stepping scheme together, e.g. all fibers of a rank in Control::MultipleInstances.
+ *  In general, the instances are advanced one after the other. For certain schemes, partial specializations of this class advance all instances in lockstep
+ *  and combine the work of the instances, e.g. evaluate the CellML right hand sides of all instances in a single call.
+ *  The partial specializations for nested schemes (MultipleInstances, Strang) collect the terms of all instances and use BatchedAdvance for them again.
+ *
+ *  The instances have to be initialized before initialize is called, it has to be called on all ranks, also on ranks without instances. Every instance has to be given its time span by setTimeSpan before advanceTimeSpan is called.
+ *  advanceTimeSpan can also be called in two phases, startAdvanceTimeSpan and finishAdvanceTimeSpan. Schemes with non-blocking communication leave
+ *  the communication of the last step in progress between the two calls, all other schemes do the whole work in startAdvanceTimeSpan.
+ *
+ *  Instances that are quiescent, i.e. at rest and not stimulated (see CellmlAdapter::isQuiescent), can be skipped: getQuiescentInstances detects them
+ *  and setActiveInstances excludes them from the following calls to advanceTimeSpan. This is done by the specialization for Strang splittings in every time step.
+ */
+template<typename TimeSteppingType>
+class BatchedAdvance
+{
+public:
+
+  //! store the instances that will be advanced together, instanceNosGlobal are the numbers of the instances in [0,nInstancesGlobal) in ascending order,
+  //! these are the same on all ranks that share an instance, e.g. the fiber numbers
+  void initialize(const std::vector<TimeSteppingType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal);
+
+  //! advance all instances by their time spans, this corresponds to calling advanceTimeSpan of every instance
+  void advanceTimeSpan();
+
+  //! first phase of advanceTimeSpan, after this the communication of the last step may still be in progress, e.g. to overlap it with the work of other instances
+  void startAdvanceTimeSpan();
+
+  //! second phase of advanceTimeSpan, wait for the communication that was started by startAdvanceTimeSpan and finish the time span
+  void finishAdvanceTimeSpan();
+
+  //! determine for every instance if it is quiescent in the time interval [startTime,endTime] and does not need to be advanced, this is collective for instances on several ranks.
+  //! @return if quiescent instances can be detected for this scheme at all, this only depends on the settings. Here, no instance is quiescent.
+  bool getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent);
+
+  //! set which instances are advanced by the next calls to advanceTimeSpan, the others are skipped. Initially all instances are active.
+  void setActiveInstances(const std::vector<bool> &instanceIsActive);
+
+protected:
+
+  std::vector<TimeSteppingType *> instances_;   ///< the instances that are advanced together
+  std::vector<bool> instanceIsActive_;          ///< for every instance if it is advanced
+};
+
+//! check if all instances have the same time span and number of time steps, only then they can be advanced in lockstep
+template<typename TimeSteppingType>
+bool haveEqualTimeSpans(const std::vector<TimeSteppingType *> &instances);
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance.tpp"
+
+// the partial specialization for MultipleInstances, the specializations for other schemes are included at the end of the headers of these schemes
+#include "control/batched_advance/batched_advance_multiple_instances.h"
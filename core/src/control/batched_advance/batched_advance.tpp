@@ -0,0 +1,68 @@
+#include "control/batched_advance/batched_advance.h"
+
+namespace Control
+{
+
+template<typename TimeSteppingType>
+void BatchedAdvance<TimeSteppingType>::
+initialize(const std::vector<TimeSteppingType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal)
+{
+  instances_ = instances;
+  instanceIsActive_.assign(instances_.size(), true);
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<TimeSteppingType>::
+advanceTimeSpan()
+{
+  // there is no combined implementation for this scheme, advance the instances one after the other
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    if (instanceIsActive_[instanceNo])
+      instances_[instanceNo]->advanceTimeSpan();
+  }
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<TimeSteppingType>::
+startAdvanceTimeSpan()
+{
+  advanceTimeSpan();
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<TimeSteppingType>::
+finishAdvanceTimeSpan()
+{
+}
+
+template<typename TimeSteppingType>
+bool BatchedAdvance<TimeSteppingType>::
+getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent)
+{
+  quiescent.assign(instances_.size(), false);
+  return false;
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<TimeSteppingType>::
+setActiveInstances(const std::vector<bool> &instanceIsActive)
+{
+  instanceIsActive_ = instanceIsActive;
+}
+
+template<typename TimeSteppingType>
+bool haveEqualTimeSpans(const std::vector<TimeSteppingType *> &instances)
+{
+  for (TimeSteppingType *instance : instances)
+  {
+    if (instance->startTime() != instances[0]->startTime() || instance->endTime() != instances[0]->endTime()
+      || instance->numberTimeSteps() != instances[0]->numberTimeSteps())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
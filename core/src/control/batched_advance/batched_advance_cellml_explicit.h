@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+#include <memory>
+
+#include "control/batched_advance/batched_advance.h"
+#include "cellml/cellml_adapter_batch.h"
+
+namespace Control
+{
+
+/** Common functionality of the partial specializations of BatchedAdvance for explicit time stepping schemes that integrate CellML models,
+ *  e.g. the subcellular models of all fibers of a rank. The states of all instances are gathered in one contiguous array and integrated by a single time loop,
+ *  in every stage the right hand side of all CellML instances is computed by a single call to the rhs routine (CellmlAdapterBatch).
+ *  The update of the states is done by the derived class in computeTimeStep, in a single pass over the arrays per stage.
+ *  The solution field variables of the individual instances are updated at the end of the time span
+ *  and, if they have output writers, after every time step. The rates are only stored in the stage vectors of the derived class,
+ *  the field variables increment() (and intermediateIncrement() of Heun) of the instances are not updated and keep their values from before the batched integration.
+ *
+ *  If the CellmlAdapter objects cannot be evaluated together (different CellML code or the rhs is given by a library) or the time spans differ,
+ *  the instances are advanced one after the other.
+ *
+ *  If the CellML option "useSinglePrecision" is set, the states are stored in solutionSinglePrecision_ instead of solution_ and the rhs is evaluated
+ *  in single precision, the derived classes implement their update for both precisions. The states in "doublePrecisionStateNos", e.g. the membrane potential,
+ *  are accumulated with their rounding errors, such that their small increments are not lost.
+ *
+ *  With the CellML option "skipWhenQuiescent", instances that rest at a steady state and are not stimulated are detected by getQuiescentInstances.
+ *  Inactive instances are skipped, only the instance ranges of the active instances are evaluated and updated.
+ */
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+class BatchedAdvanceCellmlExplicit
+{
+public:
+
+  //! store the instances and create the batch of their CellmlAdapter objects, this is collective on MPI_COMM_WORLD, see CellmlAdapterBatch::initialize
+  void initialize(const std::vector<TimeSteppingSchemeType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal);
+
+  //! advance all instances by their time spans
+  void advanceTimeSpan();
+
+  //! first phase of advanceTimeSpan, as there is no communication, this advances the whole time span
+  void startAdvanceTimeSpan();
+
+  //! second phase of advanceTimeSpan, nothing to do
+  void finishAdvanceTimeSpan();
+
+  //! determine the instances whose CellmlAdapter is quiescent in [startTime,endTime], an instance that is distributed over several ranks has to be quiescent on all of them.
+  //! This is collective for these ranks. @return if the option "skipWhenQuiescent" is set
+  bool getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent);
+
+  //! set which instances are advanced by the next calls to advanceTimeSpan
+  void setActiveInstances(const std::vector<bool> &instanceIsActive);
+
+  //! if the states are stored and integrated in single precision, this is set by initialize
+  bool singlePrecision() const;
+
+protected:
+
+  //! compute one time step of all instances from currentTime to currentTime + timeStepWidth on the values in solution_
+  virtual void computeTimeStep(double currentTime, double timeStepWidth) = 0;
+
+  //! allocate the vectors for the stages of the scheme, nValues is the size of solution_
+  virtual void initializeStageVectors(int nValues) = 0;
+
+  //! copy the states from the solution field variables of all active instances to solution_
+  void gatherSolution();
+
+  //! copy the states from solution_ to the solution field variable of the instance
+  void scatterSolution(int instanceNo);
+
+  //! set the prescribed Dirichlet boundary condition values of all active instances in solution_
+  void applyBoundaryConditions();
+
+  //! solution += alpha*increment for all values of the active instances, where solution is solution_ or solutionSinglePrecision_
+  template<typename RealType>
+  void addIncrement(std::vector<RealType> &solution, double alpha, const std::vector<RealType> &increment);
+
+  //! solution += alpha*(increment1 - increment0) for all values of the active instances, where solution is solution_ or solutionSinglePrecision_
+  template<typename RealType>
+  void addIncrementDifference(std::vector<RealType> &solution, double alpha, const std::vector<RealType> &increment0, const std::vector<RealType> &increment1);
+
+  std::vector<TimeSteppingSchemeType *> instances_;   ///< the instances that are advanced together
+  std::vector<bool> instanceIsActive_;                ///< for every instance if it is advanced
+  bool initialized_ = false;                          ///< if initialize has been called, then it does nothing for the same instances
+  std::shared_ptr<CellmlAdapterBatch<nStates,FunctionSpaceType>> cellmlAdapterBatch_;   ///< the CellmlAdapter objects of all instances, nullptr if they cannot be evaluated together
+
+  std::vector<double> solution_;                   ///< the states of all instances in the layout of cellmlAdapterBatch_
+  bool singlePrecision_ = false;                   ///< if the states are stored in solutionSinglePrecision_ instead of solution_
+  std::vector<float> solutionSinglePrecision_;     ///< the states of all instances in the layout of cellmlAdapterBatch_, if singlePrecision_ is set
+  std::vector<int> doublePrecisionStateNos_;       ///< the states that are accumulated in double precision, if singlePrecision_ is set
+  std::vector<int> roundingErrorsOffset_;          ///< for every state the offset in roundingErrors_, or -1 if the state is not accumulated in double precision
+  std::vector<double> roundingErrors_;             ///< for the states in doublePrecisionStateNos_, the difference between the exact values and the values in solutionSinglePrecision_
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_cellml_explicit.tpp"
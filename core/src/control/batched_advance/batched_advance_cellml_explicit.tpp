@@ -0,0 +1,382 @@
+#include "control/batched_advance/batched_advance_cellml_explicit.h"
+
+#include "control/performance_measurement.h"
+#include "utility/mpi_utility.h"
+
+namespace Control
+{
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+initialize(const std::vector<TimeSteppingSchemeType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal)
+{
+  // initialize may be called again for the same instances, then the rhs routine does not need to be compiled again
+  if (initialized_ && instances_ == instances)
+    return;
+
+  initialized_ = true;
+  instances_ = instances;
+  instanceIsActive_.assign(instances_.size(), true);
+  cellmlAdapterBatch_ = nullptr;
+  singlePrecision_ = false;
+
+  std::vector<CellmlAdapter<nStates,FunctionSpaceType> *> cellmlAdapters;
+  for (TimeSteppingSchemeType *instance : instances_)
+  {
+    cellmlAdapters.push_back(&instance->discretizableInTime());
+  }
+
+  // the batch is also initialized for a single or no instance, because the compilation of the rhs routine is collective for all ranks,
+  // a single instance is computed as before
+  cellmlAdapterBatch_ = std::make_shared<CellmlAdapterBatch<nStates,FunctionSpaceType>>(cellmlAdapters);
+  if (!cellmlAdapterBatch_->initialize())
+  {
+    cellmlAdapterBatch_ = nullptr;
+    return;
+  }
+
+  LOG(DEBUG) << "BatchedAdvance: " << instances_.size() << " time stepping instances with in total " << cellmlAdapterBatch_->nInstances()
+    << " CellML instances are integrated together";
+
+  const int nValues = nStates*cellmlAdapterBatch_->nInstances();
+  singlePrecision_ = cellmlAdapterBatch_->singlePrecision();
+  if (singlePrecision_)
+  {
+    solutionSinglePrecision_.resize(nValues);
+
+    // the states that are accumulated in double precision store the rounding error of every instance
+    doublePrecisionStateNos_ = cellmlAdapters[0]->doublePrecisionStateNos();
+    roundingErrorsOffset_.assign(nStates, -1);
+    for (int i = 0; i < doublePrecisionStateNos_.size(); i++)
+    {
+      roundingErrorsOffset_[doublePrecisionStateNos_[i]] = i*cellmlAdapterBatch_->nInstances();
+    }
+    roundingErrors_.resize(doublePrecisionStateNos_.size()*cellmlAdapterBatch_->nInstances());
+    cellmlAdapterBatch_->setRoundingErrors(roundingErrors_.data(), roundingErrorsOffset_);
+
+    LOG(DEBUG) << "BatchedAdvance: states are integrated in single precision, states " << doublePrecisionStateNos_ << " are accumulated in double precision";
+  }
+  else
+  {
+    solution_.resize(nValues);
+  }
+  initializeStageVectors(nValues);
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+gatherSolution()
+{
+  PetscErrorCode ierr;
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    if (!instanceIsActive_[instanceNo])
+      continue;
+
+    Vec &solution = instances_[instanceNo]->data().solution()->getValuesContiguous();
+
+    const double *solutionData;
+    ierr = VecGetArrayRead(solution, &solutionData); CHKERRV(ierr);
+
+    // in single precision, this also stores the rounding errors of the states that are accumulated in double precision
+    if (singlePrecision_)
+    {
+      cellmlAdapterBatch_->gatherStates(instanceNo, solutionData, solutionSinglePrecision_.data());
+    }
+    else
+    {
+      cellmlAdapterBatch_->gatherStates(instanceNo, solutionData, solution_.data());
+    }
+    ierr = VecRestoreArrayRead(solution, &solutionData); CHKERRV(ierr);
+  }
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+scatterSolution(int instanceNo)
+{
+  PetscErrorCode ierr;
+  Vec &solution = instances_[instanceNo]->data().solution()->getValuesContiguous();
+
+  double *solutionData;
+  ierr = VecGetArray(solution, &solutionData); CHKERRV(ierr);
+
+  // in single precision, this adds the rounding errors of the states that are accumulated in double precision
+  if (singlePrecision_)
+  {
+    cellmlAdapterBatch_->scatterStates(instanceNo, solutionSinglePrecision_.data(), solutionData);
+  }
+  else
+  {
+    cellmlAdapterBatch_->scatterStates(instanceNo, solution_.data(), solutionData);
+  }
+  ierr = VecRestoreArray(solution, &solutionData); CHKERRV(ierr);
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+applyBoundaryConditions()
+{
+  const int nInstancesBatch = cellmlAdapterBatch_->nInstances();
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    if (!instanceIsActive_[instanceNo])
+      continue;
+
+    auto dirichletBoundaryConditions = instances_[instanceNo]->dirichletBoundaryConditions();
+    const std::vector<dof_no_t> &dofNosLocal = dirichletBoundaryConditions->boundaryConditionNonGhostDofLocalNos();
+    const int instanceOffset = cellmlAdapterBatch_->instanceOffset(instanceNo);
+
+    for (int i = 0; i < dofNosLocal.size(); i++)
+    {
+      for (int stateNo = 0; stateNo < nStates; stateNo++)
+      {
+        const int valueNo = stateNo*nInstancesBatch + instanceOffset + dofNosLocal[i];
+        const double value = dirichletBoundaryConditions->boundaryConditionValues()[i][stateNo];
+        if (singlePrecision_)
+        {
+          solutionSinglePrecision_[valueNo] = value;
+          if (roundingErrorsOffset_[stateNo] != -1)
+            roundingErrors_[roundingErrorsOffset_[stateNo] + instanceOffset + dofNosLocal[i]] = value - solutionSinglePrecision_[valueNo];
+        }
+        else
+        {
+          solution_[valueNo] = value;
+        }
+      }
+    }
+  }
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+addIncrement(std::vector<RealType> &solution, double alpha, const std::vector<RealType> &increment)
+{
+  const int nInstancesBatch = cellmlAdapterBatch_->nInstances();
+  const RealType alphaReal = alpha;
+
+  for (int stateNo = 0; stateNo < nStates; stateNo++)
+  {
+    RealType *values = solution.data() + stateNo*nInstancesBatch;
+    const RealType *incrementValues = increment.data() + stateNo*nInstancesBatch;
+
+    for (const std::array<int,2> &instanceRange : cellmlAdapterBatch_->activeInstanceRanges())
+    {
+      // states in single precision that are accumulated in double precision, together with their rounding error
+      if (singlePrecision_ && roundingErrorsOffset_[stateNo] != -1)
+      {
+        double *roundingErrors = roundingErrors_.data() + roundingErrorsOffset_[stateNo];
+        for (int i = instanceRange[0]; i < instanceRange[1]; i++)
+        {
+          const double value = double(values[i]) + roundingErrors[i] + alpha * double(incrementValues[i]);
+          values[i] = value;
+          roundingErrors[i] = value - double(values[i]);
+        }
+      }
+      else
+      {
+        for (int i = instanceRange[0]; i < instanceRange[1]; i++)
+        {
+          values[i] += alphaReal * incrementValues[i];
+        }
+      }
+    }
+  }
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+addIncrementDifference(std::vector<RealType> &solution, double alpha, const std::vector<RealType> &increment0, const std::vector<RealType> &increment1)
+{
+  const int nInstancesBatch = cellmlAdapterBatch_->nInstances();
+  const RealType alphaReal = alpha;
+
+  for (int stateNo = 0; stateNo < nStates; stateNo++)
+  {
+    RealType *values = solution.data() + stateNo*nInstancesBatch;
+    const RealType *incrementValues0 = increment0.data() + stateNo*nInstancesBatch;
+    const RealType *incrementValues1 = increment1.data() + stateNo*nInstancesBatch;
+
+    for (const std::array<int,2> &instanceRange : cellmlAdapterBatch_->activeInstanceRanges())
+    {
+      // states in single precision that are accumulated in double precision, together with their rounding error
+      if (singlePrecision_ && roundingErrorsOffset_[stateNo] != -1)
+      {
+        double *roundingErrors = roundingErrors_.data() + roundingErrorsOffset_[stateNo];
+        for (int i = instanceRange[0]; i < instanceRange[1]; i++)
+        {
+          const double value = double(values[i]) + roundingErrors[i] + alpha * (double(incrementValues1[i]) - double(incrementValues0[i]));
+          values[i] = value;
+          roundingErrors[i] = value - double(values[i]);
+        }
+      }
+      else
+      {
+        for (int i = instanceRange[0]; i < instanceRange[1]; i++)
+        {
+          values[i] += alphaReal * (incrementValues1[i] - incrementValues0[i]);
+        }
+      }
+    }
+  }
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+advanceTimeSpan()
+{
+  if (instances_.empty())
+    return;
+
+  if (!cellmlAdapterBatch_ || !haveEqualTimeSpans(instances_))
+  {
+    for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+    {
+      if (instanceIsActive_[instanceNo])
+        instances_[instanceNo]->advanceTimeSpan();
+    }
+    return;
+  }
+
+  // all instances are quiescent
+  if (cellmlAdapterBatch_->activeInstanceRanges().empty())
+    return;
+
+  // this is the same as advanceTimeSpan of the time stepping scheme, but for the states of all instances
+  TimeSteppingSchemeType &firstInstance = *instances_[0];
+
+  // start duration measurement, the duration is measured once for all instances
+  std::string durationLogKey = firstInstance.durationLogKey();
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::start(durationLogKey);
+
+  const double startTime = firstInstance.startTime();
+  const double timeSpan = firstInstance.endTime() - startTime;
+  const double timeStepWidth = firstInstance.timeStepWidth();
+  const int numberTimeSteps = firstInstance.numberTimeSteps();
+
+  gatherSolution();
+
+  // loop over time steps
+  double currentTime = startTime;
+  for (int timeStepNo = 0; timeStepNo < numberTimeSteps;)
+  {
+    if (timeStepNo % firstInstance.timeStepOutputInterval() == 0 && timeStepNo > 0)
+    {
+      LOG(INFO) << "BatchedAdvance, timestep " << timeStepNo << "/" << numberTimeSteps << ", t=" << currentTime;
+    }
+
+    // compute the new states of all instances
+    computeTimeStep(currentTime, timeStepWidth);
+
+    // apply the prescribed boundary condition values
+    applyBoundaryConditions();
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = startTime + double(timeStepNo) / numberTimeSteps * timeSpan;
+
+    // write current output values, only the instances that have output writers need their solution in every time step
+    for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+    {
+      TimeSteppingSchemeType &instance = *instances_[instanceNo];
+      if (instanceIsActive_[instanceNo] && instance.outputWriterManager().hasOutputWriters())
+      {
+        if (durationLogKey != "")
+          Control::PerformanceMeasurement::stop(durationLogKey);
+
+        scatterSolution(instanceNo);
+        instance.outputWriterManager().writeOutput(instance.data(), timeStepNo, currentTime);
+
+        if (durationLogKey != "")
+          Control::PerformanceMeasurement::start(durationLogKey);
+      }
+    }
+  }
+
+  // copy the final states and intermediates back to the active instances
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    if (instanceIsActive_[instanceNo])
+      scatterSolution(instanceNo);
+  }
+  cellmlAdapterBatch_->scatterIntermediates();
+
+  // stop duration measurement
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::stop(durationLogKey);
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+startAdvanceTimeSpan()
+{
+  advanceTimeSpan();
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+finishAdvanceTimeSpan()
+{
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+bool BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent)
+{
+  quiescent.assign(instances_.size(), false);
+  if (instances_.empty() || !instances_[0]->discretizableInTime().skipWhenQuiescent())
+    return false;
+
+  std::vector<int> isQuiescent(instances_.size());
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    isQuiescent[instanceNo] = instances_[instanceNo]->discretizableInTime().isQuiescent(startTime, endTime);
+  }
+
+  // an instance that is distributed over several ranks, e.g. a fiber, can only be skipped if it is quiescent on all of them,
+  // otherwise the activity on the other ranks would spread to the own part
+  std::vector<MPI_Request> requests;
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    MPI_Comm mpiCommunicator = instances_[instanceNo]->discretizableInTime().functionSpace()->meshPartition()->mpiCommunicator();
+    int nRanks;
+    MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator, &nRanks), "MPI_Comm_size");
+    if (nRanks == 1)
+      continue;
+
+    MPI_Request request;
+    MPIUtility::handleReturnValue(MPI_Iallreduce(MPI_IN_PLACE, &isQuiescent[instanceNo], 1, MPI_INT, MPI_LAND, mpiCommunicator, &request), "MPI_Iallreduce");
+    requests.push_back(request);
+  }
+  if (!requests.empty())
+  {
+    MPIUtility::handleReturnValue(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE), "MPI_Waitall");
+  }
+
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    quiescent[instanceNo] = isQuiescent[instanceNo];
+  }
+  return true;
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+void BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+setActiveInstances(const std::vector<bool> &instanceIsActive)
+{
+  instanceIsActive_ = instanceIsActive;
+  if (cellmlAdapterBatch_)
+    cellmlAdapterBatch_->setActiveAdapters(instanceIsActive_);
+}
+
+template<typename TimeSteppingSchemeType, int nStates, typename FunctionSpaceType>
+bool BatchedAdvanceCellmlExplicit<TimeSteppingSchemeType,nStates,FunctionSpaceType>::
+singlePrecision() const
+{
+  return singlePrecision_;
+}
+
+}  // namespace
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "control/batched_advance/batched_advance_cellml_explicit.h"
+#include "time_stepping_scheme/explicit_euler.h"
+
+namespace Control
+{
+
+/** Partial specialization for explicit Euler schemes that integrate CellML models, e.g. the subcellular models of all fibers of a rank.
+ *  All instances are integrated by a single explicit Euler loop, see BatchedAdvanceCellmlExplicit.
+ */
+template<int nStates, typename FunctionSpaceType>
+class BatchedAdvance<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<nStates,FunctionSpaceType>>> :
+  public BatchedAdvanceCellmlExplicit<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<nStates,FunctionSpaceType>>, nStates, FunctionSpaceType>
+{
+protected:
+
+  //! compute one explicit Euler step of all instances on the values in solution_ or solutionSinglePrecision_
+  void computeTimeStep(double currentTime, double timeStepWidth) override;
+
+  //! allocate the vector for the rates
+  void initializeStageVectors(int nValues) override;
+
+  //! compute one explicit Euler step in the precision of RealType
+  template<typename RealType>
+  void computeEulerStep(std::vector<RealType> &solution, std::vector<RealType> &increment, double currentTime, double timeStepWidth);
+
+  std::vector<double> increment_;                  ///< the rates at the beginning of the time step
+  std::vector<float> incrementSinglePrecision_;    ///< the rates at the beginning of the time step, if the states are integrated in single precision
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_explicit_euler_cellml.tpp"
@@ -0,0 +1,37 @@
+#include "control/batched_advance/batched_advance_explicit_euler_cellml.h"
+
+namespace Control
+{
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<nStates,FunctionSpaceType>>>::
+initializeStageVectors(int nValues)
+{
+  if (this->singlePrecision_)
+    incrementSinglePrecision_.resize(nValues);
+  else
+    increment_.resize(nValues);
+}
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<nStates,FunctionSpaceType>>>::
+computeTimeStep(double currentTime, double timeStepWidth)
+{
+  if (this->singlePrecision_)
+    computeEulerStep(this->solutionSinglePrecision_, incrementSinglePrecision_, currentTime, timeStepWidth);
+  else
+    computeEulerStep(this->solution_, increment_, currentTime, timeStepWidth);
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void BatchedAdvance<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<nStates,FunctionSpaceType>>>::
+computeEulerStep(std::vector<RealType> &solution, std::vector<RealType> &increment, double currentTime, double timeStepWidth)
+{
+  // compute  delta_u = f(u_{t}) and u_{t+1} = u_{t} + dt*delta_u
+  this->cellmlAdapterBatch_->evaluateRightHandSide(solution.data(), increment.data(), currentTime);
+
+  this->addIncrement(solution, timeStepWidth, increment);
+}
+
+}  // namespace
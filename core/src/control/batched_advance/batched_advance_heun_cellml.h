@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "control/batched_advance/batched_advance_cellml_explicit.h"
+#include "time_stepping_scheme/heun.h"
+
+namespace Control
+{
+
+/** Partial specialization for Heun schemes that integrate CellML models, e.g. the subcellular models of all fibers of a rank.
+ *  All instances are integrated by a single Heun loop, see BatchedAdvanceCellmlExplicit.
+ *  Every stage updates the states in one pass, u* = u_{t} + dt*f(u_{t}) and u_{t+1} = u* + 0.5*dt*(f(u*)-f(u_{t})).
+ *  The rates are kept in increment_ and intermediateIncrement_, the increment and intermediateIncrement field variables of the instances are stale afterwards.
+ */
+template<int nStates, typename FunctionSpaceType>
+class BatchedAdvance<TimeSteppingScheme::Heun<CellmlAdapter<nStates,FunctionSpaceType>>> :
+  public BatchedAdvanceCellmlExplicit<TimeSteppingScheme::Heun<CellmlAdapter<nStates,FunctionSpaceType>>, nStates, FunctionSpaceType>
+{
+protected:
+
+  //! compute one Heun step of all instances on the values in solution_ or solutionSinglePrecision_
+  void computeTimeStep(double currentTime, double timeStepWidth) override;
+
+  //! allocate the vectors for the two stages
+  void initializeStageVectors(int nValues) override;
+
+  //! compute one Heun step in the precision of RealType
+  template<typename RealType>
+  void computeHeunStep(std::vector<RealType> &solution, std::vector<RealType> &increment, std::vector<RealType> &intermediateIncrement,
+                       double currentTime, double timeStepWidth);
+
+  std::vector<double> increment_;                  ///< the rates at the beginning of the time step
+  std::vector<double> intermediateIncrement_;      ///< the rates at the predicted solution
+  std::vector<float> incrementSinglePrecision_;    ///< the rates at the beginning of the time step, if the states are integrated in single precision
+  std::vector<float> intermediateIncrementSinglePrecision_;   ///< the rates at the predicted solution, if the states are integrated in single precision
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_heun_cellml.tpp"
@@ -0,0 +1,49 @@
+#include "control/batched_advance/batched_advance_heun_cellml.h"
+
+namespace Control
+{
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::Heun<CellmlAdapter<nStates,FunctionSpaceType>>>::
+initializeStageVectors(int nValues)
+{
+  if (this->singlePrecision_)
+  {
+    incrementSinglePrecision_.resize(nValues);
+    intermediateIncrementSinglePrecision_.resize(nValues);
+  }
+  else
+  {
+    increment_.resize(nValues);
+    intermediateIncrement_.resize(nValues);
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::Heun<CellmlAdapter<nStates,FunctionSpaceType>>>::
+computeTimeStep(double currentTime, double timeStepWidth)
+{
+  if (this->singlePrecision_)
+    computeHeunStep(this->solutionSinglePrecision_, incrementSinglePrecision_, intermediateIncrementSinglePrecision_, currentTime, timeStepWidth);
+  else
+    computeHeunStep(this->solution_, increment_, intermediateIncrement_, currentTime, timeStepWidth);
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void BatchedAdvance<TimeSteppingScheme::Heun<CellmlAdapter<nStates,FunctionSpaceType>>>::
+computeHeunStep(std::vector<RealType> &solution, std::vector<RealType> &increment, std::vector<RealType> &intermediateIncrement,
+                double currentTime, double timeStepWidth)
+{
+  // compute  delta_u = f(u_{t}) and u* = u_{t} + dt*delta_u
+  this->cellmlAdapterBatch_->evaluateRightHandSide(solution.data(), increment.data(), currentTime);
+
+  this->addIncrement(solution, timeStepWidth, increment);
+
+  // compute  delta_u* = f(u*) and u_{t+1} = u* + 0.5*dt*(f(u*)-f(u_{t}))
+  this->cellmlAdapterBatch_->evaluateRightHandSide(solution.data(), intermediateIncrement.data(), currentTime + timeStepWidth);
+
+  this->addIncrementDifference(solution, 0.5*timeStepWidth, increment, intermediateIncrement);
+}
+
+}  // namespace
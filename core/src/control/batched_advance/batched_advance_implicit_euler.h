@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+#include <memory>
+
+#include "control/batched_advance/batched_advance.h"
+#include "time_stepping_scheme/implicit_euler.h"
+#include "solver/tridiagonal_system.h"
+
+namespace Control
+{
+
+/** Partial specialization for implicit Euler schemes, e.g. the diffusion of all fibers of a rank.
+ *  If all instances solve their linear systems with the direct tridiagonal solver (solverType "tridiagonal"), the systems of all instances
+ *  are solved together in every time step by Solver::TridiagonalSystemBatch, i.e. with interleaved sweeps and overlapping communication.
+ *  Otherwise or if the time spans differ, the instances are advanced one after the other.
+ *
+ *  When called in the two phases startAdvanceTimeSpan and finishAdvanceTimeSpan, the exchange of the interface values of the last time step
+ *  is in progress in between, such that e.g. the reaction term of other fibers can be computed meanwhile (see BatchedAdvance<Strang>).
+ *
+ *  Inactive instances (setActiveInstances) are skipped, then the tridiagonal systems of the active instances are solved together.
+ */
+template<typename DiscretizableInTimeType>
+class BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>
+{
+public:
+
+  typedef TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType> ImplicitEulerType;
+
+  //! store the instances and collect their tridiagonal systems
+  void initialize(const std::vector<ImplicitEulerType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal);
+
+  //! advance all instances by their time spans
+  void advanceTimeSpan();
+
+  //! first phase of advanceTimeSpan, do all time steps but leave the exchange of the interface values of the last linear solve in progress
+  void startAdvanceTimeSpan();
+
+  //! second phase of advanceTimeSpan, finish the last linear solve and write the output of the last time step
+  void finishAdvanceTimeSpan();
+
+  //! the instances are never quiescent on their own, see BatchedAdvance
+  bool getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent);
+
+  //! set which instances are advanced by the next calls to advanceTimeSpan and collect the tridiagonal systems of the active instances
+  void setActiveInstances(const std::vector<bool> &instanceIsActive);
+
+protected:
+
+  //! collect the tridiagonal systems of the active instances in tridiagonalSystemBatch_
+  void initializeTridiagonalSystemBatch();
+
+  //! adjust the right hand sides for the boundary conditions and start the linear solve of all active instances
+  void startTimeStep();
+
+  //! finish the linear solve of all active instances and write the output
+  void finishTimeStep(int timeStepNo, double currentTime);
+
+  std::vector<ImplicitEulerType *> instances_;        ///< the instances that are advanced together
+  std::vector<bool> instanceIsActive_;                ///< for every instance if it is advanced
+  std::vector<ImplicitEulerType *> activeInstances_;  ///< the instances that are advanced
+  std::shared_ptr<Solver::TridiagonalSystemBatch> tridiagonalSystemBatch_;   ///< the tridiagonal systems of the active instances, nullptr if not all instances use the tridiagonal solver
+
+  std::vector<double *> values_;                      ///< the local solution values of all instances during a linear solve
+  bool solveInProgress_ = false;                      ///< if startAdvanceTimeSpan left the last linear solve in progress
+  int lastTimeStepNo_ = 0;                            ///< the time step no of the linear solve that is in progress
+  double lastTime_ = 0;                               ///< the time of the linear solve that is in progress
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_implicit_euler.tpp"
@@ -0,0 +1,216 @@
+#include "control/batched_advance/batched_advance_implicit_euler.h"
+
+#include <cassert>
+
+#include "control/performance_measurement.h"
+
+namespace Control
+{
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+initialize(const std::vector<ImplicitEulerType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal)
+{
+  instances_ = instances;
+  instanceIsActive_.assign(instances_.size(), true);
+  activeInstances_ = instances_;
+  tridiagonalSystemBatch_ = nullptr;
+
+  // a single instance is computed as before
+  if (instances_.size() <= 1)
+    return;
+
+  for (ImplicitEulerType *instance : instances_)
+  {
+    if (!instance->tridiagonalSystem())
+      return;
+  }
+
+  tridiagonalSystemBatch_ = std::make_shared<Solver::TridiagonalSystemBatch>();
+  initializeTridiagonalSystemBatch();
+
+  LOG(DEBUG) << "BatchedAdvance: the tridiagonal systems of " << instances_.size() << " ImplicitEuler instances are solved together";
+}
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+initializeTridiagonalSystemBatch()
+{
+  std::vector<Solver::TridiagonalSystem *> tridiagonalSystems;
+  for (ImplicitEulerType *instance : activeInstances_)
+  {
+    tridiagonalSystems.push_back(instance->tridiagonalSystem().get());
+  }
+  tridiagonalSystemBatch_->initialize(tridiagonalSystems);
+}
+
+template<typename DiscretizableInTimeType>
+bool BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent)
+{
+  quiescent.assign(instances_.size(), false);
+  return false;
+}
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+setActiveInstances(const std::vector<bool> &instanceIsActive)
+{
+  if (instanceIsActive == instanceIsActive_)
+    return;
+
+  assert(!solveInProgress_);
+  instanceIsActive_ = instanceIsActive;
+
+  activeInstances_.clear();
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    if (instanceIsActive_[instanceNo])
+      activeInstances_.push_back(instances_[instanceNo]);
+  }
+
+  // only the systems of the active instances are solved together, collecting the factorizations again is cheap compared to a time step
+  if (tridiagonalSystemBatch_)
+    initializeTridiagonalSystemBatch();
+}
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+advanceTimeSpan()
+{
+  startAdvanceTimeSpan();
+  finishAdvanceTimeSpan();
+}
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+startAdvanceTimeSpan()
+{
+  if (activeInstances_.empty())
+    return;
+
+  if (!tridiagonalSystemBatch_ || !haveEqualTimeSpans(activeInstances_))
+  {
+    for (ImplicitEulerType *instance : activeInstances_)
+    {
+      instance->advanceTimeSpan();
+    }
+    return;
+  }
+
+  // this is the same as ImplicitEuler::advanceTimeSpan, but the linear systems of all active instances are solved together
+  ImplicitEulerType &firstInstance = *activeInstances_[0];
+
+  // start duration measurement, the duration is measured once for all instances
+  std::string durationLogKey = firstInstance.durationLogKey();
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::start(durationLogKey);
+
+  const double startTime = firstInstance.startTime();
+  const double timeSpan = firstInstance.endTime() - startTime;
+  const int numberTimeSteps = firstInstance.numberTimeSteps();
+
+  // loop over time steps
+  double currentTime = startTime;
+  for (int timeStepNo = 0; timeStepNo < numberTimeSteps;)
+  {
+    if (timeStepNo % firstInstance.timeStepOutputInterval() == 0 && timeStepNo > 0)
+    {
+      LOG(INFO) << "Implicit Euler, timestep " << timeStepNo << "/" << numberTimeSteps << ", t=" << currentTime;
+    }
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = startTime + double(timeStepNo) / numberTimeSteps * timeSpan;
+
+    // solve A*u^{t+1} = u^{t} for u^{t+1} for all instances in-place
+    startTimeStep();
+
+    // the last solve is finished by finishAdvanceTimeSpan
+    if (timeStepNo == numberTimeSteps)
+    {
+      solveInProgress_ = true;
+      lastTimeStepNo_ = timeStepNo;
+      lastTime_ = currentTime;
+      break;
+    }
+
+    finishTimeStep(timeStepNo, currentTime);
+  }
+
+  // stop duration measurement
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::stop(durationLogKey);
+}
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+finishAdvanceTimeSpan()
+{
+  if (!solveInProgress_)
+    return;
+
+  solveInProgress_ = false;
+
+  // start duration measurement
+  std::string durationLogKey = activeInstances_[0]->durationLogKey();
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::start(durationLogKey);
+
+  finishTimeStep(lastTimeStepNo_, lastTime_);
+
+  // stop duration measurement
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::stop(durationLogKey);
+}
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+startTimeStep()
+{
+  // adjust rhs vectors such that boundary conditions are satisfied
+  for (ImplicitEulerType *instance : activeInstances_)
+  {
+    instance->dirichletBoundaryConditions()->applyInRightHandSide(instance->data().solution(), instance->dataImplicit().boundaryConditionsRightHandSideSummand());
+  }
+
+  // the arrays stay accessed until the solve is finished in finishTimeStep
+  PetscErrorCode ierr;
+  values_.resize(activeInstances_.size());
+  for (int instanceNo = 0; instanceNo < activeInstances_.size(); instanceNo++)
+  {
+    ierr = VecGetArray(activeInstances_[instanceNo]->data().solution()->valuesGlobal(), &values_[instanceNo]); CHKERRV(ierr);
+  }
+
+  tridiagonalSystemBatch_->startSolve(values_);
+}
+
+template<typename DiscretizableInTimeType>
+void BatchedAdvance<TimeSteppingScheme::ImplicitEuler<DiscretizableInTimeType>>::
+finishTimeStep(int timeStepNo, double currentTime)
+{
+  tridiagonalSystemBatch_->finishSolve(values_);
+
+  PetscErrorCode ierr;
+  for (int instanceNo = 0; instanceNo < activeInstances_.size(); instanceNo++)
+  {
+    ierr = VecRestoreArray(activeInstances_[instanceNo]->data().solution()->valuesGlobal(), &values_[instanceNo]); CHKERRV(ierr);
+  }
+
+  // stop duration measurement
+  std::string durationLogKey = activeInstances_[0]->durationLogKey();
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::stop(durationLogKey);
+
+  // write current output values
+  for (ImplicitEulerType *instance : activeInstances_)
+  {
+    instance->outputWriterManager().writeOutput(instance->dataImplicit(), timeStepNo, currentTime);
+  }
+
+  // start duration measurement
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::start(durationLogKey);
+}
+
+}  // namespace
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+namespace Control
+{
+
+template<class TimeSteppingScheme>
+class MultipleInstances;
+
+/** Partial specialization for nested MultipleInstances, the local instances of all MultipleInstances objects are collected and advanced together.
+ */
+template<typename TimeSteppingType>
+class BatchedAdvance<MultipleInstances<TimeSteppingType>>
+{
+public:
+
+  //! collect the local instances of all MultipleInstances objects, the local instance i of the MultipleInstances object with global number n
+  //! gets the global number n*nInstances + i, where nInstances is the number of instances of the MultipleInstances objects
+  void initialize(const std::vector<MultipleInstances<TimeSteppingType> *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal);
+
+  //! advance all local instances of all MultipleInstances objects
+  void advanceTimeSpan();
+
+  //! first phase of advanceTimeSpan, see BatchedAdvance
+  void startAdvanceTimeSpan();
+
+  //! second phase of advanceTimeSpan, see BatchedAdvance
+  void finishAdvanceTimeSpan();
+
+  //! a MultipleInstances object is quiescent if all its local instances are quiescent, see BatchedAdvance
+  bool getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent);
+
+  //! set which MultipleInstances objects are advanced, this applies to all their local instances, see BatchedAdvance
+  void setActiveInstances(const std::vector<bool> &instanceIsActive);
+
+protected:
+
+  BatchedAdvance<TimeSteppingType> batchedAdvanceInstancesLocal_;   ///< the object that advances the local instances of all MultipleInstances objects
+  std::vector<int> nInstancesLocal_;                                ///< for every MultipleInstances object the number of its local instances
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_multiple_instances.tpp"
@@ -0,0 +1,92 @@
+#include "control/batched_advance/batched_advance_multiple_instances.h"
+
+#include "utility/mpi_utility.h"
+
+namespace Control
+{
+
+template<typename TimeSteppingType>
+void BatchedAdvance<MultipleInstances<TimeSteppingType>>::
+initialize(const std::vector<MultipleInstances<TimeSteppingType> *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal)
+{
+  // the number of instances of the nested MultipleInstances objects, this is given by the settings and is the same on all ranks
+  int nInstancesNested = 0;
+  if (!instances.empty())
+    nInstancesNested = instances[0]->nInstances();
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, &nInstancesNested, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD), "MPI_Allreduce");
+
+  std::vector<TimeSteppingType *> instancesLocal;
+  std::vector<int> instanceNosGlobalLocal;
+  nInstancesLocal_.clear();
+  for (int instanceNo = 0; instanceNo < instances.size(); instanceNo++)
+  {
+    MultipleInstances<TimeSteppingType> *instance = instances[instanceNo];
+    for (int i = 0; i < instance->instancesLocal().size(); i++)
+    {
+      instancesLocal.push_back(&instance->instancesLocal()[i]);
+      instanceNosGlobalLocal.push_back(instanceNosGlobal[instanceNo]*nInstancesNested + instance->instanceNosGlobal()[i]);
+    }
+    nInstancesLocal_.push_back(instance->instancesLocal().size());
+  }
+
+  batchedAdvanceInstancesLocal_.initialize(instancesLocal, instanceNosGlobalLocal, nInstancesGlobal*nInstancesNested);
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<MultipleInstances<TimeSteppingType>>::
+advanceTimeSpan()
+{
+  batchedAdvanceInstancesLocal_.advanceTimeSpan();
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<MultipleInstances<TimeSteppingType>>::
+startAdvanceTimeSpan()
+{
+  batchedAdvanceInstancesLocal_.startAdvanceTimeSpan();
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<MultipleInstances<TimeSteppingType>>::
+finishAdvanceTimeSpan()
+{
+  batchedAdvanceInstancesLocal_.finishAdvanceTimeSpan();
+}
+
+template<typename TimeSteppingType>
+bool BatchedAdvance<MultipleInstances<TimeSteppingType>>::
+getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent)
+{
+  std::vector<bool> quiescentInstancesLocal;
+  bool detectsQuiescentInstances = batchedAdvanceInstancesLocal_.getQuiescentInstances(startTime, endTime, quiescentInstancesLocal);
+
+  quiescent.assign(nInstancesLocal_.size(), detectsQuiescentInstances);
+  if (!detectsQuiescentInstances)
+    return false;
+
+  // an instance is quiescent if all its local instances are quiescent
+  int instanceLocalNo = 0;
+  for (int instanceNo = 0; instanceNo < nInstancesLocal_.size(); instanceNo++)
+  {
+    for (int i = 0; i < nInstancesLocal_[instanceNo]; i++, instanceLocalNo++)
+    {
+      if (!quiescentInstancesLocal[instanceLocalNo])
+        quiescent[instanceNo] = false;
+    }
+  }
+  return true;
+}
+
+template<typename TimeSteppingType>
+void BatchedAdvance<MultipleInstances<TimeSteppingType>>::
+setActiveInstances(const std::vector<bool> &instanceIsActive)
+{
+  std::vector<bool> instanceLocalIsActive;
+  for (int instanceNo = 0; instanceNo < nInstancesLocal_.size(); instanceNo++)
+  {
+    instanceLocalIsActive.insert(instanceLocalIsActive.end(), nInstancesLocal_[instanceNo], instanceIsActive[instanceNo]);
+  }
+  batchedAdvanceInstancesLocal_.setActiveInstances(instanceLocalIsActive);
+}
+
+}  // namespace
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "control/batched_advance/batched_advance_cellml_explicit.h"
+#include "time_stepping_scheme/runge_kutta_4.h"
+
+namespace Control
+{
+
+/** Partial specialization for Runge-Kutta 4 schemes that integrate CellML models, e.g. the subcellular models of all fibers of a rank.
+ *  All instances are integrated by a single Runge-Kutta loop, see BatchedAdvanceCellmlExplicit.
+ *  After the rhs call of every stage, one pass over the arrays accumulates the rate in incrementSum_ and computes the input of the next stage, like in RungeKutta4.
+ *  In single precision, the states in doublePrecisionStateNos_ are computed from their values at the beginning of the time step including the rounding errors.
+ */
+template<int nStates, typename FunctionSpaceType>
+class BatchedAdvance<TimeSteppingScheme::RungeKutta4<CellmlAdapter<nStates,FunctionSpaceType>>> :
+  public BatchedAdvanceCellmlExplicit<TimeSteppingScheme::RungeKutta4<CellmlAdapter<nStates,FunctionSpaceType>>, nStates, FunctionSpaceType>
+{
+protected:
+
+  //! compute one Runge-Kutta step of all instances on the values in solution_ or solutionSinglePrecision_
+  void computeTimeStep(double currentTime, double timeStepWidth) override;
+
+  //! allocate the vectors for the stages
+  void initializeStageVectors(int nValues) override;
+
+  //! compute one Runge-Kutta step in the precision of RealType
+  template<typename RealType>
+  void computeRungeKuttaStep(std::vector<RealType> &solution, std::vector<RealType> &increment, std::vector<RealType> &initialSolution,
+                             std::vector<RealType> &incrementSum, double currentTime, double timeStepWidth);
+
+  //! accumulate the rate of the stage stageNo in incrementSum and compute the input of the next stage in solution, or the new solution after the last stage
+  template<typename RealType>
+  void updateStage(int stageNo, std::vector<RealType> &solution, const std::vector<RealType> &increment, std::vector<RealType> &initialSolution,
+                   std::vector<RealType> &incrementSum, double timeStepWidth);
+
+  std::vector<double> increment_;                  ///< the rate of the current stage
+  std::vector<double> initialSolution_;            ///< the states at the beginning of the time step
+  std::vector<double> incrementSum_;               ///< the weighted sum of the rates of the stages, k1 + 2*k2 + 2*k3 + k4
+  std::vector<float> incrementSinglePrecision_;    ///< the rate of the current stage, if the states are integrated in single precision
+  std::vector<float> initialSolutionSinglePrecision_;   ///< the states at the beginning of the time step, if the states are integrated in single precision
+  std::vector<float> incrementSumSinglePrecision_;      ///< the weighted sum of the rates of the stages, if the states are integrated in single precision
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_runge_kutta_4_cellml.tpp"
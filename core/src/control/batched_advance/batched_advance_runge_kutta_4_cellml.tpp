@@ -0,0 +1,109 @@
+#include "control/batched_advance/batched_advance_runge_kutta_4_cellml.h"
+
+namespace Control
+{
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::RungeKutta4<CellmlAdapter<nStates,FunctionSpaceType>>>::
+initializeStageVectors(int nValues)
+{
+  if (this->singlePrecision_)
+  {
+    incrementSinglePrecision_.resize(nValues);
+    initialSolutionSinglePrecision_.resize(nValues);
+    incrementSumSinglePrecision_.resize(nValues);
+  }
+  else
+  {
+    increment_.resize(nValues);
+    initialSolution_.resize(nValues);
+    incrementSum_.resize(nValues);
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::RungeKutta4<CellmlAdapter<nStates,FunctionSpaceType>>>::
+computeTimeStep(double currentTime, double timeStepWidth)
+{
+  if (this->singlePrecision_)
+    computeRungeKuttaStep(this->solutionSinglePrecision_, incrementSinglePrecision_, initialSolutionSinglePrecision_, incrementSumSinglePrecision_,
+                          currentTime, timeStepWidth);
+  else
+    computeRungeKuttaStep(this->solution_, increment_, initialSolution_, incrementSum_, currentTime, timeStepWidth);
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void BatchedAdvance<TimeSteppingScheme::RungeKutta4<CellmlAdapter<nStates,FunctionSpaceType>>>::
+computeRungeKuttaStep(std::vector<RealType> &solution, std::vector<RealType> &increment, std::vector<RealType> &initialSolution,
+                      std::vector<RealType> &incrementSum, double currentTime, double timeStepWidth)
+{
+  // the rate k of stage stageNo is evaluated at the time currentTime + stageTime*dt
+  for (int stageNo = 0; stageNo < 4; stageNo++)
+  {
+    const double stageTime = (stageNo == 0? 0.0 : (stageNo == 3? 1.0 : 0.5));
+    this->cellmlAdapterBatch_->evaluateRightHandSide(solution.data(), increment.data(), currentTime + stageTime*timeStepWidth);
+
+    updateStage(stageNo, solution, increment, initialSolution, incrementSum, timeStepWidth);
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+template<typename RealType>
+void BatchedAdvance<TimeSteppingScheme::RungeKutta4<CellmlAdapter<nStates,FunctionSpaceType>>>::
+updateStage(int stageNo, std::vector<RealType> &solution, const std::vector<RealType> &increment, std::vector<RealType> &initialSolution,
+            std::vector<RealType> &incrementSum, double timeStepWidth)
+{
+  const int nInstancesBatch = this->cellmlAdapterBatch_->nInstances();
+
+  // the factor of dt for the input of the next stage: u_{t} + dt/2*k1, u_{t} + dt/2*k2, u_{t} + dt*k3 and u_{t+1} = u_{t} + dt/6*(k1 + 2*k2 + 2*k3 + k4)
+  const double stageTimeStepWidth = (stageNo == 3? timeStepWidth/6.0 : (stageNo == 2? timeStepWidth : 0.5*timeStepWidth));
+  const RealType stageTimeStepWidthReal = stageTimeStepWidth;
+  const RealType incrementFactor = (stageNo == 0 || stageNo == 3? 1 : 2);
+
+  for (int stateNo = 0; stateNo < nStates; stateNo++)
+  {
+    RealType *values = solution.data() + stateNo*nInstancesBatch;
+    const RealType *incrementValues = increment.data() + stateNo*nInstancesBatch;
+    RealType *initialValues = initialSolution.data() + stateNo*nInstancesBatch;
+    RealType *incrementSumValues = incrementSum.data() + stateNo*nInstancesBatch;
+
+    // states in single precision that are accumulated in double precision, their rounding errors are only updated by the last stage
+    double *roundingErrors = nullptr;
+    if (this->singlePrecision_ && this->roundingErrorsOffset_[stateNo] != -1)
+      roundingErrors = this->roundingErrors_.data() + this->roundingErrorsOffset_[stateNo];
+
+    for (const std::array<int,2> &instanceRange : this->cellmlAdapterBatch_->activeInstanceRanges())
+    {
+      for (int i = instanceRange[0]; i < instanceRange[1]; i++)
+      {
+        // accumulate the rate, the values at the beginning of the time step are stored by the first stage
+        if (stageNo == 0)
+        {
+          initialValues[i] = values[i];
+          incrementSumValues[i] = incrementValues[i];
+        }
+        else
+        {
+          incrementSumValues[i] += incrementFactor * incrementValues[i];
+        }
+
+        // compute the input of the next stage or the new solution
+        const RealType stageIncrement = (stageNo == 3? incrementSumValues[i] : incrementValues[i]);
+        if (roundingErrors)
+        {
+          const double value = double(initialValues[i]) + roundingErrors[i] + stageTimeStepWidth * double(stageIncrement);
+          values[i] = value;
+          if (stageNo == 3)
+            roundingErrors[i] = value - double(values[i]);
+        }
+        else
+        {
+          values[i] = initialValues[i] + stageTimeStepWidthReal * stageIncrement;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
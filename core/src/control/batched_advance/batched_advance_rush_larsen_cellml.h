@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "control/batched_advance/batched_advance_cellml_explicit.h"
+#include "time_stepping_scheme/rush_larsen.h"
+
+namespace Control
+{
+
+/** Partial specialization for Rush-Larsen schemes that integrate CellML models, e.g. the subcellular models of all fibers of a rank.
+ *  All instances are integrated by a single Rush-Larsen loop, see BatchedAdvanceCellmlExplicit. The rates and the coefficients of the gating variables
+ *  of all instances are computed by one call to the batched library, then all states are updated in one pass, exponentially for the gating variables and
+ *  by the explicit Euler scheme for the other states.
+ *  In single precision there are no coefficients of the gating variables, then all states are integrated by the explicit Euler scheme, like in RushLarsen.
+ */
+template<int nStates, typename FunctionSpaceType>
+class BatchedAdvance<TimeSteppingScheme::RushLarsen<CellmlAdapter<nStates,FunctionSpaceType>>> :
+  public BatchedAdvanceCellmlExplicit<TimeSteppingScheme::RushLarsen<CellmlAdapter<nStates,FunctionSpaceType>>, nStates, FunctionSpaceType>
+{
+protected:
+
+  //! compute one Rush-Larsen step of all instances on the values in solution_ or solutionSinglePrecision_
+  void computeTimeStep(double currentTime, double timeStepWidth) override;
+
+  //! allocate the vectors for the rates and the coefficients of the gating variables
+  void initializeStageVectors(int nValues) override;
+
+  std::vector<bool> isGatingState_;                ///< for every state if it is a gating variable that is integrated exponentially
+  std::vector<double> increment_;                  ///< the rates at the beginning of the time step
+  std::vector<double> gatingCoefficients_;         ///< the coefficients b of the rates a - b*y of the gating variables, in the same layout as the rates
+  std::vector<float> incrementSinglePrecision_;    ///< the rates at the beginning of the time step, if the states are integrated in single precision
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_rush_larsen_cellml.tpp"
@@ -0,0 +1,80 @@
+#include "control/batched_advance/batched_advance_rush_larsen_cellml.h"
+
+#include <cmath>
+
+namespace Control
+{
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::RushLarsen<CellmlAdapter<nStates,FunctionSpaceType>>>::
+initializeStageVectors(int nValues)
+{
+  isGatingState_.assign(nStates, false);
+
+  if (this->singlePrecision_)
+  {
+    incrementSinglePrecision_.resize(nValues);
+    return;
+  }
+
+  increment_.resize(nValues);
+  if (this->cellmlAdapterBatch_->hasGatingCoefficients())
+  {
+    for (int stateNo : this->cellmlAdapterBatch_->gatingStateNos())
+    {
+      isGatingState_[stateNo] = true;
+    }
+    gatingCoefficients_.resize(nValues);
+  }
+}
+
+template<int nStates, typename FunctionSpaceType>
+void BatchedAdvance<TimeSteppingScheme::RushLarsen<CellmlAdapter<nStates,FunctionSpaceType>>>::
+computeTimeStep(double currentTime, double timeStepWidth)
+{
+  // without coefficients of the gating variables, all states are integrated by the explicit Euler scheme
+  if (this->singlePrecision_)
+  {
+    this->cellmlAdapterBatch_->evaluateRightHandSide(this->solutionSinglePrecision_.data(), incrementSinglePrecision_.data(), currentTime);
+    this->addIncrement(this->solutionSinglePrecision_, timeStepWidth, incrementSinglePrecision_);
+    return;
+  }
+
+  // compute delta_u = f(u) and the coefficients b of the gating variables, where f(u) = a - b*u
+  double *gatingCoefficients = (gatingCoefficients_.empty()? nullptr : gatingCoefficients_.data());
+  this->cellmlAdapterBatch_->evaluateRightHandSide(this->solution_.data(), increment_.data(), currentTime, gatingCoefficients);
+
+  const int nInstancesBatch = this->cellmlAdapterBatch_->nInstances();
+  for (int stateNo = 0; stateNo < nStates; stateNo++)
+  {
+    double *y = this->solution_.data() + stateNo*nInstancesBatch;
+    const double *f = increment_.data() + stateNo*nInstancesBatch;
+
+    for (const std::array<int,2> &instanceRange : this->cellmlAdapterBatch_->activeInstanceRanges())
+    {
+      if (isGatingState_[stateNo])
+      {
+        // integrate exponentially, y += (y_inf - y)*(1 - exp(-b*dt)), with y_inf - y = f/b
+        const double *b = gatingCoefficients_.data() + stateNo*nInstancesBatch;
+        for (int i = instanceRange[0]; i < instanceRange[1]; i++)
+        {
+          const double bdt = b[i]*timeStepWidth;
+          if (std::abs(bdt) > 1e-12)
+            y[i] -= f[i] * std::expm1(-bdt) / b[i];
+          else
+            y[i] += timeStepWidth * f[i];
+        }
+      }
+      else
+      {
+        // integrate, y += dt * delta_u
+        for (int i = instanceRange[0]; i < instanceRange[1]; i++)
+        {
+          y[i] += timeStepWidth * f[i];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
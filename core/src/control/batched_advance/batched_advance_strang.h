@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "control/batched_advance/batched_advance.h"
+#include "operator_splitting/strang.h"
+
+namespace Control
+{
+
+/** Partial specialization for Strang splittings. The splitting steps of all instances are done in lockstep,
+ *  such that in every step the terms of all instances can be advanced together by BatchedAdvance.
+ *  This requires that all instances have the same time span and number of time steps, otherwise the instances are advanced one after the other.
+ *
+ *  With the option "nPipelineGroups" of the Strang splitting (taken from the first instance), the instances are split into groups which are pipelined:
+ *  In every splitting step, first the first half step of timeStepping1 and the start of timeStepping2 is done for all groups,
+ *  then the end of timeStepping2 and the second half step of timeStepping1. Thus, the communication of the last step of timeStepping2 of a group,
+ *  e.g. the exchange of the tridiagonal diffusion solver of fibers that are distributed over multiple ranks, overlaps with the reaction term of the next groups.
+ *  The groups are derived from the global numbers of the instances, e.g. the fiber numbers, such that the ranks that share an instance have it in the same group.
+ *  All ranks have the same number of groups, some of them may be empty on a rank.
+ *
+ *  At the beginning of every splitting step, the instances whose timeStepping1 is quiescent (CellML option "skipWhenQuiescent") are determined for every group.
+ *  These instances, e.g. resting fibers that are not stimulated in the step, are skipped in both terms until they are stimulated again
+ *  or a rank that shares the instance detects activity.
+ */
+template<typename TimeStepping1, typename TimeStepping2>
+class BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>
+{
+public:
+
+  typedef OperatorSplitting::Strang<TimeStepping1,TimeStepping2> StrangType;
+
+  //! store the instances, split them into groups and collect their terms
+  void initialize(const std::vector<StrangType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal);
+
+  //! advance all instances by their time spans
+  void advanceTimeSpan();
+
+  //! first phase of advanceTimeSpan, as the splitting steps depend on each other, this advances the whole time span
+  void startAdvanceTimeSpan();
+
+  //! second phase of advanceTimeSpan, nothing to do
+  void finishAdvanceTimeSpan();
+
+  //! determine the instances whose timeStepping1 is quiescent in [startTime,endTime], see BatchedAdvance::getQuiescentInstances
+  bool getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent);
+
+  //! set which instances are advanced by the next calls to advanceTimeSpan
+  void setActiveInstances(const std::vector<bool> &instanceIsActive);
+
+protected:
+
+  //! determine the active instances of the groups for the splitting step [startTime,endTime] and pass them to the BatchedAdvance objects of the terms
+  void updateActiveInstances(double startTime, double endTime);
+
+  std::vector<StrangType *> instances_;                               ///< the instances that are advanced together
+  std::vector<bool> instanceIsActive_;                                ///< for every instance if it is advanced, set by setActiveInstances
+  std::vector<std::vector<bool>> groupInstanceIsActive_;              ///< for every group and instance of the group if it is advanced in the current splitting step
+  std::vector<std::vector<StrangType *>> groups_;                     ///< the instances of every pipeline group
+  std::vector<BatchedAdvance<TimeStepping1>> batchedAdvances1_;       ///< for every group the object that advances timeStepping1 of the instances of the group
+  std::vector<BatchedAdvance<TimeStepping2>> batchedAdvances2_;       ///< for every group the object that advances timeStepping2 of the instances of the group
+};
+
+}  // namespace
+
+#include "control/batched_advance/batched_advance_strang.tpp"
@@ -0,0 +1,232 @@
+#include "control/batched_advance/batched_advance_strang.h"
+
+#include <algorithm>
+
+#include "control/performance_measurement.h"
+#include "utility/mpi_utility.h"
+
+namespace Control
+{
+
+template<typename TimeStepping1, typename TimeStepping2>
+void BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>::
+initialize(const std::vector<StrangType *> &instances, const std::vector<int> &instanceNosGlobal, int nInstancesGlobal)
+{
+  instances_ = instances;
+  instanceIsActive_.assign(instances_.size(), true);
+
+  // All ranks have the same number of groups, also ranks without instances. The number of groups is given by the settings of the instances,
+  // these are only known on the ranks that have instances.
+  int nGroups = 1;
+  if (!instances_.empty())
+    nGroups = instances_[0]->nPipelineGroups();
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, &nGroups, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD), "MPI_Allreduce");
+  nGroups = std::max(1, std::min(nGroups, nInstancesGlobal));
+
+  // split the instances into groups by their global numbers, such that an instance that is shared by several ranks is in the same group on all of them,
+  // otherwise the ranks would wait for the communication of the instance in different groups
+  groups_.clear();
+  groups_.resize(nGroups);
+  std::vector<std::vector<int>> groupInstanceNosGlobal(nGroups);
+  for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+  {
+    const int groupNo = (long long)instanceNosGlobal[instanceNo]*nGroups / nInstancesGlobal;
+    groups_[groupNo].push_back(instances_[instanceNo]);
+    groupInstanceNosGlobal[groupNo].push_back(instanceNosGlobal[instanceNo]);
+  }
+
+  LOG(DEBUG) << "BatchedAdvance: " << instances_.size() << " Strang instances in " << nGroups << " pipeline group(s)";
+
+  // collect the terms of the instances of every group
+  batchedAdvances1_.clear();
+  batchedAdvances2_.clear();
+  batchedAdvances1_.resize(nGroups);
+  batchedAdvances2_.resize(nGroups);
+  groupInstanceIsActive_.resize(nGroups);
+  for (int groupNo = 0; groupNo < nGroups; groupNo++)
+  {
+    std::vector<TimeStepping1 *> timeSteppings1;
+    std::vector<TimeStepping2 *> timeSteppings2;
+    for (StrangType *instance : groups_[groupNo])
+    {
+      timeSteppings1.push_back(&instance->timeStepping1());
+      timeSteppings2.push_back(&instance->timeStepping2());
+    }
+
+    batchedAdvances1_[groupNo].initialize(timeSteppings1, groupInstanceNosGlobal[groupNo], nInstancesGlobal);
+    batchedAdvances2_[groupNo].initialize(timeSteppings2, groupInstanceNosGlobal[groupNo], nInstancesGlobal);
+    groupInstanceIsActive_[groupNo].assign(groups_[groupNo].size(), true);
+  }
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>::
+advanceTimeSpan()
+{
+  if (instances_.empty())
+    return;
+
+  // the instances can only be advanced in lockstep if they have the same time steps
+  if (!haveEqualTimeSpans(instances_))
+  {
+    LOG(DEBUG) << "BatchedAdvance: Strang instances have different time spans, advance them one after the other";
+    for (int instanceNo = 0; instanceNo < instances_.size(); instanceNo++)
+    {
+      if (instanceIsActive_[instanceNo])
+        instances_[instanceNo]->advanceTimeSpan();
+    }
+    return;
+  }
+
+  // this is the same as Strang::advanceTimeSpan, but every step is done for all instances
+  StrangType &firstInstance = *instances_[0];
+
+  // start duration measurement, the duration is measured once for all instances
+  std::string durationLogKey = firstInstance.durationLogKey();
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::start(durationLogKey);
+
+  const double startTime = firstInstance.startTime();
+  const double timeSpan = firstInstance.endTime() - startTime;
+  const double timeStepWidth = firstInstance.timeStepWidth();
+  const int numberTimeSteps = firstInstance.numberTimeSteps();
+
+  LOG(DEBUG) << "  BatchedAdvance Strang: " << instances_.size() << " instances, timeSpan=[" << startTime << "," << firstInstance.endTime() << "]"
+    << ", n steps: " << numberTimeSteps << ", timeStepWidth=" << timeStepWidth;
+
+  for (StrangType *instance : instances_)
+  {
+    instance->startTimeSpan();
+  }
+
+  // loop over time steps
+  const int nGroups = groups_.size();
+  double currentTime = startTime;
+  for (int timeStepNo = 0; timeStepNo < numberTimeSteps;)
+  {
+    const double midTime = currentTime + 0.5 * timeStepWidth;
+
+    if (timeStepNo % firstInstance.timeStepOutputInterval() == 0 && timeStepNo > 0)
+    {
+      LOG(INFO) << "Strang, timestep " << timeStepNo << "/" << numberTimeSteps << ", t=" << currentTime;
+    }
+
+    // skip the instances that are quiescent in this step
+    updateActiveInstances(currentTime, currentTime+timeStepWidth);
+
+    // first half step of timeStepping1 and start of timeStepping2, the communication of timeStepping2 of a group overlaps with the next groups
+    for (int groupNo = 0; groupNo < nGroups; groupNo++)
+    {
+      for (StrangType *instance : groups_[groupNo])
+      {
+        instance->timeStepping1().setTimeSpan(currentTime, midTime);
+      }
+      batchedAdvances1_[groupNo].advanceTimeSpan();
+
+      for (int instanceNo = 0; instanceNo < groups_[groupNo].size(); instanceNo++)
+      {
+        StrangType *instance = groups_[groupNo][instanceNo];
+        if (groupInstanceIsActive_[groupNo][instanceNo])
+          instance->transferToTimeStepping2();
+        instance->timeStepping2().setTimeSpan(currentTime, currentTime+timeStepWidth);
+      }
+      batchedAdvances2_[groupNo].startAdvanceTimeSpan();
+    }
+
+    // end of timeStepping2 and second half step of timeStepping1
+    for (int groupNo = 0; groupNo < nGroups; groupNo++)
+    {
+      batchedAdvances2_[groupNo].finishAdvanceTimeSpan();
+
+      for (int instanceNo = 0; instanceNo < groups_[groupNo].size(); instanceNo++)
+      {
+        StrangType *instance = groups_[groupNo][instanceNo];
+        if (groupInstanceIsActive_[groupNo][instanceNo])
+          instance->transferToTimeStepping1();
+        instance->timeStepping1().setTimeSpan(midTime, currentTime+timeStepWidth);
+      }
+      batchedAdvances1_[groupNo].advanceTimeSpan();
+    }
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = startTime + double(timeStepNo) / numberTimeSteps * timeSpan;
+  }
+
+  for (StrangType *instance : instances_)
+  {
+    instance->finishTimeSpan();
+  }
+
+  // stop duration measurement
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::stop(durationLogKey);
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>::
+startAdvanceTimeSpan()
+{
+  advanceTimeSpan();
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>::
+finishAdvanceTimeSpan()
+{
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+bool BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>::
+getQuiescentInstances(double startTime, double endTime, std::vector<bool> &quiescent)
+{
+  // the groups are contiguous, concatenate their results
+  quiescent.clear();
+  bool canBeQuiescent = false;
+  for (int groupNo = 0; groupNo < groups_.size(); groupNo++)
+  {
+    std::vector<bool> quiescentGroup;
+    if (batchedAdvances1_[groupNo].getQuiescentInstances(startTime, endTime, quiescentGroup))
+      canBeQuiescent = true;
+    quiescent.insert(quiescent.end(), quiescentGroup.begin(), quiescentGroup.end());
+  }
+  return canBeQuiescent;
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>::
+setActiveInstances(const std::vector<bool> &instanceIsActive)
+{
+  instanceIsActive_ = instanceIsActive;
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void BatchedAdvance<OperatorSplitting::Strang<TimeStepping1,TimeStepping2>>::
+updateActiveInstances(double startTime, double endTime)
+{
+  int instanceNo = 0;
+  for (int groupNo = 0; groupNo < groups_.size(); groupNo++)
+  {
+    // this is collective for instances that are shared with other ranks, therefore it is called for all groups, also if they are inactive
+    std::vector<bool> quiescent;
+    batchedAdvances1_[groupNo].getQuiescentInstances(startTime, endTime, quiescent);
+
+    std::vector<bool> instanceIsActive(groups_[groupNo].size());
+    for (int groupInstanceNo = 0; groupInstanceNo < groups_[groupNo].size(); groupInstanceNo++, instanceNo++)
+    {
+      instanceIsActive[groupInstanceNo] = instanceIsActive_[instanceNo] && !quiescent[groupInstanceNo];
+    }
+
+    if (instanceIsActive != groupInstanceIsActive_[groupNo])
+    {
+      LOG(DEBUG) << "BatchedAdvance Strang: group " << groupNo << " has " << std::count(instanceIsActive.begin(), instanceIsActive.end(), true)
+        << " of " << instanceIsActive.size() << " instances active at t=" << startTime;
+
+      groupInstanceIsActive_[groupNo] = instanceIsActive;
+      batchedAdvances1_[groupNo].setActiveInstances(instanceIsActive);
+      batchedAdvances2_[groupNo].setActiveInstances(instanceIsActive);
+    }
+  }
+}
+
+}  // namespace
@@ -206,7 +206,7 @@ int DihuContext::ownRankNo()
   return rankNo;
 }
 
-std::shared_ptr<Mesh::Manager> DihuContext::meshManager() const
+std::shared_ptr<Mesh::Manager> DihuContext::meshManager()
 {
   return meshManager_;
 }
@@ -41,8 +41,8 @@ public:
   //! create a context object, like with the operator[] but with given config
   DihuContext createSubContext(PythonConfig config);
 
-  //! return the mesh manager object that contains all meshes
-  std::shared_ptr<Mesh::Manager> meshManager() const;
+  //! return the mesh manager object that contains all meshes, it is the same for all contexts
+  static std::shared_ptr<Mesh::Manager> meshManager();
 
   //! return the solver manager object that contains all solvers
   std::shared_ptr<Solver::Manager> solverManager() const;
@@ -8,11 +8,13 @@
 #include "data_management/multiple_instances.h"
 #include "output_writer/manager.h"
 #include "partition/mesh_partition/01_mesh_partition.h"
+#include "control/batched_advance/batched_advance.h"
 
 namespace Control
 {
 
 /** This class holds multiple instances of the template type, e.g. for having multiple fibers, which are each as in example electrophysiology
+  * With the option "batchInstances" the local instances are advanced together in lockstep, see BatchedAdvance.
   */
 template<class TimeSteppingScheme>
 class MultipleInstances: public Runnable
@@ -45,6 +47,18 @@ public:
   //! return the data object
   Data &data();
 
+  //! the instances that are computed on the local rank
+  std::vector<TimeSteppingScheme> &instancesLocal();
+
+  //! for every local instance its number in the list of all instances in the settings
+  const std::vector<int> &instanceNosGlobal() const;
+
+  //! the number of instances in the settings, this is the same on all ranks
+  int nInstances() const;
+
+  //! the object that advances the local instances together if the option "batchInstances" is set
+  BatchedAdvance<TimeSteppingScheme> &batchedAdvance();
+
   //! get the data that will be transferred in the operator splitting to the other term of the splitting
   //! the transfer is done by the solution_vector_mapping class
   TransferableSolutionDataType getSolutionForTransferInOperatorSplitting();
@@ -65,9 +79,13 @@ protected:
   int nInstancesComputedGlobally_; ///< number of instances that any process will compute
   std::vector<TimeSteppingScheme> instancesLocal_;   ///< the instances of the problem that are computed on the local rank
   int nInstancesLocal_;   ///< the number of local instances, i.e. the size of the instancesLocal_ vector
+  std::vector<int> instanceNosGlobal_;   ///< for every local instance the number of its config in the "instances" list, e.g. the fiber number
   
   std::shared_ptr<Partition::RankSubset> rankSubsetAllComputedInstances_;   ///< the rank nos of all computed instances of this MultipleInstances object
 
+  bool batchInstances_;   ///< if the local instances are advanced together by batchedAdvance_ instead of one after the other, set by the option "batchInstances"
+  BatchedAdvance<TimeSteppingScheme> batchedAdvance_;   ///< the object that advances all local instances together, e.g. evaluates the CellML models of all fibers in one call
+
   Data data_;  ///< the data object
 };
 
@@ -33,6 +33,9 @@ MultipleInstances(DihuContext context) :
   
   // extract the number of instances
   nInstances_ = specificSettings_.getOptionInt("nInstances", 1, PythonUtility::Positive);
+
+  // if the local instances should be advanced together, e.g. the CellML models of all fibers evaluated in one call
+  batchInstances_ = specificSettings_.getOptionBool("batchInstances", false);
    
   // parse all instance configs 
   std::vector<PythonConfig> instanceConfigs;
@@ -155,6 +158,7 @@ MultipleInstances(DihuContext context) :
 
     VLOG(1) << "create sub context for instance no " << instanceConfigNo << ", rankSubset: " << *rankSubset;
     instancesLocal_.emplace_back(context_.createSubContext(instanceConfig));
+    instanceNosGlobal_.push_back(instanceConfigNo);
   }
 
   nInstancesLocal_ = instancesLocal_.size();
@@ -165,6 +169,12 @@ void MultipleInstances<TimeSteppingScheme>::
 advanceTimeSpan()
 {
   // This method advances the simulation by the specified time span. It will be needed when this MultipleInstances object is part of a parent control element, like a coupling to 3D model.
+  if (batchInstances_)
+  {
+    batchedAdvance_.advanceTimeSpan();
+    return;
+  }
+
   for (int i = 0; i < nInstancesLocal_; i++)
   {
     instancesLocal_[i].advanceTimeSpan();
@@ -194,6 +204,17 @@ initialize()
   
   data_.setInstancesData(instancesLocal_);
 
+  // collect the local instances that will be advanced together
+  if (batchInstances_)
+  {
+    std::vector<TimeSteppingScheme *> instances;
+    for (int i = 0; i < nInstancesLocal_; i++)
+    {
+      instances.push_back(&instancesLocal_[i]);
+    }
+    batchedAdvance_.initialize(instances, instanceNosGlobal_, nInstances_);
+  }
+
 // #ifdef HAVE_PAT
   // PAT_region_end(1);    // end region "initialization", id 1
 // #endif
@@ -215,18 +236,26 @@ run()
   LOG(INFO) << "PAT_region_begin(" << label << ")";
 #endif
 
-  //#pragma omp parallel for // does not work with the python interpreter
-  for (int i = 0; i < nInstancesLocal_; i++)
+  // advance all instances together over the time spans given in their settings
+  if (batchInstances_)
+  {
+    batchedAdvance_.advanceTimeSpan();
+  }
+  else
   {
-    if (omp_get_thread_num() == 0)
+    //#pragma omp parallel for // does not work with the python interpreter
+    for (int i = 0; i < nInstancesLocal_; i++)
     {
-      std::stringstream msg;
-      msg << omp_get_thread_num() << ": running " << nInstancesLocal_ << " instances with " << omp_get_num_threads() << " OpenMP threads";
-      LOG(DEBUG) << msg.str();
+      if (omp_get_thread_num() == 0)
+      {
+        std::stringstream msg;
+        msg << omp_get_thread_num() << ": running " << nInstancesLocal_ << " instances with " << omp_get_num_threads() << " OpenMP threads";
+        LOG(DEBUG) << msg.str();
+      }
+
+      //instancesLocal_[i].reset();
+      instancesLocal_[i].run();
     }
-    
-    //instancesLocal_[i].reset();
-    instancesLocal_[i].run();
   }
   
 #ifdef HAVE_PAT
@@ -262,6 +291,34 @@ data()
   return data_;
 }
 
+template<class TimeSteppingScheme>
+std::vector<TimeSteppingScheme> &MultipleInstances<TimeSteppingScheme>::
+instancesLocal()
+{
+  return instancesLocal_;
+}
+
+template<class TimeSteppingScheme>
+const std::vector<int> &MultipleInstances<TimeSteppingScheme>::
+instanceNosGlobal() const
+{
+  return instanceNosGlobal_;
+}
+
+template<class TimeSteppingScheme>
+int MultipleInstances<TimeSteppingScheme>::
+nInstances() const
+{
+  return nInstances_;
+}
+
+template<class TimeSteppingScheme>
+BatchedAdvance<TimeSteppingScheme> &MultipleInstances<TimeSteppingScheme>::
+batchedAdvance()
+{
+  return batchedAdvance_;
+}
+
 template<class TimeSteppingScheme>
 void MultipleInstances<TimeSteppingScheme>::
 reset()
@@ -19,12 +19,18 @@ namespace Control
 
 std::map<std::string, PerformanceMeasurement::Measurement> PerformanceMeasurement::measurements_;
 std::map<std::string,std::string> PerformanceMeasurement::parameters_;
+std::map<std::string, PerformanceMeasurement::Sum> PerformanceMeasurement::sums_;
 
 PerformanceMeasurement::Measurement::Measurement() :
   start(0.0), totalDuration(0.0), nTimeSpans(0), totalError(0.0), nErrors(0)
 {
 }
 
+PerformanceMeasurement::Sum::Sum() :
+  totalNumber(0), nNumbers(0)
+{
+}
+
 void PerformanceMeasurement::start(std::string name)
 {
   std::map<std::string, Measurement>::iterator iter = measurements_.find(name);
@@ -60,6 +66,13 @@ void PerformanceMeasurement::stop(std::string name, int numberAccumulated)
   }
 }
 
+void PerformanceMeasurement::countNumber(std::string name, int number)
+{
+  Sum &sum = sums_[name];
+  sum.totalNumber += number;
+  sum.nNumbers++;
+}
+
 void PerformanceMeasurement::writeLogFile(std::string logFileName)
 {
   //LOG(DEBUG) << "PerformanceMeasurement::writeLogFile \"" << logFileName;
@@ -93,6 +106,12 @@ void PerformanceMeasurement::writeLogFile(std::string logFileName)
   {
     header << measurement.first << ";n;";
   }
+
+  // write names of sums
+  for (std::pair<std::string, Sum> sum : sums_)
+  {
+    header << sum.first << ";n;";
+  }
   header << std::endl;
 
   // compose data
@@ -120,6 +139,13 @@ void PerformanceMeasurement::writeLogFile(std::string logFileName)
     data << measurement.second.totalDuration << ";"
     << measurement.second.nTimeSpans << ";";
   }
+
+  // write sums
+  for (std::pair<std::string, Sum> sum : sums_)
+  {
+    data << sum.second.totalNumber << ";"
+    << sum.second.nNumbers << ";";
+  }
   data << std::endl;
 
   // check if header has to be added to file
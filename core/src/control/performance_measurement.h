@@ -21,6 +21,9 @@ public:
   //! stop timing measurement for a given keyword, the counter of number of time spans is increased by numberAccumulated
   static void stop(std::string name, int numberAccumulated=1);
 
+  //! add a number, e.g. a number of solver iterations, to the sum stored under name, the counter of summands is increased by one
+  static void countNumber(std::string name, int number);
+
   //! compute the mean magnitude of the given error vector or matrix and store it under name
   template<typename T>
   static void measureError(std::string name, T differenceVector);
@@ -50,8 +53,18 @@ private:
     int nErrors;        ///< number of summands of totalError
   };
 
+  struct Sum
+  {
+    //! constructor
+    Sum();
+
+    long long totalNumber;   ///< sum of all counted numbers
+    int nNumbers;            ///< number of summands of totalNumber
+  };
+
   static std::map<std::string, Measurement> measurements_;   ///< the currently stored measurements
   static std::map<std::string,std::string> parameters_;   ///< arbitrary parameters that will be stored in the log
+  static std::map<std::string, Sum> sums_;   ///< the currently stored sums of counted numbers
 
 
 };
@@ -3,6 +3,50 @@
 namespace FieldVariable
 {
 
+template<typename FunctionSpaceType>
+const typename FieldVariableVector<FunctionSpaceType,1>::NodalBasisTables &FieldVariableVector<FunctionSpaceType,1>::
+nodalBasisTables()
+{
+  // the initialization of a function-local static variable is done only once and is thread-safe
+  static const NodalBasisTables tables = computeNodalBasisTables();
+  return tables;
+}
+
+template<typename FunctionSpaceType>
+typename FieldVariableVector<FunctionSpaceType,1>::NodalBasisTables FieldVariableVector<FunctionSpaceType,1>::
+computeNodalBasisTables()
+{
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+  const int D = FunctionSpaceType::dim();
+  typedef typename FunctionSpaceType::BasisFunction BasisFunctionType;
+
+  // number of 1D basis functions, number of 1D dofs per node (1 for Lagrange, 2 for Hermite) and number of nodes per coordinate direction
+  const int nDofsPerBasis = BasisFunctionType::nDofsPerBasis();
+  const int nDofsPerNode1D = BasisFunctionType::nDofsPerNode();
+  const int nNodes1D = nDofsPerBasis / nDofsPerNode1D;
+
+  NodalBasisTables tables;
+  for (int nodalDofIndex = 0; nodalDofIndex < nDofsPerElement; nodalDofIndex++)
+  {
+    // set xi to the position of the node of the dof, the dof ordering is like in FunctionSpaceFunction, x fastest
+    std::array<double,D> xi;
+    int remainder = nodalDofIndex;
+    for (int direction = 0; direction < D; direction++)
+    {
+      const int basisFunctionIndex1D = remainder % nDofsPerBasis;
+      remainder /= nDofsPerBasis;
+
+      xi[direction] = double(basisFunctionIndex1D / nDofsPerNode1D) / (nNodes1D - 1);
+    }
+
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      tables.gradPhi[nodalDofIndex][dofIndex] = FunctionSpaceType::gradPhi(dofIndex, xi);
+    }
+  }
+  return tables;
+}
+
 //! compute the gradient field
 template<typename FunctionSpaceType>
 void FieldVariableVector<FunctionSpaceType,1>::
@@ -22,98 +66,112 @@ computeGradientField(std::shared_ptr<FieldVariable<FunctionSpaceType, FunctionSp
   const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
   const int D = FunctionSpaceType::dim();
 
+  const element_no_t nElements = this->functionSpace_->nElementsLocal();
   const dof_no_t nDofsWithGhosts = this->functionSpace_->nDofsLocalWithGhosts();
-  std::vector<int> nSummands(nDofsWithGhosts, 0);   ///< the number of elements that are adjacent to the node
 
-  // count number evaluations for every dof
-  // loop over elements
-  for (element_no_t elementNo = 0; elementNo < this->functionSpace_->nElementsLocal(); elementNo++)
-  {
-    // get local dof nos of this element
-    std::array<dof_no_t,nDofsPerElement> elementDofs = this->functionSpace_->getElementDofNosLocal(elementNo);
+  // the derivatives of all basis functions at the nodes of the element, these are the same for every element
+  const NodalBasisTables &tables = nodalBasisTables();
 
-    // loop over dofs in element, where to compute the gradient
-    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
-    {
-      dof_no_t dofNo = elementDofs[dofIndex];
+  // gather the geometry of all elements once, then getElementGeometry does not modify the function space and can be used by multiple threads
+  this->functionSpace_->updateElementGeometryCache();
 
-      // increase counter of number of summands for that dof
-      nSummands[dofNo]++;
-    }
-  }
+  // access the local values including ghosts directly instead of by getElementValues, which would call VecGetValues for every element
+  PetscErrorCode ierr;
+  const double *solutionData;
+  ierr = VecGetArrayRead(this->values_->valuesLocal(0), &solutionData); CHKERRV(ierr);
 
-  // compute gradient value divided by number of evaluations
-  // loop over elements
-  for (element_no_t elementNo = 0; elementNo < this->functionSpace_->nElementsLocal(); elementNo++)
+  // Compute the gradient at every dof of every element, as continuous to the element (gradients have discontinuities between elements at dofs).
+  // The elements are independent and are computed thread-parallel, the results are stored per element and summed up afterwards, this avoids races at shared dofs.
+  // The jacobian is computed with the same table of basis function derivatives at the nodes, from the geometry values.
+  std::vector<std::array<VecD<D>,nDofsPerElement>> elementGradients(nElements);
+
+  #pragma omp parallel for
+  for (element_no_t elementNo = 0; elementNo < nElements; elementNo++)
   {
     // get local dof nos of this element
     std::array<dof_no_t,nDofsPerElement> elementDofs = this->functionSpace_->getElementDofNosLocal(elementNo);
 
-    // compute gradient at every dof, as continuous to current element (gradients have discontinuities between elements at dofs)
     std::array<double,nDofsPerElement> solutionValues;
-    this->getElementValues(elementNo, solutionValues);
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      solutionValues[dofIndex] = solutionData[elementDofs[dofIndex]];
+    }
 
     // get geometry field (which are the node positions for Lagrange basis and node positions and derivatives for Hermite)
     std::array<Vec3,nDofsPerElement> geometryValues;
     this->functionSpace_->getElementGeometry(elementNo, geometryValues);
 
-    std::array<double,D> xi;
-
     // loop over dofs in element, where to compute the gradient
-    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    for (int nodalDofIndex = 0; nodalDofIndex < nDofsPerElement; nodalDofIndex++)
     {
-      // set xi to dofIndex
-      for (int i = 0; i < D; i++)
+      const std::array<std::array<double,D>,nDofsPerElement> &gradPhi = tables.gradPhi[nodalDofIndex];
+
+      // compute the gradient of the solution in parameter space and the jacobian of the parameter space to world space mapping in one pass over the dofs,
+      // jacobianParameterSpace[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
+      VecD<D> gradientParameterSpace{};
+      Tensor2<D> jacobianParameterSpace{};
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
       {
-        if (i == 0)
-          xi[i] = double(dofIndex % 2);
-        else if (i == 1)
-          xi[i] = double((dofIndex % 4) / 2);
-        else if (i == 2)
-          xi[i] = double(dofIndex / 4);
+        for (int k = 0; k < D; k++)
+        {
+          gradientParameterSpace[k] += gradPhi[dofIndex][k] * solutionValues[dofIndex];
+          for (int rowIdx = 0; rowIdx < D; rowIdx++)
+          {
+            jacobianParameterSpace[k][rowIdx] += gradPhi[dofIndex][k] * geometryValues[dofIndex][rowIdx];
+          }
+        }
       }
 
-      VLOG(2) << "element " << elementNo << " dofIndex " << dofIndex << ", xi " << xi << " g:" << geometryValues;
-
-      // compute the 3xD jacobian of the parameter space to world space mapping
-      Tensor2<D> jacobianParameterSpace = MathUtility::transformToDxD<D,D>(FunctionSpaceType::computeJacobian(geometryValues, xi));
       double jacobianDeterminant;
       Tensor2<D> inverseJacobianParameterSpace = MathUtility::computeInverse<D>(jacobianParameterSpace, jacobianDeterminant);
 
-      std::array<double,D> gradPhiWorldSpace = this->functionSpace_->interpolateGradientInElement(solutionValues, inverseJacobianParameterSpace, xi);
-
-      dof_no_t dofNo = elementDofs[dofIndex];
-
-      VLOG(2) << "   local dof " << dofNo << ", add value " << gradPhiWorldSpace;
-
-      gradPhiWorldSpace /= nSummands[dofNo];
-
-      int rankNo;
-      MPIUtility::handleReturnValue (MPI_Comm_rank(MPI_COMM_WORLD, &rankNo));
-
-      // add value to gradient field variable
-      if (VLOG_IS_ON(2))
+      // transform the gradient from parameter space to world space,
+      // inverseJacobianParameterSpace[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
+      VecD<D> &gradientWorldSpace = elementGradients[elementNo][nodalDofIndex];
+      for (int direction = 0; direction < D; direction++)
       {
-        if ((rankNo == 0 && dofNo == 150) || (rankNo == 1 && dofNo == 0))
+        gradientWorldSpace[direction] = 0.0;
+        for (int k = 0; k < D; k++)
         {
-          LOG(DEBUG) << "dofNo " << dofNo << " gradPhiWorldSpace: " << gradPhiWorldSpace << ", nSummands[dofNo]: " << nSummands[dofNo]
-            << ",geometryValues: " << geometryValues << ", for this dof: " << geometryValues[dofIndex];
-          LOG(DEBUG) << "solutionValues: " << solutionValues[dofIndex] << ", all: " << solutionValues;
+          gradientWorldSpace[direction] += gradientParameterSpace[k] * inverseJacobianParameterSpace[direction][k];
         }
       }
+    }  // nodalDofIndex
+  }  // elementNo
 
-      gradientField->setValue(dofNo, gradPhiWorldSpace, ADD_VALUES);
-      //VecD<D> test({1.0 + 0.1*(1+rankNo)});
-      //LOG(DEBUG) << "test: " << test;
-      //gradientField->setValue(dofNo, test, ADD_VALUES);
+  ierr = VecRestoreArrayRead(this->values_->valuesLocal(0), &solutionData); CHKERRV(ierr);
 
-    }  // dofIndex
-  }  // elementNo
+  // sum up the contributions of the elements at the dofs and count the number of adjacent elements for every dof
+  std::vector<VecD<D>> gradientSum(nDofsWithGhosts, VecD<D>{});
+  std::vector<int> nSummands(nDofsWithGhosts, 0);   ///< the number of elements that are adjacent to the node
 
-  gradientField->finishGhostManipulation();
-  //gradientField->setRepresentationLocal();
+  for (element_no_t elementNo = 0; elementNo < nElements; elementNo++)
+  {
+    std::array<dof_no_t,nDofsPerElement> elementDofs = this->functionSpace_->getElementDofNosLocal(elementNo);
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      const dof_no_t dofNo = elementDofs[dofIndex];
+      gradientSum[dofNo] += elementGradients[elementNo][dofIndex];
+      nSummands[dofNo]++;
+    }
+  }
 
-  //LOG(DEBUG) << "gradientField: " << *gradientField;
+  // write the averaged gradient directly to the local vectors of the gradient field, the contributions of ghost dofs are added to the owning rank by finishGhostManipulation
+  for (int componentNo = 0; componentNo < D; componentNo++)
+  {
+    double *gradientData;
+    ierr = VecGetArray(gradientField->valuesLocal(componentNo), &gradientData); CHKERRV(ierr);
+
+    for (dof_no_t dofNo = 0; dofNo < nDofsWithGhosts; dofNo++)
+    {
+      if (nSummands[dofNo] > 0)
+        gradientData[dofNo] += gradientSum[dofNo][componentNo] / nSummands[dofNo];
+    }
+
+    ierr = VecRestoreArray(gradientField->valuesLocal(componentNo), &gradientData); CHKERRV(ierr);
+  }
+
+  gradientField->finishGhostManipulation();
 }
 
 } // namespace
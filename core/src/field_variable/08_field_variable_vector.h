@@ -31,8 +31,23 @@ public:
   using FieldVariableSetGet<FunctionSpaceType,1>::FieldVariableSetGet;
 
   //! fill the gradient field with the gradient values in world coordinates of this field variable. This is only possible for scalar fields.
+  //! At every dof the gradients of the adjacent elements are averaged. The elements are processed thread-parallel.
   void computeGradientField(std::shared_ptr<FieldVariable<FunctionSpaceType, FunctionSpaceType::dim()>> gradientField);
 
+protected:
+
+  /** The derivatives of all basis functions of an element evaluated at the nodes of the element
+   */
+  struct NodalBasisTables
+  {
+    std::array<std::array<std::array<double,FunctionSpaceType::dim()>,FunctionSpaceType::nDofsPerElement()>,FunctionSpaceType::nDofsPerElement()> gradPhi;  ///< gradPhi[nodalDofIndex][dofIndex] = gradient of phi_dofIndex w.r.t. xi at the node of nodalDofIndex
+  };
+
+  //! get the tables of basis function derivatives at the nodes, they are computed on the first call
+  static const NodalBasisTables &nodalBasisTables();
+
+  //! compute the tables of basis function derivatives at the nodes
+  static NodalBasisTables computeNodalBasisTables();
 };
 
 } // namespace
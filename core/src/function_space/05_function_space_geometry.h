@@ -3,6 +3,7 @@
 #include <Python.h>  // has to be the first included header
 
 #include <array>
+#include <vector>
 #include "control/types.h"
 
 #include "function_space/04_function_space_numbers_structured.h"
@@ -73,15 +74,36 @@ public:
   //! return the geometry field entry (node position for Lagrange elements) of a specific dof
   Vec3 getGeometry(node_no_t dofGlobalNo) const;
 
-  //! get all geometry entries for an element
+  //! get all geometry entries for an element, the values are taken from the element geometry cache which is refreshed when the geometry field has changed
   void getElementGeometry(element_no_t elementNo, std::array<Vec3, FunctionSpaceBaseDim<MeshType::dim(),BasisFunctionType>::nDofsPerElement()> &values);
 
+  //! fill all outdated entries of the element geometry cache. Afterwards getElementGeometry only reads from the cache until the geometry field is changed again,
+  //! therefore it can then be called concurrently from multiple threads.
+  void updateElementGeometryCache();
+
+  //! get the bounding boxes of all local elements, boundingBoxes[elementNo] = {minimum corner, maximum corner}.
+  //! The geometry is sampled at xi = 0, 0.5, 1 in every coordinate direction, therefore this also works for Hermite and quadratic elements.
+  const std::vector<std::array<Vec3,2>> &elementBoundingBoxes();
+
+  //! get a number that changes whenever the values of the geometry field are modified, this can be used to detect that data derived from the geometry is outdated
+  PetscObjectState geometryState();
+
   //! return the internal geometry field variable
   GeometryFieldType &geometryField();
 
   //! if the geometry field is set
   bool hasGeometryField();
 
+protected:
+
+  //! check if the geometry field has changed since the element geometry cache was filled, if so, mark all entries of the cache as outdated
+  void checkElementGeometryCache();
+
+  std::vector<std::array<Vec3, FunctionSpaceBaseDim<MeshType::dim(),BasisFunctionType>::nDofsPerElement()>> elementGeometryCache_;  ///< the geometry field values of all local elements in contiguous memory, an entry is filled when the element is accessed for the first time after the geometry has changed
+  std::vector<char> elementGeometryCacheIsValid_;       ///< for every local element if the entry in elementGeometryCache_ is up to date
+  std::vector<std::array<Vec3,2>> elementBoundingBoxes_;   ///< the bounding boxes of all local elements, computed from elementGeometryCache_
+  bool elementBoundingBoxesAreValid_ = false;           ///< if elementBoundingBoxes_ is up to date
+  PetscObjectState elementGeometryCacheState_ = -1;     ///< the value of geometryState() for which the valid entries in the cache were computed
 };
 
 }  // namespace
@@ -1,6 +1,7 @@
 #include "function_space/05_function_space_geometry.h"
 
 #include "easylogging++.h"
+#include "utility/vector_operators.h"
 
 namespace FunctionSpace
 {
@@ -27,7 +28,129 @@ getElementGeometry(element_no_t elementNo, std::array<Vec3, FunctionSpaceBaseDim
     LOG(ERROR) << "FunctionSpace::getElementGeometry elementNo: " << elementNo << ", nElementsLocal: " << this->nElementsLocal();
   assert (elementNo < this->nElementsLocal());
 
-  this->geometryField_->getElementValues(elementNo, values);
+  // the geometry of deformable meshes changes only rarely (e.g. once per coupling step), but it is read many times by assembly, findPosition and gradient computation,
+  // therefore the values are gathered from the geometry field only once after every change
+  checkElementGeometryCache();
+
+  if (!elementGeometryCacheIsValid_[elementNo])
+  {
+    this->geometryField_->getElementValues(elementNo, elementGeometryCache_[elementNo]);
+    elementGeometryCacheIsValid_[elementNo] = true;
+  }
+
+  values = elementGeometryCache_[elementNo];
+}
+
+template<typename MeshType,typename BasisFunctionType,typename DummyForTraits>
+void FunctionSpaceGeometry<MeshType,BasisFunctionType,DummyForTraits>::
+checkElementGeometryCache()
+{
+  const element_no_t nElements = this->nElementsLocal();
+  const PetscObjectState state = geometryState();
+
+  if (state == elementGeometryCacheState_ && (element_no_t)elementGeometryCache_.size() == nElements)
+    return;
+
+  VLOG(1) << "geometry field has changed (state " << elementGeometryCacheState_ << " -> " << state << "), refresh element geometry cache";
+
+  // mark all entries as outdated, they will be refreshed when they are accessed
+  elementGeometryCache_.resize(nElements);
+  elementGeometryCacheIsValid_.assign(nElements, false);
+  elementBoundingBoxesAreValid_ = false;
+  elementGeometryCacheState_ = state;
+}
+
+template<typename MeshType,typename BasisFunctionType,typename DummyForTraits>
+void FunctionSpaceGeometry<MeshType,BasisFunctionType,DummyForTraits>::
+updateElementGeometryCache()
+{
+  assert (this->geometryField_);
+  checkElementGeometryCache();
+
+  const element_no_t nElements = this->nElementsLocal();
+  for (element_no_t elementNo = 0; elementNo < nElements; elementNo++)
+  {
+    if (!elementGeometryCacheIsValid_[elementNo])
+    {
+      this->geometryField_->getElementValues(elementNo, elementGeometryCache_[elementNo]);
+      elementGeometryCacheIsValid_[elementNo] = true;
+    }
+  }
+
+  // filling the cache can change the representation of the geometry field and with it its state, the values are still the same
+  elementGeometryCacheState_ = geometryState();
+}
+
+template<typename MeshType,typename BasisFunctionType,typename DummyForTraits>
+const std::vector<std::array<Vec3,2>> &FunctionSpaceGeometry<MeshType,BasisFunctionType,DummyForTraits>::
+elementBoundingBoxes()
+{
+  const int D = MeshType::dim();
+  const int nDofsPerElement = FunctionSpaceBaseDim<MeshType::dim(),BasisFunctionType>::nDofsPerElement();
+
+  checkElementGeometryCache();
+
+  if (elementBoundingBoxesAreValid_)
+    return elementBoundingBoxes_;
+
+  // number of sampling points of the geometry per coordinate direction in an element, i.e. at xi = 0, 0.5, 1
+  const int nSamplingPoints1D = 3;
+  int nSamplingPoints = 1;
+  for (int i = 0; i < D; i++)
+    nSamplingPoints *= nSamplingPoints1D;
+
+  const element_no_t nElements = this->nElementsLocal();
+  elementBoundingBoxes_.resize(nElements);
+
+  std::array<Vec3,nDofsPerElement> geometryValues;
+  for (element_no_t elementNo = 0; elementNo < nElements; elementNo++)
+  {
+    getElementGeometry(elementNo, geometryValues);
+
+    std::array<Vec3,2> &boundingBox = elementBoundingBoxes_[elementNo];
+    for (int samplingPointNo = 0; samplingPointNo < nSamplingPoints; samplingPointNo++)
+    {
+      // compute xi of the sampling point
+      std::array<double,D> xi;
+      int index = samplingPointNo;
+      for (int i = 0; i < D; i++)
+      {
+        xi[i] = double(index % nSamplingPoints1D) / (nSamplingPoints1D - 1);
+        index /= nSamplingPoints1D;
+      }
+
+      // interpolate the geometry at xi
+      Vec3 position({0.0, 0.0, 0.0});
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      {
+        position += FunctionSpaceFunction<MeshType,BasisFunctionType>::phi(dofIndex, xi) * geometryValues[dofIndex];
+      }
+
+      for (int i = 0; i < 3; i++)
+      {
+        if (samplingPointNo == 0 || position[i] < boundingBox[0][i])
+          boundingBox[0][i] = position[i];
+        if (samplingPointNo == 0 || position[i] > boundingBox[1][i])
+          boundingBox[1][i] = position[i];
+      }
+    }
+  }
+
+  elementBoundingBoxesAreValid_ = true;
+  return elementBoundingBoxes_;
+}
+
+template<typename MeshType,typename BasisFunctionType,typename DummyForTraits>
+PetscObjectState FunctionSpaceGeometry<MeshType,BasisFunctionType,DummyForTraits>::
+geometryState()
+{
+  assert (this->geometryField_);
+
+  // the geometry field of StructuredRegularFixed meshes has no values vector, the geometry is computed from the mesh width and does not change
+  if (!this->geometryField_->partitionedPetscVec())
+    return 0;
+
+  return this->geometryField_->partitionedPetscVec()->valuesState();
 }
 
 template<typename MeshType,typename BasisFunctionType,typename DummyForTraits>
@@ -4,6 +4,7 @@
 
 #include "function_space/08_function_space_nodes.h"
 #include "function_space/09_function_space_structured_check_neighbouring_elements.h"
+#include "function_space/element_search_grid.h"
 
 namespace FunctionSpace
 {
@@ -50,6 +51,12 @@ public:
   //! check if the point lies inside the element, if yes, return true and set xi to the value of the point, defined in 11_function_space_xi.h
   virtual bool pointIsInElement(Vec3 point, element_no_t elementNo, std::array<double,D> &xi) = 0;
 
+  //! mark the element search grid as outdated, such that it is rebuilt on the next call to findPosition. This has to be called after the geometry field has been changed, e.g. by updateGeometryActual of solid mechanics. Changes through PETSc are additionally detected by geometryState().
+  void invalidateElementSearchGrid();
+
+protected:
+
+  ElementSearchGrid elementSearchGrid_;     ///< uniform grid over the bounding boxes of the local elements, used by findPosition if the point is not in the start element
 };
 
 
@@ -27,23 +27,19 @@ findPosition(Vec3 point, element_no_t &elementNo, int &ghostMeshNo, std::array<d
     return true;
   }
 
-  // look in every element, starting at elementNo-2
-  element_no_t elementNoStart = (elementNo - 2 + nElements) % nElements;
-  element_no_t elementNoEnd = (elementNo - 3 + nElements) % nElements;
+  // search among all elements, use the element search grid to only test elements whose bounding box contains the point
+  // the grid is rebuilt if the geometry has changed since it was built, e.g. for deformable meshes in solid mechanics
+  if (!elementSearchGrid_.initialized() || elementSearchGrid_.geometryState() != this->geometryState())
+  {
+    elementSearchGrid_.template initialize<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>(this);
+  }
 
-  VLOG(3) << "elementNoStart: " << elementNoStart << ", elementNoEnd: " << elementNoEnd << ", nElements: " << nElements;
+  const std::vector<element_no_t> &candidateElements = elementSearchGrid_.candidateElements(point);
 
-  // search among all elements
-  for (element_no_t currentElementNo = elementNoStart; currentElementNo != elementNoEnd; currentElementNo++)
-  {
-    // restart with element 0
-    if (currentElementNo == nElements)
-    {
-      currentElementNo = 0;
-      if (elementNoEnd == currentElementNo)
-        break;
-    }
+  VLOG(3) << "point " << point << " has " << candidateElements.size() << " candidate elements, nElements: " << nElements;
 
+  for (element_no_t currentElementNo : candidateElements)
+  {
     if (this->pointIsInElement(point, currentElementNo, xi))
     {
       elementNo = currentElementNo;
@@ -54,5 +50,12 @@ findPosition(Vec3 point, element_no_t &elementNo, int &ghostMeshNo, std::array<d
   return false;
 }
 
+template<int D,typename BasisFunctionType>
+void FunctionSpaceFindPosition<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType,Mesh::UnstructuredDeformableOfDimension<D>>::
+invalidateElementSearchGrid()
+{
+  elementSearchGrid_.invalidate();
+}
+
 
 } // namespace
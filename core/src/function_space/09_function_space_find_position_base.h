@@ -3,6 +3,7 @@
 #include <Python.h>  // has to be the first included header
 
 #include "function_space/08_function_space_nodes.h"
+#include "function_space/element_search_grid.h"
 
 namespace FunctionSpace
 {
@@ -36,6 +37,9 @@ public:
   //! print via VLOG(1) << which ghostMesh_ variables are set
   void debugOutputGhostMeshSet();
 
+  //! mark the element search grid as outdated, such that it is rebuilt on the next call to findPosition. This has to be called after the geometry field has been changed, e.g. by updateGeometryActual of solid mechanics. Changes through PETSc are additionally detected by geometryState().
+  void invalidateElementSearchGrid();
+
 protected:
 
   //! check if the point is in a neighbouring element to elementNo on ghostMeshNo (-1=main mesh, 0-5=ghost mesh on respective face, 0=face0Minus, 1=face0Plus, etc.), return true if the element was found amoung the neighbours
@@ -43,6 +47,7 @@ protected:
   virtual bool checkNeighbouringElements(const Vec3 &point, element_no_t &elementNo, int &ghostMeshNo, std::array<double,MeshType::dim()> &xi) = 0;
 
   std::array<std::shared_ptr<FunctionSpace<MeshType,BasisFunctionType>>,6> ghostMesh_;   // neighbouring functionSpaces of the local domain, i.e. containing ghost elements, this is used by findPosition
+  ElementSearchGrid elementSearchGrid_;     ///< uniform grid over the bounding boxes of the local elements, used by findPosition if the point is not in the neighbourhood of the start element
 };
 
 }  // namespace
@@ -86,25 +86,20 @@ findPosition(Vec3 point, element_no_t &elementNo, int &ghostMeshNo, std::array<d
     }
   }
 
-  // search among all elements
+  // search among all elements, use the element search grid to only test elements whose bounding box contains the point
+  // the grid is rebuilt if the geometry has changed since it was built, e.g. for deformable meshes in solid mechanics
+  if (!elementSearchGrid_.initialized() || elementSearchGrid_.geometryState() != this->geometryState())
+  {
+    elementSearchGrid_.template initialize<MeshType,BasisFunctionType>(this);
+  }
 
-  // look in every element, starting at elementNo-2
-  element_no_t elementNoStart = (elementNo - 2 + nElements) % nElements;
-  element_no_t elementNoEnd = (elementNo - 3 + nElements) % nElements;
+  const std::vector<element_no_t> &candidateElements = elementSearchGrid_.candidateElements(point);
 
-  VLOG(3) << "elementNoStart: " << elementNoStart << ", elementNoEnd: " << elementNoEnd << ", nElements: " << nElements
+  VLOG(3) << "point " << point << " has " << candidateElements.size() << " candidate elements, nElements: " << nElements
     << "(" << this->meshPartition_->nElementsLocal(0) << "x" << this->meshPartition_->nElementsLocal(1) << "x" << this->meshPartition_->nElementsLocal(2) << ")";
 
-  for (element_no_t currentElementNo = elementNoStart; currentElementNo != elementNoEnd; currentElementNo++)
+  for (element_no_t currentElementNo : candidateElements)
   {
-    // restart with element 0
-    if (currentElementNo == nElements)
-    {
-      currentElementNo = 0;
-      if (elementNoEnd == currentElementNo)
-        break;
-    }
-
     VLOG(4) << "check element " << currentElementNo;
 
     if (this->pointIsInElement(point, currentElementNo, xi))
@@ -164,6 +159,13 @@ setGhostMesh(Mesh::face_t face, const std::shared_ptr<FunctionSpace<MeshType,Bas
   VLOG(1) << "set ghost mesh for face " << Mesh::getString((Mesh::face_t)face) << " to " << (ghostMesh == nullptr? " null" : "x");
 }
 
+template<typename MeshType, typename BasisFunctionType>
+void FunctionSpaceStructuredFindPositionBase<MeshType,BasisFunctionType>::
+invalidateElementSearchGrid()
+{
+  elementSearchGrid_.invalidate();
+}
+
 template<typename MeshType, typename BasisFunctionType>
 void FunctionSpaceStructuredFindPositionBase<MeshType,BasisFunctionType>::
 debugOutputGhostMeshSet()
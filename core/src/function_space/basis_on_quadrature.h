@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <array>
+#include "control/types.h"
+
+#include "quadrature/tensor_product.h"
+#include "utility/math_utility.h"
+
+namespace FunctionSpace
+{
+
+/** Precomputed tables of the basis functions and their derivatives at the quadrature points of a tensor product quadrature
+ *  and sum factorization kernels that apply them, for tensor product bases (Lagrange and Hermite).
+ *
+ *  The D-dimensional basis functions are products of 1D basis functions, phi_{i0 + n*i1 + n^2*i2}(xi) = phi_i0(xi0)*phi_i1(xi1)*phi_i2(xi2),
+ *  where n = nDofsPerBasis (this is the dof ordering of FunctionSpaceFunction). The quadrature points are ordered like in Quadrature::TensorProduct, x fastest.
+ *  Therefore the evaluation of a field at all quadrature points can be done direction by direction with the 1D tables (sum factorization),
+ *  this needs O(D*n^(D+1)) instead of O(n^(2D)) operations.
+ *
+ *  The tables are computed only once per (function space, quadrature) pair on first use. They are stored contiguously with the innermost index
+ *  being the one that is contracted, such that the contractions can be vectorized.
+ *
+ *  QuadratureType is the 1D quadrature, e.g. Quadrature::Gauss<3>.
+ */
+template<typename FunctionSpaceType,typename QuadratureType>
+class BasisOnQuadrature
+{
+public:
+
+  typedef Quadrature::TensorProduct<FunctionSpaceType::dim(),QuadratureType> QuadratureDD;   ///< the D-dimensional quadrature
+
+  static constexpr int D = FunctionSpaceType::dim();                                          ///< dimension of the mesh
+  static constexpr int nDofsPerBasis = FunctionSpaceType::BasisFunction::nDofsPerBasis();     ///< number of 1D basis functions
+  static constexpr int nDofsPerElement = FunctionSpaceType::nDofsPerElement();                ///< number of D-dimensional basis functions
+  static constexpr int nQuadraturePoints1D = QuadratureType::numberEvaluations();             ///< number of 1D quadrature points
+  static constexpr int nQuadraturePoints = QuadratureDD::numberEvaluations();                 ///< number of D-dimensional quadrature points
+
+  /** The precomputed tables
+   */
+  struct Tables
+  {
+    alignas(64) std::array<double,nQuadraturePoints1D*nDofsPerBasis> phi1D;          ///< phi1D[q*nDofsPerBasis + i] = phi_i(xi_q), 1D basis functions at the 1D quadrature points
+    alignas(64) std::array<double,nQuadraturePoints1D*nDofsPerBasis> dphi1D;         ///< dphi1D[q*nDofsPerBasis + i] = dphi_i/dxi(xi_q)
+    alignas(64) std::array<double,nDofsPerBasis*nQuadraturePoints1D> phi1DTransposed;  ///< phi1DTransposed[i*nQuadraturePoints1D + q] = phi_i(xi_q)
+    alignas(64) std::array<double,nDofsPerBasis*nQuadraturePoints1D> dphi1DTransposed; ///< dphi1DTransposed[i*nQuadraturePoints1D + q] = dphi_i/dxi(xi_q)
+    std::array<double,nQuadraturePoints1D> weights1D;                                  ///< the weights of the 1D quadrature
+    std::array<double,nQuadraturePoints> weights;                                      ///< the weights of the D-dimensional quadrature
+    std::array<std::array<double,D>,nQuadraturePoints> samplingPoints;                 ///< the D-dimensional quadrature points, in the order of QuadratureDD::samplingPoints()
+    alignas(64) std::array<double,nQuadraturePoints*nDofsPerElement> phi;            ///< phi[q*nDofsPerElement + dofIndex] = Phi_dofIndex(xi_q), D-dimensional basis functions at the quadrature points
+    alignas(64) std::array<std::array<double,nQuadraturePoints*nDofsPerElement>,D> dphi;  ///< dphi[k][q*nDofsPerElement + dofIndex] = dPhi_dofIndex/dxi_k(xi_q)
+  };
+
+  //! get the tables, they are computed on the first call
+  static const Tables &tables();
+
+  //! evaluate the field with the given element dof values at all quadrature points, using sum factorization.
+  //! ValueType is double for scalar fields or e.g. Vec3 for the geometry.
+  template<typename ValueType>
+  static void interpolate(const std::array<ValueType,nDofsPerElement> &dofValues, std::array<ValueType,nQuadraturePoints> &values);
+
+  //! evaluate the derivative w.r.t. xi_derivativeDirection of the field with the given element dof values at all quadrature points, using sum factorization.
+  //! For the geometry field this gives the column derivativeDirection of the jacobian at all quadrature points.
+  template<typename ValueType>
+  static void interpolateDerivative(int derivativeDirection, const std::array<ValueType,nDofsPerElement> &dofValues, std::array<ValueType,nQuadraturePoints> &values);
+
+  //! compute the integrals over the reference element of the given values at the quadrature points multiplied by every basis function,
+  //! integrals[dofIndex] = sum_q w_q * Phi_dofIndex(xi_q) * values[q], using sum factorization.
+  template<typename ValueType>
+  static void integrate(const std::array<ValueType,nQuadraturePoints> &values, std::array<ValueType,nDofsPerElement> &integrals);
+
+  //! compute the integrals over the reference element of the given values at the quadrature points multiplied by the derivative of every basis function,
+  //! integrals[dofIndex] = sum_q w_q * dPhi_dofIndex/dxi_derivativeDirection(xi_q) * values[q], using sum factorization.
+  template<typename ValueType>
+  static void integrateDerivative(int derivativeDirection, const std::array<ValueType,nQuadraturePoints> &values, std::array<ValueType,nDofsPerElement> &integrals);
+
+protected:
+
+  //! size of the temporary arrays of the sum factorization, the intermediate results have at most max(nDofsPerBasis,nQuadraturePoints1D)^D entries
+  static constexpr int nTemporaryEntries = MathUtility::pow(nDofsPerBasis > nQuadraturePoints1D? nDofsPerBasis : nQuadraturePoints1D, D);
+
+  //! compute the tables
+  static Tables computeTables();
+
+  //! apply the 1D table in one direction of the tensor, the input has layout [nAfter][nIn][nBefore], the output [nAfter][nOut][nBefore],
+  //! output[(a*nOut + o)*nBefore + b] = sum_i table[o*nIn + i] * input[(a*nIn + i)*nBefore + b]
+  template<typename ValueType>
+  static void applyInDirection(const double *table, int nIn, int nOut, int nBefore, int nAfter, const ValueType *input, ValueType *output);
+
+  //! apply the tables in all directions, tables[direction] is used for the direction, the tables have nOut x nIn entries
+  template<typename ValueType, std::size_t nInputEntries, std::size_t nOutputEntries>
+  static void applyInAllDirections(const std::array<const double *,D> &tables, int nIn, int nOut,
+                                   const std::array<ValueType,nInputEntries> &input, std::array<ValueType,nOutputEntries> &output);
+};
+
+}  // namespace
+
+#include "function_space/basis_on_quadrature.tpp"
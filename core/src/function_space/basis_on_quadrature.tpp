@@ -0,0 +1,233 @@
+#include "function_space/basis_on_quadrature.h"
+
+#include <cassert>
+
+#include "utility/vector_operators.h"
+
+namespace FunctionSpace
+{
+
+// definitions of the static members, needed in C++14 if they are odr-used
+template<typename FunctionSpaceType,typename QuadratureType>
+constexpr int BasisOnQuadrature<FunctionSpaceType,QuadratureType>::D;
+
+template<typename FunctionSpaceType,typename QuadratureType>
+constexpr int BasisOnQuadrature<FunctionSpaceType,QuadratureType>::nDofsPerBasis;
+
+template<typename FunctionSpaceType,typename QuadratureType>
+constexpr int BasisOnQuadrature<FunctionSpaceType,QuadratureType>::nDofsPerElement;
+
+template<typename FunctionSpaceType,typename QuadratureType>
+constexpr int BasisOnQuadrature<FunctionSpaceType,QuadratureType>::nQuadraturePoints1D;
+
+template<typename FunctionSpaceType,typename QuadratureType>
+constexpr int BasisOnQuadrature<FunctionSpaceType,QuadratureType>::nQuadraturePoints;
+
+template<typename FunctionSpaceType,typename QuadratureType>
+const typename BasisOnQuadrature<FunctionSpaceType,QuadratureType>::Tables &BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+tables()
+{
+  // the initialization of a function-local static variable is done only once and is thread-safe
+  static const Tables tables = computeTables();
+  return tables;
+}
+
+template<typename FunctionSpaceType,typename QuadratureType>
+typename BasisOnQuadrature<FunctionSpaceType,QuadratureType>::Tables BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+computeTables()
+{
+  typedef typename FunctionSpaceType::BasisFunction BasisFunctionType;
+
+  Tables tables;
+  std::array<double,nQuadraturePoints1D> samplingPoints1D = QuadratureType::samplingPoints();
+
+  // 1D tables
+  for (int q = 0; q < nQuadraturePoints1D; q++)
+  {
+    for (int i = 0; i < nDofsPerBasis; i++)
+    {
+      tables.phi1D[q*nDofsPerBasis + i] = BasisFunctionType::phi(i, samplingPoints1D[q]);
+      tables.dphi1D[q*nDofsPerBasis + i] = BasisFunctionType::dphi_dxi(i, samplingPoints1D[q]);
+      tables.phi1DTransposed[i*nQuadraturePoints1D + q] = tables.phi1D[q*nDofsPerBasis + i];
+      tables.dphi1DTransposed[i*nQuadraturePoints1D + q] = tables.dphi1D[q*nDofsPerBasis + i];
+    }
+  }
+
+  // the quadrature schemes do not provide their weights directly, but the integral is linear in the evaluations, so the weight of a point is the integral of its unit vector
+  for (int q = 0; q < nQuadraturePoints1D; q++)
+  {
+    std::array<double,nQuadraturePoints1D> unitVector{};
+    unitVector[q] = 1.0;
+    tables.weights1D[q] = QuadratureType::template computeIntegral<double>(unitVector);
+  }
+
+  // D-dimensional tables
+  tables.samplingPoints = QuadratureDD::samplingPoints();
+  for (int q = 0; q < nQuadraturePoints; q++)
+  {
+    // indices of the 1D quadrature points in the tensor product, x fastest
+    std::array<int,D> quadraturePointIndex1D;
+    int remainder = q;
+    for (int direction = 0; direction < D; direction++)
+    {
+      quadraturePointIndex1D[direction] = remainder % nQuadraturePoints1D;
+      remainder /= nQuadraturePoints1D;
+    }
+
+    tables.weights[q] = 1.0;
+    for (int direction = 0; direction < D; direction++)
+      tables.weights[q] *= tables.weights1D[quadraturePointIndex1D[direction]];
+
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      // indices of the 1D basis functions, like in FunctionSpaceFunction
+      std::array<int,D> basisFunctionIndex1D;
+      int dofIndexRemainder = dofIndex;
+      for (int direction = 0; direction < D; direction++)
+      {
+        basisFunctionIndex1D[direction] = dofIndexRemainder % nDofsPerBasis;
+        dofIndexRemainder /= nDofsPerBasis;
+      }
+
+      double phi = 1.0;
+      std::array<double,D> dphi;
+      dphi.fill(1.0);
+      for (int direction = 0; direction < D; direction++)
+      {
+        const int entryNo = quadraturePointIndex1D[direction]*nDofsPerBasis + basisFunctionIndex1D[direction];
+        phi *= tables.phi1D[entryNo];
+        for (int derivativeDirection = 0; derivativeDirection < D; derivativeDirection++)
+        {
+          if (derivativeDirection == direction)
+            dphi[derivativeDirection] *= tables.dphi1D[entryNo];
+          else
+            dphi[derivativeDirection] *= tables.phi1D[entryNo];
+        }
+      }
+
+      tables.phi[q*nDofsPerElement + dofIndex] = phi;
+      for (int derivativeDirection = 0; derivativeDirection < D; derivativeDirection++)
+        tables.dphi[derivativeDirection][q*nDofsPerElement + dofIndex] = dphi[derivativeDirection];
+    }
+  }
+
+  return tables;
+}
+
+template<typename FunctionSpaceType,typename QuadratureType>
+template<typename ValueType>
+void BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+applyInDirection(const double *table, int nIn, int nOut, int nBefore, int nAfter, const ValueType *input, ValueType *output)
+{
+  for (int a = 0; a < nAfter; a++)
+  {
+    for (int o = 0; o < nOut; o++)
+    {
+      ValueType *outputEntries = output + (a*nOut + o)*nBefore;
+      for (int b = 0; b < nBefore; b++)
+        outputEntries[b] = ValueType{};
+
+      // the innermost loop runs over contiguous entries and can be vectorized
+      for (int i = 0; i < nIn; i++)
+      {
+        const double factor = table[o*nIn + i];
+        const ValueType *inputEntries = input + (a*nIn + i)*nBefore;
+        for (int b = 0; b < nBefore; b++)
+          outputEntries[b] += factor * inputEntries[b];
+      }
+    }
+  }
+}
+
+template<typename FunctionSpaceType,typename QuadratureType>
+template<typename ValueType, std::size_t nInputEntries, std::size_t nOutputEntries>
+void BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+applyInAllDirections(const std::array<const double *,D> &tables, int nIn, int nOut,
+                     const std::array<ValueType,nInputEntries> &input, std::array<ValueType,nOutputEntries> &output)
+{
+  // ping-pong between two temporary buffers, after transforming direction d the tensor has nOut^(d+1)*nIn^(D-d-1) entries
+  std::array<std::array<ValueType,nTemporaryEntries>,2> buffers;
+
+  const ValueType *currentInput = input.data();
+  int nBefore = 1;
+  int nAfter = int(nInputEntries) / nIn;
+
+  for (int direction = 0; direction < D; direction++)
+  {
+    ValueType *currentOutput = (direction == D-1? output.data() : buffers[direction % 2].data());
+
+    applyInDirection(tables[direction], nIn, nOut, nBefore, nAfter, currentInput, currentOutput);
+
+    currentInput = currentOutput;
+    nBefore *= nOut;
+    nAfter /= nIn;
+  }
+}
+
+template<typename FunctionSpaceType,typename QuadratureType>
+template<typename ValueType>
+void BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+interpolate(const std::array<ValueType,nDofsPerElement> &dofValues, std::array<ValueType,nQuadraturePoints> &values)
+{
+  const Tables &tables = BasisOnQuadrature<FunctionSpaceType,QuadratureType>::tables();
+
+  std::array<const double *,D> directionTables;
+  directionTables.fill(tables.phi1D.data());
+
+  applyInAllDirections(directionTables, nDofsPerBasis, nQuadraturePoints1D, dofValues, values);
+}
+
+template<typename FunctionSpaceType,typename QuadratureType>
+template<typename ValueType>
+void BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+interpolateDerivative(int derivativeDirection, const std::array<ValueType,nDofsPerElement> &dofValues, std::array<ValueType,nQuadraturePoints> &values)
+{
+  assert(0 <= derivativeDirection && derivativeDirection < D);
+  const Tables &tables = BasisOnQuadrature<FunctionSpaceType,QuadratureType>::tables();
+
+  std::array<const double *,D> directionTables;
+  directionTables.fill(tables.phi1D.data());
+  directionTables[derivativeDirection] = tables.dphi1D.data();
+
+  applyInAllDirections(directionTables, nDofsPerBasis, nQuadraturePoints1D, dofValues, values);
+}
+
+template<typename FunctionSpaceType,typename QuadratureType>
+template<typename ValueType>
+void BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+integrate(const std::array<ValueType,nQuadraturePoints> &values, std::array<ValueType,nDofsPerElement> &integrals)
+{
+  const Tables &tables = BasisOnQuadrature<FunctionSpaceType,QuadratureType>::tables();
+
+  // multiply by the quadrature weights, then apply the transposed tables
+  std::array<ValueType,nQuadraturePoints> weightedValues;
+  for (int q = 0; q < nQuadraturePoints; q++)
+    weightedValues[q] = tables.weights[q] * values[q];
+
+  std::array<const double *,D> directionTables;
+  directionTables.fill(tables.phi1DTransposed.data());
+
+  applyInAllDirections(directionTables, nQuadraturePoints1D, nDofsPerBasis, weightedValues, integrals);
+}
+
+template<typename FunctionSpaceType,typename QuadratureType>
+template<typename ValueType>
+void BasisOnQuadrature<FunctionSpaceType,QuadratureType>::
+integrateDerivative(int derivativeDirection, const std::array<ValueType,nQuadraturePoints> &values, std::array<ValueType,nDofsPerElement> &integrals)
+{
+  assert(0 <= derivativeDirection && derivativeDirection < D);
+  const Tables &tables = BasisOnQuadrature<FunctionSpaceType,QuadratureType>::tables();
+
+  // multiply by the quadrature weights, then apply the transposed tables
+  std::array<ValueType,nQuadraturePoints> weightedValues;
+  for (int q = 0; q < nQuadraturePoints; q++)
+    weightedValues[q] = tables.weights[q] * values[q];
+
+  std::array<const double *,D> directionTables;
+  directionTables.fill(tables.phi1DTransposed.data());
+  directionTables[derivativeDirection] = tables.dphi1DTransposed.data();
+
+  applyInAllDirections(directionTables, nQuadraturePoints1D, nDofsPerBasis, weightedValues, integrals);
+}
+
+}  // namespace
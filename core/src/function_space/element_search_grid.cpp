@@ -0,0 +1,189 @@
+#include "function_space/element_search_grid.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "easylogging++.h"
+#include "utility/vector_operators.h"
+
+namespace FunctionSpace
+{
+
+ElementSearchGrid::ElementSearchGrid() :
+  initialized_(false), geometryState_(-1), nCells_{{1,1,1}}
+{
+}
+
+void ElementSearchGrid::
+initialize(const std::vector<std::array<Vec3,2>> &boundingBoxes)
+{
+  const element_no_t nElements = boundingBoxes.size();
+  boundingBoxes_ = boundingBoxes;
+
+  // enlarge the bounding boxes, because the geometry is only sampled at some points and pointIsInElement allows points slightly outside of the element.
+  // The margin is relative to the largest extent of the element and the same on every axis, such that flat elements (e.g. with a face
+  // in a coordinate plane) also get a margin in their thin direction
+  const double relativeMargin = 0.1;
+  for (std::array<Vec3,2> &boundingBox : boundingBoxes_)
+  {
+    double maximumExtent = 0.0;
+    for (int i = 0; i < 3; i++)
+      maximumExtent = std::max(maximumExtent, boundingBox[1][i] - boundingBox[0][i]);
+
+    double margin = relativeMargin*maximumExtent + 1e-12;
+    for (int i = 0; i < 3; i++)
+    {
+      boundingBox[0][i] -= margin;
+      boundingBox[1][i] += margin;
+    }
+  }
+
+  // compute bounding box of all elements
+  Vec3 gridMaximum;
+  for (int i = 0; i < 3; i++)
+  {
+    gridMinimum_[i] = 0.0;
+    gridMaximum[i] = 0.0;
+  }
+  for (element_no_t elementNo = 0; elementNo < nElements; elementNo++)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      if (elementNo == 0 || boundingBoxes_[elementNo][0][i] < gridMinimum_[i])
+        gridMinimum_[i] = boundingBoxes_[elementNo][0][i];
+      if (elementNo == 0 || boundingBoxes_[elementNo][1][i] > gridMaximum[i])
+        gridMaximum[i] = boundingBoxes_[elementNo][1][i];
+    }
+  }
+
+  // determine the number of cells such that there is about one element per cell, directions with no extent (e.g. for 1D and 2D meshes) get a single cell
+  Vec3 extent = gridMaximum - gridMinimum_;
+  double maximumExtent = std::max(extent[0], std::max(extent[1], extent[2]));
+
+  int nDirectionsWithExtent = 0;
+  double product = 1.0;
+  for (int i = 0; i < 3; i++)
+  {
+    if (extent[i] > 1e-8*maximumExtent)
+    {
+      nDirectionsWithExtent++;
+      product *= extent[i];
+    }
+  }
+
+  double targetCellSize = 0.0;
+  if (nDirectionsWithExtent > 0 && nElements > 0)
+    targetCellSize = std::pow(product / nElements, 1.0/nDirectionsWithExtent);
+
+  for (int i = 0; i < 3; i++)
+  {
+    nCells_[i] = 1;
+    if (targetCellSize > 0 && extent[i] > 1e-8*maximumExtent)
+      nCells_[i] = std::max(1, std::min(nElements, (element_no_t)std::round(extent[i] / targetCellSize)));
+    cellSize_[i] = std::max(extent[i] / nCells_[i], 1e-15);
+  }
+  const int nCellsTotal = nCells_[0]*nCells_[1]*nCells_[2];
+
+  // count the elements per cell, then fill the cells (compressed storage)
+  cellStart_.assign(nCellsTotal+1, 0);
+  for (int pass = 0; pass < 2; pass++)
+  {
+    std::vector<int> cellPosition;
+    if (pass == 1)
+    {
+      // compute the start index of every cell from the counts
+      for (int cellNo = 0; cellNo < nCellsTotal; cellNo++)
+        cellStart_[cellNo+1] += cellStart_[cellNo];
+      cellElements_.resize(cellStart_[nCellsTotal]);
+      cellPosition.assign(cellStart_.begin(), cellStart_.end()-1);
+    }
+
+    for (element_no_t elementNo = 0; elementNo < nElements; elementNo++)
+    {
+      std::array<int,3> begin, end;
+      for (int i = 0; i < 3; i++)
+      {
+        begin[i] = cellIndex(boundingBoxes_[elementNo][0][i], i);
+        end[i] = cellIndex(boundingBoxes_[elementNo][1][i], i) + 1;
+      }
+
+      for (int z = begin[2]; z < end[2]; z++)
+      {
+        for (int y = begin[1]; y < end[1]; y++)
+        {
+          for (int x = begin[0]; x < end[0]; x++)
+          {
+            int cellNo = (z*nCells_[1] + y)*nCells_[0] + x;
+            if (pass == 0)
+              cellStart_[cellNo+1]++;
+            else
+              cellElements_[cellPosition[cellNo]++] = elementNo;
+          }
+        }
+      }
+    }
+  }
+
+  VLOG(1) << "ElementSearchGrid for " << nElements << " elements, " << nCells_[0] << "x" << nCells_[1] << "x" << nCells_[2]
+    << " cells, " << cellElements_.size() << " entries";
+
+  initialized_ = true;
+}
+
+bool ElementSearchGrid::
+initialized() const
+{
+  return initialized_;
+}
+
+void ElementSearchGrid::
+invalidate()
+{
+  initialized_ = false;
+}
+
+PetscObjectState ElementSearchGrid::
+geometryState() const
+{
+  return geometryState_;
+}
+
+int ElementSearchGrid::
+cellIndex(double coordinate, int coordinateDirection) const
+{
+  int index = (int)std::floor((coordinate - gridMinimum_[coordinateDirection]) / cellSize_[coordinateDirection]);
+  return std::max(0, std::min(nCells_[coordinateDirection]-1, index));
+}
+
+const std::vector<element_no_t> &ElementSearchGrid::
+candidateElements(const Vec3 &point)
+{
+  candidateElements_.clear();
+
+  // the point is outside of the grid
+  for (int i = 0; i < 3; i++)
+  {
+    if (point[i] < gridMinimum_[i] || point[i] > gridMinimum_[i] + nCells_[i]*cellSize_[i])
+      return candidateElements_;
+  }
+
+  int cellNo = (cellIndex(point[2],2)*nCells_[1] + cellIndex(point[1],1))*nCells_[0] + cellIndex(point[0],0);
+
+  // collect the elements of the cell whose bounding box contains the point
+  for (int i = cellStart_[cellNo]; i < cellStart_[cellNo+1]; i++)
+  {
+    element_no_t elementNo = cellElements_[i];
+    const std::array<Vec3,2> &boundingBox = boundingBoxes_[elementNo];
+
+    if (boundingBox[0][0] <= point[0] && point[0] <= boundingBox[1][0]
+      && boundingBox[0][1] <= point[1] && point[1] <= boundingBox[1][1]
+      && boundingBox[0][2] <= point[2] && point[2] <= boundingBox[1][2])
+    {
+      candidateElements_.push_back(elementNo);
+    }
+  }
+
+  return candidateElements_;
+}
+
+}  // namespace
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <array>
+#include <vector>
+#include "control/types.h"
+
+namespace FunctionSpace
+{
+
+/** A uniform grid over the bounding boxes of the local elements, used by findPosition to find the elements that may contain a point
+ *  without testing all elements. Every grid cell stores the elements whose bounding box overlaps the cell.
+ *  The bounding boxes are taken from the element geometry cache of the function space, they are computed by sampling the geometry in the element, therefore this also works for Hermite and quadratic elements.
+ *  The grid stores the geometry state of the function space it was built for, it has to be rebuilt when the geometry of the mesh has changed.
+ */
+class ElementSearchGrid
+{
+public:
+
+  //! constructor
+  ElementSearchGrid();
+
+  //! build the grid from the bounding boxes of all local elements of the function space
+  template<typename MeshType,typename BasisFunctionType,typename FunctionSpaceType>
+  void initialize(FunctionSpaceType *functionSpace);
+
+  //! build the grid from the given bounding boxes, boundingBoxes[elementNo] = {minimum corner, maximum corner}
+  void initialize(const std::vector<std::array<Vec3,2>> &boundingBoxes);
+
+  //! if the grid has been built and is valid for the current geometry
+  bool initialized() const;
+
+  //! mark the grid as outdated, e.g. after the geometry has changed, it will be rebuilt on the next use
+  void invalidate();
+
+  //! get the geometry state of the function space (FunctionSpaceGeometry::geometryState()) for which the grid was built
+  PetscObjectState geometryState() const;
+
+  //! get the local element nos whose bounding box contains the point, the returned vector is valid until the next call
+  const std::vector<element_no_t> &candidateElements(const Vec3 &point);
+
+protected:
+
+  //! get the index of the grid cell in the given coordinate direction that contains the coordinate, clamped to the grid
+  int cellIndex(double coordinate, int coordinateDirection) const;
+
+  bool initialized_;                                  ///< if the grid has been built
+  PetscObjectState geometryState_;                    ///< the geometry state of the function space for which the grid was built
+  std::vector<std::array<Vec3,2>> boundingBoxes_;     ///< the (slightly enlarged) bounding box of every element, {minimum corner, maximum corner}
+  Vec3 gridMinimum_;                                  ///< the minimum corner of the bounding box of all elements
+  Vec3 cellSize_;                                     ///< the extent of a grid cell in every coordinate direction
+  std::array<int,3> nCells_;                          ///< the number of grid cells in every coordinate direction
+  std::vector<int> cellStart_;                        ///< cellElements_[cellStart_[cellNo]] until cellElements_[cellStart_[cellNo+1]-1] are the elements of cell cellNo
+  std::vector<element_no_t> cellElements_;            ///< the element nos of all cells, cell by cell
+  std::vector<element_no_t> candidateElements_;       ///< temporary vector that holds the result of candidateElements
+};
+
+}  // namespace
+
+#include "function_space/element_search_grid.tpp"
@@ -0,0 +1,17 @@
+#include "function_space/element_search_grid.h"
+
+#include "easylogging++.h"
+
+namespace FunctionSpace
+{
+
+template<typename MeshType,typename BasisFunctionType,typename FunctionSpaceType>
+void ElementSearchGrid::
+initialize(FunctionSpaceType *functionSpace)
+{
+  // the bounding boxes are computed from the cached element geometry of the function space
+  initialize(functionSpace->elementBoundingBoxes());
+  geometryState_ = functionSpace->geometryState();
+}
+
+}  // namespace
@@ -1,43 +1,118 @@
 #pragma once
 
 #include <Python.h>  // has to be the first included header
+#include <petscmat.h>
+#include <array>
+#include <vector>
+#include <type_traits>
+
+#include "control/types.h"
+
+namespace FieldVariable
+{
+template<typename FunctionSpaceType,int nComponents>
+class FieldVariable;
+}
 
 namespace Mesh
 {
 
-class MappingBetweenMeshesBase{};
+/** Base class of all mappings between meshes, such that mappings with different function space types can be stored together
+ */
+class MappingBetweenMeshesBase
+{
+public:
+  //! virtual destructor, such that the derived mapping can be obtained by dynamic_pointer_cast
+  virtual ~MappingBetweenMeshesBase() {}
+};
 
 /**
  * This is a mapping between two meshes, e.g. one 1D fiber mesh and one 3D mesh. The mapping is from source mesh to target mesh.
+ * It is stored as a parallel sparse matrix with rows for the target dofs and columns for the source dofs, such that the mapping is a single MatMult.
+ *
+ * If the source mesh has a lower dimension than the target mesh (e.g. fiber -> 3D), the source dofs are located in the target mesh and their values are
+ * distributed to the dofs of the containing target element, weighted with the basis functions. Every target dof gets the weighted average of its contributions.
+ * Otherwise (e.g. 3D -> fiber), the target dofs are located in the source mesh and the values are interpolated.
+ *
+ * Points that are not inside the local domain of the containing mesh are sent to the ranks whose domain bounding box contains them.
+ * The mapping matrix and all communication use the communicator of the containing mesh (the mesh of higher dimension, or the source mesh for equal dimensions).
+ * The other mesh can be partitioned on a subset of its ranks, e.g. a fiber that lives on one rank of a 3D mesh on multiple ranks.
+ * The constructor and the mappings are collective on all ranks of the containing mesh, on ranks that do not have a part of the other mesh,
+ * its function space is nullptr and mapWithoutSource or mapWithoutTarget is called instead of map.
+ * For Hermite meshes only the nodal values are mapped to, the derivative dofs of the target are set to 0.
+ *
+ * The mapping is used by the transfers of the operator splittings between field variables on different meshes, if it is specified under "MappingsBetweenMeshes".
  */
 template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
 class MappingBetweenMeshes : public MappingBetweenMeshesBase
 {
 public:
 
-  //! constructor, the function spaces need to be initialized
+  //! constructor, the function spaces need to be initialized. The function space of the contained mesh is nullptr on ranks that are not part of its partition.
   MappingBetweenMeshes(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource, std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget);
 
-  //! map data between field variables in the source and target function spaces
+  //! map data between field variables in the source and target function spaces, target dofs without contribution are set to 0
   template<int nComponentsSource, int nComponentsTarget>
   void map(FieldVariable::FieldVariable<FunctionSpaceSourceType,nComponentsSource> &fieldVariableSource, int componentNoSource,
-           FieldVariable::FieldVariable<FunctionSpaceSourceType,nComponentsSource> &fieldVariableTarget, int componentNoTarget);
+           FieldVariable::FieldVariable<FunctionSpaceTargetType,nComponentsTarget> &fieldVariableTarget, int componentNoTarget);
+
+  //! take part in the mapping on a rank that has no part of the source mesh, the target field variable gets the contributions of the other ranks
+  template<int nComponentsTarget>
+  void mapWithoutSource(FieldVariable::FieldVariable<FunctionSpaceTargetType,nComponentsTarget> &fieldVariableTarget, int componentNoTarget);
+
+  //! take part in the mapping on a rank that has no part of the target mesh, the local values of the source field variable are sent to the other ranks
+  template<int nComponentsSource>
+  void mapWithoutTarget(FieldVariable::FieldVariable<FunctionSpaceSourceType,nComponentsSource> &fieldVariableSource, int componentNoSource);
 
 private:
 
-  //! initialize the mapping
-  void initialize();
+  //! create the mapping matrix by locating the source dofs in the target mesh, for a source mesh of lower dimension than the target mesh
+  void initialize(std::true_type sourceHasLowerDimension);
+
+  //! create the mapping matrix by locating the target dofs in the source mesh
+  void initialize(std::false_type sourceHasLowerDimension);
+
+  //! for every local dof (without ghosts) of functionSpacePoints, find the containing element in functionSpaceContainer, on any rank.
+  //! Get the global PETSc dof nos of that element and the values of its basis functions at the point. pointFound is false for points outside of functionSpaceContainer.
+  //! functionSpacePoints can be nullptr on ranks that have no part of that mesh, all ranks of functionSpaceContainer have to call this method.
+  template<typename FunctionSpacePointsType, typename FunctionSpaceContainerType>
+  static void locatePoints(std::shared_ptr<FunctionSpacePointsType> functionSpacePoints, std::shared_ptr<FunctionSpaceContainerType> functionSpaceContainer,
+                           std::vector<std::array<PetscInt,FunctionSpaceContainerType::nDofsPerElement()>> &containerDofNosGlobalPetsc,
+                           std::vector<std::array<double,FunctionSpaceContainerType::nDofsPerElement()>> &basisFunctionValues,
+                           std::vector<bool> &pointFound);
+
+  //! check that the contained mesh is partitioned on a subset of the ranks of mpiCommunicator_, if it uses different ranks, create the vector that holds its values in the
+  //! layout of the mapping matrix, this is a vector on mpiCommunicator_ with the same local values
+  template<typename FunctionSpaceType>
+  void createValuesOnMappingCommunicator(std::shared_ptr<FunctionSpaceType> functionSpace, Vec &valuesOnMappingCommunicator);
+
+  //! get the name of the mesh of the function space, also if the own rank has no part of it
+  template<typename FunctionSpaceType>
+  static std::string meshName(std::shared_ptr<FunctionSpaceType> functionSpace);
+
+  //! create the (not yet assembled) mapping matrix with the sizes of the target and source vectors
+  void createMatrix(int nEntriesPerRowEstimate);
+
+  //! assemble the mapping matrix
+  void assembleMatrix();
+
+  //! scale every row of the assembled mapping matrix by the inverse of its sum, such that every target value is a weighted average
+  void normalizeRows();
+
+  //! compute targetValues = mappingMatrix_ * sourceValues, the vectors are PETSC_NULL on ranks that have no part of the respective mesh
+  void mapValues(Vec sourceValues, Vec targetValues);
 
-  std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource_;   ///< the function space of the mesh from which to map data
-  std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget_;   ///< the function space of the mesh to which to map data
+  std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource_;   ///< the function space of the mesh from which to map data, nullptr on ranks that have no part of the mesh
+  std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget_;   ///< the function space of the mesh to which to map data, nullptr on ranks that have no part of the mesh
 
-  struct targetDof_t
-  {
-    element_no_t elementNoLocal;   //< local element no of the target element
-    std::vector<double> scalingFactors;          //< factors for the dofs of the element with which to scale the value
-  };
+  MPI_Comm mpiCommunicator_;            ///< the communicator of the containing mesh, the mapping matrix and all communication use this communicator
+  dof_no_t nDofsLocalSource_;           ///< the number of local dofs without ghosts of the source mesh, 0 on ranks that have no part of it
+  dof_no_t nDofsLocalTarget_;           ///< the number of local dofs without ghosts of the target mesh, 0 on ranks that have no part of it
+  PetscInt dofNoOffsetPoints_;          ///< the global no. of the first local dof of the contained mesh in the column or row numbering of the mapping matrix
+  Vec sourceValuesOnMappingCommunicator_;   ///< the source values as vector on mpiCommunicator_, only if the source mesh is partitioned on fewer ranks, else PETSC_NULL
+  Vec targetValuesOnMappingCommunicator_;   ///< the target values as vector on mpiCommunicator_, only if the target mesh is partitioned on fewer ranks, else PETSC_NULL
 
-  std::vector<targetDof_t> targetMappingInfo_;  ///< [localDofNo source functionSpace] information where in the target to store the value from local dof No of the source
+  Mat mappingMatrix_;   ///< the matrix of the mapping, target values = mappingMatrix_ * source values, rows: global target dofs, columns: global source dofs
 };
 
 }  // namespace
@@ -1,5 +1,13 @@
 #include "mesh/mapping_between_meshes.h"
 
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <mpi.h>
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+
 namespace Mesh
 {
 
@@ -7,85 +15,571 @@ template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
 MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::MappingBetweenMeshes(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource,
                                                                                              std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget) :
   functionSpaceSource_(functionSpaceSource),
-  functionSpaceTarget_(functionSpaceTarget)
+  functionSpaceTarget_(functionSpaceTarget),
+  mpiCommunicator_(MPI_COMM_NULL),
+  nDofsLocalSource_(0),
+  nDofsLocalTarget_(0),
+  dofNoOffsetPoints_(0),
+  sourceValuesOnMappingCommunicator_(PETSC_NULL),
+  targetValuesOnMappingCommunicator_(PETSC_NULL),
+  mappingMatrix_(PETSC_NULL)
+{
+  // the points of the mesh of lower dimension are located in the other mesh, for equal dimensions the target dofs are located in the source mesh
+  const bool sourceHasLowerDimension = (FunctionSpaceSourceType::dim() < FunctionSpaceTargetType::dim());
+
+  // the mapping matrix and all collective operations use the communicator of the containing mesh, this mesh has to exist on all ranks that construct the mapping
+  if (sourceHasLowerDimension ? !functionSpaceTarget_ : !functionSpaceSource_)
+  {
+    LOG(FATAL) << "Cannot create mapping between meshes \"" << meshName(functionSpaceSource_) << "\" and \"" << meshName(functionSpaceTarget_)
+      << "\", the own rank has no part of the containing mesh.";
+    return;
+  }
+  if (sourceHasLowerDimension)
+    mpiCommunicator_ = functionSpaceTarget_->meshPartition()->mpiCommunicator();
+  else
+    mpiCommunicator_ = functionSpaceSource_->meshPartition()->mpiCommunicator();
+
+  if (functionSpaceSource_)
+    nDofsLocalSource_ = functionSpaceSource_->nDofsLocalWithoutGhosts();
+  if (functionSpaceTarget_)
+    nDofsLocalTarget_ = functionSpaceTarget_->nDofsLocalWithoutGhosts();
+
+  // the contained mesh can be partitioned on a subset of the ranks, then its values are mapped through a vector on the communicator of the mapping
+  if (sourceHasLowerDimension)
+    createValuesOnMappingCommunicator(functionSpaceSource_, sourceValuesOnMappingCommunicator_);
+  else
+    createValuesOnMappingCommunicator(functionSpaceTarget_, targetValuesOnMappingCommunicator_);
+
+  // in the mapping matrix the dofs of the contained mesh are numbered contiguously in the order of the ranks of mpiCommunicator_,
+  // this is the PETSc numbering of the mesh if it is partitioned on the same ranks
+  PetscInt nDofsLocalPoints = (sourceHasLowerDimension ? nDofsLocalSource_ : nDofsLocalTarget_);
+  int ownRankNo;
+  MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator_, &ownRankNo), "MPI_Comm_rank");
+  MPIUtility::handleReturnValue(MPI_Exscan(&nDofsLocalPoints, &dofNoOffsetPoints_, 1, MPIU_INT, MPI_SUM, mpiCommunicator_), "MPI_Exscan");
+  if (ownRankNo == 0)
+    dofNoOffsetPoints_ = 0;   // the result of MPI_Exscan is undefined on the first rank
+
+  // decide at compile time which mesh is located in the other
+  initialize(std::integral_constant<bool, (FunctionSpaceSourceType::dim() < FunctionSpaceTargetType::dim())>());
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+  template<typename FunctionSpaceType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+createValuesOnMappingCommunicator(std::shared_ptr<FunctionSpaceType> functionSpace, Vec &valuesOnMappingCommunicator)
+{
+  dof_no_t nDofsLocal = 0;
+  if (functionSpace)
+  {
+    // if the mesh is partitioned on the same ranks, its vectors can directly be used with the mapping matrix. This check is local and does not need communication.
+    MPI_Comm mpiCommunicator = functionSpace->meshPartition()->mpiCommunicator();
+    int comparison;
+    MPIUtility::handleReturnValue(MPI_Comm_compare(mpiCommunicator, mpiCommunicator_, &comparison), "MPI_Comm_compare");
+    if (comparison == MPI_IDENT || comparison == MPI_CONGRUENT)
+      return;
+
+    // all ranks of the mesh have to be ranks of the containing mesh
+    int nRanks;
+    MPI_Group group, groupMapping;
+    MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator, &nRanks), "MPI_Comm_size");
+    MPIUtility::handleReturnValue(MPI_Comm_group(mpiCommunicator, &group), "MPI_Comm_group");
+    MPIUtility::handleReturnValue(MPI_Comm_group(mpiCommunicator_, &groupMapping), "MPI_Comm_group");
+
+    std::vector<int> rankNos(nRanks), rankNosMapping(nRanks);
+    for (int rankNo = 0; rankNo < nRanks; rankNo++)
+      rankNos[rankNo] = rankNo;
+    MPIUtility::handleReturnValue(MPI_Group_translate_ranks(group, nRanks, rankNos.data(), groupMapping, rankNosMapping.data()), "MPI_Group_translate_ranks");
+    MPIUtility::handleReturnValue(MPI_Group_free(&group), "MPI_Group_free");
+    MPIUtility::handleReturnValue(MPI_Group_free(&groupMapping), "MPI_Group_free");
+
+    if (std::find(rankNosMapping.begin(), rankNosMapping.end(), MPI_UNDEFINED) != rankNosMapping.end())
+    {
+      LOG(FATAL) << "Cannot create mapping between meshes \"" << meshName(functionSpaceSource_) << "\" and \"" << meshName(functionSpaceTarget_)
+        << "\", mesh \"" << functionSpace->meshName() << "\" is partitioned on ranks that are not part of the partition of the containing mesh.";
+      return;
+    }
+    nDofsLocal = functionSpace->nDofsLocalWithoutGhosts();
+  }
+
+  // the vector has the same local values as the vector of the mesh, ranks without a part of the mesh have no local values
+  PetscErrorCode ierr;
+  ierr = VecCreateMPI(mpiCommunicator_, nDofsLocal, PETSC_DETERMINE, &valuesOnMappingCommunicator); CHKERRV(ierr);
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+  template<typename FunctionSpaceType>
+std::string MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+meshName(std::shared_ptr<FunctionSpaceType> functionSpace)
 {
+  if (functionSpace)
+    return functionSpace->meshName();
+  return std::string("(not on this rank)");
+}
 
-  const dof_no_t nDofsLocalSource = functionSpaceSource->nDofsLocalWithoutGhosts();
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+initialize(std::true_type sourceHasLowerDimension)
+{
+  // locate the source dofs (e.g. on the fibers) in the target mesh (e.g. 3D mesh)
   const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+  const int nNodesPerTargetElement = FunctionSpaceTargetType::nNodesPerElement();
+  const int nDofsPerTargetNode = FunctionSpaceTargetType::nDofsPerNode();
+  std::vector<std::array<PetscInt,nDofsPerTargetElement>> targetDofNosGlobalPetsc;
+  std::vector<std::array<double,nDofsPerTargetElement>> basisFunctionValues;
+  std::vector<bool> pointFound;
+
+  locatePoints(functionSpaceSource_, functionSpaceTarget_, targetDofNosGlobalPetsc, basisFunctionValues, pointFound);
+
+  // a target dof can get contributions from all source dofs in the adjacent elements, this is only an estimate for the preallocation
+  createMatrix(2*nDofsPerTargetElement);
+
+  // the source value is distributed to the nodal value dofs of the target element, weighted by the basis functions,
+  // the rows can belong to other ranks, then the values are communicated at assembly.
+  // The derivative dofs of Hermite target elements get no contribution, the basis functions of the nodal values alone are a partition of unity.
+  PetscErrorCode ierr;
+  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal < nDofsLocalSource_; sourceDofNoLocal++)
+  {
+    if (!pointFound[sourceDofNoLocal])
+      continue;
+
+    std::array<PetscInt,nNodesPerTargetElement> targetNodalDofNosGlobalPetsc;
+    std::array<double,nNodesPerTargetElement> weights;
+    for (int nodeIndex = 0; nodeIndex < nNodesPerTargetElement; nodeIndex++)
+    {
+      targetNodalDofNosGlobalPetsc[nodeIndex] = targetDofNosGlobalPetsc[sourceDofNoLocal][nodeIndex*nDofsPerTargetNode];
+      weights[nodeIndex] = basisFunctionValues[sourceDofNoLocal][nodeIndex*nDofsPerTargetNode];
+    }
+
+    PetscInt sourceDofNoGlobalPetsc = dofNoOffsetPoints_ + sourceDofNoLocal;
+    ierr = MatSetValues(mappingMatrix_, nNodesPerTargetElement, targetNodalDofNosGlobalPetsc.data(), 1, &sourceDofNoGlobalPetsc,
+                        weights.data(), ADD_VALUES); CHKERRV(ierr);
+  }
+
+  assembleMatrix();
+
+  // every target value is the weighted average of the source values in the adjacent target elements
+  normalizeRows();
+}
 
-  element_no_t elementNo;
-  int ghostMeshNo;
-  std::array<double,FunctionSpaceTargetType::dim()> xi;
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+initialize(std::false_type sourceHasLowerDimension)
+{
+  // locate the target dofs (e.g. on the fibers) in the source mesh (e.g. 3D mesh)
+  const int nDofsPerSourceElement = FunctionSpaceSourceType::nDofsPerElement();
+  std::vector<std::array<PetscInt,nDofsPerSourceElement>> sourceDofNosGlobalPetsc;
+  std::vector<std::array<double,nDofsPerSourceElement>> basisFunctionValues;
+  std::vector<bool> pointFound;
+
+  locatePoints(functionSpaceTarget_, functionSpaceSource_, sourceDofNosGlobalPetsc, basisFunctionValues, pointFound);
+
+  createMatrix(nDofsPerSourceElement);
+
+  // the target value is interpolated from the dofs of the source element, the rows are all local.
+  // This uses all dofs of the source element, also the derivative dofs of Hermite elements. The rows are not normalized,
+  // the interpolation is exact for the basis, for Lagrange basis functions the row sums are 1 anyway.
+  PetscErrorCode ierr;
+  for (dof_no_t targetDofNoLocal = 0; targetDofNoLocal < nDofsLocalTarget_; targetDofNoLocal++)
+  {
+    if (!pointFound[targetDofNoLocal])
+      continue;
+
+    PetscInt targetDofNoGlobalPetsc = dofNoOffsetPoints_ + targetDofNoLocal;
+    ierr = MatSetValues(mappingMatrix_, 1, &targetDofNoGlobalPetsc, nDofsPerSourceElement, sourceDofNosGlobalPetsc[targetDofNoLocal].data(),
+                        basisFunctionValues[targetDofNoLocal].data(), ADD_VALUES); CHKERRV(ierr);
+  }
+
+  assembleMatrix();
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+  template<typename FunctionSpacePointsType, typename FunctionSpaceContainerType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+locatePoints(std::shared_ptr<FunctionSpacePointsType> functionSpacePoints, std::shared_ptr<FunctionSpaceContainerType> functionSpaceContainer,
+             std::vector<std::array<PetscInt,FunctionSpaceContainerType::nDofsPerElement()>> &containerDofNosGlobalPetsc,
+             std::vector<std::array<double,FunctionSpaceContainerType::nDofsPerElement()>> &basisFunctionValues,
+             std::vector<bool> &pointFound)
+{
+  const int nDofsPerContainerElement = FunctionSpaceContainerType::nDofsPerElement();
+  const int nDofsPerPointsNode = FunctionSpacePointsType::nDofsPerNode();
+  const int D = FunctionSpaceContainerType::dim();
+  MPI_Comm mpiCommunicator = functionSpaceContainer->meshPartition()->mpiCommunicator();
+
+  int ownRankNo, nRanks;
+  MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator, &ownRankNo), "MPI_Comm_rank");
+  MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator, &nRanks), "MPI_Comm_size");
+
+  // get the positions of all local points, ranks that have no part of the points mesh have no points but take part in the communication
+  std::vector<Vec3> positions;
+  if (functionSpacePoints)
+    functionSpacePoints->geometryField().getValuesWithoutGhosts(positions);
+  const int nPoints = positions.size();
+
+  containerDofNosGlobalPetsc.resize(nPoints);
+  basisFunctionValues.resize(nPoints);
+  pointFound.assign(nPoints, false);
+
+  // locate the point in the local domain of the container mesh and store the dofs of the element and the basis function values at the point,
+  // returns false if the point is not in a non-ghost element of the local domain
+  element_no_t elementNo = 0;
+  auto locatePointLocally = [&functionSpaceContainer, &elementNo](const Vec3 &position, bool startSearchInCurrentElement,
+                                                                  std::array<PetscInt,nDofsPerContainerElement> &dofNosGlobalPetsc,
+                                                                  std::array<double,nDofsPerContainerElement> &phi)
+  {
+    int ghostMeshNo = -1;
+    std::array<double,D> xi;
+    if (!functionSpaceContainer->findPosition(position, elementNo, ghostMeshNo, xi, startSearchInCurrentElement))
+      return false;
+
+    // elements of ghost meshes are owned by the neighbouring rank
+    if (ghostMeshNo != -1)
+    {
+      elementNo = 0;
+      return false;
+    }
+
+    std::array<dof_no_t,nDofsPerContainerElement> dofNosLocal = functionSpaceContainer->getElementDofNosLocal(elementNo);
+    for (int dofIndex = 0; dofIndex < nDofsPerContainerElement; dofIndex++)
+    {
+      dofNosGlobalPetsc[dofIndex] = functionSpaceContainer->meshPartition()->getDofNoGlobalPetsc(dofNosLocal[dofIndex]);
+      phi[dofIndex] = functionSpaceContainer->phi(dofIndex, xi);
+    }
+    return true;
+  };
+
+  std::vector<int> pointsNotFoundLocally;
   bool startSearchInCurrentElement = false;
+  for (int pointNo = 0; pointNo < nPoints; pointNo++)
+  {
+    // only the first dof of every node holds a position, for Hermite the other dofs are derivatives and are not located
+    if (pointNo % nDofsPerPointsNode != 0)
+      continue;
+
+    pointFound[pointNo] = locatePointLocally(positions[pointNo], startSearchInCurrentElement, containerDofNosGlobalPetsc[pointNo], basisFunctionValues[pointNo]);
+
+    if (!pointFound[pointNo])
+      pointsNotFoundLocally.push_back(pointNo);
+
+    // next time when searching for the element, start search from previous element
+    startSearchInCurrentElement = pointFound[pointNo];
+  }
 
-  targetMappingInfo_.resize(nDofsLocalSource);
+  VLOG(1) << "MappingBetweenMeshes \"" << meshName(functionSpacePoints) << "\" in \"" << functionSpaceContainer->meshName() << "\": "
+    << nPoints/nDofsPerPointsNode - pointsNotFoundLocally.size() << " of " << nPoints/nDofsPerPointsNode << " points found locally";
 
-  // loop over all local dofs of the source functionSpace
-  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal != nDofsLocalSource; sourceDofNoLocal++)
+  if (nRanks == 1)
   {
-    // determine information how to map a source value to the target mesh
-    targetDof_t targetMappingInfo;
+    for (int pointNo : pointsNotFoundLocally)
+    {
+      LOG(WARNING) << "Point " << positions[pointNo] << " of mesh \"" << meshName(functionSpacePoints) << "\" is outside of mesh \""
+        << functionSpaceContainer->meshName() << "\", it is not considered in the mapping.";
+    }
+    return;
+  }
 
-    // get node position of the source dof
-    Vec3 position;
-    dof_no_t sourceDofNoGlobal = functionSpaceTarget->meshPartition()->getDofNoGlobalPetsc(sourceDofNoLocal);
-    functionSpaceTarget->getGeometry(sourceDofNoGlobal);
+  // ---- exchange the remaining points with the ranks whose domain bounding box contains them ----
+  // All ranks of the container mesh construct this mapping and take part in the following collective operations,
+  // ranks without a part of the points mesh have no points to send.
+  // compute the bounding box of the local domain of the container mesh from the bounding boxes of the local elements,
+  // these also contain the ghost nodes of the elements at the border of the local domain
+  std::array<double,6> localBoundingBox;    // xmin, ymin, zmin, xmax, ymax, zmax
+  for (int i = 0; i < 3; i++)
+  {
+    localBoundingBox[i] = std::numeric_limits<double>::max();
+    localBoundingBox[3+i] = std::numeric_limits<double>::lowest();
+  }
 
-    // find element no in the target mesh where the position is
-    if (!functionSpaceTarget->findPosition(position, elementNo, ghostMeshNo, xi, startSearchInCurrentElement))
+  double maximumElementExtent = 0.0;
+  for (const std::array<Vec3,2> &elementBoundingBox : functionSpaceContainer->elementBoundingBoxes())
+  {
+    for (int i = 0; i < 3; i++)
     {
-      LOG(ERROR) << "Could not create mapping between meshes \"" << functionSpaceSource->meshName() << "\" and \""
-        << functionSpaceTarget->meshName() << "\", dof local " << sourceDofNoLocal << ", global " << sourceDofNoGlobal
-        << " of mesh \"" << functionSpaceSource->meshName() << "\" at position " << position << " is outside of mesh \""
-        << functionSpaceTarget->meshName() << "\".";
-        break;
+      localBoundingBox[i] = std::min(localBoundingBox[i], elementBoundingBox[0][i]);
+      localBoundingBox[3+i] = std::max(localBoundingBox[3+i], elementBoundingBox[1][i]);
+      maximumElementExtent = std::max(maximumElementExtent, elementBoundingBox[1][i] - elementBoundingBox[0][i]);
     }
+  }
 
-    // store element no
-    targetMappingInfo.elementNoLocal = elementNo;
+  // the element geometry is only sampled and findPosition allows points slightly outside of the elements, enlarge the bounding box
+  // by a margin relative to the largest element extent, on every axis such that flat domains also get a margin in their thin direction
+  const double margin = 0.1*maximumElementExtent + 1e-12;
+  for (int i = 0; i < 3; i++)
+  {
+    localBoundingBox[i] -= margin;
+    localBoundingBox[3+i] += margin;
+  }
 
-    // determine factors how to distribute the value to the dofs of the target element
-    targetMappingInfo.scalingFactors.resize(nDofsPerTargetElement);
+  std::vector<double> boundingBoxes(6*nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(localBoundingBox.data(), 6, MPI_DOUBLE, boundingBoxes.data(), 6, MPI_DOUBLE, mpiCommunicator), "MPI_Allgather");
 
-    // note: geometry value = sum over dofs of geometryValue_dof * phi_dof(xi)
-    for (int targetDofIndex = 0; targetDofIndex < nDofsPerTargetElement; targetDofIndex++)
+  // determine which points to send to which ranks
+  std::vector<std::vector<int>> pointNosToSend(nRanks);    // [rankNo][i] local point no of the i-th point to send to rank rankNo
+  for (int pointNo : pointsNotFoundLocally)
+  {
+    for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    {
+      if (rankNo == ownRankNo)
+        continue;
+
+      bool isInsideBoundingBox = true;
+      for (int i = 0; i < 3; i++)
+      {
+        if (positions[pointNo][i] < boundingBoxes[6*rankNo+i] || positions[pointNo][i] > boundingBoxes[6*rankNo+3+i])
+          isInsideBoundingBox = false;
+      }
+      if (isInsideBoundingBox)
+        pointNosToSend[rankNo].push_back(pointNo);
+    }
+  }
+
+  // communicate the numbers of points
+  std::vector<int> nPointsToSend(nRanks), nPointsToReceive(nRanks);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    nPointsToSend[rankNo] = pointNosToSend[rankNo].size();
+
+  MPIUtility::handleReturnValue(MPI_Alltoall(nPointsToSend.data(), 1, MPI_INT, nPointsToReceive.data(), 1, MPI_INT, mpiCommunicator), "MPI_Alltoall");
+
+  // compute offsets into the send and receive buffers, in units of points
+  std::vector<int> sendOffsets(nRanks+1, 0), receiveOffsets(nRanks+1, 0);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    sendOffsets[rankNo+1] = sendOffsets[rankNo] + nPointsToSend[rankNo];
+    receiveOffsets[rankNo+1] = receiveOffsets[rankNo] + nPointsToReceive[rankNo];
+  }
+
+  // helper to scale counts and offsets by the number of values per point
+  auto scaled = [](const std::vector<int> &values, int factor)
+  {
+    std::vector<int> result(values.size());
+    for (int i = 0; i < values.size(); i++)
+      result[i] = values[i]*factor;
+    return result;
+  };
+
+  // send the point positions
+  std::vector<double> sendPositions(3*sendOffsets[nRanks]);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    for (int i = 0; i < nPointsToSend[rankNo]; i++)
     {
-      targetMappingInfo.scalingFactors[targetDofIndex] = functionSpaceTarget->phi(targetDofIndex,xi);
+      for (int j = 0; j < 3; j++)
+        sendPositions[3*(sendOffsets[rankNo]+i)+j] = positions[pointNosToSend[rankNo][i]][j];
     }
+  }
+
+  std::vector<double> receivePositions(3*receiveOffsets[nRanks]);
+  MPIUtility::handleReturnValue(MPI_Alltoallv(sendPositions.data(), scaled(nPointsToSend,3).data(), scaled(sendOffsets,3).data(), MPI_DOUBLE,
+                                              receivePositions.data(), scaled(nPointsToReceive,3).data(), scaled(receiveOffsets,3).data(), MPI_DOUBLE,
+                                              mpiCommunicator), "MPI_Alltoallv");
+
+  // locate the received points in the own domain, the answer is the dof nos of the element (-1 if not found) and the basis function values
+  const int nReceivedPoints = receiveOffsets[nRanks];
+  std::vector<PetscInt> answerDofNos(nReceivedPoints*nDofsPerContainerElement, -1);
+  std::vector<double> answerPhi(nReceivedPoints*nDofsPerContainerElement, 0.0);
+
+  startSearchInCurrentElement = false;
+  for (int receivedPointNo = 0; receivedPointNo < nReceivedPoints; receivedPointNo++)
+  {
+    Vec3 position({receivePositions[3*receivedPointNo+0], receivePositions[3*receivedPointNo+1], receivePositions[3*receivedPointNo+2]});
+    std::array<PetscInt,nDofsPerContainerElement> dofNosGlobalPetsc;
+    std::array<double,nDofsPerContainerElement> phi;
+
+    if (locatePointLocally(position, startSearchInCurrentElement, dofNosGlobalPetsc, phi))
+    {
+      std::copy(dofNosGlobalPetsc.begin(), dofNosGlobalPetsc.end(), answerDofNos.begin() + receivedPointNo*nDofsPerContainerElement);
+      std::copy(phi.begin(), phi.end(), answerPhi.begin() + receivedPointNo*nDofsPerContainerElement);
+      startSearchInCurrentElement = true;
+    }
+    else
+    {
+      startSearchInCurrentElement = false;
+    }
+  }
+
+  // send the answers back, the communication pattern is the reverse
+  std::vector<PetscInt> resultDofNos(sendOffsets[nRanks]*nDofsPerContainerElement);
+  std::vector<double> resultPhi(sendOffsets[nRanks]*nDofsPerContainerElement);
+
+  MPIUtility::handleReturnValue(MPI_Alltoallv(answerDofNos.data(), scaled(nPointsToReceive,nDofsPerContainerElement).data(),
+                                              scaled(receiveOffsets,nDofsPerContainerElement).data(), MPIU_INT,
+                                              resultDofNos.data(), scaled(nPointsToSend,nDofsPerContainerElement).data(),
+                                              scaled(sendOffsets,nDofsPerContainerElement).data(), MPIU_INT, mpiCommunicator), "MPI_Alltoallv");
+  MPIUtility::handleReturnValue(MPI_Alltoallv(answerPhi.data(), scaled(nPointsToReceive,nDofsPerContainerElement).data(),
+                                              scaled(receiveOffsets,nDofsPerContainerElement).data(), MPI_DOUBLE,
+                                              resultPhi.data(), scaled(nPointsToSend,nDofsPerContainerElement).data(),
+                                              scaled(sendOffsets,nDofsPerContainerElement).data(), MPI_DOUBLE, mpiCommunicator), "MPI_Alltoallv");
+
+  // store the results, if a point was found on multiple ranks (on the shared border), take the first
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    for (int i = 0; i < nPointsToSend[rankNo]; i++)
+    {
+      int resultNo = sendOffsets[rankNo] + i;
+      int pointNo = pointNosToSend[rankNo][i];
+      if (pointFound[pointNo] || resultDofNos[resultNo*nDofsPerContainerElement] == -1)
+        continue;
+
+      std::copy(resultDofNos.begin() + resultNo*nDofsPerContainerElement, resultDofNos.begin() + (resultNo+1)*nDofsPerContainerElement,
+                containerDofNosGlobalPetsc[pointNo].begin());
+      std::copy(resultPhi.begin() + resultNo*nDofsPerContainerElement, resultPhi.begin() + (resultNo+1)*nDofsPerContainerElement,
+                basisFunctionValues[pointNo].begin());
+      pointFound[pointNo] = true;
+    }
+  }
+
+  for (int pointNo : pointsNotFoundLocally)
+  {
+    if (!pointFound[pointNo])
+    {
+      LOG(WARNING) << "Point " << positions[pointNo] << " of mesh \"" << meshName(functionSpacePoints) << "\" is outside of mesh \""
+        << functionSpaceContainer->meshName() << "\" on all ranks, it is not considered in the mapping.";
+    }
+  }
+}
 
-    targetMappingInfo_[sourceDofNoLocal] = targetMappingInfo;
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+createMatrix(int nEntriesPerRowEstimate)
+{
+  PetscErrorCode ierr;
+
+  // rows correspond to the target vector, columns to the source vector, the matrix is on the communicator of the containing mesh,
+  // ranks that have no part of the contained mesh have no local rows or columns for it
+  ierr = MatCreateAIJ(mpiCommunicator_, nDofsLocalTarget_, nDofsLocalSource_, PETSC_DETERMINE, PETSC_DETERMINE,
+                      nEntriesPerRowEstimate, NULL, nEntriesPerRowEstimate, NULL, &mappingMatrix_); CHKERRV(ierr);
+
+  // the preallocation is only an estimate
+  ierr = MatSetOption(mappingMatrix_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE); CHKERRV(ierr);
+
+  std::string name = std::string("mapping ") + meshName(functionSpaceSource_) + " -> " + meshName(functionSpaceTarget_);
+  ierr = PetscObjectSetName((PetscObject) mappingMatrix_, name.c_str()); CHKERRV(ierr);
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+assembleMatrix()
+{
+  PetscErrorCode ierr;
+  ierr = MatAssemblyBegin(mappingMatrix_, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+  ierr = MatAssemblyEnd(mappingMatrix_, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+
+  MatInfo info;
+  ierr = MatGetInfo(mappingMatrix_, MAT_GLOBAL_SUM, &info); CHKERRV(ierr);
+  LOG(DEBUG) << "MappingBetweenMeshes \"" << meshName(functionSpaceSource_) << "\" -> \"" << meshName(functionSpaceTarget_) << "\" has "
+    << info.nz_used << " non-zeros";
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+normalizeRows()
+{
+  PetscErrorCode ierr;
+
+  // compute the sum of every row and invert it, rows without entries stay zero
+  Vec rowSums;
+  ierr = MatCreateVecs(mappingMatrix_, NULL, &rowSums); CHKERRV(ierr);
+  ierr = MatGetRowSum(mappingMatrix_, rowSums); CHKERRV(ierr);
 
-    // next time when searching for the target element, start search from previous element
-    startSearchInCurrentElement = true;
+  PetscInt nRowsLocal;
+  double *rowSumsData;
+  ierr = VecGetLocalSize(rowSums, &nRowsLocal); CHKERRV(ierr);
+  ierr = VecGetArray(rowSums, &rowSumsData); CHKERRV(ierr);
+  for (PetscInt rowNo = 0; rowNo < nRowsLocal; rowNo++)
+  {
+    if (fabs(rowSumsData[rowNo]) > 1e-15)
+      rowSumsData[rowNo] = 1.0 / rowSumsData[rowNo];
+    else
+      rowSumsData[rowNo] = 0.0;
   }
+  ierr = VecRestoreArray(rowSums, &rowSumsData); CHKERRV(ierr);
+
+  // scale the rows, then every target value is a weighted average of the source values
+  ierr = MatDiagonalScale(mappingMatrix_, rowSums, NULL); CHKERRV(ierr);
+  ierr = VecDestroy(&rowSums); CHKERRV(ierr);
 }
 
 template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
   template<int nComponentsSource, int nComponentsTarget>
 void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::map(
   FieldVariable::FieldVariable<FunctionSpaceSourceType,nComponentsSource> &fieldVariableSource, int componentNoSource,
-  FieldVariable::FieldVariable<FunctionSpaceSourceType,nComponentsSource> &fieldVariableTarget, int componentNoTarget)
+  FieldVariable::FieldVariable<FunctionSpaceTargetType,nComponentsTarget> &fieldVariableTarget, int componentNoTarget)
 {
   assert(componentNoSource >= 0 && componentNoSource < nComponentsSource);
   assert(componentNoTarget >= 0 && componentNoTarget < nComponentsTarget);
 
-  fieldVariableTarget->zeroValues();
+  // target = mappingMatrix_ * source, this needs the global vectors
+  fieldVariableSource.setRepresentationGlobal();
+  fieldVariableTarget.setRepresentationGlobal();
 
-  const dof_no_t nDofsLocalSource = fieldVariableSource->functionSpace()->nDofsLocalWithoutGhosts();
-  const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+  mapValues(fieldVariableSource.valuesGlobal(componentNoSource), fieldVariableTarget.valuesGlobal(componentNoTarget));
+
+  // update the ghost values of the target
+  fieldVariableTarget.startGhostManipulation();
+}
 
-  // loop over all local dofs of the source functionSpace
-  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal != nDofsLocalSource; sourceDofNoLocal++)
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+  template<int nComponentsTarget>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::mapWithoutSource(
+  FieldVariable::FieldVariable<FunctionSpaceTargetType,nComponentsTarget> &fieldVariableTarget, int componentNoTarget)
+{
+  assert(!functionSpaceSource_);
+  assert(componentNoTarget >= 0 && componentNoTarget < nComponentsTarget);
+
+  fieldVariableTarget.setRepresentationGlobal();
+  mapValues(PETSC_NULL, fieldVariableTarget.valuesGlobal(componentNoTarget));
+  fieldVariableTarget.startGhostManipulation();
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+  template<int nComponentsSource>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::mapWithoutTarget(
+  FieldVariable::FieldVariable<FunctionSpaceSourceType,nComponentsSource> &fieldVariableSource, int componentNoSource)
+{
+  assert(!functionSpaceTarget_);
+  assert(componentNoSource >= 0 && componentNoSource < nComponentsSource);
+
+  fieldVariableSource.setRepresentationGlobal();
+  mapValues(fieldVariableSource.valuesGlobal(componentNoSource), PETSC_NULL);
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshes<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+mapValues(Vec sourceValues, Vec targetValues)
+{
+  PetscErrorCode ierr;
+
+  // copy the local values between vectors with the same local sizes on different communicators
+  auto copyLocalValues = [](Vec valuesFrom, Vec valuesTo)
   {
-    // get value
-    double sourceValue;
-    fieldVariableSource->getValue(componentNoSource, sourceDofNoLocal, sourceValue);
+    PetscErrorCode ierr;
+    PetscInt nValuesLocal;
+    const double *valuesFromData;
+    double *valuesToData;
+    ierr = VecGetLocalSize(valuesFrom, &nValuesLocal); CHKERRV(ierr);
+    ierr = VecGetArrayRead(valuesFrom, &valuesFromData); CHKERRV(ierr);
+    ierr = VecGetArray(valuesTo, &valuesToData); CHKERRV(ierr);
+    std::copy(valuesFromData, valuesFromData + nValuesLocal, valuesToData);
+    ierr = VecRestoreArray(valuesTo, &valuesToData); CHKERRV(ierr);
+    ierr = VecRestoreArrayRead(valuesFrom, &valuesFromData); CHKERRV(ierr);
+  };
 
-    // store the value to the target function space
-    element_no_t targetElementNoLocal = targetMappingInfo_[sourceDofNoLocal].elementNoLocal;
-    std::array<double,nDofsPerTargetElement> targetValues = targetMappingInfo_[sourceDofNoLocal].scalingFactors * sourceValue;
-    fieldVariableTarget->setElementalValues(componentNoTarget, targetElementNoLocal, targetValues, ADD_VALUES);
+  // if the contained mesh is partitioned on fewer ranks than the containing mesh, its values go through the vector on the communicator of the mapping matrix
+  Vec source = sourceValues;
+  if (sourceValuesOnMappingCommunicator_ != PETSC_NULL)
+  {
+    if (sourceValues != PETSC_NULL)
+      copyLocalValues(sourceValues, sourceValuesOnMappingCommunicator_);
+    source = sourceValuesOnMappingCommunicator_;
   }
+
+  Vec target = targetValues;
+  if (targetValuesOnMappingCommunicator_ != PETSC_NULL)
+    target = targetValuesOnMappingCommunicator_;
+
+  ierr = MatMult(mappingMatrix_, source, target); CHKERRV(ierr);
+
+  if (targetValuesOnMappingCommunicator_ != PETSC_NULL && targetValues != PETSC_NULL)
+    copyLocalValues(targetValuesOnMappingCommunicator_, targetValues);
 }
 
 }  // namespace
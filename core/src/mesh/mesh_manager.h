@@ -34,6 +34,10 @@ public:
   template<typename FunctionSpace1Type, typename FunctionSpace2Type>
   void initializeMappingsBetweenMeshes(const std::shared_ptr<FunctionSpace1Type> functionSpace1, const std::shared_ptr<FunctionSpace2Type> functionSpace2);
 
+  //! get the mapping from source mesh to target mesh, nullptr if it was not defined in the config or is not yet initialized
+  template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+  std::shared_ptr<MappingBetweenMeshes<FunctionSpaceSourceType,FunctionSpaceTargetType>> mappingBetweenMeshes(std::string sourceMeshName, std::string targetMeshName);
+
   //! return previously created mesh or create on the fly, already call functionSpace->initialize()
   template<typename FunctionSpaceType=FunctionSpace::Generic>
   std::shared_ptr<FunctionSpaceType> functionSpace(PythonConfig settings);
@@ -200,4 +200,30 @@ void Manager::initializeMappingsBetweenMeshes(const std::shared_ptr<FunctionSpac
 }
 
 
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+std::shared_ptr<MappingBetweenMeshes<FunctionSpaceSourceType,FunctionSpaceTargetType>> Manager::
+mappingBetweenMeshes(std::string sourceMeshName, std::string targetMeshName)
+{
+  if (mappingsBetweenMeshes_.find(sourceMeshName) == mappingsBetweenMeshes_.end())
+    return nullptr;
+
+  if (mappingsBetweenMeshes_[sourceMeshName].find(targetMeshName) == mappingsBetweenMeshes_[sourceMeshName].end())
+    return nullptr;
+
+  std::shared_ptr<MappingBetweenMeshesBase> mappingBase = mappingsBetweenMeshes_[sourceMeshName][targetMeshName];
+
+  // the mapping is not yet initialized
+  if (!mappingBase)
+    return nullptr;
+
+  std::shared_ptr<MappingBetweenMeshes<FunctionSpaceSourceType,FunctionSpaceTargetType>> mapping
+    = std::dynamic_pointer_cast<MappingBetweenMeshes<FunctionSpaceSourceType,FunctionSpaceTargetType>>(mappingBase);
+  if (!mapping)
+  {
+    LOG(FATAL) << "The mapping between meshes \"" << sourceMeshName << "\" and \"" << targetMeshName << "\" was created for different function space types than "
+      << typeid(FunctionSpaceSourceType).name() << " and " << typeid(FunctionSpaceTargetType).name() << ".";
+  }
+  return mapping;
+}
+
 }   // namespace
@@ -27,6 +27,8 @@
 #include "time_stepping_scheme/explicit_euler.h"
 #include "time_stepping_scheme/implicit_euler.h"
 #include "time_stepping_scheme/heun.h"
+#include "time_stepping_scheme/rush_larsen.h"
+#include "time_stepping_scheme/runge_kutta_4.h"
 #include "time_stepping_scheme/multidomain_solver.h"
 
 #include "spatial_discretization/finite_element_method/05_time_stepping.h"
@@ -46,6 +46,12 @@ public:
   //! return the data object
   Data &data();
 
+  //! the first term of the splitting
+  TimeStepping1 &timeStepping1();
+
+  //! the second term of the splitting
+  TimeStepping2 &timeStepping2();
+
 protected:
 
   TimeStepping1 timeStepping1_;    ///< the object to be discretized
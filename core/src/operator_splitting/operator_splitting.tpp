@@ -127,5 +127,19 @@ data()
   return timeStepping1_.data();
 }
 
+template<typename TimeStepping1, typename TimeStepping2>
+TimeStepping1 &OperatorSplitting<TimeStepping1, TimeStepping2>::
+timeStepping1()
+{
+  return timeStepping1_;
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+TimeStepping2 &OperatorSplitting<TimeStepping1, TimeStepping2>::
+timeStepping2()
+{
+  return timeStepping2_;
+}
+
 
 }  // namespace
@@ -24,6 +24,19 @@ class SolutionVectorMapping
 {
 };
 
+//! return a copy of the transferable solution data with all prefactors set to 1, a transfer with it only copies or shares the values.
+//! This is used for transfers that do not belong to a splitting step, e.g. by the option "transferAfterTimeSpan" of Strang.
+template<typename TransferableSolutionDataType>
+TransferableSolutionDataType withoutPrefactor(const TransferableSolutionDataType &transferableSolutionData);
+
+//! return a copy of the transferable solution data of a field variable with prefactor 1
+template<typename FieldVariableType>
+std::tuple<std::shared_ptr<FieldVariableType>,int,double> withoutPrefactor(const std::tuple<std::shared_ptr<FieldVariableType>,int,double> &transferableSolutionData);
+
+//! return a copy of the transferable solution data of multiple instances with prefactors 1
+template<typename TransferableSolutionDataType>
+std::vector<TransferableSolutionDataType> withoutPrefactor(const std::vector<TransferableSolutionDataType> &transferableSolutionData);
+
 /** Transfer between two field variables with given component number, both field variables have a component no. != 1
  */
 template<typename FunctionSpaceType1, int nComponents1, typename FunctionSpaceType2, int nComponents2>
@@ -3,6 +3,75 @@
 #include <vector>
 #include <tuple>
 #include "easylogging++.h"
+#include "mesh/mesh_manager.h"
+
+/** Copy the values of source to target and scale them by prefactor in the same pass
+ */
+inline void copyScaled(Vec source, Vec target, double prefactor)
+{
+  PetscErrorCode ierr;
+  if (prefactor == 1.0)
+  {
+    ierr = VecCopy(source, target); CHKERRV(ierr);
+  }
+  else
+  {
+    // target = prefactor*source + 0*target, this avoids a separate VecScale
+    ierr = VecAXPBY(target, prefactor, 0.0, source); CHKERRV(ierr);
+  }
+}
+
+/** If the field variables are defined on different meshes and a mapping between the meshes is specified under "MappingsBetweenMeshes",
+ *  map the component of fieldVariable1 to the component of fieldVariable2 and scale it by prefactor. Return false if there is no such mapping.
+ */
+template<typename FunctionSpaceType1, int nComponents1, typename FunctionSpaceType2, int nComponents2>
+bool mapBetweenMeshes(FieldVariable::FieldVariable<FunctionSpaceType1,nComponents1> &fieldVariable1, int componentNo1,
+                      FieldVariable::FieldVariable<FunctionSpaceType2,nComponents2> &fieldVariable2, int componentNo2, double prefactor)
+{
+  std::string meshName1 = fieldVariable1.functionSpace()->meshName();
+  std::string meshName2 = fieldVariable2.functionSpace()->meshName();
+  if (meshName1 == meshName2)
+    return false;
+
+  std::shared_ptr<Mesh::MappingBetweenMeshes<FunctionSpaceType1,FunctionSpaceType2>> mapping
+    = DihuContext::meshManager()->template mappingBetweenMeshes<FunctionSpaceType1,FunctionSpaceType2>(meshName1, meshName2);
+  if (!mapping)
+    return false;
+
+  LOG(DEBUG) << "SolutionVectorMapping map from mesh \"" << meshName1 << "\" to \"" << meshName2 << "\"";
+  mapping->map(fieldVariable1, componentNo1, fieldVariable2, componentNo2);
+
+  if (prefactor != 1.0)
+  {
+    PetscErrorCode ierr;
+    ierr = VecScale(fieldVariable2.valuesGlobal(componentNo2), prefactor); CHKERRABORT(fieldVariable2.functionSpace()->meshPartition()->mpiCommunicator(), ierr);
+  }
+  return true;
+}
+
+template<typename TransferableSolutionDataType>
+TransferableSolutionDataType withoutPrefactor(const TransferableSolutionDataType &transferableSolutionData)
+{
+  // this type has no prefactor
+  return transferableSolutionData;
+}
+
+template<typename FieldVariableType>
+std::tuple<std::shared_ptr<FieldVariableType>,int,double> withoutPrefactor(const std::tuple<std::shared_ptr<FieldVariableType>,int,double> &transferableSolutionData)
+{
+  return std::tuple<std::shared_ptr<FieldVariableType>,int,double>(std::get<0>(transferableSolutionData), std::get<1>(transferableSolutionData), 1.0);
+}
+
+template<typename TransferableSolutionDataType>
+std::vector<TransferableSolutionDataType> withoutPrefactor(const std::vector<TransferableSolutionDataType> &transferableSolutionData)
+{
+  std::vector<TransferableSolutionDataType> result;
+  for (const TransferableSolutionDataType &entry : transferableSolutionData)
+  {
+    result.push_back(withoutPrefactor(entry));
+  }
+  return result;
+}
 
 /** Transfer between two field variables with given component number
  */
@@ -30,6 +99,10 @@ void SolutionVectorMapping<
     << componentNo1 << " (" << fieldVariable1->nDofsLocalWithoutGhosts() << " dofs), prefactor " << prefactor1
     << " to " << componentNo2 << " (" << fieldVariable2->nDofsLocalWithoutGhosts() << " dofs), prefactor " << prefactor2 << " (not considered here)";
 
+  // field variables on different meshes are coupled by a mapping between the meshes
+  if (mapBetweenMeshes(*fieldVariable1, componentNo1, *fieldVariable2, componentNo2, prefactor1))
+    return;
+
   assert(fieldVariable1->nDofsLocalWithoutGhosts() == fieldVariable2->nDofsLocalWithoutGhosts());
   assert(fieldVariable1->nDofsGlobal() == fieldVariable2->nDofsGlobal());
 
@@ -39,19 +112,18 @@ void SolutionVectorMapping<
     LOG(DEBUG) << "SolutionVectorMapping restoreExtractedComponent (1)";
     // tranfer from finite elements back to cellml
     fieldVariable2->restoreExtractedComponent(fieldVariable1->partitionedPetscVec());
+
+    // scale result with prefactor1, the values are shared, therefore this acts on the memory of fieldVariable1
+    if (prefactor1 != 1.0)
+    {
+      PetscErrorCode ierr;
+      ierr = VecScale(fieldVariable2->valuesGlobal(componentNo2), prefactor1); CHKERRV(ierr);
+    }
   }
   else
   {
     LOG(DEBUG) << "SolutionVectorMapping copy (1)";
-    PetscErrorCode ierr;
-    ierr = VecCopy(fieldVariable1->valuesGlobal(componentNo1), fieldVariable2->valuesGlobal(componentNo2)); CHKERRV(ierr);
-  }
-
-  // scale result with prefactor1
-  if (prefactor1 != 1.0)
-  {
-    PetscErrorCode ierr;
-    ierr = VecScale(fieldVariable2->valuesGlobal(componentNo2), prefactor1); CHKERRV(ierr);
+    copyScaled(fieldVariable1->valuesGlobal(componentNo1), fieldVariable2->valuesGlobal(componentNo2), prefactor1);
   }
 }
 
@@ -81,6 +153,10 @@ void SolutionVectorMapping<
     << componentNo1 << " (" << fieldVariable1->nDofsLocalWithoutGhosts() << " dofs), prefactor " << prefactor1
     << " to " << componentNo2 << " (" << fieldVariable2->nDofsLocalWithoutGhosts() << " dofs), prefactor " << prefactor2 << " (not considered here)";
 
+  // field variables on different meshes are coupled by a mapping between the meshes
+  if (mapBetweenMeshes(*fieldVariable1, componentNo1, *fieldVariable2, componentNo2, prefactor1))
+    return;
+
   assert(fieldVariable1->nDofsLocalWithoutGhosts() == fieldVariable2->nDofsLocalWithoutGhosts());
   assert(fieldVariable1->nDofsGlobal() == fieldVariable2->nDofsGlobal());
 
@@ -90,6 +166,13 @@ void SolutionVectorMapping<
     LOG(DEBUG) << "SolutionVectorMapping restoreExtractedComponent (2)";
     // tranfer from finite elements back to cellml
     fieldVariable2->restoreExtractedComponent(fieldVariable1->partitionedPetscVec());
+
+    // scale result with prefactor1, the values are shared, therefore this acts on the memory of fieldVariable1
+    if (prefactor1 != 1.0)
+    {
+      PetscErrorCode ierr;
+      ierr = VecScale(fieldVariable2->valuesGlobal(componentNo2), prefactor1); CHKERRV(ierr);
+    }
   }
   else
   {
@@ -99,15 +182,7 @@ void SolutionVectorMapping<
       << Partition::valuesRepresentationString[fieldVariable2->partitionedPetscVec()->currentRepresentation()]
       << "";
 
-    PetscErrorCode ierr;
-    ierr = VecCopy(fieldVariable1->valuesGlobal(componentNo1), fieldVariable2->valuesGlobal(componentNo2)); CHKERRV(ierr);
-  }
-
-  // scale result with prefactor1
-  if (prefactor1 != 1.0)
-  {
-    PetscErrorCode ierr;
-    ierr = VecScale(fieldVariable2->valuesGlobal(componentNo2), prefactor1); CHKERRV(ierr);
+    copyScaled(fieldVariable1->valuesGlobal(componentNo1), fieldVariable2->valuesGlobal(componentNo2), prefactor1);
   }
 }
 
@@ -137,6 +212,10 @@ void SolutionVectorMapping<
     << componentNo1 << " (" << fieldVariable1->nDofsLocalWithoutGhosts() << " dofs), prefactor " << prefactor1
     << " to " << componentNo2 << " (" << fieldVariable2->nDofsLocalWithoutGhosts() << " dofs), prefactor " << prefactor2 << " (not considered here)";
 
+  // field variables on different meshes are coupled by a mapping between the meshes
+  if (mapBetweenMeshes(*fieldVariable1, componentNo1, *fieldVariable2, componentNo2, prefactor1))
+    return;
+
   assert(fieldVariable1->nDofsLocalWithoutGhosts() == fieldVariable2->nDofsLocalWithoutGhosts());
   assert(fieldVariable1->nDofsGlobal() == fieldVariable2->nDofsGlobal());
 
@@ -145,6 +224,12 @@ void SolutionVectorMapping<
   {
     LOG(FATAL) << "fieldVariable2 has invalid representation (should not happen). Maybe check if both field variables have nComponents = 1 (this is not implemented).";
   }
+  else if (fieldVariable1->partitionedPetscVec()->currentRepresentation() == Partition::values_representation_t::representationInvalid)
+  {
+    // the component is still shared with fieldVariable2 from a previous transfer in the same direction without prefactor (see withoutPrefactor),
+    // the values do not have to be shared again, but the prefactor of this transfer has to be applied
+    LOG(DEBUG) << "SolutionVectorMapping component is already shared (3)";
+  }
   else
   {
     LOG(DEBUG) << "SolutionVectorMapping extractComponentShared (3)";
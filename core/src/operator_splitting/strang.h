@@ -18,8 +18,33 @@ public:
 
   //! advance time stepping by span
   void advanceTimeSpan();
+
+  //! The following methods are the steps of advanceTimeSpan apart from the advancing of the terms themselves.
+  //! They are used when the terms of multiple Strang objects are advanced together (Control::BatchedAdvance).
+
+  //! prepare a new time span, hand the solution back to timeStepping1 if it was transferred to timeStepping2 at the end of the last time span
+  void startTimeSpan();
+
+  //! transfer the solution from timeStepping1 to timeStepping2, after the first half step of timeStepping1
+  void transferToTimeStepping2();
+
+  //! transfer the solution from timeStepping2 to timeStepping1, after the full step of timeStepping2
+  void transferToTimeStepping1();
+
+  //! finish a time span, transfer the solution to timeStepping2 if transferAfterTimeSpan is set
+  void finishTimeSpan();
+
+  //! the number of groups of instances for the pipelined execution in Control::BatchedAdvance, set by the option "nPipelineGroups"
+  int nPipelineGroups() const;
+
+protected:
+
+  bool transferAfterTimeSpan_;        ///< if the solution of timeStepping1 is transferred to timeStepping2 at the end of advanceTimeSpan, such that the data of timeStepping2 is up to date between two calls
+  int nPipelineGroups_;               ///< number of groups of instances that are pipelined when multiple Strang objects are advanced together, option "nPipelineGroups"
+  bool timeStepping2HoldsSolution_;   ///< if the last transfer was from timeStepping1 to timeStepping2 at the end of advanceTimeSpan, then the solution has to be handed back to timeStepping1 before it can continue
 };
 
 }  // namespace
 
 #include "operator_splitting/strang.tpp"
+#include "control/batched_advance/batched_advance_strang.h"
@@ -10,8 +10,10 @@ namespace OperatorSplitting
 template<typename TimeStepping1, typename TimeStepping2>
 Strang<TimeStepping1,TimeStepping2>::
 Strang(DihuContext context) :
-  OperatorSplitting<TimeStepping1,TimeStepping2>(context, "StrangSplitting")
+  OperatorSplitting<TimeStepping1,TimeStepping2>(context, "StrangSplitting"), timeStepping2HoldsSolution_(false)
 {
+  transferAfterTimeSpan_ = this->specificSettings_.getOptionBool("transferAfterTimeSpan", false);
+  nPipelineGroups_ = this->specificSettings_.getOptionInt("nPipelineGroups", 1, PythonUtility::Positive);
 }
 
 template<typename TimeStepping1, typename TimeStepping2>
@@ -38,6 +40,9 @@ advanceTimeSpan()
   //        |
   //        2
 
+  // hand the solution back to timeStepping1 if it was transferred to timeStepping2 at the end of the last call
+  startTimeSpan();
+
   // loop over time steps
   double currentTime = this->startTime_;
   double midTime = 0.0;
@@ -62,11 +67,8 @@ advanceTimeSpan()
     // advance simulation by time span
     this->timeStepping1_.advanceTimeSpan();
 
-    LOG(DEBUG) << "  Strang: transfer timeStepping1 -> timeStepping2";
-
     // scale solution in timeStepping1 and transfer to timestepping2_
-    SolutionVectorMapping<typename TimeStepping1::TransferableSolutionDataType, typename TimeStepping2::TransferableSolutionDataType>::
-      transfer(this->timeStepping1_.getSolutionForTransferInOperatorSplitting(), this->timeStepping2_.getSolutionForTransferInOperatorSplitting());
+    transferToTimeStepping2();
 
     LOG(DEBUG) << "  Strang: timeStepping2 (complete) advanceTimeSpan [" << currentTime << ", " << currentTime+this->timeStepWidth_<< "]";
     // set timespan for timestepping2
@@ -75,10 +77,8 @@ advanceTimeSpan()
     // advance simulation by time span
     this->timeStepping2_.advanceTimeSpan();
 
-    LOG(DEBUG) << "  Strang: transfer timeStepping2 -> timeStepping1";
     // scale solution in timeStepping2 and transfer to timestepping1_
-    SolutionVectorMapping<typename TimeStepping2::TransferableSolutionDataType, typename TimeStepping1::TransferableSolutionDataType>::
-      transfer(this->timeStepping2_.getSolutionForTransferInOperatorSplitting(), this->timeStepping1_.getSolutionForTransferInOperatorSplitting());
+    transferToTimeStepping1();
 
     LOG(DEBUG) << "  Strang: timeStepping1 (second half) advanceTimeSpan [" << midTime << ", " << currentTime+this->timeStepWidth_<< "]";
     // set timespan for timestepping1
@@ -87,33 +87,79 @@ advanceTimeSpan()
     // advance simulation by time span
     this->timeStepping1_.advanceTimeSpan();
 
-    /* option 1. (implemented)
-     * no need to transfer data again, since next operator splitting step will start with timeStepping1 (which has the actual data).
-     *
-     * Then we could skip output of this->timeStepping2_.data(). However, if they are needed in between two operator splitting steps (for example in the 3-scale muscle model)
-     * then this->timeStepping2_.data() should have the actualized data.
-     */
-
-    /* option 2. transfer data. (not implemented)
-     * the second option to not transfer the data again is needed, because two subsequent transfers in the same direction yield an error with shared field variables.
-     * When this will be needed in the future, there have to be actually two transfers timeStepping1->timeStepping2 and timeStepping->timeStepping1 again,
-     * to have a matching VecResetArray to the previous VecPlaceArray.
-     */
-#if 0
-    LOG(DEBUG) << "  Strang: transfer timeStepping1 -> timeStepping2";
-    // scale solution in timeStepping1 and transfer to timestepping2_
-    SolutionVectorMapping<typename TimeStepping1::TransferableSolutionDataType, typename TimeStepping2::TransferableSolutionDataType>::
-      transfer(this->timeStepping1_.getSolutionForTransferInOperatorSplitting(), this->timeStepping2_.getSolutionForTransferInOperatorSplitting());
-#endif
+    // no need to transfer data again, since next operator splitting step will start with timeStepping1 (which has the actual data).
 
     // advance simulation time
     timeStepNo++;
     currentTime = this->startTime_ + double(timeStepNo) / this->numberTimeSteps_ * timeSpan;
   }
 
+  // transfer the final solution to timeStepping2 if this is requested by transferAfterTimeSpan
+  finishTimeSpan();
+
   // stop duration measurement
   if (this->durationLogKey_ != "")
     Control::PerformanceMeasurement::stop(this->durationLogKey_);
 }
 
+template<typename TimeStepping1, typename TimeStepping2>
+void Strang<TimeStepping1,TimeStepping2>::
+startTimeSpan()
+{
+  // hand the solution back to timeStepping1 if it was transferred to timeStepping2 at the end of the last call,
+  // for shared field variables this restores the extracted component and needs no copy. As the transfer at the end of the last call, this does not apply the prefactors.
+  if (timeStepping2HoldsSolution_)
+  {
+    LOG(DEBUG) << "  Strang: transfer timeStepping2 -> timeStepping1 (hand back solution of last time span)";
+    SolutionVectorMapping<typename TimeStepping2::TransferableSolutionDataType, typename TimeStepping1::TransferableSolutionDataType>::
+      transfer(withoutPrefactor(this->timeStepping2_.getSolutionForTransferInOperatorSplitting()),
+               withoutPrefactor(this->timeStepping1_.getSolutionForTransferInOperatorSplitting()));
+    timeStepping2HoldsSolution_ = false;
+  }
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void Strang<TimeStepping1,TimeStepping2>::
+transferToTimeStepping2()
+{
+  LOG(DEBUG) << "  Strang: transfer timeStepping1 -> timeStepping2";
+  SolutionVectorMapping<typename TimeStepping1::TransferableSolutionDataType, typename TimeStepping2::TransferableSolutionDataType>::
+    transfer(this->timeStepping1_.getSolutionForTransferInOperatorSplitting(), this->timeStepping2_.getSolutionForTransferInOperatorSplitting());
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void Strang<TimeStepping1,TimeStepping2>::
+transferToTimeStepping1()
+{
+  LOG(DEBUG) << "  Strang: transfer timeStepping2 -> timeStepping1";
+  SolutionVectorMapping<typename TimeStepping2::TransferableSolutionDataType, typename TimeStepping1::TransferableSolutionDataType>::
+    transfer(this->timeStepping2_.getSolutionForTransferInOperatorSplitting(), this->timeStepping1_.getSolutionForTransferInOperatorSplitting());
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void Strang<TimeStepping1,TimeStepping2>::
+finishTimeSpan()
+{
+  /* If the data of timeStepping2 is needed in between two calls to advanceTimeSpan (for example in the 3-scale muscle model),
+   * transfer the final solution to timeStepping2. For shared field variables, this extracts the component again and the matching
+   * restore (VecResetArray to the previous VecPlaceArray) is done by the transfer back at the beginning of the next call.
+   * Both transfers are done without the prefactors, such that the result is the same as without transferAfterTimeSpan.
+   */
+  if (transferAfterTimeSpan_)
+  {
+    LOG(DEBUG) << "  Strang: transfer timeStepping1 -> timeStepping2 (end of time span)";
+    SolutionVectorMapping<typename TimeStepping1::TransferableSolutionDataType, typename TimeStepping2::TransferableSolutionDataType>::
+      transfer(withoutPrefactor(this->timeStepping1_.getSolutionForTransferInOperatorSplitting()),
+               withoutPrefactor(this->timeStepping2_.getSolutionForTransferInOperatorSplitting()));
+    timeStepping2HoldsSolution_ = true;
+  }
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+int Strang<TimeStepping1,TimeStepping2>::
+nPipelineGroups() const
+{
+  return nPipelineGroups_;
+}
+
 }  // namespace
@@ -22,6 +22,11 @@
 namespace OutputWriter
 {
 
+Exfile::Exfile(DihuContext context, PythonConfig settings) : Generic(context, settings)
+{
+  sphereSize_ = settings.getOptionString("sphereSize", "0.005*0.005*0.01");
+}
+
 void Exfile::outputComFile()
 {
   std::stringstream s;
@@ -47,8 +52,6 @@ void Exfile::outputComFile()
     << "# run by cmgui " << basename << ".com" << std::endl << std::endl;
   file << "# read files" << std::endl;
 
-  std::string sphereSize = this->specificSettings_.getOptionString("sphereSize", "0.005*0.005*0.01");
-  
   std::string lastMeshName;
   int lastDimensionality = 3;
   
@@ -110,7 +113,7 @@ void Exfile::outputComFile()
     file << std::endl
       << "##### 1D mesh #####" << std::endl
       << "# add spheres representation" << std::endl
-      << "gfx modify g_element $group points domain_mesh1d coordinate geometry glyph sphere size \"" << sphereSize << "\" select_on material default data solution" << std::endl << std::endl;
+      << "gfx modify g_element $group points domain_mesh1d coordinate geometry glyph sphere size \"" << sphereSize_ << "\" select_on material default data solution" << std::endl << std::endl;
   }
   
   file << "# add axes" << std::endl
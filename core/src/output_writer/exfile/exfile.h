@@ -15,7 +15,7 @@ class Exfile : public Generic
 public:
 
   //! constructor
-  using Generic::Generic;
+  Exfile(DihuContext context, PythonConfig specificSettings);
 
   //! write out solution to given filename, if timeStepNo is not -1, this value will be part of the filename
   template<typename DataType>
@@ -35,6 +35,7 @@ private:
     int dimensionality;   ///< the dimensionality of the mesh, i.e. 1, 2 or 3
   };
   
+  std::string sphereSize_;    ///< the size of the glyphs for the nodes in the com file, option "sphereSize"
   std::map<double,std::vector<FilenameWithElementAndNodeCount>> filenamesWithElementAndNodeCount_;   ///< for a given simulation time the filenames without suffix of all previously output exelem files
 };
 
@@ -24,7 +24,7 @@ namespace ParaviewLoopOverTuple
 template<typename OutputFieldVariablesType, typename AllOutputFieldVariablesType, int i=0>
 inline typename std::enable_if<i == std::tuple_size<OutputFieldVariablesType>::value, void>::type
 loopOutput(const OutputFieldVariablesType &fieldVariables, const AllOutputFieldVariablesType &allFieldVariables, std::string meshName,
-           std::string filename, PythonConfig specificSettings
+           std::string filename, bool binaryOutput, bool fixedFormat
 )
 {}
 
@@ -34,7 +34,7 @@ loopOutput(const OutputFieldVariablesType &fieldVariables, const AllOutputFieldV
 template<typename OutputFieldVariablesType, typename AllOutputFieldVariablesType, int i=0>
 inline typename std::enable_if<i < std::tuple_size<OutputFieldVariablesType>::value, void>::type
 loopOutput(const OutputFieldVariablesType &fieldVariables, const AllOutputFieldVariablesType &allFieldVariables, std::string meshName, 
-           std::string filename, PythonConfig specificSettings);
+           std::string filename, bool binaryOutput, bool fixedFormat);
 
 
 /** Loop body for a vector element
@@ -42,21 +42,21 @@ loopOutput(const OutputFieldVariablesType &fieldVariables, const AllOutputFieldV
 template<typename VectorType, typename OutputFieldVariablesType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 output(VectorType currentFieldVariableVector, const OutputFieldVariablesType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings);
+       std::string filename, bool binaryOutput, bool fixedFormat);
 
 /** Loop body for a tuple element
  */
 template<typename VectorType, typename OutputFieldVariablesType>
 typename std::enable_if<TypeUtility::isTuple<VectorType>::value, bool>::type
 output(VectorType currentFieldVariableVector, const OutputFieldVariablesType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings);
+       std::string filename, bool binaryOutput, bool fixedFormat);
 
  /**  Loop body for a pointer element
  */
 template<typename CurrentFieldVariableType, typename OutputFieldVariablesType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value, bool>::type
 output(CurrentFieldVariableType currentFieldVariable, const OutputFieldVariablesType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings);
+       std::string filename, bool binaryOutput, bool fixedFormat);
 
 }  // namespace ParaviewLoopOverTuple
 
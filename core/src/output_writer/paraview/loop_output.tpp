@@ -17,23 +17,23 @@ namespace ParaviewLoopOverTuple
 template<typename OutputFieldVariablesType, typename AllOutputFieldVariablesType, int i>
 inline typename std::enable_if<i < std::tuple_size<OutputFieldVariablesType>::value, void>::type
 loopOutput(const OutputFieldVariablesType &fieldVariables, const AllOutputFieldVariablesType &allFieldVariables,
-           std::string meshName, std::string filename, PythonConfig specificSettings
+           std::string meshName, std::string filename, bool binaryOutput, bool fixedFormat
 )
 {
   // call what to do in the loop body
   if (output<typename std::tuple_element<i,OutputFieldVariablesType>::type, AllOutputFieldVariablesType>(
-        std::get<i>(fieldVariables), allFieldVariables, meshName, filename, specificSettings))
+        std::get<i>(fieldVariables), allFieldVariables, meshName, filename, binaryOutput, fixedFormat))
     return;
   
   // advance iteration to next tuple element
-  loopOutput<OutputFieldVariablesType, AllOutputFieldVariablesType, i+1>(fieldVariables, allFieldVariables, meshName, filename, specificSettings);
+  loopOutput<OutputFieldVariablesType, AllOutputFieldVariablesType, i+1>(fieldVariables, allFieldVariables, meshName, filename, binaryOutput, fixedFormat);
 }
  
 // current element is of pointer type (not vector)
 template<typename CurrentFieldVariableType, typename OutputFieldVariablesType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value, bool>::type
 output(CurrentFieldVariableType currentFieldVariable, const OutputFieldVariablesType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings)
+       std::string filename, bool binaryOutput, bool fixedFormat)
 {
   // if mesh name is the specified meshName
   if (currentFieldVariable->functionSpace()->meshName() == meshName)
@@ -45,7 +45,7 @@ output(CurrentFieldVariableType currentFieldVariable, const OutputFieldVariables
     LoopOverTuple::loopCountNFieldVariablesOfMesh(fieldVariables, meshName, nFieldVariablesInMesh);
     
     // call exfile writer to output all field variables with the meshName
-    ParaviewWriter<FunctionSpace, OutputFieldVariablesType>::outputFile(filename, fieldVariables, meshName, currentFieldVariable->functionSpace(), nFieldVariablesInMesh, specificSettings);
+    ParaviewWriter<FunctionSpace, OutputFieldVariablesType>::outputFile(filename, fieldVariables, meshName, currentFieldVariable->functionSpace(), nFieldVariablesInMesh, binaryOutput, fixedFormat);
    
     return true;  // break iteration
   }
@@ -57,12 +57,12 @@ output(CurrentFieldVariableType currentFieldVariable, const OutputFieldVariables
 template<typename VectorType, typename OutputFieldVariablesType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 output(VectorType currentFieldVariableVector, const OutputFieldVariablesType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings)
+       std::string filename, bool binaryOutput, bool fixedFormat)
 {
   for (auto& currentFieldVariable : currentFieldVariableVector)
   {
     // call function on all vector entries
-    if (output<typename VectorType::value_type,OutputFieldVariablesType>(currentFieldVariable, fieldVariables, meshName, filename, specificSettings))
+    if (output<typename VectorType::value_type,OutputFieldVariablesType>(currentFieldVariable, fieldVariables, meshName, filename, binaryOutput, fixedFormat))
       return true; // break iteration
   }
   return false;  // do not break iteration 
@@ -72,10 +72,10 @@ output(VectorType currentFieldVariableVector, const OutputFieldVariablesType &fi
 template<typename TupleType, typename AllOutputFieldVariablesType>
 typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
 output(TupleType currentFieldVariableTuple, const AllOutputFieldVariablesType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings)
+       std::string filename, bool binaryOutput, bool fixedFormat)
 {
   // call for tuple element
-  loopOutput<TupleType, AllOutputFieldVariablesType>(currentFieldVariableTuple, fieldVariables, meshName, filename, specificSettings);
+  loopOutput<TupleType, AllOutputFieldVariablesType>(currentFieldVariableTuple, fieldVariables, meshName, filename, binaryOutput, fixedFormat);
   
   return false;  // do not break iteration 
 }
@@ -21,6 +21,10 @@ namespace OutputWriter
 Paraview::Paraview(DihuContext context, PythonConfig settings) :
   Generic(context, settings)
 {
+  if (settings.hasKey("binaryOutput"))
+  {
+    LOG(ERROR) << "Key \"binaryOutput\" for Paraview output was recently changed to \"binary\"!";
+  }
   binaryOutput_ = settings.getOptionBool("binary", true);
   fixedFormat_ = settings.getOptionBool("fixedFormat", true);
   combineFiles_ = settings.getOptionBool("combineFiles", false);
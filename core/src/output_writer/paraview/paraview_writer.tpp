@@ -15,7 +15,7 @@ template<int D, typename BasisFunctionType, typename OutputFieldVariablesType>
 void ParaviewWriter<FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<D>, BasisFunctionType>, OutputFieldVariablesType>::
 outputFile(std::string filename, OutputFieldVariablesType fieldVariables, std::string meshName, 
            std::shared_ptr<FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<D>, BasisFunctionType>> mesh,
-           int nFieldVariablesOfMesh, PythonConfig specificSettings)
+           int nFieldVariablesOfMesh, bool binaryOutput, bool fixedFormat)
 {
   // write a RectilinearGrid
 
@@ -26,13 +26,6 @@ outputFile(std::string filename, OutputFieldVariablesType fieldVariables, std::s
   std::vector<std::string> namesScalars, namesVectors;
   ParaviewLoopOverTuple::loopCollectFieldVariablesNames(fieldVariables, meshName, namesScalars, namesVectors);
 
-  if (specificSettings.hasKey("binaryOutput"))
-  {
-    LOG(ERROR) << "Key \"binaryOutput\" for Paraview output was recently changed to \"binary\"!";
-  }
-  bool binaryOutput = specificSettings.getOptionBool("binary", true);
-  bool fixedFormat = specificSettings.getOptionBool("fixedFormat", true);
-
   // determine file name
   std::stringstream s;
   if (mesh->meshPartition()->nRanks() > 1 && mesh->meshPartition()->ownRankNo() == 0)
@@ -290,7 +283,7 @@ template<int D, typename BasisFunctionType, typename OutputFieldVariablesType>
 void ParaviewWriter<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>, BasisFunctionType>, OutputFieldVariablesType>::
 outputFile(std::string filename, OutputFieldVariablesType fieldVariables, std::string meshName, 
            std::shared_ptr<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>, BasisFunctionType>> mesh,
-           int nFieldVariablesOfMesh, PythonConfig specificSettings)
+           int nFieldVariablesOfMesh, bool binaryOutput, bool fixedFormat)
 {
   // write a StructuredGrid
 
@@ -301,13 +294,6 @@ outputFile(std::string filename, OutputFieldVariablesType fieldVariables, std::s
   std::vector<std::string> namesScalars, namesVectors;
   ParaviewLoopOverTuple::loopCollectFieldVariablesNames(fieldVariables, meshName, namesScalars, namesVectors);
 
-  if (specificSettings.hasKey("binaryOutput"))
-  {
-    LOG(ERROR) << "Key \"binaryOutput\" for Paraview output was recently changed to \"binary\"!";
-  }
-  bool binaryOutput = specificSettings.getOptionBool("binary", true);
-  bool fixedFormat = specificSettings.getOptionBool("fixedFormat", true);
-
   // determine file name
   std::stringstream s;
   if (mesh->meshPartition()->nRanks() > 1 && mesh->meshPartition()->ownRankNo() == 0)
@@ -493,7 +479,7 @@ template<int D, typename BasisFunctionType, typename OutputFieldVariablesType>
 void ParaviewWriter<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, OutputFieldVariablesType>::
 outputFile(std::string filename, OutputFieldVariablesType fieldVariables, std::string meshName, 
            std::shared_ptr<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>> mesh,
-           int nFieldVariablesOfMesh, PythonConfig specificSettings)
+           int nFieldVariablesOfMesh, bool binaryOutput, bool fixedFormat)
 {
   // write an UnstructuredGrid
   // determine file name
@@ -511,13 +497,6 @@ outputFile(std::string filename, OutputFieldVariablesType fieldVariables, std::s
   
   
   // name of value field
-  if (specificSettings.hasKey("binaryOutput"))
-  {
-    LOG(ERROR) << "Key \"binaryOutput\" for Paraview output was recently changed to \"binary\"!";
-  }
-  bool binaryOutput = specificSettings.getOptionBool("binary", true);
-  bool fixedFormat = specificSettings.getOptionBool("fixedFormat", true);
-
   // write file
   file << "<?xml version=\"1.0\"?>" << std::endl
     << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\">" << std::endl    // intel cpus are LittleEndian
@@ -12,6 +12,7 @@ namespace OutputWriter
 PythonFile::PythonFile(DihuContext context, PythonConfig settings) : Generic(context, settings)
 {
   onlyNodalValues_ = settings.getOptionBool("onlyNodalValues", true);
+  binaryOutput_ = settings.getOptionBool("binary", false);
 }
 
 PyObject *PythonFile::openPythonFileStream(std::string filename, std::string writeFlag)
@@ -30,6 +30,7 @@ private:
   void outputPyObject(PyObject *file, PyObject *pyData);
 
   bool onlyNodalValues_;  ///< if only nodal values should be output, this omits the derivative values for Hermite ansatz functions, for Lagrange functions it has no effect
+  bool binaryOutput_;     ///< if the data should be serialized with pickle, option "binary"
 };
 
 } // namespace
@@ -68,7 +68,7 @@ void PythonFile::write(DataType& data, int timeStepNo, double currentTime)
       ofile.close();
 
     // pickle is the python library to serialize objects
-    bool usePickle = specificSettings_.getOptionBool("binary", false);
+    bool usePickle = binaryOutput_;
 
     std::string writeFlag = (usePickle? "wb" : "w");
 
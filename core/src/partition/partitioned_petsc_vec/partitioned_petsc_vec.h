@@ -24,6 +24,7 @@ class FunctionSpace;
  *  This particular standard specialization is for non-structured meshes or no meshes and currently completely serial, 
  *  it is the placeholder as long as the partial specialization for unstructured meshes is not implemented. (It will never be)
  *  This means some of the methods here have no effect.
+ *  For more than one component, all components are stored in a single allocation and the contiguous representation is a view of the same memory.
  */
 template<typename FunctionSpaceType, int nComponents, typename = typename FunctionSpaceType::Mesh>
 class PartitionedPetscVec : 
@@ -88,6 +89,9 @@ public:
   //! set the internal representation to be contiguous, i.e. using the contiguous vectors
   void setRepresentationContiguous();
 
+  //! get a number that changes whenever the values are modified, it is the sum of the PETSc object states of all internal vectors. This is used to detect when cached data that depends on the values is outdated.
+  PetscObjectState valuesState();
+
   //! output the vector to stream, for debugging
   void output(std::ostream &stream);
 
@@ -98,11 +102,13 @@ protected:
   
   std::array<Vec,nComponents> values_;  ///< the (serial) Petsc vectors that contains all the data, one for each component
   Vec valuesContiguous_ = PETSC_NULL;   ///< global vector that has all values of the components concatenated, i.e. in a "struct of arrays" memory layout
+  std::vector<double> contiguousStorage_;   ///< for more than one component the memory of all components, values_ and valuesContiguous_ are views of it, the PETSc Vecs do not own this memory
 };
 
 /** This is the partial specialization for structured meshes.
  *  An own DMDA object is generated, separately from the one in MeshPartition. This object now refers to nodes (as opposite the one of MeshPartition which refers to elements). 
  *  This object is created such that it matches the partition given by the meshPartition.
+ *  If the local partition has no ghost dofs, all components are stored in a single allocation and the contiguous representation is a view of the same memory.
  */
 template<typename MeshType, typename BasisFunctionType, int nComponents>
 class PartitionedPetscVec<
@@ -199,6 +205,9 @@ public:
   //! set the internal representation to be contiguous, i.e. using the contiguous vectors
   void setRepresentationContiguous();
 
+  //! get a number that changes whenever the values are modified, it is the sum of the PETSc object states of all internal vectors. This is used to detect when cached data that depends on the values is outdated.
+  PetscObjectState valuesState();
+
   //! get a vector of local dof nos (from meshPartition), without ghost dofs
   std::vector<PetscInt> &localDofNosWithoutGhosts();
   
@@ -217,6 +226,8 @@ protected:
   std::array<Vec,nComponents> vectorGlobal_;  ///< the global distributed vector that holds the actual data
   Vec valuesContiguous_ = PETSC_NULL;   ///< global vector that has all values of the components concatenated, i.e. in a "struct of arrays" memory layout
   const double *extractedData_ = nullptr;   ///< the data array of valuesContiguous_, used when a component is extracted by extractComponentShared, then the representation is set to invalid
+  bool sharedContiguousStorage_ = false;   ///< if the component vectors and valuesContiguous_ are views of the same memory contiguousStorage_, then switching between local and contiguous representation needs no copy. This is possible if no rank of the partition has ghost dofs.
+  std::vector<double> contiguousStorage_;   ///< the memory of all components if sharedContiguousStorage_ is set, "struct of arrays" memory layout, the PETSc Vecs do not own this memory
   std::vector<PetscInt> temporaryIndicesVector_;   ///< a temporary vector that will be used whenever indices are to be computed, this avoids creating and deleting local vectors which is time-consuming (found out by perftools on hazelhen)
 };
 
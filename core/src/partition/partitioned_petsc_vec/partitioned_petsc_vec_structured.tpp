@@ -45,22 +45,63 @@ createVector()
   // and then fetch the local portion of the global vector together with ghost values into a local vector (VecGhostGetLocalForm),
   // then manipulate the values (using standard VecSetValues/VecGetValues routines) and commit the results (VecGhostRestoreLocalForm, VecGhostUpdateBegin, VecGhostUpdateEnd).
   
+  const dof_no_t nGhostDofs = this->meshPartition_->nDofsLocalWithGhosts() - this->meshPartition_->nDofsLocalWithoutGhosts();
+  const dof_no_t nDofsLocal = this->meshPartition_->nDofsLocalWithoutGhosts();
+
+  // If there are no ghost dofs on this rank, the local vectors of all components can be placed after each other in a single allocation.
+  // Then the contiguous vector is a view of the same memory and switching between local and contiguous representation needs no copy.
+  // With ghost dofs, the local vector of a component has to hold its ghost values directly after its own values, this does not match the contiguous layout.
+  // The creation of valuesContiguous_ is collective, therefore all ranks of the partition have to decide the same, usually the last rank has no ghost dofs but the others have.
+  sharedContiguousStorage_ = false;
+  if (nComponents > 1)
+  {
+    int noGhostDofsOnAllRanks = (nGhostDofs == 0);
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, &noGhostDofsOnAllRanks, 1, MPI_INT, MPI_LAND, this->meshPartition_->mpiCommunicator()), "MPI_Allreduce");
+    sharedContiguousStorage_ = noGhostDofsOnAllRanks;
+  }
+  if (sharedContiguousStorage_)
+  {
+    contiguousStorage_.resize(nComponents*nDofsLocal, 0.0);
+  }
+
   // loop over the components of this field variable
   for (int componentNo = 0; componentNo < nComponents; componentNo++)
   {
-    const dof_no_t nGhostDofs = this->meshPartition_->nDofsLocalWithGhosts() - this->meshPartition_->nDofsLocalWithoutGhosts();
-    ierr = VecCreateGhost(this->meshPartition_->mpiCommunicator(), this->meshPartition_->nDofsLocalWithoutGhosts(),
-                          this->meshPartition_->nDofsGlobal(), nGhostDofs, this->meshPartition_->ghostDofNosGlobalPetsc().data(), &vectorGlobal_[componentNo]); CHKERRV(ierr);
-    
-    // initialize PETSc vector object
-    //ierr = VecCreate(this->meshPartition_->mpiCommunicator(), &vectorLocal_[componentNo]); CHKERRV(ierr);
-    ierr = PetscObjectSetName((PetscObject) vectorGlobal_[componentNo], this->name_.c_str()); CHKERRV(ierr);
+    if (sharedContiguousStorage_)
+    {
+      ierr = VecCreateGhostWithArray(this->meshPartition_->mpiCommunicator(), nDofsLocal, this->meshPartition_->nDofsGlobal(), 0,
+                                     this->meshPartition_->ghostDofNosGlobalPetsc().data(), contiguousStorage_.data() + componentNo*nDofsLocal,
+                                     &vectorGlobal_[componentNo]); CHKERRV(ierr);
+      ierr = PetscObjectSetName((PetscObject) vectorGlobal_[componentNo], this->name_.c_str()); CHKERRV(ierr);
 
-    // set sparsity type and other options
-    ierr = VecSetFromOptions(vectorGlobal_[componentNo]); CHKERRV(ierr);
+      // no VecSetFromOptions here, a change of the vector type would discard the user-provided array
+    }
+    else
+    {
+      ierr = VecCreateGhost(this->meshPartition_->mpiCommunicator(), nDofsLocal,
+                            this->meshPartition_->nDofsGlobal(), nGhostDofs, this->meshPartition_->ghostDofNosGlobalPetsc().data(), &vectorGlobal_[componentNo]); CHKERRV(ierr);
+
+      // initialize PETSc vector object
+      //ierr = VecCreate(this->meshPartition_->mpiCommunicator(), &vectorLocal_[componentNo]); CHKERRV(ierr);
+      ierr = PetscObjectSetName((PetscObject) vectorGlobal_[componentNo], this->name_.c_str()); CHKERRV(ierr);
+
+      // set sparsity type and other options
+      ierr = VecSetFromOptions(vectorGlobal_[componentNo]); CHKERRV(ierr);
+    }
     ierr = VecGhostGetLocalForm(vectorGlobal_[componentNo], &vectorLocal_[componentNo]); CHKERRV(ierr);
   }
 
+  // create the contiguous vector as view on the storage of all components
+  if (sharedContiguousStorage_)
+  {
+    int nEntriesLocal = nDofsLocal * nComponents;
+    int nEntriesGlobal = this->meshPartition_->nDofsGlobal() * nComponents;
+    ierr = VecCreateMPIWithArray(this->meshPartition_->mpiCommunicator(), 1, nEntriesLocal, nEntriesGlobal, contiguousStorage_.data(), &valuesContiguous_); CHKERRV(ierr);
+    ierr = PetscObjectSetName((PetscObject) valuesContiguous_, this->name_.c_str()); CHKERRV(ierr);
+
+    VLOG(1) << "\"" << this->name_ << "\" (structured) use shared storage for " << nComponents << " components and valuesContiguous_, nEntriesLocal = " << nEntriesLocal;
+  }
+
   // createVector acts like startGhostManipulation as it also gets the local vector (VecGhostGetLocalForm) to work on.
   this->currentRepresentation_ = Partition::values_representation_t::representationLocal;
 }
@@ -571,6 +612,15 @@ getValuesContiguous()
 
   PetscErrorCode ierr;
 
+  // if the storage is shared, valuesContiguous_ already contains the values of the local vectors
+  if (sharedContiguousStorage_)
+  {
+    // the data was possibly modified through the local vectors, invalidate cached values like norms of valuesContiguous_
+    ierr = PetscObjectStateIncrease((PetscObject)valuesContiguous_); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+    this->currentRepresentation_ = Partition::values_representation_t::representationContiguous;
+    return valuesContiguous_;
+  }
+
   // create contiguos vector if it does not exist yet
   if (valuesContiguous_ == PETSC_NULL)
   {
@@ -579,7 +629,7 @@ getValuesContiguous()
 
     // initialize size of vector
     int nEntriesLocal = this->meshPartition_->nDofsLocalWithoutGhosts() * nComponents;
-    int nEntriesGlobal = nEntriesLocal;
+    int nEntriesGlobal = this->meshPartition_->nDofsGlobal() * nComponents;
     ierr = VecSetSizes(valuesContiguous_, nEntriesLocal, nEntriesGlobal); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
 
     // set sparsity type and other options
@@ -633,6 +683,20 @@ restoreValuesContiguous()
   }
 
   PetscErrorCode ierr;
+
+  // if the storage is shared, the local vectors already contain the values of valuesContiguous_
+  if (sharedContiguousStorage_)
+  {
+    // the data was possibly modified through valuesContiguous_, invalidate cached values like norms of the component vectors
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      ierr = PetscObjectStateIncrease((PetscObject)vectorLocal_[componentNo]); CHKERRV(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)vectorGlobal_[componentNo]); CHKERRV(ierr);
+    }
+    this->currentRepresentation_ = Partition::values_representation_t::representationLocal;
+    return;
+  }
+
   const double *valuesDataContiguous;
   ierr = VecGetArrayRead(valuesContiguous_, &valuesDataContiguous); CHKERRV(ierr);
 
@@ -821,6 +885,38 @@ setValues(int componentNo, std::shared_ptr<PartitionedPetscVec<FunctionSpace::Fu
   setValues(componentNo, fieldVariable->valuesLocal(0), fieldVariable->name());
 }
 
+template<typename MeshType,typename BasisFunctionType,int nComponents>
+PetscObjectState PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents,Mesh::isStructured<MeshType>>::
+valuesState()
+{
+  // The state of a PETSc object is increased by every operation that modifies the values, e.g. VecSetValues, VecAXPY or VecRestoreArray.
+  // The local vectors are the local forms of the global vectors, their states are synchronized by VecGhostRestoreLocalForm,
+  // but changes in the local representation are only visible in the states of the local vectors. Therefore the states of all vectors are summed up.
+  PetscErrorCode ierr;
+  PetscObjectState stateSum = 0;
+  PetscObjectState state;
+
+  for (int componentNo = 0; componentNo < nComponents; componentNo++)
+  {
+    ierr = PetscObjectStateGet((PetscObject)vectorGlobal_[componentNo], &state); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+    stateSum += state;
+
+    if (vectorLocal_[componentNo] != PETSC_NULL)
+    {
+      ierr = PetscObjectStateGet((PetscObject)vectorLocal_[componentNo], &state); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+      stateSum += state;
+    }
+  }
+
+  if (valuesContiguous_ != PETSC_NULL)
+  {
+    ierr = PetscObjectStateGet((PetscObject)valuesContiguous_, &state); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+    stateSum += state;
+  }
+
+  return stateSum;
+}
+
 //! get a vector of local dof nos (from meshPartition), without ghost dofs
 template<typename MeshType,typename BasisFunctionType,int nComponents>
 std::vector<PetscInt> &PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents,Mesh::isStructured<MeshType>>::
@@ -865,7 +961,7 @@ output(std::ostream &stream)
     int nDofsLocal = this->meshPartition_->nDofsLocalWithoutGhosts();
     std::vector<PetscInt> &indices = temporaryIndicesVector_;
     indices.resize(nDofsLocal);
-    if (valuesContiguous_)
+    if (vector == valuesContiguous_)
     {
       for (int i = 0; i < nDofsLocal; i++)
       {
@@ -32,6 +32,25 @@ createVector()
   
   PetscErrorCode ierr;
 
+  // for multiple components, store all components after each other in a single allocation, the component vectors and valuesContiguous_ are views of it
+  if (nComponents > 1)
+  {
+    contiguousStorage_.resize(nComponents*nEntriesLocal, 0.0);
+
+    // loop over the components of this field variable
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      ierr = VecCreateMPIWithArray(this->meshPartition_->mpiCommunicator(), 1, nEntriesLocal, nEntriesGlobal,
+                                   contiguousStorage_.data() + componentNo*nEntriesLocal, &values_[componentNo]); CHKERRV(ierr);
+      ierr = PetscObjectSetName((PetscObject) values_[componentNo], this->name_.c_str()); CHKERRV(ierr);
+    }
+
+    ierr = VecCreateMPIWithArray(this->meshPartition_->mpiCommunicator(), 1, nEntriesLocal*nComponents, nEntriesGlobal*nComponents,
+                                 contiguousStorage_.data(), &valuesContiguous_); CHKERRV(ierr);
+    ierr = PetscObjectSetName((PetscObject) valuesContiguous_, this->name_.c_str()); CHKERRV(ierr);
+    return;
+  }
+
   // loop over the components of this field variable
   for (int componentNo = 0; componentNo < nComponents; componentNo++)
   {
@@ -349,6 +368,15 @@ getValuesContiguous()
 
   PetscErrorCode ierr;
 
+  // the storage is shared, valuesContiguous_ already contains the values of the component vectors
+  if (!contiguousStorage_.empty())
+  {
+    // the data was possibly modified through the component vectors, invalidate cached values like norms of valuesContiguous_
+    ierr = PetscObjectStateIncrease((PetscObject)valuesContiguous_); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+    this->currentRepresentation_ = Partition::values_representation_t::representationContiguous;
+    return valuesContiguous_;
+  }
+
   // create contiguos vector if it does not exist yet
   if (valuesContiguous_ == PETSC_NULL)
   {
@@ -407,6 +435,19 @@ restoreValuesContiguous()
   }
 
   PetscErrorCode ierr;
+
+  // the storage is shared, the component vectors already contain the values of valuesContiguous_
+  if (!contiguousStorage_.empty())
+  {
+    // the data was possibly modified through valuesContiguous_, invalidate cached values like norms of the component vectors
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      ierr = PetscObjectStateIncrease((PetscObject)values_[componentNo]); CHKERRV(ierr);
+    }
+    this->currentRepresentation_ = Partition::values_representation_t::representationLocal;
+    return;
+  }
+
   const double *valuesDataContiguous;
   ierr = VecGetArrayRead(valuesContiguous_, &valuesDataContiguous); CHKERRV(ierr);
 
@@ -430,6 +471,30 @@ restoreValuesContiguous()
   this->currentRepresentation_ = Partition::values_representation_t::representationLocal;
 }
 
+template<typename FunctionSpaceType, int nComponents, typename DummyForTraits>
+PetscObjectState PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
+valuesState()
+{
+  // the state of a PETSc object is increased by every operation that modifies the values
+  PetscErrorCode ierr;
+  PetscObjectState stateSum = 0;
+  PetscObjectState state;
+
+  for (int componentNo = 0; componentNo < nComponents; componentNo++)
+  {
+    ierr = PetscObjectStateGet((PetscObject)values_[componentNo], &state); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+    stateSum += state;
+  }
+
+  if (valuesContiguous_ != PETSC_NULL)
+  {
+    ierr = PetscObjectStateGet((PetscObject)valuesContiguous_, &state); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+    stateSum += state;
+  }
+
+  return stateSum;
+}
+
 template<typename FunctionSpaceType, int nComponents, typename DummyForTraits>
 void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
 output(std::ostream &stream)
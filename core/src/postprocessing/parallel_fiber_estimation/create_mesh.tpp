@@ -40,32 +40,16 @@ createMesh(std::array<std::vector<std::vector<Vec3>>,4> &borderPoints, std::vect
   file.close();
 
 #else
-  // call stl_create_mesh.create_3d_mesh_from_border_points_faces
-  PyObject *borderPointsFacesPy = PythonUtility::convertToPython<std::array<std::vector<std::vector<Vec3>>,4>>::get(borderPoints);
-  PythonUtility::checkForError();
-
-  //LOG(DEBUG) << PythonUtility::getString(borderPointsFacesPy);
-  LOG(DEBUG) << "call function create_3d_mesh_from_border_points_faces";
-
-  PyObject *meshData = PyObject_CallFunction(functionCreate3dMeshFromBorderPointsFaces_, "(O)", borderPointsFacesPy);
-  PythonUtility::checkForError();
-
-  //LOG(DEBUG) << PythonUtility::getString(meshData);
-  // return value:
-  //data = {
-  //  "node_positions": node_positions,
-  //  "linear_elements": linear_elements,
-  //  "quadratic_elements": quadratic_elements,
-  //  "seed_points": seed_points,
-  //  "bottom_nodes": bottom_node_indices,
-  //  "top_nodes": top_node_indices,
-  //  "n_linear_elements_per_coordinate_direction": n_linear_elements_per_coordinate_direction,
-  //  "n_quadratic_elements_per_coordinate_direction": n_quadratic_elements_per_coordinate_direction,
-  //}
-
-  PyObject *object = PythonUtility::getOptionPyObject(meshData, "node_positions", "");
-  nodePositions = PythonUtility::convertFromPython<std::vector<Vec3>>::get(object);
-  nElementsPerCoordinateDirectionLocal = PythonUtility::getOptionArray<int,3>(meshData, "n_linear_elements_per_coordinate_direction", "", std::array<int,3>({0,0,0}));
+  if (useNativeMeshGeneration_)
+  {
+    // create the mesh by a harmonic map on every z level, without the python interpreter
+    LOG(DEBUG) << "create mesh from border points by native harmonic map";
+    HarmonicMapMesh::create3dMesh(borderPoints, nodePositions, nElementsPerCoordinateDirectionLocal);
+  }
+  else
+  {
+    createMeshPython(borderPoints, nodePositions, nElementsPerCoordinateDirectionLocal);
+  }
 
   subdomainNNodesX = nElementsPerCoordinateDirectionLocal[0]+1;
   subdomainNNodesY = nElementsPerCoordinateDirectionLocal[1]+1;
@@ -82,22 +66,6 @@ createMesh(std::array<std::vector<std::vector<Vec3>>,4> &borderPoints, std::vect
   assert(subdomainNNodesX == nBorderPointsXNew_);
   assert(subdomainNNodesY == nBorderPointsXNew_);
   assert(subdomainNNodesZ == nBorderPointsZ_);
-/*
-  // revert order of node positions
-  std::vector<Vec3> nodePositions(nodePositionsOrderReversed.size());
-  for (int z = 0; z < subdomainNNodesZ; z++)
-  {
-    for (int y = 0; y < subdomainNNodesY; y++)
-    {
-      for (int x = 0; x < subdomainNNodesX; x++)
-      {
-        nodePositions[z * subdomainNNodesX*subdomainNNodesY + y * subdomainNNodesY + x]
-          = nodePositionsOrderReversed[z * subdomainNNodesX*subdomainNNodesY + (subdomainNNodesY-1-y) * subdomainNNodesY + (subdomainNNodesX-1-x)];
-      }
-    }
-  }*/
-
-  //std::vector<Vec3> &nodePositions = nodePositionsOrderReversed;
 
 #ifdef WRITE_CHECKPOINT_MESH
   std::stringstream filename;
@@ -131,4 +99,34 @@ createMesh(std::array<std::vector<std::vector<Vec3>>,4> &borderPoints, std::vect
 #endif
 }
 
+template<typename BasisFunctionType>
+void ParallelFiberEstimation<BasisFunctionType>::
+createMeshPython(std::array<std::vector<std::vector<Vec3>>,4> &borderPoints, std::vector<Vec3> &nodePositions, std::array<int,3> &nElementsPerCoordinateDirectionLocal)
+{
+  // call stl_create_mesh.create_3d_mesh_from_border_points_faces
+  PyObject *borderPointsFacesPy = PythonUtility::convertToPython<std::array<std::vector<std::vector<Vec3>>,4>>::get(borderPoints);
+  PythonUtility::checkForError();
+
+  LOG(DEBUG) << "call function create_3d_mesh_from_border_points_faces";
+
+  PyObject *meshData = PyObject_CallFunction(functionCreate3dMeshFromBorderPointsFaces_, "(O)", borderPointsFacesPy);
+  PythonUtility::checkForError();
+
+  // return value:
+  //data = {
+  //  "node_positions": node_positions,
+  //  "linear_elements": linear_elements,
+  //  "quadratic_elements": quadratic_elements,
+  //  "seed_points": seed_points,
+  //  "bottom_nodes": bottom_node_indices,
+  //  "top_nodes": top_node_indices,
+  //  "n_linear_elements_per_coordinate_direction": n_linear_elements_per_coordinate_direction,
+  //  "n_quadratic_elements_per_coordinate_direction": n_quadratic_elements_per_coordinate_direction,
+  //}
+
+  PyObject *object = PythonUtility::getOptionPyObject(meshData, "node_positions", "");
+  nodePositions = PythonUtility::convertFromPython<std::vector<Vec3>>::get(object);
+  nElementsPerCoordinateDirectionLocal = PythonUtility::getOptionArray<int,3>(meshData, "n_linear_elements_per_coordinate_direction", "", std::array<int,3>({0,0,0}));
+}
+
 } // namespace
@@ -0,0 +1,140 @@
+#include "postprocessing/parallel_fiber_estimation/harmonic_map_mesh.h"
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+#include "easylogging++.h"
+#include "utility/vector_operators.h"
+#include "utility/math_utility.h"
+#include "mesh/face_t.h"
+
+namespace Postprocessing
+{
+
+void HarmonicMapMesh::
+createPlanarMesh(const std::array<const std::vector<Vec3> *,4> &borderPoints, int nNodesX, int nNodesY, std::vector<Vec3> &nodePositions,
+                 int maxNIterations, double tolerance)
+{
+  const std::vector<Vec3> &left   = *borderPoints[(int)Mesh::face_t::face0Minus];    // x = 0
+  const std::vector<Vec3> &right  = *borderPoints[(int)Mesh::face_t::face0Plus];     // x = 1
+  const std::vector<Vec3> &bottom = *borderPoints[(int)Mesh::face_t::face1Minus];    // y = 0
+  const std::vector<Vec3> &top    = *borderPoints[(int)Mesh::face_t::face1Plus];     // y = 1
+
+  assert(left.size() == nNodesY && right.size() == nNodesY);
+  assert(bottom.size() == nNodesX && top.size() == nNodesX);
+
+  nodePositions.resize(nNodesX*nNodesY);
+  auto node = [&nodePositions, nNodesX](int i, int j) -> Vec3 &
+  {
+    return nodePositions[j*nNodesX + i];
+  };
+
+  // initialize all nodes by transfinite interpolation of the boundary (Coons patch), the boundary nodes are exactly the border points
+  const Vec3 corner00 = bottom.front();
+  const Vec3 corner10 = bottom.back();
+  const Vec3 corner01 = top.front();
+  const Vec3 corner11 = top.back();
+
+  for (int j = 0; j < nNodesY; j++)
+  {
+    const double v = double(j) / (nNodesY-1);
+    for (int i = 0; i < nNodesX; i++)
+    {
+      const double u = double(i) / (nNodesX-1);
+      node(i,j) = (1.-v)*bottom[i] + v*top[i] + (1.-u)*left[j] + u*right[j]
+        - ((1.-u)*(1.-v)*corner00 + u*(1.-v)*corner10 + (1.-u)*v*corner01 + u*v*corner11);
+    }
+  }
+
+  // set boundary exactly, the transfinite interpolation reproduces it only if the corners of the faces match
+  for (int i = 0; i < nNodesX; i++)
+  {
+    node(i,0) = bottom[i];
+    node(i,nNodesY-1) = top[i];
+  }
+  for (int j = 0; j < nNodesY; j++)
+  {
+    node(0,j) = left[j];
+    node(nNodesX-1,j) = right[j];
+  }
+
+  if (nNodesX < 3 || nNodesY < 3)
+    return;
+
+  // reference length for the convergence criterion
+  double meanEdgeLength = 0;
+  for (int i = 0; i < nNodesX-1; i++)
+    meanEdgeLength += MathUtility::distance<3>(bottom[i], bottom[i+1]) + MathUtility::distance<3>(top[i], top[i+1]);
+  for (int j = 0; j < nNodesY-1; j++)
+    meanEdgeLength += MathUtility::distance<3>(left[j], left[j+1]) + MathUtility::distance<3>(right[j], right[j+1]);
+  meanEdgeLength /= 2*(nNodesX-1) + 2*(nNodesY-1);
+
+  // Gauss-Seidel iterations of the discretized Winslow equations
+  //   alpha x_ξξ - 2 beta x_ξη + gamma x_ηη = 0,  alpha = |x_η|^2, beta = x_ξ·x_η, gamma = |x_ξ|^2
+  int iterationNo = 0;
+  double maximumChange = 0;
+  for (iterationNo = 0; iterationNo < maxNIterations; iterationNo++)
+  {
+    maximumChange = 0;
+    for (int j = 1; j < nNodesY-1; j++)
+    {
+      for (int i = 1; i < nNodesX-1; i++)
+      {
+        const Vec3 xXi  = 0.5*(node(i+1,j) - node(i-1,j));
+        const Vec3 xEta = 0.5*(node(i,j+1) - node(i,j-1));
+
+        const double alpha = MathUtility::normSquared<3>(xEta);
+        const double beta  = xXi[0]*xEta[0] + xXi[1]*xEta[1] + xXi[2]*xEta[2];
+        const double gamma = MathUtility::normSquared<3>(xXi);
+
+        const double denominator = 2*(alpha + gamma);
+        if (denominator < 1e-30)
+          continue;
+
+        const Vec3 crossDerivative = node(i+1,j+1) - node(i+1,j-1) - node(i-1,j+1) + node(i-1,j-1);
+        const Vec3 newPosition = (1./denominator) * (alpha*(node(i+1,j) + node(i-1,j)) + gamma*(node(i,j+1) + node(i,j-1)) - 0.5*beta*crossDerivative);
+
+        maximumChange = std::max(maximumChange, MathUtility::distance<3>(newPosition, node(i,j)));
+        node(i,j) = newPosition;
+      }
+    }
+
+    if (maximumChange < tolerance*meanEdgeLength)
+      break;
+  }
+
+  VLOG(1) << "harmonic map on " << nNodesX << "x" << nNodesY << " grid: " << iterationNo << " iterations, maximum change " << maximumChange
+    << ", mean edge length " << meanEdgeLength;
+}
+
+void HarmonicMapMesh::
+create3dMesh(const std::array<std::vector<std::vector<Vec3>>,4> &borderPointsFaces, std::vector<Vec3> &nodePositions,
+             std::array<int,3> &nElementsPerCoordinateDirection)
+{
+  const int nNodesX = borderPointsFaces[(int)Mesh::face_t::face1Minus][0].size();
+  const int nNodesY = borderPointsFaces[(int)Mesh::face_t::face0Minus][0].size();
+  const int nNodesZ = borderPointsFaces[(int)Mesh::face_t::face0Minus].size();
+  const int nNodesPerSlice = nNodesX*nNodesY;
+
+  nElementsPerCoordinateDirection = std::array<int,3>({nNodesX-1, nNodesY-1, nNodesZ-1});
+  nodePositions.resize(nNodesPerSlice*nNodesZ);
+
+  // the slices are independent, create them in parallel
+  #pragma omp parallel for schedule(dynamic)
+  for (int zLevelIndex = 0; zLevelIndex < nNodesZ; zLevelIndex++)
+  {
+    std::array<const std::vector<Vec3> *,4> borderPoints;
+    for (int face = (int)Mesh::face_t::face0Minus; face <= (int)Mesh::face_t::face1Plus; face++)
+    {
+      borderPoints[face] = &borderPointsFaces[face][zLevelIndex];
+    }
+
+    std::vector<Vec3> slice;
+    createPlanarMesh(borderPoints, nNodesX, nNodesY, slice);
+
+    std::copy(slice.begin(), slice.end(), nodePositions.begin() + zLevelIndex*nNodesPerSlice);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <array>
+#include <vector>
+
+#include "control/types.h"
+
+namespace Postprocessing
+{
+
+/** Creation of structured meshes inside given border points by a discrete harmonic map.
+ *  For every z level, the interior nodes of the nodesX x nodesY grid are computed such that the mapping from the logical unit square
+ *  is harmonic (Winslow's equations, i.e. the inverse map from the physical domain to the unit square is harmonic). This avoids folded elements in convex and mildly concave slices.
+ *  The slices are independent of each other and are computed thread-parallel.
+ *  This is the native replacement of stl_create_mesh.create_3d_mesh_from_border_points_faces.
+ */
+class HarmonicMapMesh
+{
+public:
+
+  //! Create the node positions of a 2D grid with the given boundary nodes, the interior nodes are computed by the harmonic map.
+  //! borderPoints are ordered like the faces in ParallelFiberEstimation: [face0Minus, face0Plus, face1Minus, face1Plus],
+  //! face0Minus and face0Plus contain nNodesY points in increasing y direction, face1Minus and face1Plus contain nNodesX points in increasing x direction.
+  //! The first and last points of the faces are the corners which are shared with the adjacent faces.
+  //! nodePositions will contain nNodesX*nNodesY points, x is the fastest index.
+  static void createPlanarMesh(const std::array<const std::vector<Vec3> *,4> &borderPoints, int nNodesX, int nNodesY, std::vector<Vec3> &nodePositions,
+                               int maxNIterations = 500, double tolerance = 1e-6);
+
+  //! Create a 3D mesh from the border points, borderPointsFaces[face][zLevelIndex][pointIndex], by creating a planar mesh on every z level.
+  //! nodePositions will contain the node positions with x the fastest and z the slowest index.
+  static void create3dMesh(const std::array<std::vector<std::vector<Vec3>>,4> &borderPointsFaces, std::vector<Vec3> &nodePositions,
+                           std::array<int,3> &nElementsPerCoordinateDirection);
+};
+
+}  // namespace
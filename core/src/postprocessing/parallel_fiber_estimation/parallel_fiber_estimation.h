@@ -9,6 +9,7 @@
 #include "interfaces/runnable.h"
 #include "data_management/parallel_fiber_estimation.h"
 #include "quadrature/gauss.h"
+#include "postprocessing/parallel_fiber_estimation/harmonic_map_mesh.h"
 
 namespace Postprocessing
 {
@@ -58,9 +59,12 @@ protected:
   //! refine the given border points (borderPointsOld) in x and y direction
   void refineBorderPoints(std::array<std::vector<std::vector<Vec3>>,4> &borderPointsOld, std::array<std::vector<std::vector<Vec3>>,4> &borderPoints);
 
-  //! create the mesh with given borderPoints, using harmonic maps by calling the python script
+  //! create the mesh with given borderPoints, using harmonic maps, either natively or by calling the python script
   void createMesh(std::array<std::vector<std::vector<Vec3>>,4> &borderPoints, std::vector<Vec3> &nodePositions, std::array<int,3> &nElementsPerCoordinateDirectionLocal);
 
+  //! create the mesh with given borderPoints by calling stl_create_mesh.create_3d_mesh_from_border_points_faces
+  void createMeshPython(std::array<std::vector<std::vector<Vec3>>,4> &borderPoints, std::vector<Vec3> &nodePositions, std::array<int,3> &nElementsPerCoordinateDirectionLocal);
+
   //! check if the algorithm is at the stage where no more subdomains are created and the final fibers are traced
   bool checkTraceFinalFibers(int &level);
 
@@ -147,6 +151,7 @@ protected:
   int nBorderPointsXNew_;  ///< the value of nBorderPointsX_ in the next subdomain
   int nBorderPointsZNew_;  ///< the value of nBorderPointsZ_ in the next subdomain
   int nFineGridFibers_;   ///< the number of additional fibers between "key" fibers in one coordinate direction
+  bool useNativeMeshGeneration_;   ///< if the meshes of the subdomains are created by HarmonicMapMesh, else by the python script stl_create_mesh
 
   PyObject *moduleStlCreateMesh_;   ///< python module, file "stl_create_mesh.py"
   PyObject *moduleStlCreateRings_;   ///< python module, file "stl_create_rings.py"
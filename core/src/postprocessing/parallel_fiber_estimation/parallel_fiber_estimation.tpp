@@ -59,10 +59,12 @@ ParallelFiberEstimation(DihuContext context) :
   nBorderPointsX_ = specificSettings_.getOptionInt("nElementsXPerSubdomain", 13)+1;
   maxLevel_ = specificSettings_.getOptionInt("maxLevel", 2);
   nFineGridFibers_ = specificSettings_.getOptionInt("nFineGridFibers", 2);
+  useNativeMeshGeneration_ = specificSettings_.getOptionBool("useNativeMeshGeneration", true);
 
   this->lineStepWidth_ = specificSettings_.getOptionDouble("lineStepWidth", 1e-2, PythonUtility::Positive);
   this->maxNIterations_ = specificSettings_.getOptionInt("maxIterations", 100000, PythonUtility::Positive);
   this->useGradientField_ = specificSettings_.getOptionBool("useGradientField", false);
+  this->parseLineIntegrationScheme(specificSettings_);
 
   // ensure nBorderPointsX is odd
   nBorderPointsX_ = 2*int(nBorderPointsX_/2)+1;
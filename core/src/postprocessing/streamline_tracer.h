@@ -36,6 +36,9 @@ protected:
   //! trace the streamlines starting from seed points
   void traceStreamlines();
   
+  //! write the node positions of the streamlines to a file, as binary file if the filename ends with ".bin", else as csv file
+  void writeStreamlines(std::string filename, const std::vector<std::vector<Vec3>> &streamlines);
+
   //! drop streamlines that are smaller than  discardRelativeLength_*median streamline length and resample to match targetElementLength_
   void postprocessStreamlines(std::vector<std::vector<Vec3>> &nodePositions);
 
@@ -52,8 +55,8 @@ protected:
   double targetElementLength_;   ///< the final length of each element of the traced streamlines. After the streamlines were traced using the fine lineStepWidth_, it gets resampled with this width.
   double targetLength_;           ///< the final length of the longest streamline, 0 means disabled
   double discardRelativeLength_;   ///< a relative length (in [0,1]), at the end streamlines are dropped that are smaller than this relative length times the median fiber length
-  std::string csvFilename_;      ///< a csv output filename to write the node positions of the streamlines to (after postprocessing)
-  std::string csvFilenameBeforePostprocessing_;      ///< a csv output filename to write the node positions of the streamlines to (before postprocessing)
+  std::string csvFilename_;      ///< a csv output filename to write the node positions of the streamlines to (after postprocessing), a binary file is written if it ends with ".bin"
+  std::string csvFilenameBeforePostprocessing_;      ///< a csv output filename to write the node positions of the streamlines to (before postprocessing), a binary file is written if it ends with ".bin"
 };
 
 } // namespace
@@ -1,6 +1,8 @@
 #include "postprocessing/streamline_tracer.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <petscvec.h>
 
 #include "utility/python_utility.h"
@@ -21,6 +23,7 @@ StreamlineTracer(DihuContext context) :
   this->lineStepWidth_ = specificSettings_.getOptionDouble("lineStepWidth", 1e-2, PythonUtility::Positive);
   this->maxNIterations_ = specificSettings_.getOptionInt("maxIterations", 100000, PythonUtility::Positive);
   this->useGradientField_ = specificSettings_.getOptionBool("useGradientField", false);
+  this->parseLineIntegrationScheme(specificSettings_);
 
   targetElementLength_ = specificSettings_.getOptionDouble("targetElementLength", 0.0, PythonUtility::Positive);
   targetLength_ = specificSettings_.getOptionDouble("targetLength", 0.0, PythonUtility::Positive);
@@ -86,91 +89,108 @@ traceStreamlines()
   problem_.data().solution()->computeGradientField(data_.gradient());
  
   const int nSeedPoints = seedPositions_.size();
-  //const int nSeedPoints = 1;
   std::vector<std::vector<Vec3>> streamlines(nSeedPoints);
+  std::vector<char> seedPointIsOutside(nSeedPoints, false);   // not vector<bool>, because it is written concurrently
 
   LOG(DEBUG) << "trace streamline, seedPositions: " << seedPositions_;
-  
-  // loop over seed points
-  //#pragma omp parallel for shared(streamlines)
+
+  // loop over seed points, the streamlines have very different lengths, therefore use dynamic scheduling
+  #pragma omp parallel for shared(streamlines,seedPointIsOutside) schedule(dynamic)
   for (int seedPointNo = 0; seedPointNo < nSeedPoints; seedPointNo++)
   {
     // get starting point
     Vec3 startingPoint = seedPositions_[seedPointNo];
-    
+
     // trace streamline forwards
     std::vector<Vec3> forwardPoints;
     this->traceStreamline(startingPoint, 1.0, forwardPoints);
-    
+
     if (forwardPoints.empty())  // if there was not even the first point found
     {
-      LOG(ERROR) << "Seed point " << startingPoint << " is outside of domain.";
+      seedPointIsOutside[seedPointNo] = true;
       continue;
     }
 
     // trace streamline backwards
     std::vector<Vec3> backwardPoints;
     this->traceStreamline(startingPoint, -1.0, backwardPoints);
-  
+
     // copy collected points to result vector, note avoiding this additional copy-step is not really possible, since it would require a push_front which is only efficient with lists, but we need a vector here
+    streamlines[seedPointNo].reserve(backwardPoints.size() + 1 + forwardPoints.size());
     streamlines[seedPointNo].insert(streamlines[seedPointNo].begin(), backwardPoints.rbegin(), backwardPoints.rend());
     streamlines[seedPointNo].insert(streamlines[seedPointNo].end(), startingPoint);
     streamlines[seedPointNo].insert(streamlines[seedPointNo].end(), forwardPoints.begin(), forwardPoints.end());
-    
-    LOG(DEBUG) << " seed point " << seedPointNo << ", " << streamlines[seedPointNo].size() << " points";
   }
-  
-  // create 1D meshes of streamline from collected node positions
-  if (!csvFilenameBeforePostprocessing_.empty())
+
+  for (int seedPointNo = 0; seedPointNo < nSeedPoints; seedPointNo++)
   {
-    std::ofstream file(csvFilenameBeforePostprocessing_, std::ios::out | std::ios::binary | std::ios::trunc);
-    if (!file.is_open())
-      LOG(WARNING) << "Could not open \"" << csvFilenameBeforePostprocessing_ << "\" for writing";
-    
-    for (int streamlineNo = 0; streamlineNo != streamlines.size(); streamlineNo++)
-    {
-      for (std::vector<Vec3>::const_iterator iter = streamlines[streamlineNo].begin(); iter != streamlines[streamlineNo].end(); iter++)
-      {
-        Vec3 point = *iter;
-        file << point[0] << ";" << point[1] << ";" << point[2] << ";";
-      }
-      file << "\n";
-    }
-    file.close();
-    LOG(INFO) << "File \"" << csvFilenameBeforePostprocessing_ << "\" written.";
+    if (seedPointIsOutside[seedPointNo])
+      LOG(ERROR) << "Seed point " << seedPositions_[seedPointNo] << " is outside of domain.";
+    else
+      LOG(DEBUG) << " seed point " << seedPointNo << ", " << streamlines[seedPointNo].size() << " points";
   }
-  
+
+  // write the streamlines before postprocessing
+  if (!csvFilenameBeforePostprocessing_.empty())
+    writeStreamlines(csvFilenameBeforePostprocessing_, streamlines);
+
   // coarsen streamlines and drop too small streamlines
   postprocessStreamlines(streamlines);
- 
+
   LOG(DEBUG) << "number streamlines after postprocessStreamlines: " << streamlines.size();
-  
-  // create 1D meshes of streamline from collected node positions
+
+  // write the streamlines after postprocessing
   if (!csvFilename_.empty())
+    writeStreamlines(csvFilename_, streamlines);
+
+  // create new meshes, one for each streamline 
+  for (int streamlineNo = 0; streamlineNo != streamlines.size(); streamlineNo++)
   {
-    std::ofstream file(csvFilename_, std::ios::out | std::ios::binary | std::ios::trunc);
-    if (!file.is_open())
-      LOG(WARNING) << "Could not open \"" << csvFilename_ << "\" for writing";
-    
-    for (int streamlineNo = 0; streamlineNo != streamlines.size(); streamlineNo++)
+    LOG(DEBUG) << "seed point " << streamlineNo << ", number node positions: " << streamlines[streamlineNo].size();
+    this->data_.createFiberMesh(streamlines[streamlineNo]);
+  }
+}
+
+template<typename DiscretizableInTimeType>
+void StreamlineTracer<DiscretizableInTimeType>::
+writeStreamlines(std::string filename, const std::vector<std::vector<Vec3>> &streamlines)
+{
+  std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    LOG(WARNING) << "Could not open \"" << filename << "\" for writing";
+    return;
+  }
+
+  // binary format: int32 number of streamlines, then for every streamline int32 number of points and the points as 3 doubles each
+  const bool binaryFormat = filename.size() >= 4 && filename.substr(filename.size()-4) == ".bin";
+  if (binaryFormat)
+  {
+    int32_t nStreamlines = streamlines.size();
+    file.write((char *)&nStreamlines, sizeof(int32_t));
+
+    for (const std::vector<Vec3> &streamline : streamlines)
+    {
+      int32_t nPoints = streamline.size();
+      file.write((char *)&nPoints, sizeof(int32_t));
+
+      // the points of a streamline are contiguous in memory, write them at once
+      file.write((char *)streamline.data(), nPoints*sizeof(Vec3));
+    }
+  }
+  else
+  {
+    for (const std::vector<Vec3> &streamline : streamlines)
     {
-      for (std::vector<Vec3>::const_iterator iter = streamlines[streamlineNo].begin(); iter != streamlines[streamlineNo].end(); iter++)
+      for (const Vec3 &point : streamline)
       {
-        Vec3 point = *iter;
         file << point[0] << ";" << point[1] << ";" << point[2] << ";";
       }
       file << "\n";
     }
-    file.close();
-    LOG(INFO) << "File \"" << csvFilename_ << "\" written.";
-  }
-  
-  // create new meshes, one for each streamline 
-  for (int streamlineNo = 0; streamlineNo != streamlines.size(); streamlineNo++)
-  {
-    LOG(DEBUG) << "seed point " << streamlineNo << ", number node positions: " << streamlines[streamlineNo].size();
-    this->data_.createFiberMesh(streamlines[streamlineNo]);
   }
+  file.close();
+  LOG(INFO) << "File \"" << filename << "\" written.";
 }
 
 template<typename DiscretizableInTimeType>
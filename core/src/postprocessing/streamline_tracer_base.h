@@ -6,6 +6,7 @@
 #include "interfaces/discretizable_in_time.h"
 #include "interfaces/runnable.h"
 #include "data_management/streamline_tracer.h"
+#include "control/python_config.h"
 
 namespace Postprocessing
 {
@@ -18,10 +19,40 @@ class StreamlineTracerBase
 public:
 
   //! trace the streamline starting from startingPoint in the element initialElementNo, direction is either 1. or -1. depending on the direction
+  //! This method can be called concurrently from multiple threads, the mesh is only accessed in a critical section when the streamline enters a new element.
   void traceStreamline(Vec3 startingPoint, double direction, std::vector<Vec3> &points);
 
 protected:
 
+  //! the values of the element that contains the current point of the streamline, every traced streamline has its own cache
+  struct ElementCache
+  {
+    bool valid = false;                    ///< if the cache contains the values of an element
+    element_no_t elementNo = 0;            ///< the local element no in the mesh given by ghostMeshNo
+    int ghostMeshNo = -1;                  ///< the ghost mesh of the element, -1 for the normal mesh
+    std::shared_ptr<FunctionSpace> functionSpace;   ///< the function space of the element, either functionSpace_ or one of the ghost meshes
+    std::array<double,FunctionSpace::dim()> xi;     ///< the xi coordinates of the last evaluated point in the element
+    std::array<Vec3,FunctionSpace::nDofsPerElement()> geometryValues;          ///< the node positions of the element
+    std::array<Vec3,FunctionSpace::nDofsPerElement()> gradientValues;          ///< the gradient field values, if useGradientField_
+    std::array<double,FunctionSpace::nDofsPerElement()> solutionValues;        ///< the solution field values, if not useGradientField_
+  };
+
+  //! which integration scheme is used to advance the streamline
+  enum lineIntegrationScheme_t
+  {
+    lineIntegrationSchemeExplicitEuler,
+    lineIntegrationSchemeRungeKutta4
+  };
+
+  //! parse the option "lineIntegrationScheme", either "ExplicitEuler" or "RK4"
+  void parseLineIntegrationScheme(PythonConfig specificSettings);
+
+  //! compute the normalized streamline direction at point, update the element cache, returns false if the point is outside of the domain
+  bool evaluateStreamlineDirection(Vec3 point, ElementCache &elementCache, Vec3 &streamlineDirection);
+
+  //! check if the point is in the cached element by a Newton iteration on the cached geometry values, this does not access the mesh
+  bool pointIsInCachedElement(Vec3 point, ElementCache &elementCache);
+
   std::shared_ptr<FunctionSpace> functionSpace_;   ///< function space of the solution field in which the tracing is performed
   std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace,1>> solution_;   ///< solution field in which the tracing is performed
   std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace,3>> gradient_;   ///< gradient field which can be used to trace the streamlines (if useGradient_ is set to true)
@@ -33,6 +64,7 @@ protected:
   double lineStepWidth_;     ///< the line step width used for integrating the streamlines
 
   int maxNIterations_;   ///< the maximum number of iterations to trace for a streamline
+  lineIntegrationScheme_t lineIntegrationScheme_ = lineIntegrationSchemeExplicitEuler;   ///< the integration scheme for the streamlines, RK4 allows larger lineStepWidth_ for the same accuracy
   bool useGradientField_;  ///< There are 2 implementations of streamline tracing. The first one (useGradientField_) uses a precomputed gradient field that is interpolated linearly and the second uses the gradient directly from the Laplace solution field. // The first one seems more stable, because the gradient is zero and the position of the boundary conditions.
 };
 
@@ -7,131 +7,217 @@ namespace Postprocessing
 
 template<typename FunctionSpace>
 void StreamlineTracerBase<FunctionSpace>::
-traceStreamline(Vec3 startingPoint, double direction, std::vector<Vec3> &points)
+parseLineIntegrationScheme(PythonConfig specificSettings)
 {
-  const int D = FunctionSpace::dim();
-  const int nDofsPerElement = FunctionSpace::nDofsPerElement();
-  
-  LOG(DEBUG) << "traceStreamline(startingPoint " << startingPoint << ", direction " << direction << ", maxNIterations_: " << maxNIterations_ << "), useGradientField_: " << useGradientField_;
+  std::string lineIntegrationScheme = specificSettings.getOptionString("lineIntegrationScheme", "ExplicitEuler");
 
-  //functionSpace_->debugOutputGhostMeshSet();
+  if (lineIntegrationScheme == "RK4")
+  {
+    lineIntegrationScheme_ = lineIntegrationSchemeRungeKutta4;
+  }
+  else
+  {
+    if (lineIntegrationScheme != "ExplicitEuler")
+    {
+      LOG(WARNING) << specificSettings << "[\"lineIntegrationScheme\"] is \"" << lineIntegrationScheme
+        << "\", valid values are \"ExplicitEuler\" and \"RK4\". Using \"ExplicitEuler\".";
+    }
+    lineIntegrationScheme_ = lineIntegrationSchemeExplicitEuler;
+  }
+}
+
+template<typename FunctionSpace>
+void StreamlineTracerBase<FunctionSpace>::
+traceStreamline(Vec3 startingPoint, double direction, std::vector<Vec3> &points)
+{
+  // this is called from multiple threads, the output is serialized, but the critical section is only entered if the output is enabled
+  if (VLOG_IS_ON(1))
+  {
+    #pragma omp critical(streamlineTracerLog)
+    VLOG(1) << "traceStreamline(startingPoint " << startingPoint << ", direction " << direction << ", maxNIterations_: " << maxNIterations_ << "), useGradientField_: " << useGradientField_;
+  }
 
   Vec3 currentPoint = startingPoint;
-  element_no_t elementNo = 0;
-  int ghostMeshNo = -1;
-  std::array<double,(unsigned long int)3> xi;
-  std::shared_ptr<FunctionSpace> functionSpace = functionSpace_;  ///< the function space to use, this can be set to one of the ghost meshes
-  
-  // There are 2 implementations of streamline tracing.
-  // The first one (useGradientField_) uses a precomputed gradient field that is interpolated linearly and the second uses the gradient directly from the Laplace solution_ field.
-  // The first one seems more stable, because the gradient is zero and the position of the boundary conditions and should be used with a linear discretization of the potential field.
-  // The second one is more accurate.
 
-  std::array<Vec3,nDofsPerElement> elementalGradientValues;
-  std::array<double,nDofsPerElement> elementalSolutionValues;
-  std::array<Vec3,nDofsPerElement> geometryValues;
+  // the element that contains the current point, the mesh is only accessed when the streamline leaves this element
+  ElementCache elementCache;
 
-  bool startSearchInCurrentElement = false;
+  const double h = lineStepWidth_*direction;
 
   // loop over length of streamline, avoid loops by limiting the number of iterations
   for (int iterationNo = 0; iterationNo <= maxNIterations_; iterationNo++)
   {
     if (iterationNo == maxNIterations_)
     {
+      #pragma omp critical(streamlineTracerLog)
       LOG(WARNING) << "streamline reached maximum number of iterations (" << maxNIterations_ << ")";
+
       points.clear();
       break;
     }
 
-    if (iterationNo == 0)
+    // compute the direction at the current point, if it is outside of the domain, the streamline ends
+    Vec3 k1;
+    if (!evaluateStreamlineDirection(currentPoint, elementCache, k1))
     {
-      startSearchInCurrentElement = false;
+      if (VLOG_IS_ON(2))
+      {
+        #pragma omp critical(streamlineTracerLog)
+        VLOG(2) << "streamline ends at iteration " << iterationNo << " because " << currentPoint << " is outside of domain";
+      }
+      break;
+    }
+
+    // integrate streamline
+    if (lineIntegrationScheme_ == lineIntegrationSchemeRungeKutta4)
+    {
+      // the intermediate points are evaluated with the same element cache, they are usually in the same element
+      Vec3 k2, k3, k4;
+      if (evaluateStreamlineDirection(currentPoint + 0.5*h*k1, elementCache, k2)
+        && evaluateStreamlineDirection(currentPoint + 0.5*h*k2, elementCache, k3)
+        && evaluateStreamlineDirection(currentPoint + h*k3, elementCache, k4))
+      {
+        currentPoint = currentPoint + h/6.0*(k1 + 2.0*k2 + 2.0*k3 + k4);
+      }
+      else
+      {
+        // an intermediate point is outside of the domain, use an explicit euler step at the border
+        currentPoint = currentPoint + h*k1;
+      }
     }
     else
     {
-      startSearchInCurrentElement = true;
+      currentPoint = currentPoint + h*k1;
     }
 
-    VLOG(1) << "startSearchInCurrentElement=" << startSearchInCurrentElement << ", elementNo: " << elementNo << " ghostMeshNo: " << ghostMeshNo;
-
-    // look for the element and xi value of the currentPoint, also considers ghost meshes if they are set
-    bool positionFound = functionSpace_->findPosition(currentPoint, elementNo, ghostMeshNo, xi, startSearchInCurrentElement);
-
-    // if no position was found, the streamline exits the domain
-    if (!positionFound)
+    if (VLOG_IS_ON(2))
     {
-      VLOG(2) << "streamline ends at iteration " << iterationNo << " because " << currentPoint << " is outside of domain";
-      break;
+      #pragma omp critical(streamlineTracerLog)
+      VLOG(2) << "              to " << currentPoint;
     }
 
-    VLOG(1) << " findPosition returned ghostMeshNo " << ghostMeshNo << ", elementNo " << elementNo << ", xi " << xi;
+    points.push_back(currentPoint);
+  }
+}
 
-    // get values for element that are later needed to compute the gradient
+template<typename FunctionSpace>
+bool StreamlineTracerBase<FunctionSpace>::
+evaluateStreamlineDirection(Vec3 point, ElementCache &elementCache, Vec3 &streamlineDirection)
+{
+  const int D = FunctionSpace::dim();
 
-    // if the streamline passes a normal element
-    if (ghostMeshNo == -1)
-    {
-      VLOG(1) << "use normal mesh";
+  // There are 2 implementations of streamline tracing.
+  // The first one (useGradientField_) uses a precomputed gradient field that is interpolated linearly and the second uses the gradient directly from the Laplace solution_ field.
+  // The first one seems more stable, because the gradient is zero and the position of the boundary conditions and should be used with a linear discretization of the potential field.
+  // The second one is more accurate.
 
-      functionSpace = functionSpace_;
+  if (!elementCache.valid || !pointIsInCachedElement(point, elementCache))
+  {
+    bool positionFound = false;
 
-      if (useGradientField_)
-      {
-        gradient_->getElementValues(elementNo, elementalGradientValues);
-      }
-      else
+    // the search in the mesh and the retrieval of field variable values is not thread-safe, this is only done when the streamline enters a new element
+    #pragma omp critical(streamlineTracerMeshAccess)
+    {
+      // look for the element and xi value of the point, also considers ghost meshes if they are set
+      bool startSearchInCurrentElement = elementCache.valid;
+      positionFound = functionSpace_->findPosition(point, elementCache.elementNo, elementCache.ghostMeshNo, elementCache.xi, startSearchInCurrentElement);
+
+      if (positionFound)
       {
-        solution_->getElementValues(elementNo, elementalSolutionValues);
+        if (VLOG_IS_ON(1))
+        {
+          #pragma omp critical(streamlineTracerLog)
+          VLOG(1) << " findPosition returned ghostMeshNo " << elementCache.ghostMeshNo << ", elementNo " << elementCache.elementNo << ", xi " << elementCache.xi;
+        }
+
+        // get values for element that are later needed to compute the gradient
+        const element_no_t elementNo = elementCache.elementNo;
+
+        // if the streamline passes a normal element
+        if (elementCache.ghostMeshNo == -1)
+        {
+          elementCache.functionSpace = functionSpace_;
+
+          if (useGradientField_)
+            gradient_->getElementValues(elementNo, elementCache.gradientValues);
+          else
+            solution_->getElementValues(elementNo, elementCache.solutionValues);
+        }
+        else    // if the streamline is in an element of a ghost mesh
+        {
+          elementCache.functionSpace = ghostMesh_[elementCache.ghostMeshNo];
+
+          if (useGradientField_)
+            ghostMeshGradient_[elementCache.ghostMeshNo]->getElementValues(elementNo, elementCache.gradientValues);
+          else
+            ghostMeshSolution_[elementCache.ghostMeshNo]->getElementValues(elementNo, elementCache.solutionValues);
+        }
 
         // get geometry field (which are the node positions for Lagrange basis and node positions and derivatives for Hermite)
-        functionSpace->getElementGeometry(elementNo, geometryValues);
+        elementCache.functionSpace->getElementGeometry(elementNo, elementCache.geometryValues);
       }
     }
-    else    // if the streamline is in an element of a ghost mesh
-    {
-      VLOG(1) << "use ghost mesh";
 
-      // use ghost mesh as current function space
-      functionSpace = ghostMesh_[ghostMeshNo];
+    elementCache.valid = positionFound;
+    if (!positionFound)
+      return false;
+  }
 
-      if (useGradientField_)
-      {
-        ghostMeshGradient_[ghostMeshNo]->getElementValues(elementNo, elementalGradientValues);
-      }
-      else
-      {
-        ghostMeshSolution_[ghostMeshNo]->getElementValues(elementNo, elementalSolutionValues);
+  // get value of gradient
+  std::shared_ptr<FunctionSpace> functionSpace = elementCache.functionSpace;
+  Vec3 gradient;
+  if (useGradientField_)
+  {
+    gradient = functionSpace->template interpolateValueInElement<3>(elementCache.gradientValues, elementCache.xi);
+  }
+  else
+  {
+    // compute the gradient value in the current value
+    Tensor2<D> inverseJacobian = functionSpace->getInverseJacobian(elementCache.geometryValues, elementCache.elementNo, elementCache.xi);
+    gradient = functionSpace->interpolateGradientInElement(elementCache.solutionValues, inverseJacobian, elementCache.xi);
+  }
 
-        // get geometry field (which are the node positions for Lagrange basis and node positions and derivatives for Hermite)
-        functionSpace->getElementGeometry(elementNo, geometryValues);
-      }
-    }
+  streamlineDirection = MathUtility::normalized<3>(gradient);
+  return true;
+}
 
-    // get value of gradient
-    Vec3 gradient;
-    if (useGradientField_)
-    {
-      gradient = functionSpace->template interpolateValueInElement<3>(elementalGradientValues, xi);
-      VLOG(2) << "use gradient field";
-    }
-    else
-    {
-      // compute the gradient value in the current value
-      Tensor2<D> inverseJacobian = functionSpace->getInverseJacobian(geometryValues, elementNo, xi);
-      gradient = functionSpace->interpolateGradientInElement(elementalSolutionValues, inverseJacobian, xi);
+template<typename FunctionSpace>
+bool StreamlineTracerBase<FunctionSpace>::
+pointIsInCachedElement(Vec3 point, ElementCache &elementCache)
+{
+  const int D = FunctionSpace::dim();
+  const int nNewtonIterations = 7;
+  const double residuumNormTolerance = 1e-4;
+  const double epsilon = 1e-4;
 
-      VLOG(2) << "use direct gradient";
-    }
+  std::shared_ptr<FunctionSpace> functionSpace = elementCache.functionSpace;
 
-    // integrate streamline
-    VLOG(2) << "  integrate from " << currentPoint << ", gradient: " << gradient << ", gradient normalized: " << MathUtility::normalized<3>(gradient)
-      << ", lineStepWidth: " << lineStepWidth_;
-    currentPoint = currentPoint + MathUtility::normalized<3>(gradient)*lineStepWidth_*direction;
+  // Newton iteration starting from the xi of the previous point, which is close
+  std::array<double,D> xi = elementCache.xi;
+  Vec3 residuum = point - functionSpace->template interpolateValueInElement<3>(elementCache.geometryValues, xi);
+  double residuumNormSquared = MathUtility::normSquared<3>(residuum);
 
-    VLOG(2) << "              to " << currentPoint;
+  for (int iterationNo = 0; iterationNo < nNewtonIterations && residuumNormSquared > MathUtility::sqr(residuumNormTolerance); iterationNo++)
+  {
+    Tensor2<D> inverseJacobian = functionSpace->getInverseJacobian(elementCache.geometryValues, elementCache.elementNo, xi);
+    xi += inverseJacobian * MathUtility::transformToD<D,3>(residuum);
 
-    points.push_back(currentPoint);
+    residuum = point - functionSpace->template interpolateValueInElement<3>(elementCache.geometryValues, xi);
+    residuumNormSquared = MathUtility::normSquared<3>(residuum);
   }
+
+  // if the iteration did not converge, xi is not reliable, then the point has to be searched in the mesh
+  if (residuumNormSquared > MathUtility::sqr(residuumNormTolerance))
+    return false;
+
+  for (int i = 0; i < D; i++)
+  {
+    if (!(0.0-epsilon <= xi[i] && xi[i] <= 1.0+epsilon))
+      return false;
+  }
+
+  elementCache.xi = xi;
+  return true;
 }
 
 }  // namespace
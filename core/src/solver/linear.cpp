@@ -1,13 +1,17 @@
 #include "solver/linear.h"
 
+#include <algorithm>
+
 #include "utility/python_utility.h"
 #include "control/performance_measurement.h"
+#include "utility/petsc_utility.h"
+#include "utility/vector_operators.h"
 
 namespace Solver
 {
 
 Linear::Linear(PythonConfig specificSettings, MPI_Comm mpiCommunicator, std::string name) :
-  Solver(specificSettings, name)
+  Solver(specificSettings, name), referenceNumberOfIterations_(-1), rebuildPreconditioner_(false), lastNumberOfIterations_(0)
 {
   if (VLOG_IS_ON(1))
   {
@@ -34,6 +38,9 @@ Linear::Linear(PythonConfig specificSettings, MPI_Comm mpiCommunicator, std::str
   // set solver type
   ierr = KSPSetType(*ksp_, kspType); CHKERRV(ierr);
 
+  // set restart length and the parameters of the deflated or augmented GMRES variants
+  initializeKrylovSubspaceRecycling(kspType);
+
   // set options from command line, this overrides the python config
   ierr = KSPSetFromOptions(*ksp_); CHKERRV(ierr);
 
@@ -56,38 +63,251 @@ Linear::Linear(PythonConfig specificSettings, MPI_Comm mpiCommunicator, std::str
 
   //                                    relative tol,      absolute tol,  diverg tol.,   max_iterations
   ierr = KSPSetTolerances (*ksp_, relativeTolerance_, PETSC_DEFAULT, PETSC_DEFAULT, maxIterations_); CHKERRV(ierr);
+
+  // parse how the initial guess is computed
+  std::string initialGuess = this->specificSettings_.getOptionString("initialGuess", "default");
+  initialGuess_ = initialGuessDefault;
+  if (initialGuess == "previous")
+  {
+    initialGuess_ = initialGuessPrevious;
+  }
+  else if (initialGuess == "extrapolate")
+  {
+    initialGuess_ = initialGuessExtrapolate;
+  }
+  else if (initialGuess != "default")
+  {
+    LOG(WARNING) << "Unknown value \"" << initialGuess << "\" for \"initialGuess\" of solver \"" << this->name_ << "\", "
+      << "allowed values are \"default\", \"previous\" and \"extrapolate\". Using \"default\".";
+  }
+
+  // parse if the preconditioner should be reused until the number of iterations increases
+  preconditionerRefreshFactor_ = this->specificSettings_.getOptionDouble("preconditionerRefreshFactor", 0.0, PythonUtility::NonNegative);
+  if (preconditionerRefreshFactor_ > 0)
+  {
+    ierr = KSPSetReusePreconditioner(*ksp_, PETSC_TRUE); CHKERRV(ierr);
+  }
+
+  // record the residual norms of all iterations, the buffer is reused for every solve
+  residualHistoryBuffer_.resize(std::min(maxIterations_+1, 1000L));
+  ierr = KSPSetResidualHistory(*ksp_, residualHistoryBuffer_.data(), residualHistoryBuffer_.size(), PETSC_TRUE); CHKERRV(ierr);
 }
 
-void Linear::parseSolverTypes(KSPType &kspType, PCType &pcType)
+Linear::~Linear()
 {
-  // parse solver type
-  std::string solverType = this->specificSettings_.getOptionString("solverType", "gmres");
+  // the solvers of the solver manager can be destroyed after PetscFinalize, then the vectors must not be destroyed any more
+  PetscBool petscIsFinalized = PETSC_FALSE;
+  PetscFinalized(&petscIsFinalized);
+  if (petscIsFinalized)
+    return;
 
-  // parse preconditioner type
-  std::string preconditionerType = this->specificSettings_.getOptionString("preconditionerType", "none");
+  for (std::pair<const PetscObjectId,SolutionHistory> &solutionHistory : solutionHistories_)
+  {
+    for (Vec &previousSolution : solutionHistory.second.previousSolutions)
+    {
+      if (previousSolution != PETSC_NULL)
+        VecDestroy(&previousSolution);
+    }
+    if (solutionHistory.second.solutionWork != PETSC_NULL)
+      VecDestroy(&solutionHistory.second.solutionWork);
+  }
+}
 
-  // all pc types: https://www.mcs.anl.gov/petsc/petsc-current/docs/manualpages/PC/PCType.html
-  pcType = PCNONE;
-  if (preconditionerType == "jacobi")
+void Linear::solve(Vec rightHandSide, Vec solution, std::string message)
+{
+  PetscErrorCode ierr;
+
+  // start duration measurement
+  std::stringstream durationKey;
+  durationKey << this->name_ << "_solve";
+  Control::PerformanceMeasurement::start(durationKey.str());
+
+  // the previous solutions are stored per solution vector, such that a solver that is shared by several problems uses the history of the current problem,
+  // the vector is identified by its id, because the address of a destroyed vector can be reused by a new vector of a different size
+  PetscObjectId solutionId;
+  ierr = PetscObjectGetId((PetscObject)solution, &solutionId); CHKERRV(ierr);
+  SolutionHistory &history = solutionHistories_[solutionId];
+  history.previousSolutions.resize(2, PETSC_NULL);
+
+  // KSPSolve does not allow rightHandSide == solution with a nonzero initial guess, then solve into a temporary vector
+  Vec kspSolution = solution;
+  if (initialGuess_ != initialGuessDefault && rightHandSide == solution)
   {
-    pcType = PCJACOBI;
+    if (history.solutionWork == PETSC_NULL)
+    {
+      ierr = VecDuplicate(solution, &history.solutionWork); CHKERRV(ierr);
+    }
+    kspSolution = history.solutionWork;
   }
-  else if (preconditionerType == "sor")
+
+  // the setting of the caller is restored after the solve, it is used when there is no previous solution
+  PetscBool initialGuessNonzero;
+  ierr = KSPGetInitialGuessNonzero(*ksp_, &initialGuessNonzero); CHKERRV(ierr);
+  if (kspSolution != solution && initialGuessNonzero)
   {
-    pcType = PCSOR;
+    ierr = VecCopy(solution, kspSolution); CHKERRV(ierr);
   }
-  else if (preconditionerType == "lu")
+
+  // set initial guess from previous solutions
+  setInitialGuess(history, kspSolution);
+
+  // rebuild the preconditioner if the iteration count has degraded
+  if (rebuildPreconditioner_)
   {
-    pcType = PCLU;
+    VLOG(1) << "Solver \"" << this->name_ << "\": rebuild preconditioner";
+    ierr = KSPSetReusePreconditioner(*ksp_, PETSC_FALSE); CHKERRV(ierr);
   }
-  else if (preconditionerType == "ilu")
+
+  // solve the system, KSPSolve(ksp,b,x)
+  ierr = KSPSolve(*ksp_, rightHandSide, kspSolution); CHKERRV(ierr);
+
+  if (rebuildPreconditioner_)
   {
-    pcType = PCILU;
+    ierr = KSPSetReusePreconditioner(*ksp_, PETSC_TRUE); CHKERRV(ierr);
   }
-  else if (preconditionerType == "gamg")
+
+  ierr = KSPSetInitialGuessNonzero(*ksp_, initialGuessNonzero); CHKERRV(ierr);
+
+  if (kspSolution != solution)
   {
-    pcType = PCGAMG;
+    ierr = VecCopy(kspSolution, solution); CHKERRV(ierr);
+  }
+
+  // store the solution for the initial guess of the next solve
+  storeSolution(history, solution);
+
+  int numberOfIterations = 0;
+  PetscReal residualNorm = 0.0;
+  ierr = KSPGetIterationNumber(*ksp_, &numberOfIterations); CHKERRV(ierr);
+  ierr = KSPGetResidualNorm(*ksp_, &residualNorm); CHKERRV(ierr);
+
+  KSPConvergedReason convergedReason;
+  ierr = KSPGetConvergedReason(*ksp_, &convergedReason); CHKERRV(ierr);
+
+  lastNumberOfIterations_ = numberOfIterations;
+
+  // stop duration measurement
+  Control::PerformanceMeasurement::stop(durationKey.str());
+
+  // record number of iterations
+  std::stringstream iterationsKey;
+  iterationsKey << this->name_ << "_iterations";
+  Control::PerformanceMeasurement::countNumber(iterationsKey.str(), numberOfIterations);
+
+  checkPreconditionerRefresh(numberOfIterations);
+
+  // record the residual norms of the iterations of the last solve
+  std::stringstream residualHistoryKey;
+  residualHistoryKey << this->name_ << "_residualHistory";
+  Control::PerformanceMeasurement::setParameter(residualHistoryKey.str(), residualHistory());
+
+  VLOG(1) << message << " solved in " << numberOfIterations << " iterations, residual norm " << residualNorm
+    << ": " << PetscUtility::getStringLinearConvergedReason(convergedReason);
+
+  if (VLOG_IS_ON(2))
+  {
+    VLOG(2) << "residual history: " << residualHistory();
   }
+}
+
+void Linear::setInitialGuess(SolutionHistory &history, Vec kspSolution)
+{
+  if (initialGuess_ == initialGuessDefault)
+    return;
+
+  // no previous solution available, keep the initial guess as configured by the caller, e.g. the value in solution for the multidomain solver
+  if (history.nPreviousSolutions == 0)
+    return;
+
+  PetscErrorCode ierr;
+  if (initialGuess_ == initialGuessExtrapolate && history.nPreviousSolutions == 2)
+  {
+    // kspSolution = 2*x^{n-1} - x^{n-2}
+    ierr = VecAXPBYPCZ(kspSolution, 2.0, -1.0, 0.0, history.previousSolutions[0], history.previousSolutions[1]); CHKERRV(ierr);
+  }
+  else if (kspSolution != history.previousSolutions[0])
+  {
+    // kspSolution = x^{n-1}
+    ierr = VecCopy(history.previousSolutions[0], kspSolution); CHKERRV(ierr);
+  }
+  ierr = KSPSetInitialGuessNonzero(*ksp_, PETSC_TRUE); CHKERRV(ierr);
+}
+
+void Linear::storeSolution(SolutionHistory &history, Vec solution)
+{
+  if (initialGuess_ == initialGuessDefault)
+    return;
+
+  PetscErrorCode ierr;
+
+  // for extrapolation, keep the two last solutions, otherwise only the last
+  if (initialGuess_ == initialGuessExtrapolate)
+  {
+    std::swap(history.previousSolutions[0], history.previousSolutions[1]);
+  }
+
+  if (history.previousSolutions[0] == PETSC_NULL)
+  {
+    ierr = VecDuplicate(solution, &history.previousSolutions[0]); CHKERRV(ierr);
+  }
+  ierr = VecCopy(solution, history.previousSolutions[0]); CHKERRV(ierr);
+
+  int nStoredSolutions = (initialGuess_ == initialGuessExtrapolate? 2 : 1);
+  history.nPreviousSolutions = std::min(history.nPreviousSolutions+1, nStoredSolutions);
+}
+
+void Linear::checkPreconditionerRefresh(int numberOfIterations)
+{
+  if (preconditionerRefreshFactor_ <= 0)
+    return;
+
+  // the first solve after a rebuild defines the reference number of iterations
+  if (rebuildPreconditioner_ || referenceNumberOfIterations_ == -1)
+  {
+    referenceNumberOfIterations_ = numberOfIterations;
+    rebuildPreconditioner_ = false;
+    return;
+  }
+
+  if (numberOfIterations > preconditionerRefreshFactor_*std::max(1, referenceNumberOfIterations_))
+  {
+    VLOG(1) << "Solver \"" << this->name_ << "\" needed " << numberOfIterations << " iterations, reference is "
+      << referenceNumberOfIterations_ << ", schedule rebuild of preconditioner";
+    rebuildPreconditioner_ = true;
+  }
+}
+
+std::vector<double> Linear::residualHistory() const
+{
+  PetscReal *residualNorms;
+  PetscInt nResidualNorms = 0;
+  PetscErrorCode ierr = KSPGetResidualHistory(*ksp_, &residualNorms, &nResidualNorms);
+  if (ierr)
+    return std::vector<double>();
+
+  return std::vector<double>(residualNorms, residualNorms + nResidualNorms);
+}
+
+int Linear::lastNumberOfIterations() const
+{
+  return lastNumberOfIterations_;
+}
+
+std::string Linear::solverType() const
+{
+  return solverType_;
+}
+
+void Linear::parseSolverTypes(KSPType &kspType, PCType &pcType)
+{
+  // parse solver type
+  std::string solverType = this->specificSettings_.getOptionString("solverType", "gmres");
+  solverType_ = solverType;
+
+  // parse preconditioner type
+  std::string preconditionerType = this->specificSettings_.getOptionString("preconditionerType", "none");
+
+  pcType = parsePreconditionerType(preconditionerType);
 
   // all ksp types: https://www.mcs.anl.gov/petsc/petsc-current/docs/manualpages/KSP/KSPType.html#KSPType
   kspType = KSPGMRES;
@@ -107,6 +327,14 @@ void Linear::parseSolverTypes(KSPType &kspType, PCType &pcType)
   {
     kspType = KSPPREONLY;
   }
+  else if (solverType == "dgmres")
+  {
+    kspType = KSPDGMRES;
+  }
+  else if (solverType == "lgmres")
+  {
+    kspType = KSPLGMRES;
+  }
   else if (solverType == "lu")
   {
     kspType = KSPPREONLY;
@@ -122,6 +350,11 @@ void Linear::parseSolverTypes(KSPType &kspType, PCType &pcType)
     kspType = KSPPREONLY;
     pcType = PCGAMG;
   }
+  else if (solverType == "tridiagonal")
+  {
+    // the direct tridiagonal solver is used by the implicit time stepping schemes if the system matrix is tridiagonal, otherwise the KSP with gmres is used
+    kspType = KSPGMRES;
+  }
 
   std::stringstream optionKey;
   optionKey << this->name_ << "_solverType";
@@ -132,6 +365,174 @@ void Linear::parseSolverTypes(KSPType &kspType, PCType &pcType)
   Control::PerformanceMeasurement::setParameter(optionKey.str(), preconditionerType);
 }
 
+void Linear::initializeKrylovSubspaceRecycling(KSPType kspType)
+{
+  PetscErrorCode ierr;
+
+  // the restart length applies to all GMRES variants
+  if (this->specificSettings_.hasKey("restart")
+      && (kspType == std::string(KSPGMRES) || kspType == std::string(KSPDGMRES) || kspType == std::string(KSPLGMRES)))
+  {
+    int restart = this->specificSettings_.getOptionInt("restart", 30, PythonUtility::Positive);
+    ierr = KSPGMRESSetRestart(*ksp_, restart); CHKERRV(ierr);
+  }
+
+  if (kspType == std::string(KSPDGMRES))
+  {
+    // Deflated GMRES computes approximate eigenvectors of the smallest eigenvalues from the Hessenberg matrix at every restart
+    // and keeps them in the KSP object. As long as the operators are not changed, the deflation space is reused in all subsequent solves.
+    // The setters are not part of the public PETSc API, they are queried from the KSP object.
+    int nDeflationEigenvalues = this->specificSettings_.getOptionInt("nDeflationEigenvalues", 1, PythonUtility::Positive);
+    int maxDeflationEigenvalues = this->specificSettings_.getOptionInt("maxDeflationEigenvalues", 10, PythonUtility::Positive);
+
+    PetscErrorCode (*setEigen)(KSP,PetscInt) = NULL;
+    PetscErrorCode (*setMaxEigen)(KSP,PetscInt) = NULL;
+    ierr = PetscObjectQueryFunction((PetscObject)*ksp_, "KSPDGMRESSetEigen_C", &setEigen); CHKERRV(ierr);
+    ierr = PetscObjectQueryFunction((PetscObject)*ksp_, "KSPDGMRESSetMaxEigen_C", &setMaxEigen); CHKERRV(ierr);
+
+    if (setEigen && setMaxEigen)
+    {
+      ierr = (*setEigen)(*ksp_, nDeflationEigenvalues); CHKERRV(ierr);
+      ierr = (*setMaxEigen)(*ksp_, maxDeflationEigenvalues); CHKERRV(ierr);
+    }
+    else
+    {
+      LOG(WARNING) << "Solver \"" << this->name_ << "\": Could not set the size of the deflation space of DGMRES, "
+        << "use the command line options -ksp_dgmres_eigen and -ksp_dgmres_max_eigen instead.";
+    }
+
+    VLOG(1) << "Solver \"" << this->name_ << "\": deflated GMRES with " << nDeflationEigenvalues << " eigenvalues per restart, "
+      << "at most " << maxDeflationEigenvalues;
+  }
+  else if (kspType == std::string(KSPLGMRES))
+  {
+    // LGMRES augments the Krylov space with approximations of the error from previous restart cycles
+    int augmentationDimension = this->specificSettings_.getOptionInt("augmentationDimension", 2, PythonUtility::Positive);
+    ierr = KSPLGMRESSetAugDim(*ksp_, augmentationDimension); CHKERRV(ierr);
+
+    VLOG(1) << "Solver \"" << this->name_ << "\": LGMRES with augmentation dimension " << augmentationDimension;
+  }
+}
+
+PCType Linear::parsePreconditionerType(std::string preconditionerType)
+{
+  // all pc types: https://www.mcs.anl.gov/petsc/petsc-current/docs/manualpages/PC/PCType.html
+  PCType pcType = PCNONE;
+  if (preconditionerType == "jacobi")
+  {
+    pcType = PCJACOBI;
+  }
+  else if (preconditionerType == "sor")
+  {
+    pcType = PCSOR;
+  }
+  else if (preconditionerType == "lu")
+  {
+    pcType = PCLU;
+  }
+  else if (preconditionerType == "ilu")
+  {
+    pcType = PCILU;
+  }
+  else if (preconditionerType == "gamg")
+  {
+    pcType = PCGAMG;
+  }
+  return pcType;
+}
+
+void Linear::initializeBlockPreconditioner(std::string blockPreconditionerType, std::string schurFactorizationType, const std::vector<std::string> &splitNames,
+                                           const std::vector<IS> &splitIndexSets, const std::vector<std::string> &splitPreconditionerTypes)
+{
+  assert(splitNames.size() == splitIndexSets.size() && splitNames.size() == splitPreconditionerTypes.size());
+
+  PetscErrorCode ierr;
+  PC pc;
+  ierr = KSPGetPC(*ksp_, &pc); CHKERRV(ierr);
+  ierr = PCSetType(pc, PCFIELDSPLIT); CHKERRV(ierr);
+
+  for (int splitNo = 0; splitNo < splitNames.size(); splitNo++)
+  {
+    ierr = PCFieldSplitSetIS(pc, splitNames[splitNo].c_str(), splitIndexSets[splitNo]); CHKERRV(ierr);
+  }
+
+  if (blockPreconditionerType == "schur")
+  {
+    if (splitNames.size() != 2)
+    {
+      LOG(FATAL) << "Solver \"" << this->name_ << "\": The Schur complement block preconditioner needs 2 splits, but " << splitNames.size() << " are given.";
+    }
+
+    ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_SCHUR); CHKERRV(ierr);
+
+    // parse the type of the block factorization
+    PCFieldSplitSchurFactType factorizationType = PC_FIELDSPLIT_SCHUR_FACT_LOWER;
+    if (schurFactorizationType == "diag")
+    {
+      factorizationType = PC_FIELDSPLIT_SCHUR_FACT_DIAG;
+    }
+    else if (schurFactorizationType == "upper")
+    {
+      factorizationType = PC_FIELDSPLIT_SCHUR_FACT_UPPER;
+    }
+    else if (schurFactorizationType == "full")
+    {
+      factorizationType = PC_FIELDSPLIT_SCHUR_FACT_FULL;
+    }
+    else if (schurFactorizationType != "lower")
+    {
+      LOG(WARNING) << "Unknown value \"" << schurFactorizationType << "\" for \"schurFactorizationType\", "
+        << "allowed values are \"diag\", \"lower\", \"upper\" and \"full\". Using \"lower\".";
+    }
+    ierr = PCFieldSplitSetSchurFactType(pc, factorizationType); CHKERRV(ierr);
+
+    // precondition the Schur complement by A11 - A10 inv(diag(A00)) A01, this is suited for diagonally dominant first blocks
+    ierr = PCFieldSplitSetSchurPre(pc, PC_FIELDSPLIT_SCHUR_PRE_SELFP, NULL); CHKERRV(ierr);
+  }
+  else if (blockPreconditionerType == "multiplicative")
+  {
+    // block Gauss-Seidel
+    ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_MULTIPLICATIVE); CHKERRV(ierr);
+  }
+  else
+  {
+    if (blockPreconditionerType != "additive")
+    {
+      LOG(WARNING) << "Unknown value \"" << blockPreconditionerType << "\" for \"blockPreconditionerType\", "
+        << "allowed values are \"none\", \"additive\", \"multiplicative\" and \"schur\". Using \"additive\".";
+    }
+
+    // block Jacobi
+    ierr = PCFieldSplitSetType(pc, PC_COMPOSITE_ADDITIVE); CHKERRV(ierr);
+  }
+
+  // set options from command line, this overrides the python config
+  ierr = PCSetFromOptions(pc); CHKERRV(ierr);
+
+  // set up the preconditioner, this creates the sub KSP objects
+  ierr = PCSetUp(pc); CHKERRV(ierr);
+
+  // configure the solvers of the splits, every split is solved by a single application of its preconditioner,
+  // for the Schur complement the last sub KSP solves the Schur complement of the second split
+  PetscInt nSplits = 0;
+  KSP *subKsps;
+  ierr = PCFieldSplitGetSubKSP(pc, &nSplits, &subKsps); CHKERRV(ierr);
+
+  for (PetscInt splitNo = 0; splitNo < nSplits; splitNo++)
+  {
+    ierr = KSPSetType(subKsps[splitNo], KSPPREONLY); CHKERRV(ierr);
+
+    PC subPc;
+    ierr = KSPGetPC(subKsps[splitNo], &subPc); CHKERRV(ierr);
+    ierr = PCSetType(subPc, parsePreconditionerType(splitPreconditionerTypes[splitNo])); CHKERRV(ierr);
+
+    // set options from command line, this overrides the python config
+    ierr = KSPSetFromOptions(subKsps[splitNo]); CHKERRV(ierr);
+  }
+
+  ierr = PetscFree(subKsps); CHKERRV(ierr);
+}
+
 std::shared_ptr<KSP> Linear::ksp()
 {
   return ksp_;
@@ -5,6 +5,8 @@
 
 #include <petscksp.h>
 #include <memory>
+#include <vector>
+#include <map>
 
 namespace Solver
 {
@@ -18,17 +20,85 @@ public:
   //! construct solver from python settings
   Linear(PythonConfig specificSettings, MPI_Comm mpiCommunicator, std::string name);
 
+  //! destroy the vectors of the stored previous solutions
+  virtual ~Linear();
+
   //! return the KSP object that is used for solving
   std::shared_ptr<KSP> ksp();
 
+  //! solve the linear system with the operators that were set to the ksp, use the initial guess strategy given by "initialGuess",
+  //! record number of iterations and duration in the performance measurement, message is used for the log output.
+  //! The previous solutions are kept per solution vector, such that a shared solver can be used for several problems. Without a previous solution,
+  //! the initial guess is the one configured by the caller, e.g. by KSPSetInitialGuessNonzero. The residual norms of the iterations are stored as parameter in the performance measurement.
+  void solve(Vec rightHandSide, Vec solution, std::string message = "Linear system");
+
+  //! return the residual norms of all iterations of the last solve
+  std::vector<double> residualHistory() const;
+
+  //! return the number of iterations of the last solve
+  int lastNumberOfIterations() const;
+
+  //! return the solver type as given by "solverType" in the python settings, e.g. "gmres" or "tridiagonal"
+  std::string solverType() const;
+
+  //! convert a preconditioner name as used in the python settings (e.g. "jacobi", "gamg") to the PETSc PCType
+  static PCType parsePreconditionerType(std::string preconditionerType);
+
+  //! Use a PCFIELDSPLIT block preconditioner with the given splits, i.e. the names (prefixes of the command line options) and the index sets of their rows.
+  //! The operators have to be set to the ksp before. blockPreconditionerType is "additive" (block Jacobi), "multiplicative" (block Gauss-Seidel)
+  //! or "schur" (Schur complement of the second of two splits with the given schurFactorizationType "diag", "lower", "upper" or "full").
+  //! Every split is solved by a single application of its preconditioner in splitPreconditionerTypes, e.g. "jacobi" or "gamg".
+  void initializeBlockPreconditioner(std::string blockPreconditionerType, std::string schurFactorizationType, const std::vector<std::string> &splitNames,
+                                     const std::vector<IS> &splitIndexSets, const std::vector<std::string> &splitPreconditionerTypes);
+
 protected:
 
   //! parse the solver and preconditioner type from settings
   void parseSolverTypes(KSPType &kspType, PCType &pcType);
 
+  //! set the GMRES restart length and the size of the deflation space (dgmres) or augmentation space (lgmres) that is retained over restarts and solves
+  void initializeKrylovSubspaceRecycling(KSPType kspType);
+
+  /** The previous solutions of the problem that is solved into a particular solution vector.
+   *  A solver that is shared by several problems, e.g. by the instances of a MultipleInstances scheme, keeps one history per problem.
+   *  The histories are identified by the PETSc id of the solution vector, which is not reused for a new vector, unlike its address.
+   */
+  struct SolutionHistory
+  {
+    std::vector<Vec> previousSolutions;   ///< the solutions of the last two solves, previousSolutions[0] is the newest, used for the initial guess
+    int nPreviousSolutions = 0;           ///< the number of valid entries in previousSolutions
+    Vec solutionWork = PETSC_NULL;        ///< temporary solution vector if rightHandSide and solution are the same vector and a nonzero initial guess is used
+  };
+
+  //! set the initial guess in kspSolution from the stored previous solutions of the history
+  void setInitialGuess(SolutionHistory &history, Vec kspSolution);
+
+  //! store the solution in the history for the initial guess of the next solve
+  void storeSolution(SolutionHistory &history, Vec solution);
+
+  //! rebuild the preconditioner if the number of iterations has increased too much since the last rebuild
+  void checkPreconditionerRefresh(int numberOfIterations);
+
+  enum initial_guess_t {
+    initialGuessDefault,        ///< do not change the initial guess, i.e. zero unless KSPSetInitialGuessNonzero was called
+    initialGuessPrevious,       ///< use the solution of the last solve
+    initialGuessExtrapolate     ///< linearly extrapolate from the solutions of the last two solves
+  };
+
   std::shared_ptr<KSP> ksp_;   ///< the PETSc KSP (Krylov subspace) object
+  std::string solverType_;     ///< the solver type as given in the settings
   double relativeTolerance_;    ///< relative solver tolerance
   long int maxIterations_;     ///< maximum number of iterations
+
+  initial_guess_t initialGuess_;   ///< how to compute the initial guess, set by the option "initialGuess"
+  std::map<PetscObjectId,SolutionHistory> solutionHistories_;   ///< the previous solutions for every solution vector that was passed to solve, key is the id of the vector
+
+  double preconditionerRefreshFactor_;   ///< if > 0, the preconditioner is reused and only rebuilt when the number of iterations exceeds this factor times the reference
+  int referenceNumberOfIterations_;      ///< the number of iterations of the first solve after the last preconditioner rebuild, -1 if not yet known
+  bool rebuildPreconditioner_;           ///< if the preconditioner should be rebuilt in the next solve
+
+  std::vector<double> residualHistoryBuffer_;  ///< buffer for the residual norms of the iterations, given to KSPSetResidualHistory
+  int lastNumberOfIterations_;           ///< the number of iterations of the last solve
 };
 
 }  // namespace
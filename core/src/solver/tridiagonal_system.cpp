@@ -0,0 +1,420 @@
+#include "solver/tridiagonal_system.h"
+
+#include <cmath>
+#include <cassert>
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+
+namespace Solver
+{
+
+TridiagonalSystem::TridiagonalSystem() :
+  nRowsLocal_(0), nRowsInterior_(0), nRanks_(1), ownRankNo_(0), mpiCommunicator_(MPI_COMM_NULL), interfaceLower_(0.0), request_(MPI_REQUEST_NULL)
+{
+}
+
+bool TridiagonalSystem::initialize(Mat matrix, MPI_Comm mpiCommunicator)
+{
+  PetscErrorCode ierr;
+  mpiCommunicator_ = mpiCommunicator;
+  MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator_, &nRanks_), "MPI_Comm_size");
+  MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator_, &ownRankNo_), "MPI_Comm_rank");
+
+  PetscInt rowBegin, rowEnd, nRowsGlobal, nColumnsGlobal;
+  ierr = MatGetOwnershipRange(matrix, &rowBegin, &rowEnd); CHKERRABORT(mpiCommunicator_, ierr);
+  ierr = MatGetSize(matrix, &nRowsGlobal, &nColumnsGlobal); CHKERRABORT(mpiCommunicator_, ierr);
+
+  const bool isLastRank = (ownRankNo_ == nRanks_-1);
+  nRowsLocal_ = rowEnd - rowBegin;
+  nRowsInterior_ = (isLastRank? nRowsLocal_ : nRowsLocal_-1);
+
+  // extract the diagonals, lower[i], diagonal[i] and upper[i] are the entries of local row i in the global columns before, at and after the diagonal
+  std::vector<double> lower(nRowsLocal_, 0.0);
+  std::vector<double> diagonal(nRowsLocal_, 0.0);
+  std::vector<double> upper(nRowsLocal_, 0.0);
+  bool canBeSolved = (nRowsGlobal == nColumnsGlobal);
+
+  for (PetscInt rowNo = rowBegin; rowNo < rowEnd; rowNo++)
+  {
+    const int i = rowNo - rowBegin;
+    PetscInt nEntries;
+    const PetscInt *columns;
+    const PetscScalar *entries;
+    ierr = MatGetRow(matrix, rowNo, &nEntries, &columns, &entries); CHKERRABORT(mpiCommunicator_, ierr);
+
+    for (int entryNo = 0; entryNo < nEntries; entryNo++)
+    {
+      if (columns[entryNo] == rowNo-1)
+        lower[i] = entries[entryNo];
+      else if (columns[entryNo] == rowNo)
+        diagonal[i] = entries[entryNo];
+      else if (columns[entryNo] == rowNo+1)
+        upper[i] = entries[entryNo];
+      else if (entries[entryNo] != 0.0)
+        canBeSolved = false;
+    }
+    ierr = MatRestoreRow(matrix, rowNo, &nEntries, &columns, &entries); CHKERRABORT(mpiCommunicator_, ierr);
+  }
+
+  // every rank needs at least one interior row
+  if (nRowsInterior_ < 1)
+    canBeSolved = false;
+
+  // factorize the interior rows, the coupling of the first interior row to the previous rank and of the last interior row to the interface row are handled by the spikes
+  if (canBeSolved)
+  {
+    lower_.assign(lower.begin(), lower.begin() + nRowsInterior_);
+    lower_[0] = 0.0;
+    upperFactorized_.resize(nRowsInterior_);
+    inversePivots_.resize(nRowsInterior_);
+
+    for (int i = 0; i < nRowsInterior_; i++)
+    {
+      const double upperInterior = (i < nRowsInterior_-1? upper[i] : 0.0);
+      const double pivot = diagonal[i] - (i > 0? lower_[i]*upperFactorized_[i-1] : 0.0);
+
+      // there is no pivoting, the factorization is only stable for e.g. diagonally dominant matrices
+      if (std::fabs(pivot) <= 1e-14*(std::fabs(diagonal[i]) + std::fabs(lower[i]) + std::fabs(upper[i])))
+      {
+        canBeSolved = false;
+        break;
+      }
+      inversePivots_[i] = 1.0 / pivot;
+      upperFactorized_[i] = upperInterior * inversePivots_[i];
+    }
+  }
+
+  // all ranks have to agree
+  int canBeSolvedLocal = canBeSolved;
+  int canBeSolvedGlobal = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&canBeSolvedLocal, &canBeSolvedGlobal, 1, MPI_INT, MPI_MIN, mpiCommunicator_), "MPI_Allreduce");
+  if (!canBeSolvedGlobal)
+    return false;
+
+  if (nRanks_ == 1)
+    return true;
+
+  // compute the spikes, i.e. the influence of the interface values on the interior values
+  leftSpike_.assign(nRowsInterior_, 0.0);
+  leftSpike_[0] = lower[0];
+  sweepInterior(leftSpike_.data());
+
+  rightSpike_.assign(nRowsInterior_, 0.0);
+  if (!isLastRank)
+    rightSpike_[nRowsInterior_-1] = upper[nRowsInterior_-1];
+  sweepInterior(rightSpike_.data());
+
+  // collect the coefficients that are needed for the system of the interface values from all ranks
+  interfaceLower_ = (isLastRank? 0.0 : lower[nRowsLocal_-1]);
+  std::vector<double> localCoefficients = {
+    interfaceLower_,
+    (isLastRank? 0.0 : diagonal[nRowsLocal_-1]),
+    (isLastRank? 0.0 : upper[nRowsLocal_-1]),
+    leftSpike_[0], rightSpike_[0],
+    leftSpike_[nRowsInterior_-1], rightSpike_[nRowsInterior_-1]
+  };
+  const int nCoefficients = localCoefficients.size();
+  std::vector<double> coefficients(nCoefficients*nRanks_);
+  MPIUtility::handleReturnValue(MPI_Allgather(localCoefficients.data(), nCoefficients, MPI_DOUBLE,
+                                              coefficients.data(), nCoefficients, MPI_DOUBLE, mpiCommunicator_), "MPI_Allgather");
+
+  // Set up and factorize the system of the interface values, it is the same on all ranks. The interface row of rank p is
+  //   a*x_{last interior of p} + b*g_p + c*x_{first interior of p+1} = d,
+  // inserting x = y - v*g_{p-1} - w*g_p for the interior values gives a tridiagonal system for g.
+  const int nInterfaces = nRanks_-1;
+  interfaceUpper_.resize(nInterfaces);
+  reducedLower_.resize(nInterfaces);
+  reducedUpperFactorized_.resize(nInterfaces);
+  reducedInversePivots_.resize(nInterfaces);
+
+  for (int p = 0; p < nInterfaces; p++)
+  {
+    const double *coefficientsRank = coefficients.data() + p*nCoefficients;
+    const double *coefficientsNextRank = coefficients.data() + (p+1)*nCoefficients;
+
+    const double a = coefficientsRank[0];
+    const double b = coefficientsRank[1];
+    const double c = coefficientsRank[2];
+    const double leftSpikeLast = coefficientsRank[5];
+    const double rightSpikeLast = coefficientsRank[6];
+    const double leftSpikeFirstNextRank = coefficientsNextRank[3];
+    const double rightSpikeFirstNextRank = coefficientsNextRank[4];
+
+    interfaceUpper_[p] = c;
+    reducedLower_[p] = -a*leftSpikeLast;
+    const double reducedDiagonal = b - a*rightSpikeLast - c*leftSpikeFirstNextRank;
+    const double reducedUpper = -c*rightSpikeFirstNextRank;
+
+    const double pivot = reducedDiagonal - (p > 0? reducedLower_[p]*reducedUpperFactorized_[p-1] : 0.0);
+    if (pivot == 0.0)
+    {
+      LOG(WARNING) << "The system of the interface values of the tridiagonal system is singular.";
+      return false;
+    }
+    reducedInversePivots_[p] = 1.0 / pivot;
+    reducedUpperFactorized_[p] = reducedUpper * reducedInversePivots_[p];
+  }
+
+  sendBuffer_.resize(2);
+  receiveBuffer_.resize(2*nRanks_);
+  interfaceValues_.resize(nInterfaces);
+  return true;
+}
+
+void TridiagonalSystem::solve(Vec rightHandSide, Vec solution)
+{
+  PetscErrorCode ierr;
+  if (rightHandSide != solution)
+  {
+    ierr = VecCopy(rightHandSide, solution); CHKERRV(ierr);
+  }
+
+  double *values;
+  ierr = VecGetArray(solution, &values); CHKERRV(ierr);
+  solve(values);
+  ierr = VecRestoreArray(solution, &values); CHKERRV(ierr);
+}
+
+void TridiagonalSystem::solve(double *values)
+{
+  solveLocal(values);
+  startExchange();
+  finishExchange(values);
+}
+
+void TridiagonalSystem::solveLocal(double *values)
+{
+  sweepInterior(values);
+  prepareExchange(values);
+}
+
+void TridiagonalSystem::sweepInterior(double *values) const
+{
+  // forward substitution
+  values[0] *= inversePivots_[0];
+  for (int i = 1; i < nRowsInterior_; i++)
+  {
+    values[i] = (values[i] - lower_[i]*values[i-1]) * inversePivots_[i];
+  }
+
+  // backward substitution
+  for (int i = nRowsInterior_-2; i >= 0; i--)
+  {
+    values[i] -= upperFactorized_[i]*values[i+1];
+  }
+}
+
+void TridiagonalSystem::prepareExchange(const double *values)
+{
+  if (nRanks_ == 1)
+    return;
+
+  // the right hand side of the interface row without the contribution of the next rank, which is added when the data of all ranks is known
+  if (ownRankNo_ == nRanks_-1)
+    sendBuffer_[0] = 0.0;
+  else
+    sendBuffer_[0] = values[nRowsLocal_-1] - interfaceLower_*values[nRowsInterior_-1];
+
+  sendBuffer_[1] = values[0];
+}
+
+void TridiagonalSystem::startExchange()
+{
+  if (nRanks_ == 1)
+    return;
+
+  MPIUtility::handleReturnValue(MPI_Iallgather(sendBuffer_.data(), 2, MPI_DOUBLE, receiveBuffer_.data(), 2, MPI_DOUBLE, mpiCommunicator_, &request_), "MPI_Iallgather");
+}
+
+void TridiagonalSystem::finishExchange(double *values)
+{
+  if (nRanks_ == 1)
+    return;
+
+  MPIUtility::handleReturnValue(MPI_Wait(&request_, MPI_STATUS_IGNORE), "MPI_Wait");
+
+  // solve the system of the interface values
+  const int nInterfaces = nRanks_-1;
+  for (int p = 0; p < nInterfaces; p++)
+  {
+    const double rightHandSide = receiveBuffer_[2*p] - interfaceUpper_[p]*receiveBuffer_[2*(p+1)+1];
+    interfaceValues_[p] = (rightHandSide - (p > 0? reducedLower_[p]*interfaceValues_[p-1] : 0.0)) * reducedInversePivots_[p];
+  }
+  for (int p = nInterfaces-2; p >= 0; p--)
+  {
+    interfaceValues_[p] -= reducedUpperFactorized_[p]*interfaceValues_[p+1];
+  }
+
+  // correct the interior values and set the value of the own interface row
+  const bool isLastRank = (ownRankNo_ == nRanks_-1);
+  const double interfaceValueLeft = (ownRankNo_ > 0? interfaceValues_[ownRankNo_-1] : 0.0);
+  const double interfaceValueRight = (isLastRank? 0.0 : interfaceValues_[ownRankNo_]);
+
+  for (int i = 0; i < nRowsInterior_; i++)
+  {
+    values[i] -= leftSpike_[i]*interfaceValueLeft + rightSpike_[i]*interfaceValueRight;
+  }
+
+  if (!isLastRank)
+    values[nRowsLocal_-1] = interfaceValueRight;
+}
+
+int TridiagonalSystem::nRowsLocal() const
+{
+  return nRowsLocal_;
+}
+
+int TridiagonalSystem::nRowsInterior() const
+{
+  return nRowsInterior_;
+}
+
+const std::vector<double> &TridiagonalSystem::lower() const
+{
+  return lower_;
+}
+
+const std::vector<double> &TridiagonalSystem::upperFactorized() const
+{
+  return upperFactorized_;
+}
+
+const std::vector<double> &TridiagonalSystem::inversePivots() const
+{
+  return inversePivots_;
+}
+
+void TridiagonalSystemBatch::initialize(const std::vector<TridiagonalSystem *> &systems)
+{
+  systems_ = systems;
+
+  // the sweeps can be interleaved if all systems have the same number of interior rows
+  interleaved_ = (systems_.size() > 1);
+  for (TridiagonalSystem *system : systems_)
+  {
+    if (system->nRowsInterior() != systems_[0]->nRowsInterior())
+      interleaved_ = false;
+  }
+
+  if (!interleaved_)
+    return;
+
+  const int nSystems = systems_.size();
+  const int nRowsInterior = systems_[0]->nRowsInterior();
+
+  lower_.resize(nRowsInterior*nSystems);
+  upperFactorized_.resize(nRowsInterior*nSystems);
+  inversePivots_.resize(nRowsInterior*nSystems);
+  values_.resize(nRowsInterior*nSystems);
+
+  for (int systemNo = 0; systemNo < nSystems; systemNo++)
+  {
+    for (int i = 0; i < nRowsInterior; i++)
+    {
+      lower_[i*nSystems + systemNo] = systems_[systemNo]->lower()[i];
+      upperFactorized_[i*nSystems + systemNo] = systems_[systemNo]->upperFactorized()[i];
+      inversePivots_[i*nSystems + systemNo] = systems_[systemNo]->inversePivots()[i];
+    }
+  }
+}
+
+void TridiagonalSystemBatch::solve(const std::vector<double *> &values)
+{
+  startSolve(values);
+  finishSolve(values);
+}
+
+void TridiagonalSystemBatch::startSolve(const std::vector<double *> &values)
+{
+  assert(values.size() == systems_.size());
+
+  // eliminate the interior rows
+  if (interleaved_)
+  {
+    sweepInteriorInterleaved(values);
+    for (int systemNo = 0; systemNo < systems_.size(); systemNo++)
+    {
+      systems_[systemNo]->prepareExchange(values[systemNo]);
+    }
+  }
+  else
+  {
+    for (int systemNo = 0; systemNo < systems_.size(); systemNo++)
+    {
+      systems_[systemNo]->solveLocal(values[systemNo]);
+    }
+  }
+
+  // start the exchange of the interface data of all systems at the same time
+  for (int systemNo = 0; systemNo < systems_.size(); systemNo++)
+  {
+    systems_[systemNo]->startExchange();
+  }
+}
+
+void TridiagonalSystemBatch::finishSolve(const std::vector<double *> &values)
+{
+  assert(values.size() == systems_.size());
+
+  // wait for the exchanges and compute the final solutions
+  for (int systemNo = 0; systemNo < systems_.size(); systemNo++)
+  {
+    systems_[systemNo]->finishExchange(values[systemNo]);
+  }
+}
+
+void TridiagonalSystemBatch::sweepInteriorInterleaved(const std::vector<double *> &values)
+{
+  const int nSystems = systems_.size();
+  const int nRowsInterior = systems_[0]->nRowsInterior();
+
+  for (int systemNo = 0; systemNo < nSystems; systemNo++)
+  {
+    for (int i = 0; i < nRowsInterior; i++)
+    {
+      values_[i*nSystems + systemNo] = values[systemNo][i];
+    }
+  }
+
+  // forward substitution, the innermost loops run over contiguous entries of all systems and can be vectorized
+  for (int systemNo = 0; systemNo < nSystems; systemNo++)
+  {
+    values_[systemNo] *= inversePivots_[systemNo];
+  }
+  for (int i = 1; i < nRowsInterior; i++)
+  {
+    double *valuesRow = values_.data() + i*nSystems;
+    const double *valuesPreviousRow = valuesRow - nSystems;
+    const double *lowerRow = lower_.data() + i*nSystems;
+    const double *inversePivotsRow = inversePivots_.data() + i*nSystems;
+
+    for (int systemNo = 0; systemNo < nSystems; systemNo++)
+    {
+      valuesRow[systemNo] = (valuesRow[systemNo] - lowerRow[systemNo]*valuesPreviousRow[systemNo]) * inversePivotsRow[systemNo];
+    }
+  }
+
+  // backward substitution
+  for (int i = nRowsInterior-2; i >= 0; i--)
+  {
+    double *valuesRow = values_.data() + i*nSystems;
+    const double *valuesNextRow = valuesRow + nSystems;
+    const double *upperFactorizedRow = upperFactorized_.data() + i*nSystems;
+
+    for (int systemNo = 0; systemNo < nSystems; systemNo++)
+    {
+      valuesRow[systemNo] -= upperFactorizedRow[systemNo]*valuesNextRow[systemNo];
+    }
+  }
+
+  for (int systemNo = 0; systemNo < nSystems; systemNo++)
+  {
+    for (int i = 0; i < nRowsInterior; i++)
+    {
+      values[systemNo][i] = values_[i*nSystems + systemNo];
+    }
+  }
+}
+
+}  // namespace
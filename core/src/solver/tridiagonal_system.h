@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <petscmat.h>
+#include <vector>
+
+namespace Solver
+{
+
+/**
+ * Direct solver for a linear system with a tridiagonal matrix in the global PETSc numbering, e.g. the system matrix of implicit time stepping
+ * on a 1D mesh with linear Lagrange basis functions. The matrix is factorized once in initialize, every solve then only needs one forward and
+ * one backward sweep over the local rows.
+ *
+ * If the matrix is distributed over multiple ranks, every rank owns a contiguous block of rows. The last row of every rank except the last rank is an interface row.
+ * The remaining (interior) rows of a rank only couple to the interface rows of the previous and of the own rank, they are eliminated locally,
+ * which gives the local solution y and the two spikes v, w (the influence of the interface values) such that x = y - v*g_{p-1} - w*g_p.
+ * The interface values g form a tridiagonal system of size nRanks-1, which is solved redundantly on all ranks,
+ * this needs one allgather of two values per rank in every solve.
+ *
+ * A solve can be split into solveLocal, startExchange and finishExchange, such that the communication of multiple systems can overlap.
+ */
+class TridiagonalSystem
+{
+public:
+  //! constructor
+  TridiagonalSystem();
+
+  //! extract the three diagonals of the local rows of the matrix and compute the factorization, collective on mpiCommunicator.
+  //! @return if the matrix is tridiagonal and every rank has enough rows, otherwise the system cannot be solved by this class
+  bool initialize(Mat matrix, MPI_Comm mpiCommunicator);
+
+  //! solve matrix*solution = rightHandSide, rightHandSide and solution may be the same vector, collective
+  void solve(Vec rightHandSide, Vec solution);
+
+  //! solve the system in-place, values contains the local entries of the right hand side on input and of the solution on output, collective
+  void solve(double *values);
+
+  //! first phase of solve, eliminate the interior rows and prepare the data for the exchange of the interface values
+  void solveLocal(double *values);
+
+  //! second phase of solve, start the exchange of the interface data with the other ranks
+  void startExchange();
+
+  //! third phase of solve, wait for the exchange, solve the system of the interface values and compute the final solution
+  void finishExchange(double *values);
+
+  //! the number of rows that are owned by the own rank
+  int nRowsLocal() const;
+
+  //! the number of interior rows of the own rank that are eliminated by the local sweep
+  int nRowsInterior() const;
+
+  //! the lower diagonal of the interior rows, without the coupling of the first interior row to the previous rank
+  const std::vector<double> &lower() const;
+
+  //! the factorized upper diagonal of the interior rows
+  const std::vector<double> &upperFactorized() const;
+
+  //! the inverse pivots of the interior rows
+  const std::vector<double> &inversePivots() const;
+
+  //! compute the data for the exchange of the interface values, this has to be called after the interior rows were eliminated by a custom sweep instead of solveLocal
+  void prepareExchange(const double *values);
+
+protected:
+
+  //! solve the system with the interior rows for the given right hand side by forward and backward substitution with the factorization
+  void sweepInterior(double *values) const;
+
+  int nRowsLocal_;                              ///< number of rows of the own rank
+  int nRowsInterior_;                           ///< number of interior rows, nRowsLocal_ - 1 on all ranks but the last, nRowsLocal_ on the last rank
+  int nRanks_;                                  ///< number of ranks of the communicator
+  int ownRankNo_;                               ///< own rank no in the communicator
+  MPI_Comm mpiCommunicator_;                    ///< the communicator of the matrix
+
+  std::vector<double> lower_;                   ///< lower diagonal of the interior rows, lower_[0] = 0
+  std::vector<double> upperFactorized_;         ///< upper diagonal of the factorization, upper_i / pivot_i
+  std::vector<double> inversePivots_;           ///< inverse pivots of the factorization, 1 / (diagonal_i - lower_i*upperFactorized_{i-1})
+  std::vector<double> leftSpike_;               ///< solution of the interior system for the coupling of the first interior row to the interface row of the previous rank
+  std::vector<double> rightSpike_;              ///< solution of the interior system for the coupling of the last interior row to the interface row of the own rank
+
+  double interfaceLower_;                       ///< coefficient of the last interior row in the interface row
+  std::vector<double> interfaceUpper_;          ///< for every interface row, the coefficient of the first row of the next rank
+  std::vector<double> reducedLower_;            ///< lower diagonal of the system of the interface values
+  std::vector<double> reducedUpperFactorized_;  ///< factorized upper diagonal of the system of the interface values
+  std::vector<double> reducedInversePivots_;    ///< inverse pivots of the system of the interface values
+
+  std::vector<double> sendBuffer_;              ///< the data of the own rank for the exchange, [right hand side of the interface row without the next rank, first interior value]
+  std::vector<double> receiveBuffer_;           ///< the exchanged data of all ranks
+  std::vector<double> interfaceValues_;         ///< the interface values g
+  MPI_Request request_;                         ///< the request of the non-blocking allgather
+};
+
+/**
+ * Solve multiple tridiagonal systems, e.g. of all fibers of a rank, together. If all systems have the same number of interior rows, the values
+ * are interleaved and the forward and backward sweeps of all systems are done at once, with the innermost loop over the systems that can be vectorized.
+ * The exchange of the interface values of distributed systems overlaps for all systems.
+ * With startSolve and finishSolve, other work can be done while the exchange is in progress.
+ */
+class TridiagonalSystemBatch
+{
+public:
+
+  //! store the systems, they have to be initialized
+  void initialize(const std::vector<TridiagonalSystem *> &systems);
+
+  //! solve all systems in-place, values[i] contains the local entries of the right hand side of system i on input and of its solution on output
+  void solve(const std::vector<double *> &values);
+
+  //! first phase of solve, eliminate the interior rows of all systems and start the exchanges of the interface data, values have to stay valid until finishSolve
+  void startSolve(const std::vector<double *> &values);
+
+  //! second phase of solve, wait for the exchanges and compute the solutions, values have to be the same as in startSolve
+  void finishSolve(const std::vector<double *> &values);
+
+protected:
+
+  //! forward and backward sweep of the interior rows of all systems with interleaved values
+  void sweepInteriorInterleaved(const std::vector<double *> &values);
+
+  std::vector<TridiagonalSystem *> systems_;    ///< the systems that are solved together
+  bool interleaved_;                            ///< if the systems have the same number of interior rows and the sweeps are done interleaved
+
+  std::vector<double> lower_;                   ///< lower diagonals of all systems, interleaved, lower_[rowNo*nSystems + systemNo]
+  std::vector<double> upperFactorized_;         ///< factorized upper diagonals of all systems, interleaved
+  std::vector<double> inversePivots_;           ///< inverse pivots of all systems, interleaved
+  std::vector<double> values_;                  ///< buffer for the interleaved values
+};
+
+}  // namespace
@@ -12,6 +12,7 @@ namespace SpatialDiscretization
 /**
  * Base class containing basic finite element functionality such as initializing and solving.
  * Further classes derive from this base class and add special functionality such as setting stiffness matrix, rhs and timestepping
+ * The options that are used during the computation (e.g. "prefactor") are parsed in the constructor, later changes of the python config have no effect.
  */
 template<typename FunctionSpaceType,typename QuadratureType,typename Term>
 class FiniteElementMethodBase : public SpatialDiscretization, public Runnable
@@ -68,6 +69,7 @@ protected:
   Data data_;     ///< data object that holds all PETSc vectors and matrices
   PythonConfig specificSettings_;    ///< python object containing the value of the python config dict with corresponding key
   OutputWriter::Manager outputWriterManager_; ///< manager object holding all output writer
+  double prefactor_;       ///< the prefactor of the stiffness matrix, option "prefactor", parsed in the constructor
   bool initialized_;     ///< if initialize was already called on this object, then further calls to initialize() have no effect
 };
 
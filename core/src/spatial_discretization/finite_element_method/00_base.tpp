@@ -29,6 +29,9 @@ FiniteElementMethodBase(DihuContext context, std::shared_ptr<FunctionSpaceType>
 {
   outputWriterManager_.initialize(context_, specificSettings_);
 
+  // parse options that are needed during the computation, such that the python config is not accessed later
+  prefactor_ = specificSettings_.getOptionDouble("prefactor", 1.0);
+
   // Create mesh or retrieve existing mesh from meshManager. This already creates meshPartition in functionSpace.initialize(), see function_space/03_function_space_partition_structured.tpp
   if (!functionSpace)
   {
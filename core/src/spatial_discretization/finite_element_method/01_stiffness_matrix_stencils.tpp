@@ -41,7 +41,7 @@ setStiffnessMatrix()
   double elementLength = functionSpace->meshWidth();
 
   double integralFactor = 1./elementLength;
-  double prefactor = this->specificSettings_.getOptionDouble("prefactor", 1.0);
+  double prefactor = this->prefactor_;
 
   integralFactor = prefactor*integralFactor;
 
@@ -126,7 +126,7 @@ setStiffnessMatrix()
   }
 
   double integralFactor = 1.;
-  double prefactor = this->specificSettings_.getOptionDouble("prefactor", 1.0);
+  double prefactor = this->prefactor_;
 
   integralFactor = prefactor*integralFactor;
 
@@ -348,7 +348,7 @@ setStiffnessMatrix()
   }
 
   double integralFactor = elementLength0;
-  double prefactor = this->specificSettings_.getOptionDouble("prefactor", 1.0);
+  double prefactor = this->prefactor_;
 
   integralFactor = prefactor*integralFactor;
 
@@ -4,6 +4,7 @@
 
 #include "spatial_discretization/finite_element_method/solid_mechanics/solid_mechanics_nonlinear_solve.h"
 #include "spatial_discretization/finite_element_method/solid_mechanics/solid_mechanics_utility.h"
+#include "quadrature/tensor_product.h"
 
 namespace SpatialDiscretization
 {
@@ -42,8 +43,47 @@ public:
   //! write the current state as output
   void writeOutput();
 
+  //! store a copy of the solver variable for which the nonlinear function was evaluated, the current quadrature point states belong to this input
+  void storeQuadraturePointStatesInput(Vec solverVariable);
+
+  //! check if the jacobian is requested for the same solver variable as the last nonlinear function evaluation, then the current quadrature point states are reused
+  void checkQuadraturePointStatesInput(Vec solverVariable);
+
 protected:
 
+  typedef typename FunctionSpaceType::HighOrderFunctionSpace HighOrderFunctionSpace;
+  typedef Quadrature::TensorProduct<FunctionSpaceType::dim(), typename QuadratureType::HighOrderQuadrature> QuadratureHighOrderDD;
+
+  //! quantities at a quadrature point that only depend on the reference configuration, they are computed only once
+  struct ReferenceQuadraturePointState
+  {
+    Tensor2<FunctionSpaceType::dim()> inverseJacobianMaterial;   ///< inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx
+    double jacobianDeterminant;    ///< determinant of the jacobian dX/dxi
+  };
+
+  //! quantities at a quadrature point that depend on the current displacements (and pressure), computed by the nonlinear function and reused for the tangent stiffness matrix
+  struct CurrentQuadraturePointState
+  {
+    Tensor2<FunctionSpaceType::dim()> deformationGradient;      ///< F
+    double deformationGradientDeterminant;                      ///< J = det F
+    Tensor2<FunctionSpaceType::dim()> rightCauchyGreen;         ///< C = F^T*F
+    Tensor2<FunctionSpaceType::dim()> inverseRightCauchyGreen;  ///< C^-1
+    std::array<double,2> reducedInvariants;                     ///< Ibar_1, Ibar_2
+    double pressure;                                            ///< artificial pressure for penalty formulation or interpolated pressure for mixed formulation
+    double pressureTilde;                                       ///< pTilde, needed for the elasticity tensor
+    Tensor2<FunctionSpaceType::dim()> fictitiousPK2Stress;      ///< Sbar
+    Tensor2<FunctionSpaceType::dim()> pk2StressIsochoric;       ///< S_iso
+    Tensor2<FunctionSpaceType::dim()> PK2Stress;                ///< S = S_vol + S_iso
+  };
+
+  //! compute the inverse jacobians, their determinants and the gradients of the basis functions at the quadrature points, if this was not done yet
+  void initializeReferenceQuadraturePointStates();
+
+  //! compute the quantities of the current configuration at the quadrature point xi, preparePressureInterpolation has to be called for the element before
+  void computeCurrentQuadraturePointState(const std::array<VecD<FunctionSpaceType::dim()>,HighOrderFunctionSpace::nDofsPerElement()> &displacementValues,
+                                          const Tensor2<FunctionSpaceType::dim()> &inverseJacobianMaterial, const VecD<FunctionSpaceType::dim()> xi,
+                                          CurrentQuadraturePointState &state);
+
   //! compute the tangent stiffnes matrix into the given matrix (implemented by inherited class)
   virtual void setStiffnessMatrix(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix) = 0;
 
@@ -78,6 +118,15 @@ protected:
 
   bool tangentStiffnessMatrixInitialized_ = false;   ///< if the tangentStiffnessMatrix has been set
   bool outputIntermediateSteps_ = false;    ///< if intermediate steps while solving should be output
+
+  std::vector<std::array<ReferenceQuadraturePointState,QuadratureHighOrderDD::numberEvaluations()>> referenceQuadraturePointStates_;  ///< for every local element the states at the quadrature points of the reference configuration
+  std::array<std::array<VecD<FunctionSpaceType::dim()>,HighOrderFunctionSpace::nDofsPerElement()>,QuadratureHighOrderDD::numberEvaluations()> gradPhi_;  ///< the gradients of the basis functions at the quadrature points, gradPhi_[samplingPointIndex][dofIndex][i] = dphi_dofIndex/dxi_i
+  std::vector<std::array<CurrentQuadraturePointState,QuadratureHighOrderDD::numberEvaluations()>> currentQuadraturePointStates_;  ///< for every local element the states at the quadrature points of the last evaluation of the nonlinear function
+
+  bool cacheQuadraturePointStates_ = true;   ///< if the current quadrature point states should be stored and reused for the tangent stiffness matrix, option "cacheQuadraturePointStates"
+  Vec quadraturePointStatesInput_ = PETSC_NULL;    ///< copy of the solver variable for which currentQuadraturePointStates_ were computed
+  bool quadraturePointStatesInputValid_ = false;   ///< if quadraturePointStatesInput_ contains the input of the last evaluation of the nonlinear function
+  bool useCachedQuadraturePointStates_ = false;    ///< if the next computation of the tangent stiffness matrix can use currentQuadraturePointStates_
 };
 
 } // namespace
@@ -125,6 +125,14 @@ setStiffnessMatrixEntriesForDisplacements(std::shared_ptr<PartitionedPetscMat<Fu
     VLOG(3) << " zero tangentStiffnessMatrix";
   }
 
+  // compute jacobians of the reference configuration and gradients of the basis functions, this is only done once
+  initializeReferenceQuadraturePointStates();
+
+  // if the nonlinear function was evaluated for the same displacements, reuse F, C, S etc. from there
+  const bool useCachedStates = useCachedQuadraturePointStates_;
+  useCachedQuadraturePointStates_ = false;
+  VLOG(1) << "setStiffnessMatrix, use cached quadrature point states: " << useCachedStates;
+
   // loop over elements
   for (int elementNo = 0; elementNo < nElements; elementNo++)
   {
@@ -133,13 +141,10 @@ setStiffnessMatrixEntriesForDisplacements(std::shared_ptr<PartitionedPetscMat<Fu
     Control::PerformanceMeasurement::start("stiffnessMatrixDisplacements");
 #endif
 
-    // get geometry field of reference configuration, the geometry field is always 3D, also in 2D problems
-    std::array<Vec3,nDofsPerElement> geometryReferenceValues;
-    this->data_.geometryReference().getElementValues(elementNo, geometryReferenceValues);
-
     // get displacement field
     std::array<VecD<D>,nDofsPerElement> displacementValues;
-    this->data_.displacements().getElementValues(elementNo, displacementValues);
+    if (!useCachedStates)
+      this->data_.displacements().getElementValues(elementNo, displacementValues);
 
     // For mixed formulation get the pressure values of this element. This is done only in the derived class for mixed formulation and not in the derived class for penalty formulation.
     this->preparePressureInterpolation(elementNo);
@@ -150,55 +155,41 @@ setStiffnessMatrixEntriesForDisplacements(std::shared_ptr<PartitionedPetscMat<Fu
       // get parameter values of current sampling point
       VecD<D> xi = samplingPoints[samplingPointIndex];
 
-      // compute the 3xD jacobian of the parameter space to world space mapping
-      Tensor2<D> jacobianMaterial = MathUtility::transformToDxD<D,D>(FunctionSpace::computeJacobian(geometryReferenceValues, xi));
-      double jacobianDeterminant;
-      Tensor2<D> inverseJacobianMaterial = MathUtility::computeInverse<D>(jacobianMaterial, jacobianDeterminant);
-      // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
+      // get the inverse jacobian of the parameter space to world space mapping of the reference configuration
+      const ReferenceQuadraturePointState &referenceState = referenceQuadraturePointStates_[elementNo][samplingPointIndex];
+      const Tensor2<D> &inverseJacobianMaterial = referenceState.inverseJacobianMaterial;
+      const double jacobianDeterminant = referenceState.jacobianDeterminant;
       // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
 
-      // F
-      Tensor2<D> deformationGradient = this->computeDeformationGradient(displacementValues, inverseJacobianMaterial, xi);
-      double deformationGradientDeterminant = MathUtility::computeDeterminant<D>(deformationGradient);  // J
-
-      Tensor2<D> rightCauchyGreen = this->computeRightCauchyGreenTensor(deformationGradient);  // C = F^T*F
-
-      double rightCauchyGreenDeterminant;   // J^2
-      Tensor2<D> inverseRightCauchyGreen = MathUtility::computeSymmetricInverse<D>(rightCauchyGreen, rightCauchyGreenDeterminant);  // C^-1
-
-      // invariants
-      std::array<double,3> invariants = this->computeInvariants(rightCauchyGreen, rightCauchyGreenDeterminant);  // I_1, I_2, I_3
-      std::array<double,2> reducedInvariants = this->computeReducedInvariants(invariants, deformationGradientDeterminant); // Ibar_1, Ibar_2
+      // get F, C, S etc., either from the last evaluation of the nonlinear function or compute them
+      CurrentQuadraturePointState computedState;
+      if (!useCachedStates)
+        computeCurrentQuadraturePointState(displacementValues, inverseJacobianMaterial, xi, computedState);
+      const CurrentQuadraturePointState &currentState = (useCachedStates? currentQuadraturePointStates_[elementNo][samplingPointIndex] : computedState);
 
-      // pressure is the artificialPressure for penalty formulation or the separately interpolated pressure for mixed formulation
-      double artificialPressureTilde;
-      const double artificialPressure = this->getPressure(deformationGradientDeterminant, xi, artificialPressureTilde);
+      const Tensor2<D> &deformationGradient = currentState.deformationGradient;   // F
+      const double deformationGradientDeterminant = currentState.deformationGradientDeterminant;  // J
+      const Tensor2<D> &PK2Stress = currentState.PK2Stress;   // S
 
-      // Pk2 stress tensor S = S_vol + S_iso (p.234)
-      Tensor2<D> fictitiousPK2Stress;
-      Tensor2<D> pk2StressIsochoric;
-      Tensor2<D> PK2Stress = this->computePK2Stress(artificialPressure, rightCauchyGreen, inverseRightCauchyGreen, reducedInvariants, deformationGradientDeterminant, fictitiousPK2Stress, pk2StressIsochoric);
       // elasticity tensor C_{ijkl}
-      ElasticityTensor elasticity = this->computeElasticityTensor(artificialPressure, artificialPressureTilde, rightCauchyGreen, inverseRightCauchyGreen, fictitiousPK2Stress, pk2StressIsochoric, deformationGradientDeterminant, reducedInvariants);
+      ElasticityTensor elasticity = this->computeElasticityTensor(currentState.pressure, currentState.pressureTilde, currentState.rightCauchyGreen,
+                                                                  currentState.inverseRightCauchyGreen, currentState.fictitiousPK2Stress, currentState.pk2StressIsochoric,
+                                                                  deformationGradientDeterminant, currentState.reducedInvariants);
 
-      std::array<VecD<D>,nDofsPerElement> gradPhi = functionSpace->getGradPhi(xi);
+      const std::array<VecD<D>,nDofsPerElement> &gradPhi = gradPhi_[samplingPointIndex];
       // (column-major storage) gradPhi[M][a] = dphi_M / dxi_a
       // gradPhi[column][row] = gradPhi[dofIndex][i] = dphi_dofIndex/dxi_i, columnIdx = dofIndex, rowIdx = which direction
 
-      VLOG(2) << "geometryReferenceValues: " << geometryReferenceValues;
-      VLOG(2) << "Jacobian: J_phi=" << jacobianMaterial;
       VLOG(2) << "jacobianDeterminant: J=" << jacobianDeterminant;
       VLOG(2) << "inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
       VLOG(2) << "deformationGradient: F=" << deformationGradient;
       VLOG(2) << "deformationGradientDeterminant: det F=" << deformationGradientDeterminant;
-      VLOG(2) << "rightCauchyGreen: C=" << rightCauchyGreen;
-      VLOG(2) << "rightCauchyGreenDeterminant: det C=" << rightCauchyGreenDeterminant;
-      VLOG(2) << "inverseRightCauchyGreen: C^-1=" << inverseRightCauchyGreen;
-      VLOG(2) << "invariants: I1,I2,I3: " << invariants;
-      VLOG(2) << "reducedInvariants: Ibar1, Ibar2: " << reducedInvariants;
-      VLOG(2) << "artificialPressure: p=" << artificialPressure << ", artificialPressureTilde: pTilde=" << artificialPressureTilde;
-      VLOG(2) << "fictitiousPK2Stress: Sbar=" << fictitiousPK2Stress;
-      VLOG(2) << "pk2StressIsochoric: S_iso=" << pk2StressIsochoric;
+      VLOG(2) << "rightCauchyGreen: C=" << currentState.rightCauchyGreen;
+      VLOG(2) << "inverseRightCauchyGreen: C^-1=" << currentState.inverseRightCauchyGreen;
+      VLOG(2) << "reducedInvariants: Ibar1, Ibar2: " << currentState.reducedInvariants;
+      VLOG(2) << "artificialPressure: p=" << currentState.pressure << ", artificialPressureTilde: pTilde=" << currentState.pressureTilde;
+      VLOG(2) << "fictitiousPK2Stress: Sbar=" << currentState.fictitiousPK2Stress;
+      VLOG(2) << "pk2StressIsochoric: S_iso=" << currentState.pk2StressIsochoric;
       VLOG(2) << "PK2Stress: S=" << PK2Stress;
       VLOG(2) << "gradPhi: " << gradPhi;
       VLOG(2) << "elasticity: C=" << elasticity;
@@ -295,6 +286,11 @@ setStiffnessMatrixEntriesForDisplacements(std::shared_ptr<PartitionedPetscMat<Fu
 #endif
 
 #ifdef QUADRATURE_TEST
+    // get geometry field of reference configuration, the geometry field is always 3D, also in 2D problems
+    std::array<Vec3,nDofsPerElement> geometryReferenceValues;
+    this->data_.geometryReference().getElementValues(elementNo, geometryReferenceValues);
+    this->data_.displacements().getElementValues(elementNo, displacementValues);
+
     // loop over integration points (e.g. gauss points) for displacement field
     for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPointsExact.size(); samplingPointIndex++)
     {
@@ -949,6 +945,14 @@ computeInternalVirtualWork(Vec &resultVec)
   // set values to zero
   ierr = VecZeroEntries(resultVec); CHKERRV(ierr);
 
+  // compute jacobians of the reference configuration and gradients of the basis functions, this is only done once
+  initializeReferenceQuadraturePointStates();
+
+  // the stored current quadrature point states will be overwritten, they are valid again when the input is stored by storeQuadraturePointStatesInput
+  quadraturePointStatesInputValid_ = false;
+  if (cacheQuadraturePointStates_)
+    currentQuadraturePointStates_.resize(nElements);
+
   // get memory from PETSc where to store result (not used)
   //const PetscScalar *result;
   //VecGetArray(resultVec, &result);
@@ -961,10 +965,6 @@ computeInternalVirtualWork(Vec &resultVec)
     Control::PerformanceMeasurement::start("internalVirtualWork");
 #endif
 
-    // get geometry field of reference configuration, note the dimension of the vecs is always 3 also for 2D problems
-    std::array<Vec3,nDofsPerElement> geometryReferenceValues;
-    this->data_.geometryReference().getElementValues(elementNo, geometryReferenceValues);
-
     // get displacement field values for element
     std::array<VecD<D>,nDofsPerElement> displacementValues;
     this->data_.displacements().getElementValues(elementNo, displacementValues);
@@ -978,71 +978,44 @@ computeInternalVirtualWork(Vec &resultVec)
       // get parameter values of current sampling point
       VecD<D> xi = samplingPoints[samplingPointIndex];
 
-      // compute the 3xD jacobian of the parameter space to world space mapping
-      Tensor2<D> jacobianMaterial = MathUtility::transformToDxD<D,D>(FunctionSpace::computeJacobian(geometryReferenceValues, xi));
-      double jacobianDeterminant;
-      Tensor2<D> inverseJacobianMaterial = MathUtility::computeInverse<D>(jacobianMaterial, jacobianDeterminant);
-      // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
+      // get the inverse jacobian of the parameter space to world space mapping of the reference configuration
+      const ReferenceQuadraturePointState &referenceState = referenceQuadraturePointStates_[elementNo][samplingPointIndex];
+      const Tensor2<D> &inverseJacobianMaterial = referenceState.inverseJacobianMaterial;
       // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
 
-      checkInverseIsCorrect<D>(jacobianMaterial, inverseJacobianMaterial, "jacobianMaterial");
-
-      // F
-      Tensor2<D> deformationGradient = this->computeDeformationGradient(displacementValues, inverseJacobianMaterial, xi);
-      double deformationGradientDeterminant = MathUtility::computeDeterminant<D>(deformationGradient);  // J
-
-      Tensor2<D> rightCauchyGreen = this->computeRightCauchyGreenTensor(deformationGradient);  // C = F^T*F
-
-      checkSymmetry<D>(rightCauchyGreen, "C");
-
-      double rightCauchyGreenDeterminant;   // J^2
-      Tensor2<D> inverseRightCauchyGreen = MathUtility::computeSymmetricInverse<D>(rightCauchyGreen, rightCauchyGreenDeterminant);  // C^-1
-
-      checkInverseIsCorrect<D>(rightCauchyGreen, inverseRightCauchyGreen, "rightCauchyGreen");
+      // compute F, C, S etc., store them to be reused by the tangent stiffness matrix
+      CurrentQuadraturePointState computedState;
+      CurrentQuadraturePointState &currentState = (cacheQuadraturePointStates_? currentQuadraturePointStates_[elementNo][samplingPointIndex] : computedState);
+      computeCurrentQuadraturePointState(displacementValues, inverseJacobianMaterial, xi, currentState);
 
-      // invariants
-      std::array<double,3> invariants = this->computeInvariants(rightCauchyGreen, rightCauchyGreenDeterminant);  // I_1, I_2, I_3
-      std::array<double,2> reducedInvariants = this->computeReducedInvariants(invariants, deformationGradientDeterminant); // Ibar_1, Ibar_2
-
-      // pressure is the artificialPressure for penalty formulation or the separately interpolated pressure for mixed formulation
-      double pressureTilde = 0.0;
-      const double pressure = this->getPressure(deformationGradientDeterminant, xi, pressureTilde);
-
-      // Pk2 stress tensor S = S_vol + S_iso (p.234)
-      Tensor2<D> fictitiousPK2Stress;
-      Tensor2<D> pk2StressIsochoric;
-
-      //! compute 2nd Piola-Kirchhoff stress tensor S = 2*dPsi/dC and the fictitious PK2 Stress Sbar
-      Tensor2<D> PK2Stress = this->computePK2Stress(pressure, rightCauchyGreen, inverseRightCauchyGreen, reducedInvariants, deformationGradientDeterminant, fictitiousPK2Stress, pk2StressIsochoric);
+      const Tensor2<D> &deformationGradient = currentState.deformationGradient;   // F
+      const double deformationGradientDeterminant = currentState.deformationGradientDeterminant;  // J
+      const double pressure = currentState.pressure;
+      const Tensor2<D> &PK2Stress = currentState.PK2Stress;   // S
 
       // check if PK2 is the same as from explicit formula for Mooney-Rivlin (p.249)
       if (VLOG_IS_ON(1))
       {
-        this->checkFictitiousPK2Stress(fictitiousPK2Stress, rightCauchyGreen, deformationGradientDeterminant, reducedInvariants);
+        this->checkFictitiousPK2Stress(currentState.fictitiousPK2Stress, currentState.rightCauchyGreen, deformationGradientDeterminant, currentState.reducedInvariants);
       }
 
-      std::array<VecD<D>,nDofsPerElement> gradPhi = functionSpace->getGradPhi(xi);
+      const std::array<VecD<D>,nDofsPerElement> &gradPhi = gradPhi_[samplingPointIndex];
       // (column-major storage) gradPhi[M][a] = dphi_M / dxi_a
       // gradPhi[column][row] = gradPhi[dofIndex][i] = dphi_dofIndex/dxi_i, columnIdx = dofIndex, rowIdx = which direction
 
       VLOG(2) << "";
       VLOG(2) << "element " << elementNo << " xi: " << xi;
-      VLOG(2) << "  geometryReferenceValues: " << geometryReferenceValues;
       VLOG(2) << "  displacementValues: " << displacementValues;
-      VLOG(2) << "  Jacobian: J_phi=" << jacobianMaterial;
-      VLOG(2) << "  jacobianDeterminant: J=" << jacobianDeterminant;
+      VLOG(2) << "  jacobianDeterminant: J=" << referenceState.jacobianDeterminant;
       VLOG(2) << "  inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
       VLOG(2) << "  deformationGradient: F=" << deformationGradient;
       VLOG(2) << "  deformationGradientDeterminant: det F=" << deformationGradientDeterminant;
-      VLOG(2) << "  rightCauchyGreen: C=" << rightCauchyGreen;
-      VLOG(2) << "  rightCauchyGreenDeterminant: det C=" << rightCauchyGreenDeterminant;
-      VLOG(2) << "  inverseRightCauchyGreen: C^-1=" << inverseRightCauchyGreen;
-      VLOG(2) << "  invariants: I1,I2,I3: " << invariants;
-      VLOG(2) << "  reducedInvariants: Ibar1, Ibar2: " << reducedInvariants;
+      VLOG(2) << "  rightCauchyGreen: C=" << currentState.rightCauchyGreen;
+      VLOG(2) << "  inverseRightCauchyGreen: C^-1=" << currentState.inverseRightCauchyGreen;
+      VLOG(2) << "  reducedInvariants: Ibar1, Ibar2: " << currentState.reducedInvariants;
       VLOG(2) << "  pressure/artificialPressure: " << pressure;
-      //VLOG(2) << "  artificialPressure: p=" << artificialPressure << ", artificialPressureTilde: pTilde=" << artificialPressureTilde;
-      VLOG(2) << "  fictitiousPK2Stress: Sbar=" << fictitiousPK2Stress;
-      VLOG(2) << "  pk2StressIsochoric: S_iso=" << pk2StressIsochoric;
+      VLOG(2) << "  fictitiousPK2Stress: Sbar=" << currentState.fictitiousPK2Stress;
+      VLOG(2) << "  pk2StressIsochoric: S_iso=" << currentState.pk2StressIsochoric;
       VLOG(2) << "  PK2Stress: S=" << PK2Stress;
       VLOG(2) << "  gradPhi: " << gradPhi;
 
@@ -1055,7 +1028,7 @@ computeInternalVirtualWork(Vec &resultVec)
 
       if (VLOG_IS_ON(2))
       {
-        Tensor2<D> greenLangrangeStrain = this->computeGreenLagrangeStrain(rightCauchyGreen);
+        Tensor2<D> greenLangrangeStrain = this->computeGreenLagrangeStrain(currentState.rightCauchyGreen);
         VLOG(2) << "  strain E=" << greenLangrangeStrain;
       }
 
@@ -1125,6 +1098,10 @@ computeInternalVirtualWork(Vec &resultVec)
 
 #ifdef QUADRATURE_TEST
 
+    // get geometry field of reference configuration, note the dimension of the vecs is always 3 also for 2D problems
+    std::array<Vec3,nDofsPerElement> geometryReferenceValues;
+    this->data_.geometryReference().getElementValues(elementNo, geometryReferenceValues);
+
     // loop over integration points (e.g. gauss points) for displacement field
     for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPointsExact.size(); samplingPointIndex++)
     {
@@ -1361,6 +1338,8 @@ initialize()
   }
 
   this->outputIntermediateSteps_ = this->specificSettings_.getOptionBool("outputIntermediateSteps", false);
+  this->cacheQuadraturePointStates_ = this->specificSettings_.getOptionBool("cacheQuadraturePointStates", true);
+  this->parseNonlinearSolveOptions();
 
   this->printBoundaryConditions();
 
@@ -1435,4 +1414,123 @@ writeOutput()
 #endif
 }
 
+template<typename FunctionSpaceType,typename FunctionSpaceTypeForUtility, typename QuadratureType, typename Term>
+void SolidMechanicsCommon<FunctionSpaceType,FunctionSpaceTypeForUtility,QuadratureType,Term>::
+initializeReferenceQuadraturePointStates()
+{
+  typedef typename FunctionSpaceType::HighOrderFunctionSpace FunctionSpace;  // for mixed formulation get the high order FunctionSpace
+
+  std::shared_ptr<FunctionSpace> functionSpace = this->data_.functionSpace();
+
+  const int D = FunctionSpace::dim();  // = 2 or 3
+  const int nDofsPerElement = FunctionSpace::nDofsPerElement();
+  const int nElements = functionSpace->nElementsLocal();
+
+  // the reference configuration does not change, the states only have to be computed once
+  if (referenceQuadraturePointStates_.size() == (size_t)nElements)
+    return;
+
+  LOG(DEBUG) << "initialize reference quadrature point states for " << nElements << " elements";
+
+  std::array<VecD<D>, QuadratureHighOrderDD::numberEvaluations()> samplingPoints = QuadratureHighOrderDD::samplingPoints();
+
+  // the gradients of the basis functions in parameter space are the same for all elements
+  for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+  {
+    gradPhi_[samplingPointIndex] = functionSpace->getGradPhi(samplingPoints[samplingPointIndex]);
+  }
+
+  referenceQuadraturePointStates_.resize(nElements);
+
+  // loop over elements
+  for (int elementNo = 0; elementNo < nElements; elementNo++)
+  {
+    // get geometry field of reference configuration, note the dimension of the vecs is always 3 also for 2D problems
+    std::array<Vec3,nDofsPerElement> geometryReferenceValues;
+    this->data_.geometryReference().getElementValues(elementNo, geometryReferenceValues);
+
+    for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+    {
+      ReferenceQuadraturePointState &state = referenceQuadraturePointStates_[elementNo][samplingPointIndex];
+
+      // compute the 3xD jacobian of the parameter space to world space mapping
+      Tensor2<D> jacobianMaterial = MathUtility::transformToDxD<D,D>(FunctionSpace::computeJacobian(geometryReferenceValues, samplingPoints[samplingPointIndex]));
+      state.inverseJacobianMaterial = MathUtility::computeInverse<D>(jacobianMaterial, state.jacobianDeterminant);
+      // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
+      // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
+
+      checkInverseIsCorrect<D>(jacobianMaterial, state.inverseJacobianMaterial, "jacobianMaterial");
+    }
+  }
+}
+
+template<typename FunctionSpaceType,typename FunctionSpaceTypeForUtility, typename QuadratureType, typename Term>
+void SolidMechanicsCommon<FunctionSpaceType,FunctionSpaceTypeForUtility,QuadratureType,Term>::
+computeCurrentQuadraturePointState(const std::array<VecD<FunctionSpaceType::dim()>,HighOrderFunctionSpace::nDofsPerElement()> &displacementValues,
+                                   const Tensor2<FunctionSpaceType::dim()> &inverseJacobianMaterial, const VecD<FunctionSpaceType::dim()> xi,
+                                   CurrentQuadraturePointState &state)
+{
+  const int D = FunctionSpaceType::dim();  // = 2 or 3
+
+  // F
+  state.deformationGradient = this->computeDeformationGradient(displacementValues, inverseJacobianMaterial, xi);
+  state.deformationGradientDeterminant = MathUtility::computeDeterminant<D>(state.deformationGradient);  // J
+
+  state.rightCauchyGreen = this->computeRightCauchyGreenTensor(state.deformationGradient);  // C = F^T*F
+
+  checkSymmetry<D>(state.rightCauchyGreen, "C");
+
+  double rightCauchyGreenDeterminant;   // J^2
+  state.inverseRightCauchyGreen = MathUtility::computeSymmetricInverse<D>(state.rightCauchyGreen, rightCauchyGreenDeterminant);  // C^-1
+
+  checkInverseIsCorrect<D>(state.rightCauchyGreen, state.inverseRightCauchyGreen, "rightCauchyGreen");
+
+  // invariants
+  std::array<double,3> invariants = this->computeInvariants(state.rightCauchyGreen, rightCauchyGreenDeterminant);  // I_1, I_2, I_3
+  state.reducedInvariants = this->computeReducedInvariants(invariants, state.deformationGradientDeterminant); // Ibar_1, Ibar_2
+
+  // pressure is the artificialPressure for penalty formulation or the separately interpolated pressure for mixed formulation
+  state.pressureTilde = 0.0;
+  state.pressure = this->getPressure(state.deformationGradientDeterminant, xi, state.pressureTilde);
+
+  // Pk2 stress tensor S = S_vol + S_iso (p.234) and the fictitious PK2 Stress Sbar
+  state.PK2Stress = this->computePK2Stress(state.pressure, state.rightCauchyGreen, state.inverseRightCauchyGreen, state.reducedInvariants,
+                                           state.deformationGradientDeterminant, state.fictitiousPK2Stress, state.pk2StressIsochoric);
+}
+
+template<typename FunctionSpaceType,typename FunctionSpaceTypeForUtility, typename QuadratureType, typename Term>
+void SolidMechanicsCommon<FunctionSpaceType,FunctionSpaceTypeForUtility,QuadratureType,Term>::
+storeQuadraturePointStatesInput(Vec solverVariable)
+{
+  if (!cacheQuadraturePointStates_)
+    return;
+
+  PetscErrorCode ierr;
+  if (quadraturePointStatesInput_ == PETSC_NULL)
+  {
+    ierr = VecDuplicate(solverVariable, &quadraturePointStatesInput_); CHKERRV(ierr);
+  }
+
+  // store a copy, because the SNES line search evaluates the function in a work vector and copies it to the solution afterwards
+  ierr = VecCopy(solverVariable, quadraturePointStatesInput_); CHKERRV(ierr);
+  quadraturePointStatesInputValid_ = true;
+}
+
+template<typename FunctionSpaceType,typename FunctionSpaceTypeForUtility, typename QuadratureType, typename Term>
+void SolidMechanicsCommon<FunctionSpaceType,FunctionSpaceTypeForUtility,QuadratureType,Term>::
+checkQuadraturePointStatesInput(Vec solverVariable)
+{
+  useCachedQuadraturePointStates_ = false;
+
+  if (!cacheQuadraturePointStates_ || !quadraturePointStatesInputValid_)
+    return;
+
+  // the stored states can be used if the jacobian is evaluated at the same point as the last nonlinear function
+  PetscBool inputIsEqual = PETSC_FALSE;
+  PetscErrorCode ierr;
+  ierr = VecEqual(solverVariable, quadraturePointStatesInput_, &inputIsEqual); CHKERRV(ierr);
+
+  useCachedQuadraturePointStates_ = (inputIsEqual == PETSC_TRUE);
+}
+
 }  // namespace
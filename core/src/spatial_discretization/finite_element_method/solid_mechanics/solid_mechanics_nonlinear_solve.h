@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <petscsnes.h>
 
 #include "spatial_discretization/finite_element_method/00_base.h"
 #include "spatial_discretization/finite_element_method/solid_mechanics/solid_mechanics_utility.h"
@@ -25,7 +26,23 @@ public:
   // use constructor of base class
   using FiniteElementMethodBase<FunctionSpaceType, QuadratureType, Term>::FiniteElementMethodBase;
 
+  //! get the coloring for the finite differences jacobian or NULL if the jacobian is computed column by column, called from a PETSc SNES callback
+  MatFDColoring finiteDifferenceColoring();
+
 protected:
+  //! options of the nonlinear solve, they are parsed once by parseNonlinearSolveOptions such that solve does not access the python config
+  struct NonlinearSolveOptions
+  {
+    bool useAnalyticJacobian = true;             ///< option "analyticJacobian"
+    bool useNumericJacobian = true;              ///< option "numericJacobian"
+    bool useFiniteDifferenceColoring = true;     ///< option "finiteDifferenceColoring"
+    bool useMatrixFreeJacobian = false;          ///< option "matrixFreeJacobian"
+    std::string logFileName;                     ///< option "logfile", empty if no log file should be written
+  };
+
+  //! parse and validate the options of the nonlinear solve from the settings, this is called from initialize
+  void parseNonlinearSolveOptions();
+
   //! solve nonlinear system
   virtual void solve() override;
 
@@ -35,6 +52,9 @@ protected:
   //! debugging method
   void debug();
 
+  //! compute a coloring of the given jacobian from its non-zero structure and create the finite difference context finiteDifferenceColoring_
+  void initializeFiniteDifferenceColoring(Mat jacobian, PetscErrorCode (*callbackNonlinearFunction)(SNES, Vec, Vec, void *));
+
   //--- methods that are used by this class but are defined further down in the class hierarchy ----
   //! set the internal displacement variable as copy of the given values
   virtual void setFromSolverVariableSolution(Vec &solverSolutionVariable) = 0;
@@ -51,6 +71,8 @@ protected:
   //! compute the nonlinear function
   virtual void evaluateNonlinearFunction(Vec &result) = 0;
 
+  MatFDColoring finiteDifferenceColoring_ = NULL;   ///< the coloring context for the finite differences jacobian, NULL if not used
+  NonlinearSolveOptions nonlinearSolveOptions_;     ///< the parsed options of the nonlinear solve
 };
 
 } // namespace
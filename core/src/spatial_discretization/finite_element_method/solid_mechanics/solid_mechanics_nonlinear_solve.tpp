@@ -40,6 +40,9 @@ PetscErrorCode nonlinearFunction(SNES snes, Vec u, Vec f, void *context)
   // compute the lhs which is the virtual work
   object->evaluateNonlinearFunction(f);
 
+  // the quadrature point states that were computed by evaluateNonlinearFunction are valid for the input u
+  object->storeQuadraturePointStatesInput(u);
+
   // set rows in f to 0 for which dirichlet BC in u is given
   object->applyDirichletBoundaryConditionsInNonlinearFunction(f, object->data());
 
@@ -76,6 +79,9 @@ PetscErrorCode jacobianFunctionAnalytic(SNES snes, Vec x, Mat jac, Mat b, void *
 
   LOG(DEBUG) << "tangentStiffnessMatrix jac: " << jac << ", b: " << b;
 
+  // reuse the quadrature point states of the last nonlinear function evaluation if it was at the same x
+  object->checkQuadraturePointStatesInput(x);
+
   // compute the tangent stiffness matrix
   object->computeAnalyticStiffnessMatrix(jac);
 
@@ -95,7 +101,16 @@ PetscErrorCode jacobianFunctionFiniteDifferences(SNES snes, Vec x, Mat jac, Mat
 {
   T* object = static_cast<T*>(context);
 
-  SNESComputeJacobianDefault(snes, x, jac, b, context);
+  // if a coloring of the sparsity pattern is available, only one residual evaluation per color is needed, otherwise one per column
+  MatFDColoring finiteDifferenceColoring = object->finiteDifferenceColoring();
+  if (finiteDifferenceColoring)
+  {
+    SNESComputeJacobianDefaultColor(snes, x, jac, b, finiteDifferenceColoring);
+  }
+  else
+  {
+    SNESComputeJacobianDefault(snes, x, jac, b, context);
+  }
 
   // zero rows and columns for which Dirichlet BC is set
   object->applyDirichletBoundaryConditionsInStiffnessMatrix(b, object->data());
@@ -107,6 +122,32 @@ PetscErrorCode jacobianFunctionFiniteDifferences(SNES snes, Vec x, Mat jac, Mat
 }
 
 
+/**
+ * Prepares the matrix-free jacobian jac and computes the analytic tangent stiffness matrix as preconditioner matrix b
+ */
+template<typename T>
+PetscErrorCode jacobianFunctionMatrixFree(SNES snes, Vec x, Mat jac, Mat b, void *context)
+{
+  T* object = static_cast<T*>(context);
+
+  // set the base point of the matrix-free jacobian to the current solution and residual of the SNES
+  MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(jac, MAT_FINAL_ASSEMBLY);
+
+  object->setFromSolverVariableSolution(x);
+
+  // reuse the quadrature point states of the last nonlinear function evaluation if it was at the same x
+  object->checkQuadraturePointStatesInput(x);
+
+  // compute the tangent stiffness matrix, stored in the preconditioner slot b
+  object->computeAnalyticStiffnessMatrix(b);
+
+  VLOG(1) << "-- computed tangent stiffness matrix as preconditioner for matrix-free jacobian: " << PetscUtility::getStringMatrix(b);
+
+  object->writeOutput();
+  return 0;
+}
+
 template<typename T>
 PetscErrorCode jacobianFunctionCombined(SNES snes, Vec x, Mat jac, Mat b, void *context)
 {
@@ -408,21 +449,48 @@ debug()
 
 }
 
-// general implementation of nonlinear solving for solid mechanics
 template<typename FunctionSpaceType, typename QuadratureType, typename Term>
 void SolidMechanicsNonlinearSolve<FunctionSpaceType,QuadratureType,Term>::
-solve()
+parseNonlinearSolveOptions()
 {
-  LOG(TRACE) << "FiniteElementMethod::solve (nonlinear)";
+  NonlinearSolveOptions &options = nonlinearSolveOptions_;
 
-  bool useAnalyticJacobian = this->specificSettings_.getOptionBool("analyticJacobian", true);
-  bool useNumericJacobian = this->specificSettings_.getOptionBool("numericJacobian", true);
+  options.useAnalyticJacobian = this->specificSettings_.getOptionBool("analyticJacobian", true);
+  options.useNumericJacobian = this->specificSettings_.getOptionBool("numericJacobian", true);
 
-  if (!useAnalyticJacobian && !useNumericJacobian)
+  options.useFiniteDifferenceColoring = this->specificSettings_.getOptionBool("finiteDifferenceColoring", true);
+  options.useMatrixFreeJacobian = this->specificSettings_.getOptionBool("matrixFreeJacobian", false);
+
+  if (!options.useAnalyticJacobian && !options.useNumericJacobian)
   {
     LOG(WARNING) << "Can not set both \"analyticJacobian\" and \"numericJacobian\" to False, using numeric jacobian.";
-    useNumericJacobian = true;
+    options.useNumericJacobian = true;
+  }
+
+  if (options.useMatrixFreeJacobian && !options.useAnalyticJacobian)
+  {
+    LOG(WARNING) << "\"matrixFreeJacobian\" needs the analytic jacobian as preconditioner, but \"analyticJacobian\" is False. Not using matrix-free jacobian.";
+    options.useMatrixFreeJacobian = false;
+  }
+
+  options.logFileName = "";
+  if (this->specificSettings_.hasKey("logfile"))
+  {
+    options.logFileName = this->specificSettings_.getOptionString("logfile", "residual_norm.txt");
   }
+}
+
+// general implementation of nonlinear solving for solid mechanics
+template<typename FunctionSpaceType, typename QuadratureType, typename Term>
+void SolidMechanicsNonlinearSolve<FunctionSpaceType,QuadratureType,Term>::
+solve()
+{
+  LOG(TRACE) << "FiniteElementMethod::solve (nonlinear)";
+
+  const bool useAnalyticJacobian = nonlinearSolveOptions_.useAnalyticJacobian;
+  const bool useNumericJacobian = nonlinearSolveOptions_.useNumericJacobian;
+  const bool useFiniteDifferenceColoring = nonlinearSolveOptions_.useFiniteDifferenceColoring;
+  const bool useMatrixFreeJacobian = nonlinearSolveOptions_.useMatrixFreeJacobian;
 
   PetscErrorCode ierr;
 
@@ -480,13 +548,21 @@ solve()
   PetscErrorCode (*callbackJacobianAnalytic)(SNES, Vec, Mat, Mat, void *) = *jacobianFunctionAnalytic<ThisClass>;
   PetscErrorCode (*callbackJacobianFiniteDifferences)(SNES, Vec, Mat, Mat, void *) = *jacobianFunctionFiniteDifferences<ThisClass>;
   PetscErrorCode (*callbackJacobianCombined)(SNES, Vec, Mat, Mat, void *) = *jacobianFunctionCombined<ThisClass>;
+  PetscErrorCode (*callbackJacobianMatrixFree)(SNES, Vec, Mat, Mat, void *) = *jacobianFunctionMatrixFree<ThisClass>;
   PetscErrorCode (*callbackMonitorFunction)(SNES, PetscInt, PetscReal, void *) = *monitorFunction<ThisClass>;
 
   // set function
   ierr = SNESSetFunction(*snes, solverVariableResidual, callbackNonlinearFunction, this); CHKERRV(ierr);
 
   // set jacobian
-  if (useAnalyticJacobian)
+  Mat matrixFreeJacobian = NULL;
+  if (useMatrixFreeJacobian)   // use matrix-free jacobian-vector products by finite differences, preconditioned by the analytic jacobian
+  {
+    ierr = MatCreateSNESMF(*snes, &matrixFreeJacobian); CHKERRV(ierr);
+    ierr = SNESSetJacobian(*snes, matrixFreeJacobian, solverMatrixTangentStiffness, callbackJacobianMatrixFree, this); CHKERRV(ierr);
+    LOG(DEBUG) << "Use matrix-free jacobian with analytic jacobian as preconditioner: " << solverMatrixTangentStiffness;
+  }
+  else if (useAnalyticJacobian)
   {
     if (useNumericJacobian)   // use combination of analytic jacobian also with finite differences
     {
@@ -503,6 +579,12 @@ solve()
   }
   else
   {
+    // color the sparsity pattern of the tangent stiffness matrix, which is given by the element connectivity
+    if (useFiniteDifferenceColoring)
+    {
+      initializeFiniteDifferenceColoring(solverMatrixTangentStiffness, callbackNonlinearFunction);
+    }
+
     // set function to compute jacobian from finite differences
     ierr = SNESSetJacobian(*snes, solverMatrixTangentStiffness, solverMatrixTangentStiffness, callbackJacobianFiniteDifferences, this); CHKERRV(ierr);
     LOG(DEBUG) << "Use Finite-Differences approximation for jacobian";
@@ -510,9 +592,9 @@ solve()
 
   // prepare log file
   std::shared_ptr<std::ofstream> logFile = nullptr;
-  if (this->specificSettings_.hasKey("logfile"))
+  if (!nonlinearSolveOptions_.logFileName.empty())
   {
-    std::string logFileName = this->specificSettings_.getOptionString("logfile", "residual_norm.txt");
+    const std::string &logFileName = nonlinearSolveOptions_.logFileName;
 
     logFile = std::make_shared<std::ofstream>(logFileName, std::ios::out | std::ios::binary | std::ios::trunc);
 
@@ -556,6 +638,53 @@ solve()
   setFromSolverVariableSolution(solverVariableSolution);
 
   updateGeometryActual();
+
+  // free the jacobian approximations
+  if (finiteDifferenceColoring_)
+  {
+    ierr = MatFDColoringDestroy(&finiteDifferenceColoring_); CHKERRV(ierr);
+    finiteDifferenceColoring_ = NULL;
+  }
+  if (matrixFreeJacobian)
+  {
+    ierr = MatDestroy(&matrixFreeJacobian); CHKERRV(ierr);
+  }
+}
+
+template<typename FunctionSpaceType, typename QuadratureType, typename Term>
+void SolidMechanicsNonlinearSolve<FunctionSpaceType,QuadratureType,Term>::
+initializeFiniteDifferenceColoring(Mat jacobian, PetscErrorCode (*callbackNonlinearFunction)(SNES, Vec, Vec, void *))
+{
+  PetscErrorCode ierr;
+
+  // compute a coloring of the columns of the jacobian, columns of the same color have no common non-zero rows
+  // the non-zero structure of the jacobian has been set by the first analytic computation of the tangent stiffness matrix
+  MatColoring matrixColoring;
+  ISColoring columnColoring;
+  ierr = MatColoringCreate(jacobian, &matrixColoring); CHKERRV(ierr);
+  ierr = MatColoringSetType(matrixColoring, MATCOLORINGSL); CHKERRV(ierr);
+  ierr = MatColoringSetFromOptions(matrixColoring); CHKERRV(ierr);
+  ierr = MatColoringApply(matrixColoring, &columnColoring); CHKERRV(ierr);
+  ierr = MatColoringDestroy(&matrixColoring); CHKERRV(ierr);
+
+  // create the finite difference context, it calls the nonlinear function once per color
+  ierr = MatFDColoringCreate(jacobian, columnColoring, &finiteDifferenceColoring_); CHKERRV(ierr);
+  ierr = MatFDColoringSetFunction(finiteDifferenceColoring_, (PetscErrorCode (*)(void))callbackNonlinearFunction, this); CHKERRV(ierr);
+  ierr = MatFDColoringSetFromOptions(finiteDifferenceColoring_); CHKERRV(ierr);
+  ierr = MatFDColoringSetUp(jacobian, columnColoring, finiteDifferenceColoring_); CHKERRV(ierr);
+
+  PetscInt nColors;
+  ierr = ISColoringGetColors(columnColoring, NULL, &nColors, NULL); CHKERRV(ierr);
+  ierr = ISColoringDestroy(&columnColoring); CHKERRV(ierr);
+
+  LOG(DEBUG) << "Use colored finite differences for jacobian with " << nColors << " colors";
+}
+
+template<typename FunctionSpaceType, typename QuadratureType, typename Term>
+MatFDColoring SolidMechanicsNonlinearSolve<FunctionSpaceType,QuadratureType,Term>::
+finiteDifferenceColoring()
+{
+  return finiteDifferenceColoring_;
 }
 
 // general implementation of nonlinear solving for solid mechanics
@@ -579,6 +708,9 @@ updateGeometryActual()
     // w = alpha*x+y
     VecWAXPY(this->data_.geometryActual().valuesLocal(), 1.0, this->data_.geometryReference().valuesLocal(), this->data_.displacements().valuesLocal());
   }
+
+  // the elements have moved, the search grid of findPosition has to be rebuilt
+  this->data_.functionSpace()->invalidateElementSearchGrid();
 }
 
 }  // namespace
@@ -31,3 +31,4 @@ private:
 }  // namespace
 
 #include "time_stepping_scheme/explicit_euler.tpp"
+#include "control/batched_advance/batched_advance_explicit_euler_cellml.h"
@@ -35,3 +35,4 @@ private:
 }  // namespace
 
 #include "time_stepping_scheme/heun.tpp"
+#include "control/batched_advance/batched_advance_heun_cellml.h"
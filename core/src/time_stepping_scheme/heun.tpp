@@ -55,7 +55,8 @@ void Heun<DiscretizableInTime>::advanceTimeSpan()
       solution, increment, timeStepNo, currentTime);
 
     // integrate u* += dt * delta_u : values = solution.values + timeStepWidth * increment.values
-    VecAXPY(solution, this->timeStepWidth_, increment);
+    PetscErrorCode ierr;
+    ierr = VecAXPY(solution, this->timeStepWidth_, increment); CHKERRV(ierr);
 
     VLOG(1) << "increment: " << this->data_->increment() << ", dt: " << this->timeStepWidth_;
 
@@ -66,13 +67,8 @@ void Heun<DiscretizableInTime>::advanceTimeSpan()
       solution, intermediateIncrement, timeStepNo + 1, currentTime + this->timeStepWidth_);
 
     // integrate u_{t+1} = u_{t} + dt*0.5(delta_u + delta_u_star)
-    // however, use: u_{t+1} = u* + 0.5*dt*(f(u*)-f(u_{t}))     (#)
-    //
-    // first calculate (f(u*)-f(u_{t})). to save storage we store into f(u*):
-    VecAXPY(intermediateIncrement, -1.0, increment);
-
-    // now compute overall step as described above (#)
-    VecAXPY(solution, 0.5*this->timeStepWidth_, intermediateIncrement);
+    // however, use: u_{t+1} = u* + 0.5*dt*(f(u*)-f(u_{t})), in a single pass over the vectors
+    ierr = VecAXPBYPCZ(solution, 0.5*this->timeStepWidth_, -0.5*this->timeStepWidth_, 1.0, intermediateIncrement, increment); CHKERRV(ierr);
 
     // apply the prescribed boundary condition values
     this->applyBoundaryConditions();
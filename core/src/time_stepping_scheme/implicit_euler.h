@@ -34,3 +34,4 @@ protected:
 }  // namespace
 
 #include "time_stepping_scheme/implicit_euler.tpp"
+#include "control/batched_advance/batched_advance_implicit_euler.h"
@@ -55,6 +55,9 @@ protected:
   //! initialize the relative factors fr_k
   void initializeCompartmentRelativeFactors();
 
+  //! set up a PCFIELDSPLIT block preconditioner for the nested system matrix, if "blockPreconditionerType" is not "none"
+  void initializeBlockPreconditioner();
+
   Data dataMultidomain_;  ///< the data object of the multidomain solver which stores all field variables and matrices
 
   FiniteElementMethodPotentialFlow finiteElementMethodPotentialFlow_;   ///< the finite element object that is used for the Laplace problem of the potential flow, needed for the fiber directions
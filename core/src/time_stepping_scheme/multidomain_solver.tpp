@@ -200,6 +200,9 @@ initialize()
   PetscErrorCode ierr;
   ierr = KSPSetOperators(*this->linearSolver_->ksp(), systemMatrix_, systemMatrix_); CHKERRV(ierr);
 
+  // set up the field split preconditioner that uses the block structure of the system matrix
+  initializeBlockPreconditioner();
+
   // initialize rhs and solution vector
   subvectorsRightHandSide_.resize(nCompartments_+1);
   subvectorsSolution_.resize(nCompartments_+1);
@@ -426,6 +429,62 @@ setSystemMatrix(double timeStepWidth)
                        nCompartments_+1, NULL, nCompartments_+1, NULL, submatrices.data(), &this->systemMatrix_); CHKERRV(ierr);
 }
 
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void MultidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+initializeBlockPreconditioner()
+{
+  // parse the type of block preconditioner, "none" keeps the preconditioner of the linear solver
+  std::string blockPreconditionerType = this->specificSettings_.getOptionString("blockPreconditionerType", "none");
+
+  if (blockPreconditionerType == "none")
+    return;
+
+  // parse the preconditioners for the sub blocks
+  std::string compartmentPreconditionerType = this->specificSettings_.getOptionString("compartmentPreconditionerType", "jacobi");
+  std::string extracellularPreconditionerType = this->specificSettings_.getOptionString("extracellularPreconditionerType", "gamg");
+  std::string schurFactorizationType = this->specificSettings_.getOptionString("schurFactorizationType", "lower");
+
+  LOG(DEBUG) << "initialize block preconditioner \"" << blockPreconditionerType << "\", compartments: \"" << compartmentPreconditionerType
+    << "\", extracellular: \"" << extracellularPreconditionerType << "\"";
+
+  PetscErrorCode ierr;
+
+  // get the index sets of the rows of the blocks in the nested system matrix, the last one is for phi_e
+  std::vector<IS> indexSets(nCompartments_+1);
+  ierr = MatNestGetISs(systemMatrix_, indexSets.data(), NULL); CHKERRV(ierr);
+
+  if (blockPreconditionerType == "schur")
+  {
+    // the Schur complement preconditioner needs exactly two splits: all compartments (Vm_k) and the extracellular potential (phi_e)
+    MPI_Comm mpiCommunicator = this->dataMultidomain_.functionSpace()->meshPartition()->mpiCommunicator();
+    IS indexSetCompartments;
+    ierr = ISConcatenate(mpiCommunicator, nCompartments_, indexSets.data(), &indexSetCompartments); CHKERRV(ierr);
+
+    this->linearSolver_->initializeBlockPreconditioner(blockPreconditionerType, schurFactorizationType,
+                                                       std::vector<std::string>{"compartments", "extracellular"},
+                                                       std::vector<IS>{indexSetCompartments, indexSets[nCompartments_]},
+                                                       std::vector<std::string>{compartmentPreconditionerType, extracellularPreconditionerType});
+    ierr = ISDestroy(&indexSetCompartments); CHKERRV(ierr);
+  }
+  else
+  {
+    // one split for every block row of the system matrix
+    std::vector<std::string> splitNames;
+    std::vector<std::string> splitPreconditionerTypes;
+    for (int k = 0; k < nCompartments_; k++)
+    {
+      std::stringstream splitName;
+      splitName << "compartment" << k;
+      splitNames.push_back(splitName.str());
+      splitPreconditionerTypes.push_back(compartmentPreconditionerType);
+    }
+    splitNames.push_back("extracellular");
+    splitPreconditionerTypes.push_back(extracellularPreconditionerType);
+
+    this->linearSolver_->initializeBlockPreconditioner(blockPreconditionerType, schurFactorizationType, splitNames, indexSets, splitPreconditionerTypes);
+  }
+}
+
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
 void MultidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
 solveLinearSystem()
@@ -438,21 +497,10 @@ solveLinearSystem()
   // configure that the initial value for the iterative solver is the value in solution, not zero
   ierr = KSPSetInitialGuessNonzero(*this->linearSolver_->ksp(), PETSC_TRUE); CHKERRV(ierr);
 
-  // solve the system, KSPSolve(ksp,b,x)
-  ierr = KSPSolve(*this->linearSolver_->ksp(), rightHandSide_, solution_); CHKERRV(ierr);
-
-  int numberOfIterations = 0;
-  PetscReal residualNorm = 0.0;
-  ierr = KSPGetIterationNumber(*this->linearSolver_->ksp(), &numberOfIterations); CHKERRV(ierr);
-  ierr = KSPGetResidualNorm(*this->linearSolver_->ksp(), &residualNorm); CHKERRV(ierr);
-
-  KSPConvergedReason convergedReason;
-  ierr = KSPGetConvergedReason(*this->linearSolver_->ksp(), &convergedReason); CHKERRV(ierr);
-
-  lastNumberOfIterations_ = numberOfIterations;
+  // solve the system, this also sets the initial guess if specified by the option "initialGuess" of the solver
+  this->linearSolver_->solve(rightHandSide_, solution_, "Linear system of multidomain problem");
 
-  LOG(DEBUG) << "Linear system of multidomain problem solved in " << numberOfIterations << " iterations, residual norm " << residualNorm
-    << ": " << PetscUtility::getStringLinearConvergedReason(convergedReason);
+  lastNumberOfIterations_ = this->linearSolver_->lastNumberOfIterations();
 }
 
 //! return whether the underlying discretizableInTime object has a specified mesh type and is not independent of the mesh type
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "time_stepping_scheme/time_stepping_explicit.h"
+#include "interfaces/runnable.h"
+#include "data_management/time_stepping/time_stepping.h"
+#include "control/dihu_context.h"
+
+namespace TimeSteppingScheme
+{
+
+/** The classical Runge-Kutta scheme of 4th order, u_{t+1} = u_{t} + dt/6*(k1 + 2*k2 + 2*k3 + k4) with
+ *  k1 = f(u_{t}), k2 = f(u_{t} + dt/2*k1), k3 = f(u_{t} + dt/2*k2) and k4 = f(u_{t} + dt*k3).
+ *
+ *  The stages are computed in the solution vector, the rates in the increment vector. After every evaluation of the right hand side,
+ *  a single pass over the vectors accumulates the rate and computes the input of the next stage from the values at the beginning of the time step.
+ */
+template<typename DiscretizableInTime>
+class RungeKutta4 :
+  public TimeSteppingExplicit<DiscretizableInTime>, public Runnable
+{
+public:
+
+  //! constructor
+  RungeKutta4(DihuContext context);
+
+  //! advance simulation by the given time span [startTime_, endTime_] with given numberTimeSteps, data in solution is used, afterwards new data is in solution
+  void advanceTimeSpan();
+
+  //! run the simulation
+  void run();
+
+private:
+
+  std::vector<double> initialSolution_;       ///< the solution at the beginning of the time step
+  std::vector<double> incrementSum_;          ///< the weighted sum of the rates of the stages, k1 + 2*k2 + 2*k3 + k4
+};
+
+}  // namespace
+
+#include "time_stepping_scheme/runge_kutta_4.tpp"
+#include "control/batched_advance/batched_advance_runge_kutta_4_cellml.h"
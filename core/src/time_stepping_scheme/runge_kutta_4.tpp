@@ -0,0 +1,132 @@
+#include "time_stepping_scheme/runge_kutta_4.h"
+
+#include <Python.h>  // has to be the first included header
+
+#include "utility/python_utility.h"
+#include "utility/petsc_utility.h"
+
+namespace TimeSteppingScheme
+{
+
+template<typename DiscretizableInTime>
+RungeKutta4<DiscretizableInTime>::RungeKutta4(DihuContext context) :
+  TimeSteppingExplicit<DiscretizableInTime>(context, "RungeKutta4")
+{
+  this->data_ = std::make_shared<Data::TimeStepping<typename DiscretizableInTime::FunctionSpace, DiscretizableInTime::nComponents()>>(context); // create data object for Runge-Kutta
+}
+
+template<typename DiscretizableInTime>
+void RungeKutta4<DiscretizableInTime>::advanceTimeSpan()
+{
+  // start duration measurement, the name of the output variable can be set by "durationLogKey" in the config
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKey_);
+
+  // compute timestep width
+  double timeSpan = this->endTime_ - this->startTime_;
+
+  LOG(DEBUG) << "RungeKutta4::advanceTimeSpan, timeSpan=" << timeSpan<< ", timeStepWidth=" << this->timeStepWidth_
+    << " n steps: " << this->numberTimeSteps_;
+
+  // get vectors of all components in struct-of-array order, as needed by CellML (i.e. one long vector with [state0 state0 state0 ... state1 state1...]
+  Vec &solution = this->data_->solution()->getValuesContiguous();
+  Vec &increment = this->data_->increment()->getValuesContiguous();
+
+  PetscErrorCode ierr;
+  int nValues;
+  ierr = VecGetLocalSize(solution, &nValues); CHKERRV(ierr);
+  initialSolution_.resize(nValues);
+  incrementSum_.resize(nValues);
+
+  const double timeStepWidth = this->timeStepWidth_;
+
+  // loop over time steps
+  double currentTime = this->startTime_;
+  for (int timeStepNo = 0; timeStepNo < this->numberTimeSteps_;)
+  {
+    if (timeStepNo % this->timeStepOutputInterval_ == 0 && timeStepNo > 0)
+    {
+      LOG(INFO) << "Runge-Kutta 4, timestep " << timeStepNo << "/" << this->numberTimeSteps_<< ", t=" << currentTime;
+    }
+
+    VLOG(1) << "starting from solution: " << this->data_->solution();
+
+    // the four stages, the rate k of stage stageNo is evaluated at the time currentTime + stageTime*dt
+    for (int stageNo = 0; stageNo < 4; stageNo++)
+    {
+      const double stageTime = (stageNo == 0? 0.0 : (stageNo == 3? 1.0 : 0.5));
+      this->discretizableInTime_.evaluateTimesteppingRightHandSideExplicit(
+        solution, increment, (stageNo == 3? timeStepNo + 1 : timeStepNo), currentTime + stageTime*timeStepWidth);
+
+      double *solutionData;
+      const double *incrementData;
+      ierr = VecGetArray(solution, &solutionData); CHKERRV(ierr);
+      ierr = VecGetArrayRead(increment, &incrementData); CHKERRV(ierr);
+
+      if (stageNo == 0)
+      {
+        // store u_{t}, sum = k1 and compute u_{t} + dt/2*k1
+        for (int i = 0; i < nValues; i++)
+        {
+          initialSolution_[i] = solutionData[i];
+          incrementSum_[i] = incrementData[i];
+          solutionData[i] = initialSolution_[i] + 0.5*timeStepWidth * incrementData[i];
+        }
+      }
+      else if (stageNo < 3)
+      {
+        // sum += 2*k2 and compute u_{t} + dt/2*k2, or sum += 2*k3 and compute u_{t} + dt*k3
+        const double stageTimeStepWidth = (stageNo == 1? 0.5*timeStepWidth : timeStepWidth);
+        for (int i = 0; i < nValues; i++)
+        {
+          incrementSum_[i] += 2.0*incrementData[i];
+          solutionData[i] = initialSolution_[i] + stageTimeStepWidth * incrementData[i];
+        }
+      }
+      else
+      {
+        // u_{t+1} = u_{t} + dt/6*(k1 + 2*k2 + 2*k3 + k4)
+        for (int i = 0; i < nValues; i++)
+        {
+          solutionData[i] = initialSolution_[i] + timeStepWidth/6.0 * (incrementSum_[i] + incrementData[i]);
+        }
+      }
+
+      ierr = VecRestoreArrayRead(increment, &incrementData); CHKERRV(ierr);
+      ierr = VecRestoreArray(solution, &solutionData); CHKERRV(ierr);
+    }
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = this->startTime_ + double(timeStepNo) / this->numberTimeSteps_ * timeSpan;
+
+    VLOG(1) << "solution after integration: " << this->data_->solution();
+
+    // apply the prescribed boundary condition values
+    this->applyBoundaryConditions();
+
+    // stop duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+
+    // write current output values
+    this->outputWriterManager_.writeOutput(*this->data_, timeStepNo, currentTime);
+
+    // start duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(this->durationLogKey_);
+  }
+
+  this->data_->solution()->restoreValuesContiguous();
+
+  // stop duration measurement
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+}
+
+template<typename DiscretizableInTime>
+void RungeKutta4<DiscretizableInTime>::run()
+{
+  TimeSteppingSchemeOde<DiscretizableInTime>::run();
+}
+} // namespace TimeSteppingScheme
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "time_stepping_scheme/time_stepping_explicit.h"
+#include "interfaces/runnable.h"
+#include "data_management/time_stepping/time_stepping.h"
+#include "control/dihu_context.h"
+
+namespace TimeSteppingScheme
+{
+
+/** The Rush-Larsen integration scheme for CellML models. The gating variables, i.e. states y with a rate of the form dy/dt = a - b*y = (y_inf - y)/tau,
+ *  where a and b do not depend on y, are integrated exponentially, y_{t+1} = y_inf + (y_t - y_inf)*exp(-dt/tau), with a and b evaluated at time t.
+ *  This is stable for any time step width, such that the time step width is no longer limited by the fast gating variables.
+ *  All other states are integrated by the explicit Euler scheme.
+ *
+ *  The gating variables are detected when the CellML source is parsed (RhsRoutineHandler::createSimdSourceFile).
+ *  If there are none, e.g. because the rhs is given by a library, the scheme is the same as the explicit Euler scheme.
+ *  DiscretizableInTime has to be a CellmlAdapter.
+ */
+template<typename DiscretizableInTime>
+class RushLarsen :
+  public TimeSteppingExplicit<DiscretizableInTime>, public Runnable
+{
+public:
+
+  //! constructor
+  RushLarsen(DihuContext context);
+
+  //! initialize discretizableInTime and determine the gating variables
+  void initialize() override;
+
+  //! advance simulation by the given time span [startTime_, endTime_] with given numberTimeSteps, data in solution is used, afterwards new data is in solution
+  void advanceTimeSpan();
+
+  //! run the simulation
+  void run();
+
+private:
+
+  std::vector<bool> isGatingState_;           ///< for every state if it is a gating variable that is integrated exponentially
+  std::vector<double> gatingCoefficients_;    ///< the coefficients b of the rates a - b*y of the gating variables, in the same layout as the rates
+};
+
+}  // namespace
+
+#include "time_stepping_scheme/rush_larsen.tpp"
+#include "control/batched_advance/batched_advance_rush_larsen_cellml.h"
@@ -0,0 +1,157 @@
+#include "time_stepping_scheme/rush_larsen.h"
+
+#include <Python.h>  // has to be the first included header
+#include <cmath>
+
+#include "utility/python_utility.h"
+#include "utility/petsc_utility.h"
+
+namespace TimeSteppingScheme
+{
+
+template<typename DiscretizableInTime>
+RushLarsen<DiscretizableInTime>::RushLarsen(DihuContext context) :
+  TimeSteppingExplicit<DiscretizableInTime>(context, "RushLarsen")
+{
+  this->data_ = std::make_shared<Data::TimeStepping<typename DiscretizableInTime::FunctionSpace, DiscretizableInTime::nComponents()>>(context); // create data object for Rush-Larsen
+}
+
+template<typename DiscretizableInTime>
+void RushLarsen<DiscretizableInTime>::initialize()
+{
+  if (this->initialized_)
+    return;
+
+  TimeSteppingExplicit<DiscretizableInTime>::initialize();
+
+  const int nStates = DiscretizableInTime::nComponents();
+  isGatingState_.assign(nStates, false);
+
+  if (this->discretizableInTime_.hasGatingCoefficients())
+  {
+    for (int stateNo : this->discretizableInTime_.gatingStateNos())
+    {
+      isGatingState_[stateNo] = true;
+    }
+    LOG(DEBUG) << "RushLarsen: " << this->discretizableInTime_.gatingStateNos().size() << " of " << nStates << " states are integrated exponentially: "
+      << this->discretizableInTime_.gatingStateNos();
+  }
+  else
+  {
+    LOG(WARNING) << "RushLarsen: The CellML model has no gating variables or the rhs was not compiled by opendihu, all states are integrated by the explicit Euler scheme.";
+  }
+}
+
+template<typename DiscretizableInTime>
+void RushLarsen<DiscretizableInTime>::advanceTimeSpan()
+{
+  // start duration measurement, the name of the output variable can be set by "durationLogKey" in the config
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKey_);
+
+  // compute timestep width
+  double timeSpan = this->endTime_ - this->startTime_;
+
+  LOG(DEBUG) << "RushLarsen::advanceTimeSpan, timeSpan=" << timeSpan<< ", timeStepWidth=" << this->timeStepWidth_
+    << " n steps: " << this->numberTimeSteps_;
+
+  // get vectors of all components in struct-of-array order, as needed by CellML (i.e. one long vector with [state0 state0 state0 ... state1 state1...]
+  Vec &solution = this->data_->solution()->getValuesContiguous();
+  Vec &increment = this->data_->increment()->getValuesContiguous();
+
+  PetscErrorCode ierr;
+  int nValues;
+  ierr = VecGetLocalSize(solution, &nValues); CHKERRV(ierr);
+  gatingCoefficients_.resize(nValues);
+
+  const int nStates = DiscretizableInTime::nComponents();
+  const int nInstances = nValues / nStates;
+  const double timeStepWidth = this->timeStepWidth_;
+
+  // loop over time steps
+  double currentTime = this->startTime_;
+  for (int timeStepNo = 0; timeStepNo < this->numberTimeSteps_;)
+  {
+    if (timeStepNo % this->timeStepOutputInterval_ == 0 && timeStepNo > 0)
+    {
+      LOG(INFO) << "Rush-Larsen, timestep " << timeStepNo << "/" << this->numberTimeSteps_<< ", t=" << currentTime;
+    }
+
+    VLOG(1) << "starting from solution: " << this->data_->solution();
+
+    // compute delta_u = f(u) and the coefficients b of the gating variables, where f(u) = a - b*u
+    this->discretizableInTime_.evaluateTimesteppingRightHandSideAndGatingCoefficients(
+      solution, increment, gatingCoefficients_.data(), timeStepNo, currentTime);
+
+    VLOG(1) << "increment: " << this->data_->increment() << ", dt: " << this->timeStepWidth_;
+
+    double *solutionData;
+    const double *incrementData;
+    ierr = VecGetArray(solution, &solutionData); CHKERRV(ierr);
+    ierr = VecGetArrayRead(increment, &incrementData); CHKERRV(ierr);
+
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
+    {
+      double *y = solutionData + stateNo*nInstances;
+      const double *f = incrementData + stateNo*nInstances;
+
+      if (isGatingState_[stateNo])
+      {
+        // integrate exponentially, y += (y_inf - y)*(1 - exp(-b*dt)), with y_inf - y = f/b
+        const double *b = gatingCoefficients_.data() + stateNo*nInstances;
+        for (int i = 0; i < nInstances; i++)
+        {
+          const double bdt = b[i]*timeStepWidth;
+          if (std::abs(bdt) > 1e-12)
+            y[i] -= f[i] * std::expm1(-bdt) / b[i];
+          else
+            y[i] += timeStepWidth * f[i];
+        }
+      }
+      else
+      {
+        // integrate, y += dt * delta_u
+        for (int i = 0; i < nInstances; i++)
+        {
+          y[i] += timeStepWidth * f[i];
+        }
+      }
+    }
+
+    ierr = VecRestoreArrayRead(increment, &incrementData); CHKERRV(ierr);
+    ierr = VecRestoreArray(solution, &solutionData); CHKERRV(ierr);
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = this->startTime_ + double(timeStepNo) / this->numberTimeSteps_ * timeSpan;
+
+    VLOG(1) << "solution after integration: " << this->data_->solution();
+
+    // apply the prescribed boundary condition values
+    this->applyBoundaryConditions();
+
+    // stop duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(this->durationLogKey_);
+
+    // write current output values
+    this->outputWriterManager_.writeOutput(*this->data_, timeStepNo, currentTime);
+
+    // start duration measurement
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(this->durationLogKey_);
+  }
+
+  this->data_->solution()->restoreValuesContiguous();
+
+  // stop duration measurement
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+}
+
+template<typename DiscretizableInTime>
+void RushLarsen<DiscretizableInTime>::run()
+{
+  TimeSteppingSchemeOde<DiscretizableInTime>::run();
+}
+} // namespace TimeSteppingScheme
@@ -5,6 +5,7 @@
 #include "interfaces/runnable.h"
 #include "data_management/time_stepping/time_stepping_implicit.h"
 #include "control/dihu_context.h"
+#include "solver/tridiagonal_system.h"
 
 namespace TimeSteppingScheme
 {
@@ -27,6 +28,12 @@ public:
   
   //! set the system matrix
   virtual void initialize();
+
+  //! the data object of the implicit time stepping scheme
+  Data::TimeSteppingImplicit<typename DiscretizableInTimeType::FunctionSpace, DiscretizableInTimeType::nComponents()> &dataImplicit();
+
+  //! the direct solver for the system matrix if "solverType" is "tridiagonal" and the system matrix is tridiagonal, nullptr otherwise
+  std::shared_ptr<Solver::TridiagonalSystem> tridiagonalSystem();
    
 protected:
   
@@ -35,6 +42,9 @@ protected:
    
   //! initialize the linear solve that is needed for the solution of the implicit timestepping system
   void initializeLinearSolver();
+
+  //! factorize the system matrix with the direct tridiagonal solver if it was requested by "solverType", otherwise or if the matrix is not tridiagonal do nothing
+  void initializeTridiagonalSystem();
   
   //! solves the linear system of equations resulting from the Implicit Euler method time discretization
   void solveLinearSystem(Vec &input, Vec &output);
@@ -42,6 +52,7 @@ protected:
   std::shared_ptr<Data::TimeSteppingImplicit<typename DiscretizableInTimeType::FunctionSpace, DiscretizableInTimeType::nComponents()>> dataImplicit_;  ///< a pointer to the data_ object but of type Data::TimeSteppingImplicit
   std::shared_ptr<Solver::Linear> linearSolver_;   ///< the linear solver used for solving the system
   std::shared_ptr<KSP> ksp_;     ///< the ksp object of the linear solver
+  std::shared_ptr<Solver::TridiagonalSystem> tridiagonalSystem_;   ///< the direct solver that is used instead of the linear solver for tridiagonal system matrices, e.g. on 1D meshes with linear basis functions
 
 };
 
@@ -44,10 +44,45 @@ initialize()
   assert(this->ksp_);
   PetscErrorCode ierr;
   ierr = KSPSetOperators(*ksp_, systemMatrix, systemMatrix); CHKERRV(ierr);
+
+  // factorize the system matrix if the tridiagonal solver is used
+  initializeTridiagonalSystem();
   
   this->initialized_ = true;
 }
 
+template<typename DiscretizableInTimeType>
+void TimeSteppingImplicit<DiscretizableInTimeType>::
+initializeTridiagonalSystem()
+{
+  tridiagonalSystem_ = nullptr;
+  if (linearSolver_->solverType() != "tridiagonal")
+    return;
+
+  Mat &systemMatrix = this->dataImplicit_->systemMatrix()->valuesGlobal();
+  tridiagonalSystem_ = std::make_shared<Solver::TridiagonalSystem>();
+  if (!tridiagonalSystem_->initialize(systemMatrix, this->data_->functionSpace()->meshPartition()->mpiCommunicator()))
+  {
+    LOG(WARNING) << "The solver type \"tridiagonal\" was specified for the implicit time stepping scheme, but the system matrix is not tridiagonal "
+      << "or cannot be factorized without pivoting. The system is solved by gmres instead.";
+    tridiagonalSystem_ = nullptr;
+  }
+}
+
+template<typename DiscretizableInTimeType>
+Data::TimeSteppingImplicit<typename DiscretizableInTimeType::FunctionSpace, DiscretizableInTimeType::nComponents()> &TimeSteppingImplicit<DiscretizableInTimeType>::
+dataImplicit()
+{
+  return *dataImplicit_;
+}
+
+template<typename DiscretizableInTimeType>
+std::shared_ptr<Solver::TridiagonalSystem> TimeSteppingImplicit<DiscretizableInTimeType>::
+tridiagonalSystem()
+{
+  return tridiagonalSystem_;
+}
+
 template<typename DiscretizableInTimeType>
 void TimeSteppingImplicit<DiscretizableInTimeType>::
 solveLinearSystem(Vec &input, Vec &output)
@@ -55,22 +90,17 @@ solveLinearSystem(Vec &input, Vec &output)
   // solve systemMatrix*output = input for output
   Mat &systemMatrix = this->dataImplicit_->systemMatrix()->valuesGlobal();
   
-  PetscErrorCode ierr;
   PetscUtility::checkDimensionsMatrixVector(systemMatrix, input);
+
+  // the tridiagonal system matrix was factorized in initialize, then the solve is only a forward and backward substitution
+  if (tridiagonalSystem_)
+  {
+    tridiagonalSystem_->solve(input, output);
+    return;
+  }
   
-  // solve the system, KSPSolve(ksp,b,x)
-  ierr = KSPSolve(*ksp_, input, output); CHKERRV(ierr);
-  
-  int numberOfIterations = 0;
-  PetscReal residualNorm = 0.0;
-  ierr = KSPGetIterationNumber(*ksp_, &numberOfIterations); CHKERRV(ierr);
-  ierr = KSPGetResidualNorm(*ksp_, &residualNorm); CHKERRV(ierr);
-  
-  KSPConvergedReason convergedReason;
-  ierr = KSPGetConvergedReason(*ksp_, &convergedReason); CHKERRV(ierr);
-  
-  VLOG(1) << "Linear system of implicit time stepping solved in " << numberOfIterations << " iterations, residual norm " << residualNorm
-    << ": " << PetscUtility::getStringLinearConvergedReason(convergedReason);
+  // solve the system, this also sets the initial guess and records the number of iterations
+  linearSolver_->solve(input, output, "Linear system of implicit time stepping");
 }
 
 template<typename DiscretizableInTimeType>
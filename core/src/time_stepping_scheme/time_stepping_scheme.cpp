@@ -137,4 +137,14 @@ PythonConfig TimeSteppingScheme::specificSettings()
   return specificSettings_;
 }
 
+std::string TimeSteppingScheme::durationLogKey()
+{
+  return durationLogKey_;
+}
+
+OutputWriter::Manager &TimeSteppingScheme::outputWriterManager()
+{
+  return outputWriterManager_;
+}
+
 } // namespace
@@ -57,6 +57,12 @@ public:
   //! python object containing the value of the python config dict with corresponding key
   PythonConfig specificSettings();
 
+  //! the key under which the duration of the time stepping is saved in the log, empty if no duration is measured
+  std::string durationLogKey();
+
+  //! the manager object that holds the output writers
+  OutputWriter::Manager &outputWriterManager();
+
   //! destructor
   virtual ~TimeSteppingScheme() {}
 
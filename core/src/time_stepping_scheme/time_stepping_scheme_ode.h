@@ -46,6 +46,9 @@ public:
   
   //! discretizable in time object
   DiscretizableInTimeType &discretizableInTime();
+
+  //! the object that stores the Dirichlet boundary condition values
+  std::shared_ptr<SpatialDiscretization::DirichletBoundaryConditions<FunctionSpace,DiscretizableInTimeType::nComponents()>> dirichletBoundaryConditions();
   
   //! set the subset of ranks that will compute the work
   void setRankSubset(Partition::RankSubset rankSubset);
@@ -86,6 +86,13 @@ discretizableInTime()
   return this->discretizableInTime_;
 }
 
+template<typename DiscretizableInTimeType>
+std::shared_ptr<SpatialDiscretization::DirichletBoundaryConditions<typename DiscretizableInTimeType::FunctionSpace,DiscretizableInTimeType::nComponents()>> TimeSteppingSchemeOdeBase<DiscretizableInTimeType>::
+dirichletBoundaryConditions()
+{
+  return this->dirichletBoundaryConditions_;
+}
+
 template<typename DiscretizableInTimeType>
 void TimeSteppingSchemeOdeBase<DiscretizableInTimeType>::
 setRankSubset(Partition::RankSubset rankSubset)
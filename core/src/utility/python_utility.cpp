@@ -994,6 +994,38 @@ PyObject *PythonUtility::convertToPythonList(unsigned int nEntries, double* data
   return result;    // return value: new reference
 }
 
+PyObject *PythonUtility::convertToPythonBuffer(unsigned int nEntries, double* data)
+{
+  // create a memoryview of the raw bytes and cast it to double values
+  PyObject *bytesView = PyMemoryView_FromMemory((char *)data, (Py_ssize_t)(nEntries*sizeof(double)), PyBUF_WRITE);
+  if (bytesView == NULL)
+  {
+    PyErr_Print();
+    return NULL;
+  }
+
+  PyObject *result = PyObject_CallMethod(bytesView, "cast", "s", "d");
+  if (result == NULL)
+    PyErr_Print();
+
+  Py_CLEAR(bytesView);
+  return result;    // return value: new reference
+}
+
+void PythonUtility::releasePythonBuffer(PyObject *memoryView)
+{
+  if (memoryView == NULL)
+    return;
+
+  PyObject *result = PyObject_CallMethod(memoryView, "release", NULL);
+  if (result == NULL)
+  {
+    LOG(ERROR) << "Could not release the memoryview of the data, a python object still uses it, e.g. a numpy array that was stored by the callback.";
+    PyErr_Print();
+  }
+  Py_CLEAR(result);
+}
+
 std::string PythonUtility::pyUnicodeToString(PyObject* object)
 {
   // start critical section for python API calls
@@ -1007,6 +1039,19 @@ std::string PythonUtility::pyUnicodeToString(PyObject* object)
 }
 
 
+PythonUtility::GlobalInterpreterLockRelease::GlobalInterpreterLockRelease() :
+  threadState_(nullptr)
+{
+  if (Py_IsInitialized() && PyGILState_Check())
+    threadState_ = PyEval_SaveThread();
+}
+
+PythonUtility::GlobalInterpreterLockRelease::~GlobalInterpreterLockRelease()
+{
+  if (threadState_)
+    PyEval_RestoreThread(threadState_);
+}
+
 // python GIL handling is only needed for multi-threading. It does not work properly with openmp.
 //int PythonUtility::GlobalInterpreterLock::nGILS_ = 0;
 /*std::recursive_mutex PythonUtility::GlobalInterpreterLock::mutex_;
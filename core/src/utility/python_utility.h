@@ -147,6 +147,14 @@ public:
   //! create a python list out of the long vector
   static PyObject *convertToPythonList(unsigned int nEntries, double *data);
 
+  //! create a writable python memoryview of the double values that shares the memory of data, without copying. It can be used as numpy array by numpy.asarray.
+  //! The memoryview must not be used after data is deallocated.
+  static PyObject *convertToPythonBuffer(unsigned int nEntries, double *data);
+
+  //! release a memoryview that was created by convertToPythonBuffer, before its data is deallocated. Afterwards, python code that kept a reference to the
+  //! memoryview gets an error when using it instead of accessing the deallocated data. If the buffer is still exported, e.g. to a numpy array, an error is printed.
+  static void releasePythonBuffer(PyObject *memoryView);
+
   //! convert a PyUnicode object to a std::string
   static std::string pyUnicodeToString(PyObject *object);
 
@@ -181,7 +189,23 @@ public:
     //static bool lockInitialized_;
     //static omp_nest_lock_t lock_;
   };
-  
+
+  /** Helper class that releases the global interpreter lock while native code runs that does not use the python api, e.g. the CellML rhs routine.
+   *  Then other threads that use the python interpreter are not blocked meanwhile. The lock is acquired again when the object gets destructed.
+   *  If the calling thread does not hold the lock, nothing is done.
+   */
+  class GlobalInterpreterLockRelease
+  {
+  public:
+    //! constructor, releases the lock
+    GlobalInterpreterLockRelease();
+
+    //! destructor, acquires the lock again
+    ~GlobalInterpreterLockRelease();
+  private:
+    PyThreadState *threadState_;   ///< the state of the thread that released the lock, nullptr if the lock was not released
+  };
+
 private:
 
   static PyObject *itemList;    ///< list of items (key,value) for dictionary,  to use for getOptionDictBegin, getOptionDictEnd, getOptionDictNext
@@ -50,6 +50,21 @@ std::string replace(std::string str, const std::string& from, const std::string&
   return result;
 }
 
+//! replace all occurences of from by to
+std::string replaceAll(std::string str, const std::string& from, const std::string& to)
+{
+  if (from.empty())
+    return str;
+
+  size_t start_pos = 0;
+  while ((start_pos = str.find(from, start_pos)) != std::string::npos)
+  {
+    str.replace(start_pos, from.length(), to);
+    start_pos += to.length();
+  }
+  return str;
+}
+
 template<>
 std::string multiply<1>(std::string str)
 {
@@ -169,6 +169,13 @@ def set_specific_states(n_nodes_global, time_step_no, current_time, states, fibr
     for node_no_global in nodes_to_stimulate_global:
       states[(node_no_global,0,0)] = 20.0   # key: ((x,y,z),nodal_dof_index,state_no)
 
+# firing times of the motor unit of the fibre, for the stimulation schedule that is evaluated without python callbacks
+def get_firing_times(fibre_no, frequency):
+  mu_no = (int)(get_motor_unit_no(fibre_no)*0.8)
+  n_firing_times = np.size(firing_times,0)
+  n_stimulations = int(end_time * frequency) + 1
+  return [index / frequency for index in range(n_stimulations) if firing_times[index % n_firing_times, mu_no] == 1]
+
 def callback(data, shape, nEntries, dim, timeStepNo, currentTime):
   pass
     
@@ -211,6 +218,8 @@ def get_instance_config(i):
             "setSpecificStatesFunction": set_specific_states,    # callback function that sets states like Vm, activation can be implemented by using this method and directly setting Vm values, or by using setParameters/setSpecificParameters
             "setSpecificStatesCallInterval": int(1./stimulation_frequency/dt_0D),     # set_specific_states should be called every 0.1, 5e-5 * 1e3 = 5e-2 = 0.05
             "additionalArgument": i,
+            # alternative to setSpecificStatesFunction that is evaluated natively, without calling python, the stimulated node is the center node of the fibre
+            #"stimulationSchedule": [{"firingTimes": get_firing_times(i, stimulation_frequency), "stimulationDuration": dt_0D, "dofNos": [int(len(streamlines[i])/2)], "stateNo": 0, "value": 20.0}],
             
             "outputStateIndex": 0,     # state 0 = Vm, rate 28 = gamma
             "parametersUsedAsIntermediate": parameters_used_as_intermediate,  #[32],       # list of intermediate value indices, that will be set by parameters. Explicitely defined parameters that will be copied to intermediates, this vector contains the indices of the algebraic array. This is ignored if the input is generated from OpenCMISS generated c code.
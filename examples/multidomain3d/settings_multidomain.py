@@ -144,8 +144,10 @@ config = {
     "activationSolver": {
       "relativeTolerance": 1e-5,
       "maxIterations": 10000,
-      "solverType": "gmres",
-      "preconditionerType": "none"
+      "solverType": "gmres",                 # use "dgmres" to keep a deflation space of approximate eigenvectors over all solves, with "nDeflationEigenvalues" and "maxDeflationEigenvalues"
+      "preconditionerType": "none",
+      "initialGuess": "default",             # "default", "previous" (solution of last time step) or "extrapolate" (linear extrapolation of the last two solutions)
+      "preconditionerRefreshFactor": 0,      # if > 0, reuse the preconditioner until the number of iterations exceeds this factor times the iterations after the last rebuild
     }
   },
   "MultidomainSolver" : {
@@ -156,6 +158,9 @@ config = {
     "endTime": end_time,
     "timeStepOutputInterval": 50,
     "solverName": "activationSolver",
+    "blockPreconditionerType": "none",              # "none", "additive" (block Jacobi), "multiplicative" (block Gauss-Seidel) or "schur" (Schur complement for phi_e)
+    "compartmentPreconditionerType": "jacobi",      # preconditioner of the diagonal blocks of the compartments, if blockPreconditionerType is not "none"
+    "extracellularPreconditionerType": "gamg",      # preconditioner of the block for phi_e, if blockPreconditionerType is not "none"
 #    "compartmentRelativeFactors": [
 #      [...],
 #      [...],
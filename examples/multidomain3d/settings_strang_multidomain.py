@@ -318,6 +318,9 @@ config = {
         "endTime": end_time,
         "timeStepOutputInterval": 50,
         "solverName": "activationSolver",
+        "blockPreconditionerType": "none",              # "none", "additive" (block Jacobi), "multiplicative" (block Gauss-Seidel) or "schur" (Schur complement for phi_e)
+        "compartmentPreconditionerType": "jacobi",      # preconditioner of the diagonal blocks of the compartments, if blockPreconditionerType is not "none"
+        "extracellularPreconditionerType": "gamg",      # preconditioner of the block for phi_e, if blockPreconditionerType is not "none"
         "inputIsGlobal": True,
         "compartmentRelativeFactors": relative_factors.tolist(),
         "PotentialFlow": {
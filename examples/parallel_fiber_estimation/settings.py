@@ -34,6 +34,7 @@ config = {
     "useGradientField": False,    # set to False
     "maxLevel": 1,          # maximum level (1=8 processes, 2=64 processes)
     "lineStepWidth":  0.1,  # line width for tracing of fibers
+    "lineIntegrationScheme": "ExplicitEuler",   # "ExplicitEuler" or "RK4", RK4 allows a larger lineStepWidth for the same accuracy
     "FiniteElementMethod" : {
       "meshName": "potentialFlow",
       "solverName": "linearSolver",
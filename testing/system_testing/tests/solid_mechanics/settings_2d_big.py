@@ -69,6 +69,8 @@ config = {
     #"rightHandSide": traction,  # surface traction T or body force B, both in material description
     "materialParameters": material_parameters,  # c0, c1, kappa
     "analyticJacobian": analytic_jacobian,   # False = compute Jacobian by finite differences
+    #"finiteDifferenceColoring": True,   # for finite differences jacobian, use a coloring of the sparsity pattern to need fewer function evaluations
+    #"matrixFreeJacobian": False,        # True = use matrix-free jacobian-vector products by finite differences, preconditioned by the analytic jacobian
       
     "OutputWriter" : [
       #{"format": "Paraview", "outputInterval": 1, "filename": "out", "binary": "false", "fixedFormat": False},
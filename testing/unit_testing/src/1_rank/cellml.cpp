@@ -60,6 +60,410 @@ config = {
   assertFileMatchesContent("out_0000009.py", referenceOutput);
 }
 
+TEST(CellMLTest, HodgkinHuxleyParameterTable)
+{
+  std::string pythonConfig = R"(
+
+# CellML Hodgkin-Huxley from cpp file, the same as in the HodgkinHuxley test but the parameter is set by a parameter table
+config = {
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-5,
+    "endTime" : 1.0,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "OutputWriter" : [
+      {"format": "PythonFile", "filename": "out", "binary": False, "outputInterval": 1e4}
+    ],
+
+    "CellML" : {
+      "sourceFilename": "../input/hodgkin_huxley_1952.c",
+      "setParametersCallInterval": 1e3,
+      "useGivenLibrary": False,
+      #"statesInitialValues": [-75,  .05, 0.6, 0.325],
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [0.0],        # initial values for the parameters: I_Stim, overwritten by the parameter table
+      "parameterTables": [
+        {"parameterNo": 0, "times": [0.0], "values": [400.0]},    # I_Stim = 400 from t=0 on, evaluated without calling python
+      ],
+
+      "parametersUsedAsIntermediate": [],       # list of intermediate value indices, that will be set by parameters. Explicitely defined parameters that will be copied to intermediates, this vector contains the indices of the algebraic array. This is ignored if the input is generated from OpenCMISS generated c code.
+      "parametersUsedAsConstant": [2],           # list of constant value indices, that will be set by parameters. This is ignored if the input is generated from OpenCMISS generated c code.
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<
+    CellmlAdapter<4>
+  > problem(settings);
+
+  problem.run();
+
+  std::string referenceOutput = "{\"meshType\": \"StructuredRegularFixed\", \"dimension\": 1, \"nElementsGlobal\": [0], \"nElementsLocal\": [0], \"beginNodeGlobalNatural\": [0], \"hasFullNumberOfNodes\": [true], \"basisFunction\": \"Lagrange\", \"basisOrder\": 1, \"onlyNodalValues\": true, \"nRanks\": 1, \"ownRankNo\": 0, \"data\": [{\"name\": \"geometry\", \"components\": [{\"name\": \"x\", \"values\": [0.0]}, {\"name\": \"y\", \"values\": [0.0]}, {\"name\": \"z\", \"values\": [0.0]}]}, {\"name\": \"solution\", \"components\": [{\"name\": \"V\", \"values\": [36.18142823585638]}, {\"name\": \"m\", \"values\": [0.9987345768519429]}, {\"name\": \"h\", \"values\": [0.2446134695357078]}, {\"name\": \"n\", \"values\": [0.5789949501440312]}]}], \"timeStepNo\": 90001, \"currentTime\": 0.90001}";
+  assertFileMatchesContent("out_0000009.py", referenceOutput);
+}
+
+//! settings for 5 Hodgkin-Huxley instances on a fiber, I_Stim changes in several intervals at the dofs 1,2,3 and V is stimulated at the dofs 0 and 3,
+//! for mode "schedule" this is given by "parameterTables" and "stimulationSchedule", for modes "buffers" and "lists" by the equivalent Python callbacks
+std::string stimulationScheduleConfig(std::string mode)
+{
+  return std::string("mode = \"") + mode + "\"" + R"(
+
+parameter_times = [0.0, 0.2, 0.5, 0.8]
+parameter_values = [400.0, 0.0, 200.0, 50.0]
+parameter_dofs = [1, 2, 3]
+firing_times = [0.1, 0.6]
+stimulation_duration = 0.05
+stimulated_dofs = [0, 3]
+
+# the parameter table, the value of the last time that is not after current_time
+def set_parameters(n_instances, time_step_no, current_time, parameters, dof_nos_global, additional_argument):
+  interval_no = max([i for i in range(len(parameter_times)) if parameter_times[i] <= current_time])
+  for instance_no, dof_no in enumerate(dof_nos_global):
+    if dof_no in parameter_dofs:
+      parameters[instance_no] = parameter_values[interval_no]
+
+# the stimulation schedule, V is set to 20 in [firing_time, firing_time + stimulation_duration)
+def set_specific_states(n_nodes_global, time_step_no, current_time, states, additional_argument):
+  for firing_time in firing_times:
+    if firing_time <= current_time < firing_time + stimulation_duration:
+      for dof_no in stimulated_dofs:
+        states[([dof_no],0,0)] = 20.0
+
+cellml_config = {
+  "sourceFilename": "../input/hodgkin_huxley_1952.c",
+  "meshName": "MeshFibre",
+  "useGivenLibrary": False,
+  "statesInitialValues": [-75, 0.05, 0.6, 0.325],
+  "parametersInitialValues": [0.0],          # initial values for the parameters: I_Stim
+  "parametersUsedAsIntermediate": [],
+  "parametersUsedAsConstant": [2],
+}
+
+if mode == "schedule":
+  cellml_config["parameterTables"] = [
+    {"parameterNo": 0, "times": parameter_times, "values": parameter_values, "dofNos": parameter_dofs},
+  ]
+  cellml_config["stimulationSchedule"] = [
+    {"stateNo": 0, "firingTimes": firing_times, "stimulationDuration": stimulation_duration, "value": 20.0, "dofNos": stimulated_dofs},
+  ]
+else:
+  cellml_config["setParametersFunction"] = set_parameters
+  cellml_config["setParametersCallInterval"] = 1
+  cellml_config["setSpecificStatesFunction"] = set_specific_states
+  cellml_config["setSpecificStatesCallInterval"] = 1
+  cellml_config["pythonCallbackBuffers"] = (mode == "buffers")
+
+config = {
+  "Meshes": {
+    "MeshFibre": {
+      "nElements": 4,
+      "physicalExtent": 4.0,
+    },
+  },
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-4,
+    "endTime" : 1.0,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+    "CellML" : cellml_config,
+  }
+}
+)";
+}
+
+TEST(CellMLTest, HodgkinHuxleyStimulationSchedule)
+{
+  typedef TimeSteppingScheme::ExplicitEuler<
+    CellmlAdapter<4>
+  > ProblemType;
+
+  // the states of all instances, set by the native schedule, by Python callbacks with memoryviews and by Python callbacks with lists
+  std::vector<std::string> modes = {"schedule", "buffers", "lists"};
+  std::vector<std::vector<std::array<double,4>>> states(modes.size());
+  for (int modeNo = 0; modeNo < modes.size(); modeNo++)
+  {
+    DihuContext settings(argc, argv, stimulationScheduleConfig(modes[modeNo]));
+
+    ProblemType problem(settings);
+    problem.run();
+
+    problem.data().solution()->getValuesWithoutGhosts(states[modeNo]);
+    ASSERT_EQ(states[modeNo].size(), 5);
+  }
+
+  // the schedule sets the same values at the same evaluations as the callbacks
+  for (int modeNo = 1; modeNo < modes.size(); modeNo++)
+  {
+    for (int instanceNo = 0; instanceNo < 5; instanceNo++)
+    {
+      for (int stateNo = 0; stateNo < 4; stateNo++)
+      {
+        EXPECT_DOUBLE_EQ(states[0][instanceNo][stateNo], states[modeNo][instanceNo][stateNo])
+          << "mode " << modes[modeNo] << ", instance " << instanceNo << ", state " << stateNo;
+      }
+    }
+  }
+
+  // the instances that were stimulated by the table or the schedule differ from the unstimulated instance 4, the instances 1 and 2 are equal
+  EXPECT_NE(states[0][0][0], states[0][4][0]);
+  EXPECT_NE(states[0][1][0], states[0][4][0]);
+  EXPECT_NE(states[0][3][0], states[0][1][0]);
+  EXPECT_DOUBLE_EQ(states[0][1][0], states[0][2][0]);
+}
+
+TEST(CellMLTest, HodgkinHuxleyLookupTables)
+{
+  std::string pythonConfig = R"(
+
+# CellML Hodgkin-Huxley from cpp file, the same as in the HodgkinHuxley test but the rate coefficients of the gating variables are interpolated in lookup tables
+config = {
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-5,
+    "endTime" : 1.0,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "CellML" : {
+      "sourceFilename": "../input/hodgkin_huxley_1952.c",
+      "useGivenLibrary": False,
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [400.0],      # initial values for the parameters: I_Stim
+      "parametersUsedAsIntermediate": [],
+      "parametersUsedAsConstant": [2],
+
+      "useLookupTables": True,                 # interpolate algebraics that only depend on the membrane potential
+      "lookupTableStateNo": 0,                 # the state of the membrane potential V
+      "lookupTableRange": [-100, 100],         # range of V that is covered by the lookup tables
+      "lookupTableResolution": 0.05,           # distance of the sampling points of V
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<
+    CellmlAdapter<4>
+  > problem(settings);
+
+  problem.run();
+
+  // the generated rhs routine has to interpolate the rate coefficients of the gating variables in the lookup tables
+  std::ifstream simdSourceFile("src/hodgkin_huxley_1952_simd.c.0.c");
+  ASSERT_TRUE(simdSourceFile.is_open());
+  std::stringstream simdSource;
+  simdSource << simdSourceFile.rdbuf();
+  EXPECT_NE(simdSource.str().find("= interpolateLookupTable(lookupTables[5]"), std::string::npos);
+  EXPECT_NE(simdSource.str().find("void initializeLookupTables()"), std::string::npos);
+
+  // the result at t=1 has to be close to the result without lookup tables, 34.4442920049919, 0.998870348078852, 0.22136530229588, 0.591529516926352,
+  // the reference values are computed by a separate implementation of the explicit Euler scheme with the same lookup tables
+  std::vector<std::array<double,4>> values;
+  problem.data().solution()->getValuesWithoutGhosts(values);
+
+  ASSERT_EQ(values.size(), 1);
+  EXPECT_NEAR(values[0][0], 34.4442924842978, 1e-8);
+  EXPECT_NEAR(values[0][1], 0.998870347494905, 1e-10);
+  EXPECT_NEAR(values[0][2], 0.221365303316248, 1e-10);
+  EXPECT_NEAR(values[0][3], 0.591529512662257, 1e-10);
+
+  // the interpolation error is visible in the membrane potential, otherwise the lookup tables were not used
+  EXPECT_GT(fabs(values[0][0] - 34.4442920049919), 1e-7);
+}
+
+TEST(CellMLTest, GatingVariableDetection)
+{
+  // rates of the form a - b*y are linear in y
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree(" algebraics[1]*(1.00000 - y) - algebraics[5]*y", "y"), 1);
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree("(algebraics[3] - y)/algebraics[4]", "y"), 1);
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree("pow(algebraics[1], 2.0)*y + 1.5e-3", "y"), 1);
+
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree("algebraics[1] - CONSTANTS[2]", "y"), 0);
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree("y*(1.0 - y)", "y"), 2);
+
+  // the variable in a function argument, a denominator or a conditional is not polynomial
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree("exp(y)", "y"), -1);
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree("1.0/y", "y"), -1);
+  ASSERT_EQ(CellmlExpressionAnalysis::polynomialDegree("(a > 0.0 ? y : 1.0)", "y"), -1);
+
+  // candidates for lookup tables only use the membrane potential, algebraics and constants and contain function calls
+  std::set<std::string> variableNames;
+  ASSERT_TRUE(CellmlExpressionAnalysis::getVariableNames(" 4.00000*exp(- (membranePotential+CONSTANTS[2])/18.0000)", variableNames));
+  ASSERT_EQ(variableNames, std::set<std::string>({"CONSTANTS", "membranePotential"}));
+  ASSERT_TRUE(CellmlExpressionAnalysis::containsFunctionCall(" 4.00000*exp(- (membranePotential+CONSTANTS[2])/18.0000)"));
+  ASSERT_FALSE(CellmlExpressionAnalysis::containsFunctionCall("CONSTANTS[5]*(membranePotential - ALGEBRAIC[8])"));
+}
+
+TEST(CellMLTest, HodgkinHuxleyRushLarsen)
+{
+  std::string pythonConfig = R"(
+
+# CellML Hodgkin-Huxley from cpp file, integrated by the Rush-Larsen scheme
+config = {
+  "RushLarsen" : {
+    "timeStepWidth": 1e-3,
+    "endTime" : 1.0,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "OutputWriter" : [
+      {"format": "PythonFile", "filename": "out_rush_larsen", "binary": False, "outputInterval": 1e4}
+    ],
+
+    "CellML" : {
+      "sourceFilename": "../input/hodgkin_huxley_1952.c",
+      "useGivenLibrary": False,
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [400.0],      # initial values for the parameters: I_Stim
+      "parametersUsedAsIntermediate": [],
+      "parametersUsedAsConstant": [2],
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::RushLarsen<
+    CellmlAdapter<4>
+  > problem(settings);
+
+  problem.run();
+
+  // the gating variables m, h and n are detected, the membrane voltage V is integrated explicitly
+  std::vector<int> gatingStateNos = problem.discretizableInTime().gatingStateNos();
+  ASSERT_EQ(gatingStateNos, std::vector<int>({1, 2, 3}));
+  ASSERT_TRUE(problem.discretizableInTime().hasGatingCoefficients());
+
+  // compare the state at t=1 to the result of the explicit Euler scheme with dt=1e-5,
+  // the scheme is first order, with dt=1e-3 the errors are about 4e-3 for V and below 3e-5 for the gating variables
+  std::vector<std::array<double,4>> values;
+  problem.data().solution()->getValuesWithoutGhosts(values);
+
+  ASSERT_EQ(values.size(), 1);
+  EXPECT_NEAR(values[0][0], 34.444292005, 1e-2);
+  EXPECT_NEAR(values[0][1], 0.998870348079, 1e-4);
+  EXPECT_NEAR(values[0][2], 0.221365302296, 1e-4);
+  EXPECT_NEAR(values[0][3], 0.591529516926, 1e-4);
+}
+
+//! settings for a single Hodgkin-Huxley instance that is integrated by the given scheme until endTime, starting from the membrane potential initialV
+std::string hodgkinHuxleyConfig(std::string schemeName, double timeStepWidth, double endTime=1.0, double stimulationCurrent=400.0, double initialV=-20.0)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << "scheme_name = \"" << schemeName << "\"" << std::endl
+    << "dt = " << timeStepWidth << std::endl
+    << "end_time = " << endTime << std::endl
+    << "i_stim = " << stimulationCurrent << std::endl
+    << "initial_v = " << initialV << std::endl << R"(
+
+config = {
+  scheme_name : {
+    "timeStepWidth": dt,
+    "endTime" : end_time,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "CellML" : {
+      "sourceFilename": "../input/hodgkin_huxley_1952.c",
+      "useGivenLibrary": False,
+      "statesInitialValues": [initial_v, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [i_stim],      # initial values for the parameters: I_Stim
+      "parametersUsedAsIntermediate": [],
+      "parametersUsedAsConstant": [2],
+    },
+  }
+}
+)";
+  return pythonConfig.str();
+}
+
+// the final update u_{t+1} = u* + 0.5*dt*(f(u*)-f(u_{t})) is computed by VecAXPBYPCZ, the result has to match the reference of the previous implementation,
+// which computed the same update with two VecAXPY calls
+TEST(CellMLTest, HodgkinHuxleyHeun)
+{
+  DihuContext settings(argc, argv, hodgkinHuxleyConfig("Heun", 1e-5));
+
+  TimeSteppingScheme::Heun<
+    CellmlAdapter<4>
+  > problem(settings);
+
+  problem.run();
+
+  std::vector<std::array<double,4>> values;
+  problem.data().solution()->getValuesWithoutGhosts(values);
+
+  ASSERT_EQ(values.size(), 1);
+  EXPECT_NEAR(values[0][0], 34.4443705548705, 1e-8);
+  EXPECT_NEAR(values[0][1], 0.998870289938882, 1e-10);
+  EXPECT_NEAR(values[0][2], 0.221366314903201, 1e-10);
+  EXPECT_NEAR(values[0][3], 0.591528959566118, 1e-10);
+}
+
+// the Runge-Kutta scheme of 4th order with dt=1e-3 has to match its own result for dt=1e-5 up to about 1e-9,
+// the Heun scheme with dt=1e-3 has errors of about 1e-6
+TEST(CellMLTest, HodgkinHuxleyRungeKutta4)
+{
+  DihuContext settings(argc, argv, hodgkinHuxleyConfig("RungeKutta4", 1e-3));
+
+  TimeSteppingScheme::RungeKutta4<
+    CellmlAdapter<4>
+  > problem(settings);
+
+  problem.run();
+
+  std::vector<std::array<double,4>> values;
+  problem.data().solution()->getValuesWithoutGhosts(values);
+
+  ASSERT_EQ(values.size(), 1);
+  EXPECT_NEAR(values[0][0], 34.4443705547663, 1e-8);
+  EXPECT_NEAR(values[0][1], 0.998870289940891, 1e-10);
+  EXPECT_NEAR(values[0][2], 0.221366314894678, 1e-10);
+  EXPECT_NEAR(values[0][3], 0.591528959573445, 1e-10);
+}
+
+//! integrate the Hodgkin-Huxley model near its resting state without stimulation until t=10 with the given scheme and return the final states
+template<typename TimeSteppingSchemeType>
+std::array<double,4> runRestingHodgkinHuxley(std::string schemeName, double timeStepWidth)
+{
+  DihuContext settings(argc, argv, hodgkinHuxleyConfig(schemeName, timeStepWidth, 10.0, 0.0, -75.0));
+
+  TimeSteppingSchemeType problem(settings);
+  problem.run();
+
+  std::vector<std::array<double,4>> values;
+  problem.data().solution()->getValuesWithoutGhosts(values);
+  EXPECT_EQ(values.size(), 1);
+  return values.empty()? std::array<double,4>({0,0,0,0}) : values[0];
+}
+
+// with dt=0.5 the gating variable m is too stiff for the explicit schemes and they diverge, the Rush-Larsen scheme stays bounded
+// and is close to the result of the Runge-Kutta scheme of 4th order with dt=1e-4
+TEST(CellMLTest, HodgkinHuxleyRushLarsenLargeTimeStep)
+{
+  const std::array<double,4> reference = {-74.990635271964, 0.0529209995399175, 0.603039097035846, 0.317097208315878};
+  const double timeStepWidth = 0.5;
+
+  std::array<double,4> statesRushLarsen = runRestingHodgkinHuxley<TimeSteppingScheme::RushLarsen<CellmlAdapter<4>>>("RushLarsen", timeStepWidth);
+  std::array<double,4> statesExplicitEuler = runRestingHodgkinHuxley<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<4>>>("ExplicitEuler", timeStepWidth);
+  std::array<double,4> statesHeun = runRestingHodgkinHuxley<TimeSteppingScheme::Heun<CellmlAdapter<4>>>("Heun", timeStepWidth);
+
+  // the errors of the Rush-Larsen scheme are about 1e-2 for V and below 1e-3 for the gating variables
+  EXPECT_NEAR(statesRushLarsen[0], reference[0], 5e-2);
+  for (int stateNo = 1; stateNo < 4; stateNo++)
+  {
+    EXPECT_NEAR(statesRushLarsen[stateNo], reference[stateNo], 2e-3) << "state " << stateNo;
+  }
+
+  // the explicit schemes give nan or values far off, the comparison is false in both cases
+  EXPECT_FALSE(fabs(statesExplicitEuler[0] - reference[0]) < 1.0) << "explicit Euler: V = " << statesExplicitEuler[0];
+  EXPECT_FALSE(fabs(statesHeun[0] - reference[0]) < 1.0) << "Heun: V = " << statesHeun[0];
+}
+
 TEST(CellMLTest, ShortenOpenCMISS)
 {
   std::string pythonConfig = R"(
@@ -153,3 +557,184 @@ config = {
   std::string referenceOutput = "{\"meshType\": \"StructuredRegularFixed\", \"dimension\": 1, \"nElementsGlobal\": [0], \"nElementsLocal\": [0], \"beginNodeGlobalNatural\": [0], \"hasFullNumberOfNodes\": [true], \"basisFunction\": \"Lagrange\", \"basisOrder\": 1, \"onlyNodalValues\": true, \"nRanks\": 1, \"ownRankNo\": 0, \"data\": [{\"name\": \"geometry\", \"components\": [{\"name\": \"x\", \"values\": [0.0]}, {\"name\": \"y\", \"values\": [0.0]}, {\"name\": \"z\", \"values\": [0.0]}]}, {\"name\": \"solution\", \"components\": [{\"name\": \"vS\", \"values\": [23.814400125628982]}, {\"name\": \"vT\", \"values\": [32.0069535572101]}, {\"name\": \"K_t\", \"values\": [5.943505949614364]}, {\"name\": \"K_i\", \"values\": [150.89852020829184]}, {\"name\": \"K_e\", \"values\": [5.90670286335029]}, {\"name\": \"Na_i\", \"values\": [12.702309626201476]}, {\"name\": \"Na_t\", \"values\": [132.39316813125978]}, {\"name\": \"Na_e\", \"values\": [132.99816117889287]}, {\"name\": \"n\", \"values\": [0.6110086409474482]}, {\"name\": \"h_K\", \"values\": [0.9679442466363977]}, {\"name\": \"m\", \"values\": [0.9989395956165837]}, {\"name\": \"h\", \"values\": [0.011749768142590286]}, {\"name\": \"S\", \"values\": [0.5803854365011085]}, {\"name\": \"n_t\", \"values\": [0.31830761662008844]}, {\"name\": \"h_K_t\", \"values\": [0.00497357422926022]}, {\"name\": \"m_t\", \"values\": [0.9991117400268303]}, {\"name\": \"h_t\", \"values\": [0.037558451115072077]}, {\"name\": \"S_t\", \"values\": [0.5807554861436337]}, {\"name\": \"O_0\", \"values\": [1.040185730088509e-06]}, {\"name\": \"O_1\", \"values\": [1.7764261016973102e-05]}, {\"name\": \"O_2\", \"values\": [0.00010214492966850287]}, {\"name\": \"O_3\", \"values\": [0.0001806534304265151]}, {\"name\": \"O_4\", \"values\": [7.488219517482619e-05]}, {\"name\": \"C_0\", \"values\": [0.5235895401090125]}, {\"name\": \"C_1\", \"values\": [0.3676938153420917]}, {\"name\": \"C_2\", \"values\": [0.0967148096280458]}, {\"name\": \"C_3\", \"values\": [0.011171890150204495]}, {\"name\": \"C_4\", \"values\": [0.0004534597686249599]}, {\"name\": \"Ca_1\", \"values\": [83.4425093078456]}, {\"name\": \"Ca_SR1\", \"values\": [1060.6659068598588]}, {\"name\": \"Ca_2\", \"values\": [3.0314298736642855]}, {\"name\": \"Ca_SR2\", \"values\": [1199.7566783570803]}, {\"name\": \"Ca_T_2\", \"values\": [24.733571546894552]}, {\"name\": \"Ca_P1\", \"values\": [641.6053654748897]}, {\"name\": \"Ca_P2\", \"values\": [616.2261077701777]}, {\"name\": \"Mg_P1\", \"values\": [810.8520611234248]}, {\"name\": \"Mg_P2\", \"values\": [810.9433332103665]}, {\"name\": \"Ca_Cs1\", \"values\": [16897.537754304743]}, {\"name\": \"Ca_Cs2\", \"values\": [16898.598304725354]}, {\"name\": \"Ca_ATP1\", \"values\": [108.46786460987256]}, {\"name\": \"Ca_ATP2\", \"values\": [10.511248908824985]}, {\"name\": \"Mg_ATP1\", \"values\": [7235.085496468541]}, {\"name\": \"Mg_ATP2\", \"values\": [7237.758581434536]}, {\"name\": \"ATP1\", \"values\": [656.44663892157]}, {\"name\": \"ATP2\", \"values\": [751.7301696566033]}, {\"name\": \"Mg1\", \"values\": [963.0444607968487]}, {\"name\": \"Mg2\", \"values\": [962.3184690076832]}, {\"name\": \"Ca_CaT2\", \"values\": [2.9818968299099726]}, {\"name\": \"D_0\", \"values\": [0.7991173574101228]}, {\"name\": \"D_1\", \"values\": [1.211475056337586]}, {\"name\": \"D_2\", \"values\": [2.9720138760087482]}, {\"name\": \"A_1\", \"values\": [0.29493676390460843]}, {\"name\": \"A_2\", \"values\": [0.23169305229112158]}, {\"name\": \"P\", \"values\": [0.2300207028869685]}, {\"name\": \"P_SR\", \"values\": [0.2301171644715283]}, {\"name\": \"P_C_SR\", \"values\": [0.22988283186639114]}, {\"name\": \"\", \"values\": [4.6429585851491e-310]}]}], \"timeStepNo\": 90001, \"currentTime\": 0.90001}";
   assertFileMatchesContent("out_0000009.py", referenceOutput);
 }
+
+//! settings for 3 Hodgkin-Huxley instances with different initial values and stimulation currents that are integrated by the given scheme,
+//! V is additionally set by a stimulation schedule, with "batchInstances" the CellML models of all instances are evaluated together,
+//! doublePrecisionStateNos is the python list of the states that are accumulated in double precision if useSinglePrecision is set
+std::string batchedInstancesConfig(std::string schemeName, bool batchInstances, bool useSinglePrecision=false, std::string doublePrecisionStateNos="[0]")
+{
+  std::stringstream pythonConfig;
+  pythonConfig << "scheme_name = \"" << schemeName << "\"" << std::endl
+    << "batch_instances = " << (batchInstances? "True" : "False") << std::endl
+    << "use_single_precision = " << (useSinglePrecision? "True" : "False") << std::endl
+    << "double_precision_state_nos = " << doublePrecisionStateNos << std::endl << R"(
+
+def instance_config(i):
+  return {
+    "ranks": [0],
+    scheme_name: {
+      "timeStepWidth": 1e-4,
+      "endTime" : 0.5,
+      "initialValues": [],
+      "timeStepOutputInterval": 1e5,
+
+      "CellML" : {
+        "sourceFilename": "../input/hodgkin_huxley_1952.c",
+        "useGivenLibrary": False,
+        "statesInitialValues": [-20+5*i, 0.05, 0.6, 0.325],
+        "parametersInitialValues": [400.0-100*i],      # initial values for the parameters: I_Stim
+        "parametersUsedAsIntermediate": [],
+        "parametersUsedAsConstant": [2],
+        "stimulationSchedule": [
+          {"stateNo": 0, "firingTimes": [0.2], "stimulationDuration": 0.05, "value": 20.0},
+        ],
+        "useSinglePrecision": use_single_precision,   # only used if the instances are batched
+        "doublePrecisionStateNos": double_precision_state_nos,   # the states that are accumulated in double precision in single precision mode
+      },
+    }
+  }
+
+config = {
+  "MultipleInstances": {
+    "nInstances": 3,
+    "batchInstances": batch_instances,
+    "instances": [instance_config(i) for i in range(3)],
+  }
+}
+)";
+  return pythonConfig.str();
+}
+
+//! run the Hodgkin-Huxley instances of the given config, that are integrated by TimeSteppingSchemeType, and return the states of all instances,
+//! if singlePrecision is given, it is set to whether the batched instances were integrated in single precision
+template<typename TimeSteppingSchemeType>
+std::vector<std::array<double,4>> runBatchedInstances(std::string pythonConfig, bool *singlePrecision=nullptr)
+{
+  DihuContext settings(argc, argv, pythonConfig);
+
+  Control::MultipleInstances<TimeSteppingSchemeType> problem(settings);
+  problem.run();
+
+  if (singlePrecision)
+    *singlePrecision = problem.batchedAdvance().singlePrecision();
+
+  std::vector<std::array<double,4>> states;
+  for (auto &instance : problem.instancesLocal())
+  {
+    std::vector<std::array<double,4>> values;
+    instance.data().solution()->getValuesWithoutGhosts(values);
+    EXPECT_EQ(values.size(), 1);
+    if (!values.empty())
+      states.push_back(values[0]);
+  }
+  return states;
+}
+
+//! run the instances of batchedInstancesConfig once advanced one after the other and once batched, check that the results are identical and return the batched states
+template<typename TimeSteppingSchemeType>
+std::vector<std::array<double,4>> checkBatchedEqualsSequential(std::string schemeName)
+{
+  std::vector<std::array<double,4>> states = runBatchedInstances<TimeSteppingSchemeType>(batchedInstancesConfig(schemeName, false));
+  std::vector<std::array<double,4>> statesBatched = runBatchedInstances<TimeSteppingSchemeType>(batchedInstancesConfig(schemeName, true));
+  EXPECT_EQ(states.size(), 3);
+  EXPECT_EQ(statesBatched.size(), 3);
+
+  // the batched integration performs the same operations per instance, the results have to be identical
+  for (int instanceNo = 0; instanceNo < std::min(states.size(), statesBatched.size()); instanceNo++)
+  {
+    for (int stateNo = 0; stateNo < 4; stateNo++)
+    {
+      EXPECT_DOUBLE_EQ(statesBatched[instanceNo][stateNo], states[instanceNo][stateNo]) << schemeName << ", instance " << instanceNo << ", state " << stateNo;
+    }
+  }
+  return statesBatched;
+}
+
+//! the maximum difference of the states stateNoBegin <= stateNo < stateNoEnd of all instances
+double maximumStateDifference(const std::vector<std::array<double,4>> &states0, const std::vector<std::array<double,4>> &states1, int stateNoBegin, int stateNoEnd)
+{
+  double maximumDifference = 0;
+  for (int instanceNo = 0; instanceNo < std::min(states0.size(), states1.size()); instanceNo++)
+  {
+    for (int stateNo = stateNoBegin; stateNo < stateNoEnd; stateNo++)
+    {
+      maximumDifference = std::max(maximumDifference, fabs(states0[instanceNo][stateNo] - states1[instanceNo][stateNo]));
+    }
+  }
+  return maximumDifference;
+}
+
+TEST(CellMLTest, BatchedInstancesHeun)
+{
+  checkBatchedEqualsSequential<TimeSteppingScheme::Heun<CellmlAdapter<4>>>("Heun");
+}
+
+TEST(CellMLTest, BatchedInstancesExplicitEuler)
+{
+  checkBatchedEqualsSequential<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<4>>>("ExplicitEuler");
+}
+
+TEST(CellMLTest, BatchedInstancesRungeKutta4)
+{
+  checkBatchedEqualsSequential<TimeSteppingScheme::RungeKutta4<CellmlAdapter<4>>>("RungeKutta4");
+}
+
+TEST(CellMLTest, BatchedInstancesRushLarsen)
+{
+  std::vector<std::array<double,4>> statesBatched = checkBatchedEqualsSequential<TimeSteppingScheme::RushLarsen<CellmlAdapter<4>>>("RushLarsen");
+  std::vector<std::array<double,4>> statesExplicitEuler = runBatchedInstances<TimeSteppingScheme::ExplicitEuler<CellmlAdapter<4>>>(batchedInstancesConfig("ExplicitEuler", true));
+  ASSERT_EQ(statesBatched.size(), 3);
+  ASSERT_EQ(statesExplicitEuler.size(), 3);
+
+  // the batch integrates the gating variables exponentially, the result differs from the explicit Euler scheme
+  EXPECT_GT(maximumStateDifference(statesBatched, statesExplicitEuler, 1, 4), 1e-9);
+}
+
+TEST(CellMLTest, BatchedInstancesSinglePrecision)
+{
+  typedef TimeSteppingScheme::Heun<CellmlAdapter<4>> TimeSteppingSchemeType;
+
+  // the states of all batched instances in double precision and in single precision with different states that are accumulated in double precision
+  bool singlePrecision = true;
+  std::vector<std::array<double,4>> states = runBatchedInstances<TimeSteppingSchemeType>(batchedInstancesConfig("Heun", true, false), &singlePrecision);
+  EXPECT_FALSE(singlePrecision);
+
+  singlePrecision = false;
+  std::vector<std::array<double,4>> statesSinglePrecision
+    = runBatchedInstances<TimeSteppingSchemeType>(batchedInstancesConfig("Heun", true, true), &singlePrecision);
+  EXPECT_TRUE(singlePrecision);
+
+  singlePrecision = false;
+  std::vector<std::array<double,4>> statesAllAccumulated
+    = runBatchedInstances<TimeSteppingSchemeType>(batchedInstancesConfig("Heun", true, true, "[0,1,2,3]"), &singlePrecision);
+  EXPECT_TRUE(singlePrecision);
+
+  std::vector<std::array<double,4>> statesGatingAccumulated
+    = runBatchedInstances<TimeSteppingSchemeType>(batchedInstancesConfig("Heun", true, true, "[1,2,3]"));
+  std::vector<std::array<double,4>> statesNoneAccumulated
+    = runBatchedInstances<TimeSteppingSchemeType>(batchedInstancesConfig("Heun", true, true, "[]"));
+
+  ASSERT_EQ(states.size(), 3);
+  ASSERT_EQ(statesSinglePrecision.size(), 3);
+  ASSERT_EQ(statesAllAccumulated.size(), 3);
+  ASSERT_EQ(statesGatingAccumulated.size(), 3);
+  ASSERT_EQ(statesNoneAccumulated.size(), 3);
+
+  // with the default, only V is accumulated in double precision, also after it was set by the stimulation schedule.
+  // After 5000 time steps, the small increments of the gating variables that are lost in single precision change them by about 1e-5 and V by about 1e-4
+  EXPECT_LT(maximumStateDifference(statesSinglePrecision, states, 0, 1), 5e-4);
+  EXPECT_LT(maximumStateDifference(statesSinglePrecision, states, 1, 4), 5e-5);
+
+  // if all states are accumulated, only the rounding errors of the rhs remain
+  const double errorAllAccumulatedV = maximumStateDifference(statesAllAccumulated, states, 0, 1);
+  const double errorAllAccumulatedGating = maximumStateDifference(statesAllAccumulated, states, 1, 4);
+  EXPECT_LT(errorAllAccumulatedV, 1e-6);
+  EXPECT_LT(errorAllAccumulatedGating, 1e-8);
+
+  // the accumulation of V reduces its error by orders of magnitude
+  EXPECT_GT(maximumStateDifference(statesGatingAccumulated, states, 0, 1), 100*errorAllAccumulatedV);
+
+  // without accumulation in double precision, the errors of all states are larger
+  EXPECT_GT(maximumStateDifference(statesNoneAccumulated, states, 0, 1), 100*errorAllAccumulatedV);
+  EXPECT_GT(maximumStateDifference(statesNoneAccumulated, states, 1, 4), 100*errorAllAccumulatedGating);
+}
@@ -931,4 +931,114 @@ config = {
   
 }
 
+// the quadratic field u = x^2 + 2xy + 3y is represented exactly by the biquadratic basis, the gradient (2x+2y, 2x+3) has to be exact at every node
+TEST(FieldVariableTest, GradientFieldQuadraticIsExact)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Domain": {
+    "nElements": [2, 2],
+    "physicalExtent": [1.0, 3.0],
+    "inputMeshIsGlobal": True,
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<2>, BasisFunction::LagrangeOfOrder<2>> FunctionSpaceType;
+  std::shared_ptr<FunctionSpaceType> functionSpace = settings.meshManager()->functionSpace<FunctionSpaceType>(settings["Domain"].getPythonConfig());
+
+  // for Lagrange basis functions every dof is at a node
+  std::vector<Vec3> positions;
+  functionSpace->geometryField().getValuesWithoutGhosts(positions);
+  ASSERT_EQ(positions.size(), 25u);
+
+  std::vector<double> values;
+  for (const Vec3 &position : positions)
+  {
+    const double x = position[0], y = position[1];
+    values.push_back(x*x + 2*x*y + 3*y);
+  }
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>> solution = functionSpace->template createFieldVariable<1>("solution");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,2>> gradient = functionSpace->template createFieldVariable<2>("gradient");
+  solution->setValuesWithoutGhosts(values);
+
+  solution->computeGradientField(gradient);
+
+  std::vector<std::array<double,2>> gradientValues;
+  gradient->getValuesWithoutGhosts(gradientValues);
+  ASSERT_EQ(gradientValues.size(), positions.size());
+
+  for (int dofNo = 0; dofNo < positions.size(); dofNo++)
+  {
+    const double x = positions[dofNo][0], y = positions[dofNo][1];
+    EXPECT_NEAR(gradientValues[dofNo][0], 2*x + 2*y, 1e-10) << "dof " << dofNo;
+    EXPECT_NEAR(gradientValues[dofNo][1], 2*x + 3, 1e-10) << "dof " << dofNo;
+  }
+}
+
+// the field u = xy is represented exactly by the bicubic Hermite basis, the dofs of every node are u, du/dxi0, du/dxi1 and d2u/dxi0dxi1,
+// the gradient (y, x) has to be exact at every node
+TEST(FieldVariableTest, GradientFieldHermiteIsExact)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Domain": {
+    "nElements": [2, 2],
+    "physicalExtent": [1.0, 3.0],
+    "inputMeshIsGlobal": True,
+    "setHermiteDerivatives": True,
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<2>, BasisFunction::Hermite> FunctionSpaceType;
+  std::shared_ptr<FunctionSpaceType> functionSpace = settings.meshManager()->functionSpace<FunctionSpaceType>(settings["Domain"].getPythonConfig());
+
+  // the geometry field contains the node position and the derivatives dX/dxi0 = (h0,0,0), dX/dxi1 = (0,h1,0) and 0 for the mixed derivative
+  const int nDofsPerNode = FunctionSpaceType::nDofsPerNode();
+  std::vector<Vec3> geometryValues;
+  functionSpace->geometryField().getValuesWithoutGhosts(geometryValues);
+  ASSERT_EQ(geometryValues.size(), 9u*nDofsPerNode);
+
+  std::vector<double> values;
+  for (int nodeNo = 0; nodeNo < 9; nodeNo++)
+  {
+    const double x = geometryValues[nodeNo*nDofsPerNode][0];
+    const double y = geometryValues[nodeNo*nDofsPerNode][1];
+    const double h0 = geometryValues[nodeNo*nDofsPerNode + 1][0];
+    const double h1 = geometryValues[nodeNo*nDofsPerNode + 2][1];
+    EXPECT_NEAR(h0, 0.5, 1e-12);
+    EXPECT_NEAR(h1, 1.5, 1e-12);
+
+    values.push_back(x*y);
+    values.push_back(h0*y);
+    values.push_back(h1*x);
+    values.push_back(h0*h1);
+  }
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>> solution = functionSpace->template createFieldVariable<1>("solution");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,2>> gradient = functionSpace->template createFieldVariable<2>("gradient");
+  solution->setValuesWithoutGhosts(values);
+
+  solution->computeGradientField(gradient);
+
+  std::vector<std::array<double,2>> gradientValues;
+  gradient->getValuesWithoutGhosts(gradientValues);
+  ASSERT_EQ(gradientValues.size(), geometryValues.size());
+
+  // check the gradient at the node positions, the first dof of every node
+  for (int nodeNo = 0; nodeNo < 9; nodeNo++)
+  {
+    const double x = geometryValues[nodeNo*nDofsPerNode][0];
+    const double y = geometryValues[nodeNo*nDofsPerNode][1];
+    EXPECT_NEAR(gradientValues[nodeNo*nDofsPerNode][0], y, 1e-10) << "node " << nodeNo;
+    EXPECT_NEAR(gradientValues[nodeNo*nDofsPerNode][1], x, 1e-10) << "node " << nodeNo;
+  }
+}
+
 }  // namespace
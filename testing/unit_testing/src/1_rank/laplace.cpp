@@ -63,6 +63,62 @@ config = {
   StiffnessMatrixTester::checkDirichletBCInSolution(equationDiscretized, dirichletBC);
 }
 
+// the prefactor is parsed in the constructor, changing it in the python config afterwards has no effect on the stiffness matrix
+TEST(LaplaceTest, PrefactorIsParsedAtConstruction)
+{
+  std::string pythonConfig = R"(
+# Laplace 1D
+n = 5
+
+# boundary conditions
+bc = {}
+bc[0] = 1.0
+bc[n] = 0.0
+
+config = {
+  "FiniteElementMethod": {
+    "nElements": n,
+    "physicalExtent": 4.0,
+    "dirichletBoundaryConditions": bc,
+    "relativeTolerance": 1e-15,
+    "prefactor": 2.0,
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  FiniteElementMethod<
+    Mesh::StructuredRegularFixedOfDimension<1>,
+    BasisFunction::LagrangeOfOrder<>,
+    Quadrature::None,
+    Equation::Static::Laplace
+  > equationDiscretized(settings);
+
+  // change the prefactor in the python dict after construction, the stiffness matrix is assembled later in run()
+  PyObject *finiteElementMethodSettings = settings["FiniteElementMethod"].getPythonConfig().pyObject();
+  PyObject *newPrefactor = PyFloat_FromDouble(5.0);
+  PyDict_SetItemString(finiteElementMethodSettings, "prefactor", newPrefactor);
+  Py_CLEAR(newPrefactor);
+  ASSERT_EQ(settings["FiniteElementMethod"].getPythonConfig().getOptionDouble("prefactor", 1.0), 5.0);
+
+  equationDiscretized.run();
+
+  // the same matrix as in MatrixIsCorrect1DSmall, scaled by the prefactor 2 except for the dirichlet boundary condition rows
+  std::vector<double> referenceMatrix = {
+    1, 0, 0, 0, 0, 0,
+    0, -5.0, 2.5, 0, 0, 0,
+    0, 2.5, -5.0, 2.5, 0, 0,
+    0, 0, 2.5, -5.0, 2.5, 0,
+    0, 0, 0, 2.5, -5.0, 0,
+    0, 0, 0, 0, 0, 1
+  };
+  std::map<int, double> dirichletBC = {{0, 1.0}, {5,0.0}};
+
+  StiffnessMatrixTester::compareMatrix(equationDiscretized, referenceMatrix);
+  StiffnessMatrixTester::checkDirichletBCInSolution(equationDiscretized, dirichletBC);
+}
+
 TEST(LaplaceTest, MatrixIsCorrect1DBig)
 {
   std::string pythonConfig = R"(
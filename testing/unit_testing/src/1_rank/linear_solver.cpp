@@ -0,0 +1,311 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+namespace Solver
+{
+
+//! settings of linear solvers that only differ in the initial guess and the reuse of the preconditioner
+std::string linearSolverConfig()
+{
+  return R"(
+def solver_config(initial_guess, preconditioner_type="none", preconditioner_refresh_factor=0.0):
+  return {
+    "solverType": "gmres",
+    "preconditionerType": preconditioner_type,
+    "relativeTolerance": 1e-10,
+    "maxIterations": 1000,
+    "initialGuess": initial_guess,
+    "preconditionerRefreshFactor": preconditioner_refresh_factor,
+  }
+
+config = {
+  "default": solver_config("default"),
+  "previous": solver_config("previous"),
+  "extrapolate": solver_config("extrapolate"),
+  "refresh": solver_config("default", "lu", 1.5),
+  "gmresRestart": dict(solver_config("default"), restart=10, maxIterations=10000),
+  "dgmres": dict(solver_config("default"), solverType="dgmres", restart=10, maxIterations=10000, nDeflationEigenvalues=2, maxDeflationEigenvalues=10),
+}
+)";
+}
+
+//! create the matrix of the 1D finite difference Laplacian with nRows rows, i.e. 2 on the main diagonal and -1 on the off-diagonals
+Mat createLaplaceMatrix(int nRows)
+{
+  Mat matrix;
+  MatCreateAIJ(MPI_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, nRows, nRows, 3, NULL, 0, NULL, &matrix);
+  for (int rowNo = 0; rowNo < nRows; rowNo++)
+  {
+    if (rowNo > 0)
+      MatSetValue(matrix, rowNo, rowNo-1, -1.0, INSERT_VALUES);
+    MatSetValue(matrix, rowNo, rowNo, 2.0, INSERT_VALUES);
+    if (rowNo < nRows-1)
+      MatSetValue(matrix, rowNo, rowNo+1, -1.0, INSERT_VALUES);
+  }
+  MatAssemblyBegin(matrix, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(matrix, MAT_FINAL_ASSEMBLY);
+  return matrix;
+}
+
+//! create the matrix of two coupled blocks of size nRowsBlock, the diagonal blocks are 1D Laplacians with a shift and differently scaled,
+//! the off-diagonal blocks are small multiples of the identity
+Mat createBlockMatrix(int nRowsBlock)
+{
+  const double blockScaling[2] = {1.0, 10.0};
+  const double shift = 0.1;
+  const double coupling = 0.01;
+
+  Mat matrix;
+  MatCreateAIJ(MPI_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, 2*nRowsBlock, 2*nRowsBlock, 4, NULL, 0, NULL, &matrix);
+  for (int blockNo = 0; blockNo < 2; blockNo++)
+  {
+    for (int i = 0; i < nRowsBlock; i++)
+    {
+      const int rowNo = blockNo*nRowsBlock + i;
+      if (i > 0)
+        MatSetValue(matrix, rowNo, rowNo-1, -blockScaling[blockNo], INSERT_VALUES);
+      MatSetValue(matrix, rowNo, rowNo, 2.0*blockScaling[blockNo] + shift, INSERT_VALUES);
+      if (i < nRowsBlock-1)
+        MatSetValue(matrix, rowNo, rowNo+1, -blockScaling[blockNo], INSERT_VALUES);
+
+      // coupling to the same row of the other block
+      MatSetValue(matrix, rowNo, (1-blockNo)*nRowsBlock + i, coupling, INSERT_VALUES);
+    }
+  }
+  MatAssemblyBegin(matrix, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(matrix, MAT_FINAL_ASSEMBLY);
+  return matrix;
+}
+
+//! create a right hand side that is not an eigenvector of the Laplacian, scaled by factor
+Vec createRightHandSide(int nRows, double factor)
+{
+  Vec rightHandSide;
+  VecCreateMPI(MPI_COMM_WORLD, PETSC_DECIDE, nRows, &rightHandSide);
+  for (int rowNo = 0; rowNo < nRows; rowNo++)
+  {
+    VecSetValue(rightHandSide, rowNo, factor*(1.0 + rowNo % 3), INSERT_VALUES);
+  }
+  VecAssemblyBegin(rightHandSide);
+  VecAssemblyEnd(rightHandSide);
+  return rightHandSide;
+}
+
+// with "initialGuess": "previous", the second solve of the same system starts at the solution, a new solution vector has its own history
+TEST(LinearSolverTest, InitialGuessPrevious)
+{
+  DihuContext settings(argc, argv, linearSolverConfig());
+
+  const int nRows = 20;
+  Mat matrix = createLaplaceMatrix(nRows);
+  Vec rightHandSide = createRightHandSide(nRows, 1.0);
+
+  for (std::string solverName : std::vector<std::string>{"default", "previous"})
+  {
+    Linear solver(settings[solverName].getPythonConfig(), MPI_COMM_WORLD, solverName);
+    KSPSetOperators(*solver.ksp(), matrix, matrix);
+
+    Vec solution;
+    VecDuplicate(rightHandSide, &solution);
+
+    solver.solve(rightHandSide, solution);
+    const int nIterationsFirstSolve = solver.lastNumberOfIterations();
+    EXPECT_GT(nIterationsFirstSolve, 1) << solverName;
+    EXPECT_EQ((int)solver.residualHistory().size(), nIterationsFirstSolve+1) << solverName;
+
+    solver.solve(rightHandSide, solution);
+    if (solverName == "default")
+    {
+      EXPECT_EQ(solver.lastNumberOfIterations(), nIterationsFirstSolve);
+    }
+    else
+    {
+      EXPECT_LE(solver.lastNumberOfIterations(), 1);
+    }
+
+    // a new vector, possibly at the same address, does not use the history of the destroyed vector
+    VecDestroy(&solution);
+    VecDuplicate(rightHandSide, &solution);
+    solver.solve(rightHandSide, solution);
+    EXPECT_EQ(solver.lastNumberOfIterations(), nIterationsFirstSolve) << solverName;
+
+    VecDestroy(&solution);
+  }
+
+  VecDestroy(&rightHandSide);
+  MatDestroy(&matrix);
+}
+
+// for right hand sides that grow linearly, the extrapolation of the last two solutions is the exact solution
+TEST(LinearSolverTest, InitialGuessExtrapolate)
+{
+  DihuContext settings(argc, argv, linearSolverConfig());
+
+  const int nRows = 20;
+  Mat matrix = createLaplaceMatrix(nRows);
+
+  std::map<std::string,int> nIterationsThirdSolve;
+  for (std::string solverName : std::vector<std::string>{"previous", "extrapolate"})
+  {
+    Linear solver(settings[solverName].getPythonConfig(), MPI_COMM_WORLD, solverName);
+    KSPSetOperators(*solver.ksp(), matrix, matrix);
+
+    Vec solution;
+    VecCreateMPI(MPI_COMM_WORLD, PETSC_DECIDE, nRows, &solution);
+
+    for (int solveNo = 1; solveNo <= 3; solveNo++)
+    {
+      Vec rightHandSide = createRightHandSide(nRows, solveNo);
+      solver.solve(rightHandSide, solution);
+      VecDestroy(&rightHandSide);
+    }
+    nIterationsThirdSolve[solverName] = solver.lastNumberOfIterations();
+
+    VecDestroy(&solution);
+  }
+
+  // the previous solution has a relative residual of 1/3, the extrapolated solution is exact up to the solver tolerances of the previous solves
+  EXPECT_GT(nIterationsThirdSolve["previous"], 2);
+  EXPECT_LE(nIterationsThirdSolve["extrapolate"], 2);
+
+  MatDestroy(&matrix);
+}
+
+// with "preconditionerRefreshFactor", the LU factorization is reused for a changed matrix until the number of iterations increases, then it is rebuilt
+TEST(LinearSolverTest, PreconditionerRefresh)
+{
+  DihuContext settings(argc, argv, linearSolverConfig());
+
+  const int nRows = 20;
+  Mat matrix = createLaplaceMatrix(nRows);
+  Vec rightHandSide = createRightHandSide(nRows, 1.0);
+  Vec solution;
+  VecDuplicate(rightHandSide, &solution);
+
+  Linear solver(settings["refresh"].getPythonConfig(), MPI_COMM_WORLD, "refresh");
+  KSPSetOperators(*solver.ksp(), matrix, matrix);
+
+  // the exact preconditioner needs one iteration, this is the reference number of iterations
+  solver.solve(rightHandSide, solution);
+  EXPECT_EQ(solver.lastNumberOfIterations(), 1);
+
+  // change the diagonal of the matrix, the factorization of the old matrix is reused and needs more iterations
+  for (int rowNo = 0; rowNo < nRows; rowNo++)
+  {
+    MatSetValue(matrix, rowNo, rowNo, 2.0 + 0.5*rowNo, INSERT_VALUES);
+  }
+  MatAssemblyBegin(matrix, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(matrix, MAT_FINAL_ASSEMBLY);
+
+  solver.solve(rightHandSide, solution);
+  EXPECT_GT(solver.lastNumberOfIterations(), 1);
+
+  // this exceeds 1.5 times the reference, the next solve rebuilds the factorization and needs one iteration again
+  solver.solve(rightHandSide, solution);
+  EXPECT_EQ(solver.lastNumberOfIterations(), 1);
+
+  VecDestroy(&solution);
+  VecDestroy(&rightHandSide);
+  MatDestroy(&matrix);
+}
+
+// the field split preconditioners with exact solves of the diagonal blocks converge in fewer iterations than GMRES without preconditioner
+TEST(LinearSolverTest, BlockPreconditioner)
+{
+  DihuContext settings(argc, argv, linearSolverConfig());
+
+  const int nRowsBlock = 30;
+  Mat matrix = createBlockMatrix(nRowsBlock);
+  Vec rightHandSide = createRightHandSide(2*nRowsBlock, 1.0);
+
+  std::vector<IS> indexSets(2);
+  for (int blockNo = 0; blockNo < 2; blockNo++)
+  {
+    ISCreateStride(MPI_COMM_WORLD, nRowsBlock, blockNo*nRowsBlock, 1, &indexSets[blockNo]);
+  }
+
+  // reference without preconditioner
+  int nIterationsWithoutPreconditioner = 0;
+  {
+    Linear solver(settings["default"].getPythonConfig(), MPI_COMM_WORLD, "default");
+    KSPSetOperators(*solver.ksp(), matrix, matrix);
+
+    Vec solution;
+    VecDuplicate(rightHandSide, &solution);
+    solver.solve(rightHandSide, solution);
+    nIterationsWithoutPreconditioner = solver.lastNumberOfIterations();
+    VecDestroy(&solution);
+  }
+
+  for (std::string blockPreconditionerType : std::vector<std::string>{"additive", "multiplicative", "schur"})
+  {
+    Linear solver(settings["default"].getPythonConfig(), MPI_COMM_WORLD, "default");
+    KSPSetOperators(*solver.ksp(), matrix, matrix);
+    solver.initializeBlockPreconditioner(blockPreconditionerType, "lower", std::vector<std::string>{"block0", "block1"}, indexSets,
+                                         std::vector<std::string>{"lu", "lu"});
+
+    Vec solution;
+    VecDuplicate(rightHandSide, &solution);
+    solver.solve(rightHandSide, solution);
+
+    KSPConvergedReason convergedReason;
+    KSPGetConvergedReason(*solver.ksp(), &convergedReason);
+    EXPECT_GT(convergedReason, 0) << blockPreconditionerType;
+
+    // the coupling is 1/10 of the smallest eigenvalue of the diagonal blocks, the preconditioned residual decreases at least by 1/10 per iteration
+    EXPECT_LE(solver.lastNumberOfIterations(), 10) << blockPreconditionerType;
+    EXPECT_LT(solver.lastNumberOfIterations(), nIterationsWithoutPreconditioner) << blockPreconditionerType;
+
+    VecDestroy(&solution);
+  }
+
+  for (IS &indexSet : indexSets)
+    ISDestroy(&indexSet);
+  VecDestroy(&rightHandSide);
+  MatDestroy(&matrix);
+}
+
+// deflated GMRES removes the smallest eigenvalues of the Laplacian that slow down the restarted GMRES
+TEST(LinearSolverTest, DeflatedGmres)
+{
+  DihuContext settings(argc, argv, linearSolverConfig());
+
+  const int nRows = 50;
+  Mat matrix = createLaplaceMatrix(nRows);
+  Vec rightHandSide = createRightHandSide(nRows, 1.0);
+
+  std::map<std::string,int> nIterations;
+  for (std::string solverName : std::vector<std::string>{"gmresRestart", "dgmres"})
+  {
+    Linear solver(settings[solverName].getPythonConfig(), MPI_COMM_WORLD, solverName);
+    KSPSetOperators(*solver.ksp(), matrix, matrix);
+
+    Vec solution;
+    VecDuplicate(rightHandSide, &solution);
+    solver.solve(rightHandSide, solution);
+    nIterations[solverName] = solver.lastNumberOfIterations();
+
+    if (solverName == "dgmres")
+    {
+      KSPConvergedReason convergedReason;
+      KSPGetConvergedReason(*solver.ksp(), &convergedReason);
+      EXPECT_GT(convergedReason, 0);
+    }
+    VecDestroy(&solution);
+  }
+
+  // both use a restart length of 10
+  EXPECT_LT(nIterations["dgmres"], nIterations["gmresRestart"]);
+
+  VecDestroy(&rightHandSide);
+  MatDestroy(&matrix);
+}
+
+}  // namespace
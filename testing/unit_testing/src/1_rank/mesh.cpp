@@ -229,4 +229,250 @@ config = {
   
 }
 
+TEST(MeshTest, ElementSearchGridFindsCandidateElements)
+{
+  // 4x4 unit square elements in the plane z=0, element no = y*4 + x
+  std::vector<std::array<Vec3,2>> boundingBoxes;
+  for (int y = 0; y < 4; y++)
+  {
+    for (int x = 0; x < 4; x++)
+    {
+      boundingBoxes.push_back(std::array<Vec3,2>({Vec3({double(x), double(y), 0.0}), Vec3({double(x+1), double(y+1), 0.0})}));
+    }
+  }
+
+  FunctionSpace::ElementSearchGrid elementSearchGrid;
+  ASSERT_FALSE(elementSearchGrid.initialized());
+  elementSearchGrid.initialize(boundingBoxes);
+  ASSERT_TRUE(elementSearchGrid.initialized());
+
+  // point in the interior of element 6
+  std::vector<element_no_t> candidateElements = elementSearchGrid.candidateElements(Vec3({2.5, 1.5, 0.0}));
+  ASSERT_EQ(candidateElements.size(), 1u);
+  ASSERT_EQ(candidateElements[0], 6);
+
+  // point on the corner of elements 5, 6, 9 and 10
+  candidateElements = elementSearchGrid.candidateElements(Vec3({2.0, 2.0, 0.0}));
+  std::sort(candidateElements.begin(), candidateElements.end());
+  ASSERT_EQ(candidateElements, std::vector<element_no_t>({5, 6, 9, 10}));
+
+  // point slightly above the plane, the margin of the flat bounding boxes is relative to the largest extent of the element and also applies in z direction
+  candidateElements = elementSearchGrid.candidateElements(Vec3({2.5, 1.5, 0.05}));
+  ASSERT_EQ(candidateElements.size(), 1u);
+  ASSERT_EQ(candidateElements[0], 6);
+
+  // points outside of the mesh
+  ASSERT_TRUE(elementSearchGrid.candidateElements(Vec3({5.0, 1.0, 0.0})).empty());
+  ASSERT_TRUE(elementSearchGrid.candidateElements(Vec3({1.0, 1.0, 1.0})).empty());
+
+  elementSearchGrid.invalidate();
+  ASSERT_FALSE(elementSearchGrid.initialized());
+}
+
+// move the nodes of a deformable mesh, the element geometry cache, the element bounding boxes and the search grid of findPosition have to be updated
+TEST(MeshTest, ElementGeometryCacheIsUpdatedWhenNodesMove)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Domain": {
+    "nElements": [2, 2, 2],
+    "physicalExtent": [2.0, 2.0, 2.0],
+    "inputMeshIsGlobal": True,
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  std::shared_ptr<FunctionSpaceType> functionSpace = settings.meshManager()->functionSpace<FunctionSpaceType>(settings["Domain"].getPythonConfig());
+
+  // element 7 is [1,2]^3, its first node is (1,1,1) and its last node is (2,2,2)
+  const element_no_t elementNo = 7;
+  std::array<Vec3,8> elementGeometry;
+  functionSpace->getElementGeometry(elementNo, elementGeometry);
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_NEAR(elementGeometry[0][i], 1.0, 1e-12);
+    EXPECT_NEAR(elementGeometry[7][i], 2.0, 1e-12);
+    EXPECT_NEAR(functionSpace->elementBoundingBoxes()[elementNo][0][i], 1.0, 1e-12);
+    EXPECT_NEAR(functionSpace->elementBoundingBoxes()[elementNo][1][i], 2.0, 1e-12);
+  }
+
+  element_no_t foundElementNo = 0;
+  int ghostMeshNo = -1;
+  std::array<double,3> xi;
+  ASSERT_TRUE(functionSpace->findPosition(Vec3({0.5, 0.5, 0.5}), foundElementNo, ghostMeshNo, xi, false));
+  EXPECT_EQ(foundElementNo, 0);
+
+  // move the nodes, x -> 2x+1, z -> z+0.5
+  PetscObjectState geometryStateBefore = functionSpace->geometryState();
+  std::vector<Vec3> positions;
+  functionSpace->geometryField().getValuesWithoutGhosts(positions);
+  for (Vec3 &position : positions)
+  {
+    position[0] = 2*position[0] + 1;
+    position[2] += 0.5;
+  }
+  functionSpace->geometryField().setValuesWithoutGhosts(positions);
+  EXPECT_NE(functionSpace->geometryState(), geometryStateBefore);
+
+  // the cached element geometry and the bounding boxes have the new positions, element 7 is now [3,5]x[1,2]x[1.5,2.5]
+  Vec3 newMinimum({3.0, 1.0, 1.5});
+  Vec3 newMaximum({5.0, 2.0, 2.5});
+  functionSpace->getElementGeometry(elementNo, elementGeometry);
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_NEAR(elementGeometry[0][i], newMinimum[i], 1e-12);
+    EXPECT_NEAR(elementGeometry[7][i], newMaximum[i], 1e-12);
+    EXPECT_NEAR(functionSpace->elementBoundingBoxes()[elementNo][0][i], newMinimum[i], 1e-12);
+    EXPECT_NEAR(functionSpace->elementBoundingBoxes()[elementNo][1][i], newMaximum[i], 1e-12);
+  }
+
+  // findPosition uses the new geometry, the old position of element 0 is now outside of the mesh
+  ASSERT_TRUE(functionSpace->findPosition(Vec3({4.0, 1.5, 2.0}), foundElementNo, ghostMeshNo, xi, false));
+  EXPECT_EQ(foundElementNo, elementNo);
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_NEAR(xi[i], 0.5, 1e-8);
+  }
+  EXPECT_FALSE(functionSpace->findPosition(Vec3({0.5, 0.5, 0.5}), foundElementNo, ghostMeshNo, xi, false));
+}
+
+// map a linear field from a 3D mesh to a fiber and a constant field from the fiber back to the 3D mesh, using the transfer of the operator splittings
+TEST(MeshTest, MappingBetweenMeshesTransfersFields)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Meshes": {
+    "Mesh3D": {
+      "nElements": [2, 2, 2],
+      "physicalExtent": [2.0, 2.0, 2.0],
+      "inputMeshIsGlobal": True,
+    },
+    "MeshFibre": {
+      "nElements": [3],
+      "nodePositions": [[0.5, 0.5, 0.2], [0.6, 0.7, 0.7], [0.7, 0.9, 1.2], [0.8, 1.1, 1.7]],
+      "inputMeshIsGlobal": True,
+    },
+  },
+  "MappingsBetweenMeshes": {
+    "Mesh3D": "MeshFibre",
+    "MeshFibre": "Mesh3D",
+  },
+  "Domain": {"meshName": "Mesh3D"},
+  "Fibre": {"meshName": "MeshFibre"},
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<3>, BasisFunction::LagrangeOfOrder<1>> FunctionSpace3D;
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceFibre;
+
+  std::shared_ptr<FunctionSpace3D> functionSpace3D = settings.meshManager()->functionSpace<FunctionSpace3D>(settings["Domain"].getPythonConfig());
+  std::shared_ptr<FunctionSpaceFibre> functionSpaceFibre = settings.meshManager()->functionSpace<FunctionSpaceFibre>(settings["Fibre"].getPythonConfig());
+  settings.meshManager()->initializeMappingsBetweenMeshes<FunctionSpaceFibre,FunctionSpace3D>(functionSpaceFibre, functionSpace3D);
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,1>> fieldVariable3D = functionSpace3D->template createFieldVariable<1>("values3D");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceFibre,2>> fieldVariableFibre = functionSpaceFibre->template createFieldVariable<2>("valuesFibre");
+
+  // a linear field is interpolated exactly by the trilinear basis functions
+  auto linearField = [](const Vec3 &position)
+  {
+    return 1.0 + position[0] + 2*position[1] + 3*position[2];
+  };
+
+  std::vector<Vec3> positions3D;
+  functionSpace3D->geometryField().getValuesWithoutGhosts(positions3D);
+  std::vector<double> values3D;
+  for (const Vec3 &position : positions3D)
+    values3D.push_back(linearField(position));
+  fieldVariable3D->setValuesWithoutGhosts(values3D);
+
+  // 3D -> fiber, the fiber nodes get the interpolated values, with prefactor 1
+  typedef std::tuple<std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,1>>,int,double> TransferableSolutionData3D;
+  typedef std::tuple<std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceFibre,2>>,int,double> TransferableSolutionDataFibre;
+
+  SolutionVectorMapping<TransferableSolutionData3D,TransferableSolutionDataFibre>::transfer(
+    TransferableSolutionData3D(fieldVariable3D, 0, 1.0), TransferableSolutionDataFibre(fieldVariableFibre, 1, 1.0));
+
+  std::vector<Vec3> positionsFibre;
+  functionSpaceFibre->geometryField().getValuesWithoutGhosts(positionsFibre);
+  std::vector<double> valuesFibre;
+  fieldVariableFibre->getValuesWithoutGhosts(1, valuesFibre);
+
+  ASSERT_EQ(valuesFibre.size(), 4u);
+  for (int i = 0; i < valuesFibre.size(); i++)
+  {
+    EXPECT_NEAR(valuesFibre[i], linearField(positionsFibre[i]), 1e-12);
+  }
+
+  // fiber -> 3D with prefactor 2, the nodes of the 3D elements that contain fiber nodes get the average of their contributions,
+  // the fiber lies in the elements (0,0,0), (0,0,1) and (0,1,1), all other nodes get 0
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceFibre,1>> constantFibre = functionSpaceFibre->template createFieldVariable<1>("constantFibre");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,2>> result3D = functionSpace3D->template createFieldVariable<2>("result3D");
+  constantFibre->setValuesWithoutGhosts(std::vector<double>(4, 3.0));
+
+  typedef std::tuple<std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceFibre,1>>,int,double> TransferableSolutionDataConstantFibre;
+  typedef std::tuple<std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,2>>,int,double> TransferableSolutionDataResult3D;
+
+  SolutionVectorMapping<TransferableSolutionDataConstantFibre,TransferableSolutionDataResult3D>::transfer(
+    TransferableSolutionDataConstantFibre(constantFibre, 0, 2.0), TransferableSolutionDataResult3D(result3D, 1, 1.0));
+
+  result3D->getValuesWithoutGhosts(1, values3D);
+  ASSERT_EQ(values3D.size(), 27u);
+  for (int k = 0; k < 3; k++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        bool hasContribution = (i <= 1 && (j <= 1 || k >= 1));
+        EXPECT_NEAR(values3D[k*9 + j*3 + i], (hasContribution? 6.0 : 0.0), 1e-12) << "node (" << i << "," << j << "," << k << ")";
+      }
+    }
+  }
+}
+
+TEST(MeshTest, HarmonicMapMeshReproducesAffineGrid)
+{
+  // the border points of a parallelogram in the plane z=1, the harmonic map of an affine mapping is the affine mapping itself
+  const int nNodes = 5;
+  auto affineMapping = [](double u, double v)
+  {
+    return Vec3({4*u + v, 2*v, 1.0});
+  };
+
+  std::array<std::vector<Vec3>,4> borderPoints;
+  for (int k = 0; k < nNodes; k++)
+  {
+    double t = double(k) / (nNodes-1);
+    borderPoints[Mesh::face_t::face0Minus].push_back(affineMapping(0.0, t));
+    borderPoints[Mesh::face_t::face0Plus].push_back(affineMapping(1.0, t));
+    borderPoints[Mesh::face_t::face1Minus].push_back(affineMapping(t, 0.0));
+    borderPoints[Mesh::face_t::face1Plus].push_back(affineMapping(t, 1.0));
+  }
+
+  std::array<const std::vector<Vec3> *,4> borderPointsPointers;
+  for (int face = 0; face < 4; face++)
+    borderPointsPointers[face] = &borderPoints[face];
+
+  std::vector<Vec3> nodePositions;
+  Postprocessing::HarmonicMapMesh::createPlanarMesh(borderPointsPointers, nNodes, nNodes, nodePositions);
+
+  ASSERT_EQ(nodePositions.size(), nNodes*nNodes);
+  for (int j = 0; j < nNodes; j++)
+  {
+    for (int i = 0; i < nNodes; i++)
+    {
+      Vec3 reference = affineMapping(double(i) / (nNodes-1), double(j) / (nNodes-1));
+      for (int k = 0; k < 3; k++)
+      {
+        EXPECT_NEAR(nodePositions[j*nNodes + i][k], reference[k], 1e-10);
+      }
+    }
+  }
+}
+
 } // namespace
@@ -3,12 +3,14 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <cmath>
 
 #include "gtest/gtest.h"
 #include "opendihu.h"
 #include "utility/petsc_utility.h"
 #include "arg.h"
 #include "stiffness_matrix_tester.h"
+#include "function_space/basis_on_quadrature.h"
 
 namespace SpatialDiscretization
 {
@@ -594,5 +596,115 @@ config = {
   equationDiscretized7.run(); 
 }
 */
-} // namespace
 
+// 2D with linear Lagrange basis functions, such that the test is cheap to compile
+// compare the sum factorization kernels of BasisOnQuadrature with the direct evaluation of the basis functions at the quadrature points,
+// the number of 1D basis functions and the number of 1D quadrature points can be different, then the 1D tables are rectangular
+template<typename FunctionSpaceType, typename QuadratureType>
+void checkBasisOnQuadratureSumFactorization()
+{
+  const int D = FunctionSpaceType::dim();
+  typedef FunctionSpace::BasisOnQuadrature<FunctionSpaceType,QuadratureType> BasisOnQuadratureType;
+  typedef Quadrature::TensorProduct<D,QuadratureType> QuadratureDD;
+
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+  const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+
+  std::array<std::array<double,D>,nQuadraturePoints> samplingPoints = QuadratureDD::samplingPoints();
+
+  // arbitrary dof values
+  std::array<double,nDofsPerElement> dofValues;
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    dofValues[dofIndex] = std::sin(1.0 + 0.7*dofIndex);
+
+  // interpolation by sum factorization has to match the direct evaluation of the basis functions
+  std::array<double,nQuadraturePoints> values;
+  BasisOnQuadratureType::interpolate(dofValues, values);
+
+  for (int q = 0; q < nQuadraturePoints; q++)
+  {
+    double value = 0;
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      value += dofValues[dofIndex] * FunctionSpaceType::phi(dofIndex, samplingPoints[q]);
+    EXPECT_NEAR(values[q], value, 1e-12) << "quadrature point " << q;
+  }
+
+  for (int derivativeDirection = 0; derivativeDirection < D; derivativeDirection++)
+  {
+    std::array<double,nQuadraturePoints> derivativeValues;
+    BasisOnQuadratureType::interpolateDerivative(derivativeDirection, dofValues, derivativeValues);
+
+    for (int q = 0; q < nQuadraturePoints; q++)
+    {
+      double derivativeValue = 0;
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+        derivativeValue += dofValues[dofIndex] * FunctionSpaceType::dphi_dxi(dofIndex, derivativeDirection, samplingPoints[q]);
+      EXPECT_NEAR(derivativeValues[q], derivativeValue, 1e-12) << "quadrature point " << q << ", derivative direction " << derivativeDirection;
+    }
+  }
+
+  // integration against the basis functions and their derivatives has to match the tensor product quadrature
+  std::array<double,nDofsPerElement> integrals;
+  BasisOnQuadratureType::integrate(values, integrals);
+
+  std::array<std::array<double,nDofsPerElement>,D> derivativeIntegrals;
+  for (int derivativeDirection = 0; derivativeDirection < D; derivativeDirection++)
+    BasisOnQuadratureType::integrateDerivative(derivativeDirection, values, derivativeIntegrals[derivativeDirection]);
+
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+  {
+    std::array<double,nQuadraturePoints> evaluations;
+    for (int q = 0; q < nQuadraturePoints; q++)
+      evaluations[q] = values[q] * FunctionSpaceType::phi(dofIndex, samplingPoints[q]);
+    EXPECT_NEAR(integrals[dofIndex], QuadratureDD::computeIntegral(evaluations), 1e-12) << "dof " << dofIndex;
+
+    for (int derivativeDirection = 0; derivativeDirection < D; derivativeDirection++)
+    {
+      for (int q = 0; q < nQuadraturePoints; q++)
+        evaluations[q] = values[q] * FunctionSpaceType::dphi_dxi(dofIndex, derivativeDirection, samplingPoints[q]);
+      EXPECT_NEAR(derivativeIntegrals[derivativeDirection][dofIndex], QuadratureDD::computeIntegral(evaluations), 1e-12)
+        << "dof " << dofIndex << ", derivative direction " << derivativeDirection;
+    }
+  }
+}
+
+TEST(NumericalIntegrationTest, BasisOnQuadratureSumFactorizationIsCorrect)
+{
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<2>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  typedef Quadrature::Gauss<2> QuadratureType;
+  typedef FunctionSpace::BasisOnQuadrature<FunctionSpaceType,QuadratureType> BasisOnQuadratureType;
+  typedef Quadrature::TensorProduct<2,QuadratureType> QuadratureDD;
+
+  checkBasisOnQuadratureSumFactorization<FunctionSpaceType,QuadratureType>();
+
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+  const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+
+  // the geometry can be interpolated with the same kernel, the derivative of an affine geometry is constant
+  std::array<Vec3,nDofsPerElement> geometry;
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+  {
+    const double x = dofIndex % 2, y = dofIndex / 2;
+    geometry[dofIndex] = Vec3({2.0*x, 3.0*y + x, 0.0});
+  }
+  std::array<Vec3,nQuadraturePoints> jacobianColumn0;
+  BasisOnQuadratureType::interpolateDerivative(0, geometry, jacobianColumn0);
+  for (int q = 0; q < nQuadraturePoints; q++)
+  {
+    EXPECT_NEAR(jacobianColumn0[q][0], 2.0, 1e-12);
+    EXPECT_NEAR(jacobianColumn0[q][1], 1.0, 1e-12);
+    EXPECT_NEAR(jacobianColumn0[q][2], 0.0, 1e-12);
+  }
+}
+
+// rectangular 1D tables: more quadrature points than basis functions per direction (quadratic with Gauss<4>),
+// fewer quadrature points than basis functions (Hermite with Gauss<3>) and 3D
+TEST(NumericalIntegrationTest, BasisOnQuadratureSumFactorizationIsCorrectRectangular)
+{
+  checkBasisOnQuadratureSumFactorization<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<2>, BasisFunction::LagrangeOfOrder<2>>, Quadrature::Gauss<4>>();
+  checkBasisOnQuadratureSumFactorization<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<2>, BasisFunction::Hermite>, Quadrature::Gauss<3>>();
+  checkBasisOnQuadratureSumFactorization<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>, BasisFunction::LagrangeOfOrder<2>>, Quadrature::Gauss<2>>();
+  checkBasisOnQuadratureSumFactorization<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>, BasisFunction::Hermite>, Quadrature::Gauss<5>>();
+}
+
+} // namespace
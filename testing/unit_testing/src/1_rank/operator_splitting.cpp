@@ -228,3 +228,270 @@ config = {
   problem.run();
 }
 */
+
+// Strang splitting with "transferAfterTimeSpan" has to give the same result as without, also for a prefactor != 1
+TEST(OperatorSplittingTest, StrangTransferAfterTimeSpan)
+{
+  std::string pythonConfigCommon = R"(
+Conductivity = 3.828    # sigma, conductivity [mS/cm]
+Am = 500.0              # surface area to volume ratio [cm^-1]
+Cm = 0.58               # membrane capacitance [uF/cm^2]
+
+config = {
+  "Meshes": {
+    "MeshFibre": {
+      "nElements": 4,
+      "physicalExtent": 0.4,
+      "inputMeshIsGlobal": True,
+    },
+  },
+  "Solvers": {
+    "implicitSolver": {
+      "relativeTolerance": 1e-15,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+    }
+  },
+  "StrangSplitting": {
+    "timeStepWidth": 1e-2,
+    "endTime": 0.1,
+    "transferAfterTimeSpan": transfer_after_time_span,
+    "Term1": {      # CellML
+      "Heun" : {
+        "timeStepWidth": 5e-3,
+        "initialValues": [],
+        "inputMeshIsGlobal": True,
+        "dirichletBoundaryConditions": {},
+        "CellML" : {
+          "sourceFilename": "../input/hodgkin_huxley_1952.c",
+          "useGivenLibrary": False,
+          "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+          "parametersInitialValues": [0.0],
+          "parametersUsedAsIntermediate": [],
+          "parametersUsedAsConstant": [2],
+          "meshName": "MeshFibre",
+          "prefactor": 0.9,      # the transmembrane potential is scaled by this factor in every transfer to Term2
+        },
+      },
+    },
+    "Term2": {     # Diffusion
+      "ImplicitEuler" : {
+        "initialValues": [],
+        "timeStepWidth": 5e-3,
+        "inputMeshIsGlobal": True,
+        "dirichletBoundaryConditions": {},
+        "solverName": "implicitSolver",
+        "FiniteElementMethod" : {
+          "meshName": "MeshFibre",
+          "prefactor": Conductivity/(Am*Cm),
+          "solverName": "implicitSolver",
+        },
+      },
+    },
+  }
+}
+)";
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  typedef OperatorSplitting::Strang<
+    TimeSteppingScheme::Heun<
+      CellmlAdapter<4,FunctionSpaceType>
+    >,
+    TimeSteppingScheme::ImplicitEuler<
+      SpatialDiscretization::FiniteElementMethod<
+        Mesh::StructuredRegularFixedOfDimension<1>,
+        BasisFunction::LagrangeOfOrder<1>,
+        Quadrature::Gauss<2>,
+        Equation::Dynamic::IsotropicDiffusion
+      >
+    >
+  > ProblemType;
+
+  // advance both problems in two time spans
+  DihuContext settings(argc, argv, "transfer_after_time_span = False\n" + pythonConfigCommon);
+  ProblemType problem(settings);
+  problem.initialize();
+  problem.setTimeSpan(0.0, 0.05);
+  problem.advanceTimeSpan();
+  problem.setTimeSpan(0.05, 0.1);
+  problem.advanceTimeSpan();
+
+  DihuContext settingsTransfer(argc, argv, "transfer_after_time_span = True\n" + pythonConfigCommon);
+  ProblemType problemTransfer(settingsTransfer);
+  problemTransfer.initialize();
+  problemTransfer.setTimeSpan(0.0, 0.05);
+  problemTransfer.advanceTimeSpan();
+  problemTransfer.setTimeSpan(0.05, 0.1);
+  problemTransfer.advanceTimeSpan();
+
+  // without transfer, the result is in Term1, with transfer it has been handed to Term2 without applying the prefactor
+  std::vector<double> values;
+  problem.timeStepping1().data().solution()->getValuesWithoutGhosts(0, values);
+
+  std::vector<double> valuesTransfer;
+  problemTransfer.timeStepping2().data().solution()->getValuesWithoutGhosts(valuesTransfer);
+
+  ASSERT_EQ(values.size(), 5u);
+  ASSERT_EQ(valuesTransfer.size(), values.size());
+  for (int i = 0; i < values.size(); i++)
+  {
+    EXPECT_DOUBLE_EQ(valuesTransfer[i], values[i]);
+  }
+}
+
+// batched Strang splittings of two fibers with "skipWhenQuiescent", the second fiber rests until it is stimulated at t=1,
+// it is skipped until then and afterwards has to give the same solution as without skipping
+TEST(OperatorSplittingTest, StrangSkipQuiescentFibers)
+{
+  std::string pythonConfigCommon = R"(
+Conductivity = 3.828    # sigma, conductivity [mS/cm]
+Am = 500.0              # surface area to volume ratio [cm^-1]
+Cm = 0.58               # membrane capacitance [uF/cm^2]
+
+# steady state of the Hodgkin-Huxley model for I_Stim = 0
+rest_states = [-74.9951235335408, 0.05296292799880796, 0.5959502019928442, 0.31772521708093526]
+firing_times = [[0.0], [1.0]]     # the firing times of the two fibers
+
+def instance_config(fiber_no):
+  return {
+    "ranks": [0],
+    "StrangSplitting": {
+      "timeStepWidth": 1e-2,
+      "endTime": 2.0,
+      "Term1": {      # CellML
+        "Heun" : {
+          "timeStepWidth": 1e-3,
+          "initialValues": [],
+          "inputMeshIsGlobal": True,
+          "dirichletBoundaryConditions": {},
+          "CellML" : {
+            "sourceFilename": "../input/hodgkin_huxley_1952.c",
+            "useGivenLibrary": False,
+            "statesInitialValues": rest_states,
+            "parametersInitialValues": [0.0],
+            "parametersUsedAsIntermediate": [],
+            "parametersUsedAsConstant": [2],
+            "meshName": "MeshFibre{}".format(fiber_no),
+            "stimulationSchedule": [
+              {"parameterNo": 0, "firingTimes": firing_times[fiber_no], "stimulationDuration": 0.1, "value": 400.0, "restValue": 0.0, "dofNos": [2]},
+            ],
+            "skipWhenQuiescent": skip_when_quiescent,
+          },
+        },
+      },
+      "Term2": {     # Diffusion
+        "ImplicitEuler" : {
+          "initialValues": [],
+          "timeStepWidth": 5e-3,
+          "inputMeshIsGlobal": True,
+          "dirichletBoundaryConditions": {},
+          "solverName": "implicitSolver",
+          "FiniteElementMethod" : {
+            "meshName": "MeshFibre{}".format(fiber_no),
+            "prefactor": Conductivity/(Am*Cm),
+            "solverName": "implicitSolver",
+          },
+        },
+      },
+    }
+  }
+
+config = {
+  "Meshes": {
+    "MeshFibre{}".format(fiber_no): {
+      "nElements": 4,
+      "physicalExtent": 0.4,
+      "inputMeshIsGlobal": True,
+    }
+    for fiber_no in range(2)
+  },
+  "Solvers": {
+    "implicitSolver": {
+      "relativeTolerance": 1e-15,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+    }
+  },
+  "MultipleInstances": {
+    "nInstances": 2,
+    "batchInstances": True,
+    "instances": [instance_config(fiber_no) for fiber_no in range(2)],
+  }
+}
+)";
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  typedef Control::MultipleInstances<
+    OperatorSplitting::Strang<
+      TimeSteppingScheme::Heun<
+        CellmlAdapter<4,FunctionSpaceType>
+      >,
+      TimeSteppingScheme::ImplicitEuler<
+        SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredRegularFixedOfDimension<1>,
+          BasisFunction::LagrangeOfOrder<1>,
+          Quadrature::Gauss<2>,
+          Equation::Dynamic::IsotropicDiffusion
+        >
+      >
+    >
+  > ProblemType;
+
+  // the states of both fibers at t=2, once without and once with skipping
+  std::array<std::vector<std::vector<std::array<double,4>>>,2> states;
+  for (int skipWhenQuiescent = 0; skipWhenQuiescent < 2; skipWhenQuiescent++)
+  {
+    DihuContext settings(argc, argv, std::string("skip_when_quiescent = ") + (skipWhenQuiescent? "True" : "False") + "\n" + pythonConfigCommon);
+    ProblemType problem(settings);
+    problem.initialize();
+    ASSERT_EQ(problem.instancesLocal().size(), 2);
+
+    // in the first time steps, the steady state of the second fiber is detected
+    problem.setTimeSpan(0.0, 0.1);
+    problem.advanceTimeSpan();
+
+    std::vector<std::array<double,4>> restingStates;
+    problem.instancesLocal()[1].timeStepping1().data().solution()->getValuesWithoutGhosts(restingStates);
+
+    problem.setTimeSpan(0.1, 0.9);
+    problem.advanceTimeSpan();
+
+    if (skipWhenQuiescent)
+    {
+      // the second fiber has been skipped, its states are unchanged, the first fiber is active
+      std::vector<std::array<double,4>> values;
+      problem.instancesLocal()[1].timeStepping1().data().solution()->getValuesWithoutGhosts(values);
+      EXPECT_EQ(values, restingStates);
+
+      EXPECT_TRUE(problem.instancesLocal()[1].timeStepping1().discretizableInTime().isQuiescent(0.9, 0.91));
+      EXPECT_FALSE(problem.instancesLocal()[0].timeStepping1().discretizableInTime().isQuiescent(0.9, 0.91));
+    }
+
+    // the second fiber is reactivated by its firing time
+    problem.setTimeSpan(0.9, 2.0);
+    problem.advanceTimeSpan();
+
+    for (int fiberNo = 0; fiberNo < 2; fiberNo++)
+    {
+      std::vector<std::array<double,4>> values;
+      problem.instancesLocal()[fiberNo].timeStepping1().data().solution()->getValuesWithoutGhosts(values);
+      ASSERT_EQ(values.size(), 5u);
+      states[skipWhenQuiescent].push_back(values);
+    }
+  }
+
+  // at rest the rates are below 1e-12, therefore the results only differ by the small changes that are not computed while the fiber is skipped
+  for (int fiberNo = 0; fiberNo < 2; fiberNo++)
+  {
+    for (int i = 0; i < 5; i++)
+    {
+      for (int stateNo = 0; stateNo < 4; stateNo++)
+      {
+        EXPECT_NEAR(states[1][fiberNo][i][stateNo], states[0][fiberNo][i][stateNo], 1e-6) << "fiber " << fiberNo << ", node " << i << ", state " << stateNo;
+      }
+    }
+  }
+
+  // the second fiber has fired
+  EXPECT_GT(states[1][1][2][0], -50.0);
+}
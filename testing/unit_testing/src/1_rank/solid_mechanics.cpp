@@ -49,4 +49,92 @@ config = {
   problem.run();*/
 }
 
+//! solve the 2D Mooney-Rivlin incompressible penalty problem of a plate that is fixed at the left and pulled at the right edge, with the given jacobian settings, return the displacements
+std::vector<std::array<double,2>> solveMooneyRivlin2D(std::string jacobianSettings)
+{
+  std::string pythonConfig = R"(
+# 2x2 elements, 3x3 nodes, dof no = 2*node no + component
+# left edge: node 0 fixed in both directions, nodes 3 and 6 fixed in x direction
+dirichletBC = {0: 0.0, 1: 0.0, 6: 0.0, 12: 0.0}
+lx = 1.5
+ly = 0.6
+tmax = 2.2
 
+config = {
+  "FiniteElementMethod" : {
+    "nElements": [2,2],
+    "physicalExtent": [lx,ly],
+    "dirichletBoundaryCondition": dirichletBC,
+    "tractionReferenceConfiguration": [
+      {"element": 1, "face": "0+", "constantValue": tmax/ly},
+      {"element": 3, "face": "0+", "constantValue": tmax/ly},
+    ],
+    "relativeTolerance": 1e-15,
+    "materialParameters": [1.0, 0.0, 100.0],  # c0, c1, kappa
+  )" + jacobianSettings + R"(
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::MooneyRivlinIncompressible2D
+  > problem(settings);
+
+  problem.run();
+
+  std::vector<std::array<double,2>> displacements;
+  problem.data().displacements().getValuesWithoutGhosts(displacements);
+  return displacements;
+}
+
+// the jacobian only changes the path of the Newton iterations, not the solution, therefore the colored finite differences,
+// the column-wise finite differences and the matrix-free jacobian have to give the same displacements as the analytic jacobian
+TEST(SolidMechanicsTest, JacobianModesGiveSameSolution)
+{
+  std::vector<std::array<double,2>> displacementsAnalytic = solveMooneyRivlin2D(R"(
+    "analyticJacobian": True,
+    "numericJacobian": False,
+  )");
+
+  // the plate is pulled to the right, otherwise the comparisons would be trivial
+  ASSERT_EQ(displacementsAnalytic.size(), 9u);
+  EXPECT_GT(displacementsAnalytic[8][0], 1e-2);
+
+  std::vector<std::pair<std::string,std::string>> jacobianModes = {
+    {"finite differences with coloring", R"(
+    "analyticJacobian": False,
+    "numericJacobian": True,
+    "finiteDifferenceColoring": True,
+  )"},
+    {"finite differences without coloring", R"(
+    "analyticJacobian": False,
+    "numericJacobian": True,
+    "finiteDifferenceColoring": False,
+  )"},
+    {"matrix-free", R"(
+    "analyticJacobian": True,
+    "numericJacobian": False,
+    "matrixFreeJacobian": True,
+  )"},
+  };
+
+  for (const std::pair<std::string,std::string> &jacobianMode : jacobianModes)
+  {
+    std::vector<std::array<double,2>> displacements = solveMooneyRivlin2D(jacobianMode.second);
+
+    ASSERT_EQ(displacements.size(), displacementsAnalytic.size()) << jacobianMode.first;
+    for (int nodeNo = 0; nodeNo < displacements.size(); nodeNo++)
+    {
+      for (int componentNo = 0; componentNo < 2; componentNo++)
+      {
+        EXPECT_NEAR(displacements[nodeNo][componentNo], displacementsAnalytic[nodeNo][componentNo], 1e-6)
+          << jacobianMode.first << ", node " << nodeNo << ", component " << componentNo;
+      }
+    }
+  }
+}
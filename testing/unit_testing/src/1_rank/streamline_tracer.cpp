@@ -0,0 +1,106 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+namespace Postprocessing
+{
+
+// the potential flow in a box with potential 0 at the bottom and 2 at the top is the analytic field u = z with gradient (0,0,1),
+// the streamlines traced with RK4 are straight lines in z direction through the seed points and are written to a binary file
+TEST(StreamlineTracerTest, StraightStreamlinesRK4BinaryOutput)
+{
+  std::string pythonConfig = R"(
+# 3x3x5 nodes, node no = k*9 + j*3 + i
+bc = {}
+for i in range(9):
+  bc[i] = 0.0
+  bc[36+i] = 2.0
+
+config = {
+  "Meshes": {
+    "box": {
+      "nElements": [2, 2, 4],
+      "physicalExtent": [1.0, 1.0, 2.0],
+      "inputMeshIsGlobal": True,
+    }
+  },
+  "Solvers": {
+    "linearSolver": {
+      "solverType": "gmres",
+      "preconditionerType": "none",
+      "relativeTolerance": 1e-15,
+      "maxIterations": 10000,
+    }
+  },
+  "StreamlineTracer": {
+    "seedPoints": [[0.3, 0.4, 1.0], [0.7, 0.6, 0.7]],
+    "lineStepWidth": 1e-2,
+    "lineIntegrationScheme": "RK4",
+    "useGradientField": False,
+    "csvFilenameBeforePostprocessing": "streamlines_rk4.bin",
+    "FiniteElementMethod": {
+      "meshName": "box",
+      "solverName": "linearSolver",
+      "dirichletBoundaryConditions": bc,
+      "prefactor": 1.0,
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  StreamlineTracer<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredDeformableOfDimension<3>,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<2>,
+      Equation::Static::Laplace
+    >
+  > problem(settings);
+
+  problem.run();
+
+  // read the binary file: int32 number of streamlines, then for every streamline int32 number of points and the points as 3 doubles each
+  std::ifstream file("streamlines_rk4.bin", std::ios::in | std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+
+  int32_t nStreamlines = 0;
+  file.read((char *)&nStreamlines, sizeof(int32_t));
+  ASSERT_EQ(nStreamlines, 2);
+
+  std::vector<Vec3> seedPoints = {Vec3({0.3, 0.4, 1.0}), Vec3({0.7, 0.6, 0.7})};
+  for (int streamlineNo = 0; streamlineNo < nStreamlines; streamlineNo++)
+  {
+    int32_t nPoints = 0;
+    file.read((char *)&nPoints, sizeof(int32_t));
+    ASSERT_GT(nPoints, 2);
+
+    std::vector<Vec3> points(nPoints);
+    file.read((char *)points.data(), nPoints*sizeof(Vec3));
+    ASSERT_TRUE(file.good());
+
+    // the streamline goes from the bottom to the top in steps of lineStepWidth, the last point of each direction may be slightly outside
+    EXPECT_NEAR(points.front()[2], 0.0, 2.5e-2) << "streamline " << streamlineNo;
+    EXPECT_NEAR(points.back()[2], 2.0, 2.5e-2) << "streamline " << streamlineNo;
+
+    for (int pointNo = 0; pointNo < nPoints; pointNo++)
+    {
+      EXPECT_NEAR(points[pointNo][0], seedPoints[streamlineNo][0], 1e-8) << "streamline " << streamlineNo << ", point " << pointNo;
+      EXPECT_NEAR(points[pointNo][1], seedPoints[streamlineNo][1], 1e-8) << "streamline " << streamlineNo << ", point " << pointNo;
+      if (pointNo > 0)
+      {
+        EXPECT_NEAR(points[pointNo][2] - points[pointNo-1][2], 1e-2, 1e-8) << "streamline " << streamlineNo << ", point " << pointNo;
+      }
+    }
+  }
+}
+
+}  // namespace
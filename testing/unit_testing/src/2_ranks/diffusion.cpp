@@ -220,3 +220,176 @@ config = {
 
   nFails += ::testing::Test::HasFailure();
 }
+
+// 1D structured deformable, implicit Euler with the direct tridiagonal solver in parallel against gmres in serial
+TEST(DiffusionTest, SerialEqualsParallelImplicitEuler1DTridiagonal)
+{
+  // run serial problem
+  std::string pythonConfig = R"(
+# Diffusion 1D
+
+n = 10   # number of elements
+
+config = {
+  "MultipleInstances": {
+    "nInstances": 1,
+    "instances": [{
+      "ranks": [0],
+      "ImplicitEuler": {
+        "initialValues": [2,2,4,5,2,2,3,3,1,1,2],
+        "numberTimeSteps": 5,
+        "endTime": 0.1,
+        "relativeTolerance": 1e-15,
+        "FiniteElementMethod": {
+          "inputMeshIsGlobal": True,
+          "nElements": n,
+          "physicalExtent": 4.0,
+          "diffusionTensor": [5.0],
+        },
+        "OutputWriter" : [
+          {"format": "PythonFile", "filename": "out_implicit_tridiagonal", "outputInterval": 1, "binary": False}
+        ]
+      }
+    }]
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef Control::MultipleInstances<
+    TimeSteppingScheme::ImplicitEuler<
+      SpatialDiscretization::FiniteElementMethod<
+        Mesh::StructuredDeformableOfDimension<1>,
+        BasisFunction::LagrangeOfOrder<1>,
+        Quadrature::Gauss<2>,
+        Equation::Dynamic::IsotropicDiffusion
+      >
+    >
+  > ProblemType;
+
+  ProblemType problemSerial(settings);
+  problemSerial.run();
+
+  // run parallel problem
+  std::string pythonConfig2 = R"(
+# Diffusion 1D
+
+n = 10   # number of elements
+
+config = {
+  "MultipleInstances": {
+    "nInstances": 1,
+    "instances": [{
+      "ranks": [0,1],
+      "ImplicitEuler": {
+        "initialValues": [2,2,4,5,2,2,3,3,1,1,2],
+        "numberTimeSteps": 5,
+        "endTime": 0.1,
+        "solverType": "tridiagonal",
+        "FiniteElementMethod": {
+          "inputMeshIsGlobal": True,
+          "nElements": n,
+          "physicalExtent": 4.0,
+          "diffusionTensor": [5.0],
+        },
+        "OutputWriter" : [
+          {"format": "PythonFile", "filename": "out_implicit_tridiagonal", "outputInterval": 1, "binary": False}
+        ]
+      }
+    }]
+  }
+}
+)";
+
+  DihuContext settings2(argc, argv, pythonConfig2);
+  ProblemType problemParallel(settings2);
+
+  problemParallel.run();
+
+  // the parallel problem has to be solved by the tridiagonal solver and not by the fallback to the linear solver
+  ASSERT_EQ(problemParallel.instancesLocal().size(), 1);
+  EXPECT_NE(problemParallel.instancesLocal()[0].tridiagonalSystem(), nullptr);
+
+  std::vector<std::string> outputFilesToCheck = {"out_implicit_tridiagonal_0000004.py", "out_implicit_tridiagonal_0000004.0.py", "out_implicit_tridiagonal_0000004.1.py"};
+  assertParallelEqualsSerialOutputFiles(outputFilesToCheck);
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// 1D structured deformable, several fibers on both ranks with the tridiagonal solver, the systems of all fibers are solved together by
+// TridiagonalSystemBatch with the option "batchInstances", the result has to be the same as for the fibers that are solved one after the other
+TEST(DiffusionTest, ImplicitEuler1DTridiagonalBatchedEqualsUnbatched)
+{
+  typedef Control::MultipleInstances<
+    TimeSteppingScheme::ImplicitEuler<
+      SpatialDiscretization::FiniteElementMethod<
+        Mesh::StructuredDeformableOfDimension<1>,
+        BasisFunction::LagrangeOfOrder<1>,
+        Quadrature::Gauss<2>,
+        Equation::Dynamic::IsotropicDiffusion
+      >
+    >
+  > ProblemType;
+
+  // the local values of all fibers, once solved one after the other and once batched
+  std::array<std::vector<std::vector<double>>,2> values;
+  for (int batchInstances = 0; batchInstances < 2; batchInstances++)
+  {
+    std::stringstream pythonConfig;
+    pythonConfig << "batch_instances = " << (batchInstances? "True" : "False") << std::endl << R"(
+n = 10   # number of elements
+
+def instance_config(i):
+  return {
+    "ranks": [0,1],
+    "ImplicitEuler": {
+      "initialValues": [2,2,4,5,2,2,3,3,1,1,2+i],
+      "numberTimeSteps": 5,
+      "endTime": 0.1,
+      "solverType": "tridiagonal",
+      "FiniteElementMethod": {
+        "inputMeshIsGlobal": True,
+        "nElements": n,
+        "physicalExtent": 4.0+i,
+        "diffusionTensor": [5.0-i],
+      },
+    }
+  }
+
+config = {
+  "MultipleInstances": {
+    "nInstances": 3,
+    "batchInstances": batch_instances,
+    "instances": [instance_config(i) for i in range(3)],
+  }
+}
+)";
+
+    DihuContext settings(argc, argv, pythonConfig.str());
+    ProblemType problem(settings);
+    problem.run();
+
+    // all fibers have a tridiagonal system, such that they are solved together by TridiagonalSystemBatch if they are batched
+    ASSERT_EQ(problem.instancesLocal().size(), 3);
+    for (auto &instance : problem.instancesLocal())
+    {
+      EXPECT_NE(instance.tridiagonalSystem(), nullptr);
+
+      std::vector<double> instanceValues;
+      instance.data().solution()->getValuesWithoutGhosts(instanceValues);
+      values[batchInstances].push_back(instanceValues);
+    }
+  }
+
+  for (int instanceNo = 0; instanceNo < 3; instanceNo++)
+  {
+    ASSERT_EQ(values[1][instanceNo].size(), values[0][instanceNo].size());
+    for (int i = 0; i < values[0][instanceNo].size(); i++)
+    {
+      EXPECT_NEAR(values[1][instanceNo][i], values[0][instanceNo][i], 1e-12) << "instance " << instanceNo << ", dof " << i;
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
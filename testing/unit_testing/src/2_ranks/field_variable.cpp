@@ -0,0 +1,188 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// 1D mesh, rank 0 has a ghost node, rank 1 has none, the contiguous vector of a field variable with 2 components has to be created collectively
+TEST(FieldVariableTest, ContiguousValuesMultipleComponents)
+{
+  std::string pythonConfig = R"(
+config = {
+  "FiniteElementMethod": {
+    "inputMeshIsGlobal": True,
+    "nElements": [4],
+    "physicalExtent": [4.0],
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredRegularFixedOfDimension<1>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Laplace
+  > FiniteElementMethodType;
+  typedef typename FiniteElementMethodType::FunctionSpace FunctionSpaceType;
+
+  FiniteElementMethodType finiteElementMethod(settings);
+  finiteElementMethod.initialize();
+
+  std::shared_ptr<FunctionSpaceType> functionSpace = finiteElementMethod.functionSpace();
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,2>> fieldVariable = functionSpace->template createFieldVariable<2>("test");
+
+  // set the values to the global dof no, +10 for the second component
+  const int nDofsLocal = functionSpace->nDofsLocalWithoutGhosts();
+  std::vector<double> values0(nDofsLocal), values1(nDofsLocal);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++)
+  {
+    values0[dofNoLocal] = functionSpace->meshPartition()->getDofNoGlobalPetsc(dofNoLocal);
+    values1[dofNoLocal] = values0[dofNoLocal] + 10.0;
+  }
+  fieldVariable->setValuesWithoutGhosts(0, values0);
+  fieldVariable->setValuesWithoutGhosts(1, values1);
+
+  // the contiguous vector contains the local values of the first component, then of the second
+  Vec valuesContiguous = fieldVariable->getValuesContiguous();
+
+  PetscErrorCode ierr;
+  PetscInt nEntriesLocal;
+  ierr = VecGetLocalSize(valuesContiguous, &nEntriesLocal); CHKERRV(ierr);
+  ASSERT_EQ(nEntriesLocal, 2*nDofsLocal);
+
+  const double *data;
+  ierr = VecGetArrayRead(valuesContiguous, &data); CHKERRV(ierr);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++)
+  {
+    EXPECT_EQ(data[dofNoLocal], values0[dofNoLocal]);
+    EXPECT_EQ(data[nDofsLocal + dofNoLocal], values1[dofNoLocal]);
+  }
+  ierr = VecRestoreArrayRead(valuesContiguous, &data); CHKERRV(ierr);
+
+  // modify the values through the contiguous vector
+  ierr = VecScale(valuesContiguous, 2.0); CHKERRV(ierr);
+  fieldVariable->restoreValuesContiguous();
+
+  std::vector<double> values;
+  fieldVariable->getValuesWithoutGhosts(1, values);
+  ASSERT_EQ(values.size(), (size_t)nDofsLocal);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++)
+  {
+    EXPECT_EQ(values[dofNoLocal], 2.0*values1[dofNoLocal]);
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// every rank has its own 1D mesh on a rank subset that contains only this rank, then no rank has ghost dofs and the component vectors
+// and the contiguous vector share the same memory, values written through one representation have to be visible in the other
+TEST(FieldVariableTest, ContiguousValuesSharedStorage)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Meshes": {
+    "MeshOwnRank": {
+      "inputMeshIsGlobal": True,
+      "nElements": [4],
+      "physicalExtent": [4.0],
+    },
+  },
+  "FieldVariable": {"meshName": "MeshOwnRank"},
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+  const int ownRankNo = DihuContext::ownRankNo();
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+
+  // the rank subsets are created collectively, every rank gets a communicator with only itself
+  std::shared_ptr<Partition::RankSubset> rankSubsetOwnRank = std::make_shared<Partition::RankSubset>(ownRankNo);
+  settings.partitionManager()->setRankSubsetForNextCreatedPartitioning(rankSubsetOwnRank);
+  std::shared_ptr<FunctionSpaceType> functionSpace = settings.meshManager()->functionSpace<FunctionSpaceType>(settings["FieldVariable"].getPythonConfig());
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,2>> fieldVariable = functionSpace->template createFieldVariable<2>("shared");
+
+  const int nDofsLocal = functionSpace->nDofsLocalWithoutGhosts();
+  ASSERT_EQ(nDofsLocal, 5);
+  ASSERT_EQ(functionSpace->nDofsLocalWithGhosts(), nDofsLocal);
+
+  // write through the component vectors
+  std::vector<double> values0(nDofsLocal), values1(nDofsLocal);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++)
+  {
+    values0[dofNoLocal] = dofNoLocal + 1.0;
+    values1[dofNoLocal] = dofNoLocal + 11.0;
+  }
+  fieldVariable->setValuesWithoutGhosts(0, values0);
+  fieldVariable->setValuesWithoutGhosts(1, values1);
+
+  // read through the contiguous vector
+  Vec valuesContiguous = fieldVariable->getValuesContiguous();
+
+  PetscErrorCode ierr;
+  double *data;
+  ierr = VecGetArray(valuesContiguous, &data); CHKERRV(ierr);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++)
+  {
+    EXPECT_EQ(data[dofNoLocal], values0[dofNoLocal]);
+    EXPECT_EQ(data[nDofsLocal + dofNoLocal], values1[dofNoLocal]);
+  }
+
+  // write through the contiguous vector
+  for (int i = 0; i < 2*nDofsLocal; i++)
+  {
+    data[i] = -i;
+  }
+  double *dataContiguous = data;
+  ierr = VecRestoreArray(valuesContiguous, &data); CHKERRV(ierr);
+
+  // the norm is cached by PETSc until the state of the vector changes
+  double normBefore;
+  ierr = VecNorm(valuesContiguous, NORM_1, &normBefore); CHKERRV(ierr);
+  EXPECT_EQ(normBefore, 45.0);
+
+  fieldVariable->restoreValuesContiguous();
+
+  // read through the component vectors, which are views of the same memory
+  for (int componentNo = 0; componentNo < 2; componentNo++)
+  {
+    const double *dataComponent;
+    ierr = VecGetArrayRead(fieldVariable->valuesLocal(componentNo), &dataComponent); CHKERRV(ierr);
+    EXPECT_EQ(dataComponent, dataContiguous + componentNo*nDofsLocal) << "component " << componentNo << " does not use the shared storage";
+    ierr = VecRestoreArrayRead(fieldVariable->valuesLocal(componentNo), &dataComponent); CHKERRV(ierr);
+
+    std::vector<double> values;
+    fieldVariable->getValuesWithoutGhosts(componentNo, values);
+    ASSERT_EQ(values.size(), (size_t)nDofsLocal);
+    for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++)
+    {
+      EXPECT_EQ(values[dofNoLocal], -(componentNo*nDofsLocal + dofNoLocal)) << "component " << componentNo << ", dof " << dofNoLocal;
+    }
+  }
+
+  // write through the component vectors again, only the first value changes, the contiguous vector has to see it and must not return the cached norm
+  fieldVariable->setValue(0, std::array<double,2>({100.0, -5.0}));
+
+  valuesContiguous = fieldVariable->getValuesContiguous();
+
+  const double *dataRead;
+  ierr = VecGetArrayRead(valuesContiguous, &dataRead); CHKERRV(ierr);
+  EXPECT_EQ(dataRead[0], 100.0);
+  ierr = VecRestoreArrayRead(valuesContiguous, &dataRead); CHKERRV(ierr);
+
+  double normAfter;
+  ierr = VecNorm(valuesContiguous, NORM_1, &normAfter); CHKERRV(ierr);
+  EXPECT_EQ(normAfter, 145.0);
+
+  fieldVariable->restoreValuesContiguous();
+
+  nFails += ::testing::Test::HasFailure();
+}
@@ -0,0 +1,118 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// 3D mesh on 2 ranks and a fiber that is only partitioned on rank 0 but crosses the domains of both ranks,
+// rank 1 has no part of the fiber and takes part in the mappings with mapWithoutSource and mapWithoutTarget
+TEST(MeshTest, MappingBetweenMeshesFiberOnOneRank)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Meshes": {
+    "Mesh3D": {
+      "nElements": [4, 4, 4],
+      "physicalExtent": [2.0, 2.0, 2.0],
+      "inputMeshIsGlobal": True,
+    },
+    "MeshFibre": {
+      "nElements": [4],
+      "nodePositions": [[0.2, 0.25, 0.3], [0.6, 0.65, 0.7], [1.1, 1.15, 1.2], [1.4, 1.45, 1.55], [1.8, 1.75, 1.7]],
+      "inputMeshIsGlobal": True,
+    },
+  },
+  "Domain": {"meshName": "Mesh3D"},
+  "Fibre": {"meshName": "MeshFibre"},
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+  const int ownRankNo = DihuContext::ownRankNo();
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<3>, BasisFunction::LagrangeOfOrder<1>> FunctionSpace3D;
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceFibre;
+
+  std::shared_ptr<FunctionSpace3D> functionSpace3D = settings.meshManager()->functionSpace<FunctionSpace3D>(settings["Domain"].getPythonConfig());
+
+  // the rank subset of the fiber has to be created on all ranks, the fiber mesh only on rank 0
+  std::shared_ptr<Partition::RankSubset> rankSubsetFibre = std::make_shared<Partition::RankSubset>(0);
+  std::shared_ptr<FunctionSpaceFibre> functionSpaceFibre = nullptr;
+  if (ownRankNo == 0)
+  {
+    settings.partitionManager()->setRankSubsetForNextCreatedPartitioning(rankSubsetFibre);
+    functionSpaceFibre = settings.meshManager()->functionSpace<FunctionSpaceFibre>(settings["Fibre"].getPythonConfig());
+  }
+
+  // the mappings are constructed collectively on both ranks
+  Mesh::MappingBetweenMeshes<FunctionSpace3D,FunctionSpaceFibre> mapping3DToFibre(functionSpace3D, functionSpaceFibre);
+  Mesh::MappingBetweenMeshes<FunctionSpaceFibre,FunctionSpace3D> mappingFibreTo3D(functionSpaceFibre, functionSpace3D);
+
+  // 3D -> fiber, a linear field is interpolated exactly by the trilinear basis functions, the fiber nodes in the domain of rank 1 get their values from rank 1
+  auto linearField = [](const Vec3 &position)
+  {
+    return 1.0 + position[0] + 2*position[1] + 3*position[2];
+  };
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,1>> fieldVariable3D = functionSpace3D->template createFieldVariable<1>("values3D");
+  std::vector<Vec3> positions3D;
+  functionSpace3D->geometryField().getValuesWithoutGhosts(positions3D);
+  std::vector<double> values3D;
+  for (const Vec3 &position : positions3D)
+    values3D.push_back(linearField(position));
+  fieldVariable3D->setValuesWithoutGhosts(values3D);
+
+  if (ownRankNo == 0)
+  {
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceFibre,1>> fieldVariableFibre = functionSpaceFibre->template createFieldVariable<1>("valuesFibre");
+    mapping3DToFibre.map(*fieldVariable3D, 0, *fieldVariableFibre, 0);
+
+    std::vector<Vec3> positionsFibre;
+    functionSpaceFibre->geometryField().getValuesWithoutGhosts(positionsFibre);
+    std::vector<double> valuesFibre;
+    fieldVariableFibre->getValuesWithoutGhosts(valuesFibre);
+
+    ASSERT_EQ(valuesFibre.size(), 5u);
+    for (int i = 0; i < valuesFibre.size(); i++)
+    {
+      EXPECT_NEAR(valuesFibre[i], linearField(positionsFibre[i]), 1e-12) << "fiber node " << i;
+    }
+  }
+  else
+  {
+    mapping3DToFibre.mapWithoutTarget(*fieldVariable3D, 0);
+  }
+
+  // fiber -> 3D with a constant field, all 3D nodes with contributions get the constant value, also the nodes of rank 1
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,1>> result3D = functionSpace3D->template createFieldVariable<1>("result3D");
+  if (ownRankNo == 0)
+  {
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceFibre,1>> constantFibre = functionSpaceFibre->template createFieldVariable<1>("constantFibre");
+    constantFibre->setValuesWithoutGhosts(std::vector<double>(5, 3.0));
+    mappingFibreTo3D.map(*constantFibre, 0, *result3D, 0);
+  }
+  else
+  {
+    mappingFibreTo3D.mapWithoutSource(*result3D, 0);
+  }
+
+  result3D->getValuesWithoutGhosts(values3D);
+  int nNodesWithContribution = 0;
+  for (double value : values3D)
+  {
+    if (fabs(value) > 1e-12)
+    {
+      EXPECT_NEAR(value, 3.0, 1e-12);
+      nNodesWithContribution++;
+    }
+  }
+  EXPECT_GT(nNodesWithContribution, 0) << "rank " << ownRankNo << " got no contribution of the fiber";
+
+  nFails += ::testing::Test::HasFailure();
+}
@@ -0,0 +1,287 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// batched Strang splittings of two fibers on 2 ranks with "skipWhenQuiescent", the first fiber is only stimulated in the part of rank 0,
+// its part on rank 1 has to be computed although it is at rest in the beginning, the second fiber rests and is skipped on both ranks
+TEST(OperatorSplittingTest, StrangSkipQuiescentFibersPartiallyActive)
+{
+  std::string pythonConfigCommon = R"(
+Conductivity = 3.828    # sigma, conductivity [mS/cm]
+Am = 500.0              # surface area to volume ratio [cm^-1]
+Cm = 0.58               # membrane capacitance [uF/cm^2]
+
+# steady state of the Hodgkin-Huxley model for I_Stim = 0
+rest_states = [-74.9951235335408, 0.05296292799880796, 0.5959502019928442, 0.31772521708093526]
+firing_times = [[0.0], []]     # the firing times of the two fibers, the second fiber is not stimulated
+
+def instance_config(fiber_no):
+  return {
+    "ranks": [0,1],
+    "StrangSplitting": {
+      "timeStepWidth": 1e-2,
+      "endTime": 2.0,
+      "Term1": {      # CellML
+        "Heun" : {
+          "timeStepWidth": 1e-3,
+          "initialValues": [],
+          "inputMeshIsGlobal": True,
+          "dirichletBoundaryConditions": {},
+          "CellML" : {
+            "sourceFilename": "../input/hodgkin_huxley_1952.c",
+            "useGivenLibrary": False,
+            "statesInitialValues": rest_states,
+            "parametersInitialValues": [0.0],
+            "parametersUsedAsIntermediate": [],
+            "parametersUsedAsConstant": [2],
+            "meshName": "MeshFibre{}".format(fiber_no),
+            "stimulationSchedule": [
+              {"parameterNo": 0, "firingTimes": firing_times[fiber_no], "stimulationDuration": 0.1, "value": 1000.0, "restValue": 0.0, "dofNos": [0]},
+            ],
+            "skipWhenQuiescent": skip_when_quiescent,
+          },
+        },
+      },
+      "Term2": {     # Diffusion
+        "ImplicitEuler" : {
+          "initialValues": [],
+          "timeStepWidth": 5e-3,
+          "inputMeshIsGlobal": True,
+          "dirichletBoundaryConditions": {},
+          "solverName": "implicitSolver",
+          "FiniteElementMethod" : {
+            "meshName": "MeshFibre{}".format(fiber_no),
+            "prefactor": Conductivity/(Am*Cm),
+            "solverName": "implicitSolver",
+          },
+        },
+      },
+    }
+  }
+
+config = {
+  "Meshes": {
+    "MeshFibre{}".format(fiber_no): {
+      "nElements": 8,
+      "physicalExtent": 0.4,
+      "inputMeshIsGlobal": True,
+    }
+    for fiber_no in range(2)
+  },
+  "Solvers": {
+    "implicitSolver": {
+      "relativeTolerance": 1e-15,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+    }
+  },
+  "MultipleInstances": {
+    "nInstances": 2,
+    "batchInstances": True,
+    "instances": [instance_config(fiber_no) for fiber_no in range(2)],
+  }
+}
+)";
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  typedef Control::MultipleInstances<
+    OperatorSplitting::Strang<
+      TimeSteppingScheme::Heun<
+        CellmlAdapter<4,FunctionSpaceType>
+      >,
+      TimeSteppingScheme::ImplicitEuler<
+        SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredRegularFixedOfDimension<1>,
+          BasisFunction::LagrangeOfOrder<1>,
+          Quadrature::Gauss<2>,
+          Equation::Dynamic::IsotropicDiffusion
+        >
+      >
+    >
+  > ProblemType;
+
+  // the local states of both fibers at t=2, once without and once with skipping
+  std::array<std::vector<std::vector<std::array<double,4>>>,2> states;
+  for (int skipWhenQuiescent = 0; skipWhenQuiescent < 2; skipWhenQuiescent++)
+  {
+    DihuContext settings(argc, argv, std::string("skip_when_quiescent = ") + (skipWhenQuiescent? "True" : "False") + "\n" + pythonConfigCommon);
+    ProblemType problem(settings);
+    problem.run();
+
+    ASSERT_EQ(problem.instancesLocal().size(), 2);
+    for (int fiberNo = 0; fiberNo < 2; fiberNo++)
+    {
+      std::vector<std::array<double,4>> values;
+      problem.instancesLocal()[fiberNo].timeStepping1().data().solution()->getValuesWithoutGhosts(values);
+      states[skipWhenQuiescent].push_back(values);
+    }
+  }
+
+  const int ownRankNo = DihuContext::ownRankNo();
+
+  // the results only differ by the small changes at rest that are not computed while the second fiber is skipped, its rates are below 1e-12
+  for (int fiberNo = 0; fiberNo < 2; fiberNo++)
+  {
+    ASSERT_EQ(states[1][fiberNo].size(), states[0][fiberNo].size());
+    for (int i = 0; i < states[0][fiberNo].size(); i++)
+    {
+      for (int stateNo = 0; stateNo < 4; stateNo++)
+      {
+        EXPECT_NEAR(states[1][fiberNo][i][stateNo], states[0][fiberNo][i][stateNo], 1e-6)
+          << "rank " << ownRankNo << ", fiber " << fiberNo << ", node " << i << ", state " << stateNo;
+      }
+    }
+  }
+
+  // the excitation of the first fiber has spread to the part of rank 1, the second fiber is still at rest
+  if (ownRankNo == 1)
+  {
+    for (int i = 0; i < states[1][0].size(); i++)
+    {
+      EXPECT_GT(states[1][0][i][0], -50.0) << "node " << i;
+    }
+  }
+  for (int i = 0; i < states[1][1].size(); i++)
+  {
+    EXPECT_NEAR(states[1][1][i][0], -74.9951235335408, 1e-6) << "rank " << ownRankNo << ", node " << i;
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// batched Strang splittings of five fibers with the tridiagonal diffusion solver, some fibers are on both ranks, some only on one rank,
+// such that the ranks have different local instances. The pipeline groups are derived from the fiber numbers and have to match on both ranks,
+// the result with several pipeline groups has to be the same as with a single group
+TEST(OperatorSplittingTest, StrangPipelineGroupsTridiagonal)
+{
+  std::string pythonConfigCommon = R"(
+Conductivity = 3.828    # sigma, conductivity [mS/cm]
+Am = 500.0              # surface area to volume ratio [cm^-1]
+Cm = 0.58               # membrane capacitance [uF/cm^2]
+
+# steady state of the Hodgkin-Huxley model for I_Stim = 0
+rest_states = [-74.9951235335408, 0.05296292799880796, 0.5959502019928442, 0.31772521708093526]
+fiber_ranks = [[0], [0,1], [0,1], [1], [0,1]]
+
+def instance_config(fiber_no):
+  return {
+    "ranks": fiber_ranks[fiber_no],
+    "StrangSplitting": {
+      "timeStepWidth": 1e-2,
+      "endTime": 1.0,
+      "nPipelineGroups": n_pipeline_groups,
+      "Term1": {      # CellML
+        "Heun" : {
+          "timeStepWidth": 1e-3,
+          "initialValues": [],
+          "inputMeshIsGlobal": True,
+          "dirichletBoundaryConditions": {},
+          "CellML" : {
+            "sourceFilename": "../input/hodgkin_huxley_1952.c",
+            "useGivenLibrary": False,
+            "statesInitialValues": rest_states,
+            "parametersInitialValues": [0.0],
+            "parametersUsedAsIntermediate": [],
+            "parametersUsedAsConstant": [2],
+            "meshName": "MeshFibre{}".format(fiber_no),
+            "stimulationSchedule": [
+              {"parameterNo": 0, "firingTimes": [0.0], "stimulationDuration": 0.1, "value": 600.0+100*fiber_no, "restValue": 0.0, "dofNos": [0]},
+            ],
+          },
+        },
+      },
+      "Term2": {     # Diffusion
+        "ImplicitEuler" : {
+          "initialValues": [],
+          "timeStepWidth": 5e-3,
+          "inputMeshIsGlobal": True,
+          "dirichletBoundaryConditions": {},
+          "solverType": "tridiagonal",
+          "FiniteElementMethod" : {
+            "meshName": "MeshFibre{}".format(fiber_no),
+            "prefactor": Conductivity/(Am*Cm),
+          },
+        },
+      },
+    }
+  }
+
+config = {
+  "Meshes": {
+    "MeshFibre{}".format(fiber_no): {
+      "nElements": 8,
+      "physicalExtent": 0.4,
+      "inputMeshIsGlobal": True,
+    }
+    for fiber_no in range(5)
+  },
+  "MultipleInstances": {
+    "nInstances": 5,
+    "batchInstances": True,
+    "instances": [instance_config(fiber_no) for fiber_no in range(5)],
+  }
+}
+)";
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  typedef Control::MultipleInstances<
+    OperatorSplitting::Strang<
+      TimeSteppingScheme::Heun<
+        CellmlAdapter<4,FunctionSpaceType>
+      >,
+      TimeSteppingScheme::ImplicitEuler<
+        SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredRegularFixedOfDimension<1>,
+          BasisFunction::LagrangeOfOrder<1>,
+          Quadrature::Gauss<2>,
+          Equation::Dynamic::IsotropicDiffusion
+        >
+      >
+    >
+  > ProblemType;
+
+  const int ownRankNo = DihuContext::ownRankNo();
+
+  // the local states of the local fibers at t=1, once with a single pipeline group and once with three groups
+  std::array<std::vector<std::vector<std::array<double,4>>>,2> states;
+  std::array<int,2> nPipelineGroups = {1, 3};
+  for (int i = 0; i < 2; i++)
+  {
+    DihuContext settings(argc, argv, std::string("n_pipeline_groups = ") + std::to_string(nPipelineGroups[i]) + "\n" + pythonConfigCommon);
+    ProblemType problem(settings);
+    problem.run();
+
+    // rank 0 has fibers 0,1,2,4 and rank 1 has fibers 1,2,3,4
+    ASSERT_EQ(problem.instancesLocal().size(), 4);
+    for (auto &instance : problem.instancesLocal())
+    {
+      EXPECT_NE(instance.timeStepping2().tridiagonalSystem(), nullptr);
+
+      std::vector<std::array<double,4>> values;
+      instance.timeStepping1().data().solution()->getValuesWithoutGhosts(values);
+      states[i].push_back(values);
+    }
+  }
+
+  for (int fiberNo = 0; fiberNo < 4; fiberNo++)
+  {
+    ASSERT_EQ(states[1][fiberNo].size(), states[0][fiberNo].size());
+    for (int i = 0; i < states[0][fiberNo].size(); i++)
+    {
+      for (int stateNo = 0; stateNo < 4; stateNo++)
+      {
+        EXPECT_NEAR(states[1][fiberNo][i][stateNo], states[0][fiberNo][i][stateNo], 1e-10)
+          << "rank " << ownRankNo << ", local fiber " << fiberNo << ", node " << i << ", state " << stateNo;
+      }
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}